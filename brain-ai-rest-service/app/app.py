@@ -165,7 +165,7 @@ async def index_document(payload: IndexPayload, request: Request) -> Dict[str, b
     start = time.perf_counter()
 
     embedding = embed_text(payload.text)
-    bridge.index_document(payload.doc_id, payload.text, embedding)
+    await bridge.index_document_async(payload.doc_id, payload.text, embedding)
     INDEXED_DOCUMENTS.inc()
     INDEX_SIZE.set(bridge.size())
 
@@ -196,7 +196,7 @@ async def query(payload: QueryPayload, request: Request) -> QueryResponse:
     start = time.perf_counter()
 
     embedding = embed_text(payload.query)
-    raw_hits = bridge.search(payload.query, payload.top_k, embedding)
+    raw_hits = await bridge.search_async(payload.query, payload.top_k, embedding)
 
     enriched_hits: List[Dict[str, object]] = []
     for doc_id, score in raw_hits:
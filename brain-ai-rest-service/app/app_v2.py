@@ -215,7 +215,7 @@ async def index_document(payload: IndexPayload, request: Request) -> Dict[str, b
     embedding = embed_text(payload.text)
     
     # Index in C++ core
-    bridge.index_document(payload.doc_id, payload.text, embedding)
+    await bridge.index_document_async(payload.doc_id, payload.text, embedding)
     
     # Update metrics
     INDEXED_DOCUMENTS.inc()
@@ -271,7 +271,7 @@ async def answer_query(payload: QueryPayload, request: Request) -> Dict[str, Any
     # Step 2: Retrieve from vector store
     embedding = embed_text(query)
     top_k_retrieval = int(os.getenv("TOP_K_RETRIEVAL", "50"))
-    raw_hits = bridge.search(query, top_k_retrieval, embedding)
+    raw_hits = await bridge.search_async(query, top_k_retrieval, embedding)
     
     # Enrich with text
     enriched_hits: List[Dict[str, Any]] = []
@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import asyncio
 import importlib
 import json
 import logging
@@ -155,6 +156,53 @@ class CoreBridge:
         # Fallback path when module is unavailable or failed
         return self._memory.search(payload, top_k)
 
+    @property
+    def native_async(self) -> bool:
+        """True when the module completes futures from native threads."""
+        return self._module is not None and hasattr(self._module, "search_async")
+
+    async def index_document_async(
+        self, doc_id: str, text: str, embedding: Iterable[float]
+    ) -> None:
+        """index_document without blocking the event loop."""
+        if not self.native_async:
+            await asyncio.to_thread(self.index_document, doc_id, text, embedding)
+            return
+        payload = list(embedding)
+        try:
+            if payload:
+                future = self._module.index_document_async(doc_id, text, payload)
+            else:
+                future = self._module.index_document_async(doc_id, text)
+            await asyncio.wrap_future(future)
+        except TypeError as exc:
+            raise TypeError(f"pybind index_document failed for doc_id={doc_id}: {exc}") from exc
+        self._memory.index_document(doc_id, payload, text)
+
+    async def search_async(
+        self, query: str, top_k: int, embedding: Iterable[float]
+    ) -> List[Tuple[str, float]]:
+        """search without blocking the event loop (same fallback rules)."""
+        if not self.native_async:
+            return await asyncio.to_thread(self.search, query, top_k, embedding)
+        payload = list(embedding)
+        try:
+            if payload:
+                future = self._module.search_async(query, top_k, payload)
+            else:
+                future = self._module.search_async(query, top_k)
+            results = await asyncio.wrap_future(future)
+            return [(doc_id, float(score)) for doc_id, score in results]
+        except TypeError as exc:
+            if payload:
+                raise TypeError(
+                    f"pybind search failed with embedding for query={query!r}: {exc}"
+                ) from exc
+            raise
+        except Exception as exc:
+            LOGGER.warning("pybind search failed; using memory fallback: %s", exc)
+        return self._memory.search(payload, top_k)
+
     def save_index(self, path: os.PathLike[str] | str) -> None:
         if self._module:
             try:
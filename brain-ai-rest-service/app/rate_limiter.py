@@ -2,16 +2,42 @@
 
 from __future__ import annotations
 
+import importlib
+import math
 import threading
 import time
 from collections import deque
-from typing import Deque, Dict
+from typing import Deque, Dict, Optional
 
 from fastapi import HTTPException, status
 
 
+def _load_native_limiter(requests_per_minute: int) -> Optional[object]:
+    """Native lock-free limiter from brain_ai_core, if the module is built."""
+    try:
+        module = importlib.import_module("brain_ai_core")
+    except ImportError:
+        return None
+    native_cls = getattr(module, "RateLimiter", None)
+    if native_cls is None:
+        return None
+    return native_cls(requests_per_minute / 60.0, float(requests_per_minute))
+
+
+def _too_many_requests(retry_after: float) -> HTTPException:
+    return HTTPException(
+        status_code=status.HTTP_429_TOO_MANY_REQUESTS,
+        detail="Too many requests",
+        headers={"Retry-After": str(int(math.ceil(retry_after)))},
+    )
+
+
 class RateLimiter:
-    """Token-bucket style limiter for per-IP enforcement."""
+    """Per-client limiter of requests_per_minute.
+
+    Uses brain_ai_core's native token buckets when available (a full minute
+    of burst, refilled continuously); otherwise a sliding one-minute window.
+    """
 
     def __init__(self, requests_per_minute: int) -> None:
         if requests_per_minute <= 0:
@@ -20,8 +46,19 @@ class RateLimiter:
         self._window_seconds = 60.0
         self._lock = threading.Lock()
         self._events: Dict[str, Deque[float]] = {}
+        self._native = _load_native_limiter(requests_per_minute)
+
+    @property
+    def native(self) -> bool:
+        return self._native is not None
 
     def check(self, client_id: str) -> None:
+        if self._native is not None:
+            allowed, _, retry_after = self._native.acquire(client_id)
+            if not allowed:
+                raise _too_many_requests(retry_after)
+            return
+
         now = time.time()
         with self._lock:
             bucket = self._events.setdefault(client_id, deque())
@@ -31,12 +68,7 @@ class RateLimiter:
 
             if len(bucket) >= self._limit:
                 retry_after = max(0.0, self._window_seconds - (now - bucket[0]))
-                headers = {"Retry-After": str(int(retry_after))}
-                raise HTTPException(
-                    status_code=status.HTTP_429_TOO_MANY_REQUESTS,
-                    detail="Too many requests",
-                    headers=headers,
-                )
+                raise _too_many_requests(retry_after)
 
             bucket.append(now)
 
@@ -0,0 +1,136 @@
+"""Concurrent search throughput of brain_ai_core from one asyncio event loop.
+
+Mimics a uvicorn worker: a single event loop serves many concurrent
+requests, each doing one index search. Three ways of calling the core:
+
+  blocking   brain_ai_core.search() straight from the coroutine
+             (stalls the loop for every call, the old REST behaviour)
+  to_thread  asyncio.to_thread(brain_ai_core.search, ...)
+             (a Python thread-pool hop per call)
+  native     asyncio.wrap_future(brain_ai_core.search_async(...))
+             (native executor, GIL released, future completed from C++)
+
+Besides requests/s and latency percentiles it reports event-loop lag: how
+late a 1 ms ticker wakes up, i.e. what every other request on the loop
+would feel.
+
+Run with the built module on PYTHONPATH:
+    PYTHONPATH=build python3 benchmarks/bench_async_bindings.py --concurrency 64
+"""
+
+from __future__ import annotations
+
+import argparse
+import asyncio
+import random
+import time
+from typing import Awaitable, Callable, List
+
+import brain_ai_core
+
+DIM = 384
+
+
+def random_embedding(rng: random.Random) -> List[float]:
+    return [rng.gauss(0.0, 1.0) for _ in range(DIM)]
+
+
+def populate(documents: int, rng: random.Random) -> None:
+    for i in range(documents):
+        brain_ai_core.index_document(f"doc-{i}", f"document {i}", random_embedding(rng))
+
+
+def percentile(values: List[float], p: float) -> float:
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, max(0, int(round(p * len(ordered))) - 1))
+    return ordered[index]
+
+
+async def measure(
+    call: Callable[[List[float]], Awaitable[object]],
+    queries: List[List[float]],
+    concurrency: int,
+    duration: float,
+) -> dict:
+    latencies: List[float] = []
+    lags: List[float] = []
+    deadline = time.perf_counter() + duration
+    stop = asyncio.Event()
+
+    async def ticker() -> None:
+        while not stop.is_set():
+            start = time.perf_counter()
+            await asyncio.sleep(0.001)
+            lags.append(time.perf_counter() - start - 0.001)
+
+    async def client(seed: int) -> None:
+        i = seed
+        while time.perf_counter() < deadline:
+            start = time.perf_counter()
+            await call(queries[i % len(queries)])
+            latencies.append(time.perf_counter() - start)
+            i += concurrency
+
+    tick = asyncio.create_task(ticker())
+    began = time.perf_counter()
+    await asyncio.gather(*(client(seed) for seed in range(concurrency)))
+    elapsed = time.perf_counter() - began
+    stop.set()
+    await tick
+
+    return {
+        "rps": len(latencies) / elapsed,
+        "p50_ms": percentile(latencies, 0.50) * 1000,
+        "p99_ms": percentile(latencies, 0.99) * 1000,
+        "lag_p99_ms": percentile(lags, 0.99) * 1000 if lags else 0.0,
+        "lag_max_ms": max(lags) * 1000 if lags else 0.0,
+    }
+
+
+async def blocking(top_k: int, query: List[float]) -> object:
+    return brain_ai_core.search("", top_k, query)
+
+
+async def to_thread(top_k: int, query: List[float]) -> object:
+    return await asyncio.to_thread(brain_ai_core.search, "", top_k, query)
+
+
+async def native(top_k: int, query: List[float]) -> object:
+    return await asyncio.wrap_future(brain_ai_core.search_async("", top_k, query))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--documents", type=int, default=20000)
+    parser.add_argument("--queries", type=int, default=256)
+    parser.add_argument("--concurrency", type=int, nargs="+", default=[1, 16, 64])
+    parser.add_argument("--top-k", type=int, default=10)
+    parser.add_argument("--duration", type=float, default=2.0)
+    args = parser.parse_args()
+
+    rng = random.Random(42)
+    print(f"Indexing {args.documents} documents (dim {DIM})...")
+    populate(args.documents, rng)
+    queries = [random_embedding(rng) for _ in range(args.queries)]
+
+    modes = {"blocking": blocking, "to_thread": to_thread, "native": native}
+
+    print(f"\n{'mode':<10} {'conc':>5} {'req/s':>10} {'p50 ms':>8} {'p99 ms':>8} "
+          f"{'lag p99':>8} {'lag max':>8}")
+    for concurrency in args.concurrency:
+        for name, mode in modes.items():
+            async def call(query: List[float], mode=mode) -> object:
+                return await mode(args.top_k, query)
+
+            # Warm up (executor threads, caches)
+            asyncio.run(measure(call, queries, concurrency, 0.2))
+            result = asyncio.run(measure(call, queries, concurrency, args.duration))
+            print(f"{name:<10} {concurrency:>5} {result['rps']:>10.0f} "
+                  f"{result['p50_ms']:>8.2f} {result['p99_ms']:>8.2f} "
+                  f"{result['lag_p99_ms']:>8.2f} {result['lag_max_ms']:>8.2f}")
+
+    brain_ai_core.shutdown_async_executor()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+/**
+ * @file bench_episodic_concurrency.cpp
+ * @brief Mixed read/write throughput of EpisodicBuffer
+ *
+ * One writer appends continuously while N readers run retrieve_similar.
+ * "snapshot" is the buffer as shipped (lock-free readers); "locked" wraps
+ * every call in one external mutex, i.e. the former single-lock behavior.
+ */
+
+#include "episodic_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+constexpr size_t kDim = 384;
+constexpr size_t kCapacity = 2048;
+constexpr auto kDuration = std::chrono::milliseconds(1000);
+
+std::vector<float> random_vector(std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(kDim);
+    for (float& x : v) x = dist(rng);
+    return v;
+}
+
+struct Throughput {
+    double reads_per_sec = 0.0;
+    double writes_per_sec = 0.0;
+};
+
+Throughput run(size_t readers, bool locked) {
+    EpisodicBuffer buffer(kCapacity);
+    std::mutex external;
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < kCapacity; ++i) {
+        buffer.add_episode("warm", "r", random_vector(rng));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> reads{0};
+    size_t writes = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 local(100 + r);
+            auto query = random_vector(local);
+            size_t n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (locked) {
+                    std::lock_guard<std::mutex> lock(external);
+                    buffer.retrieve_similar(query, 5, 0.2f);
+                } else {
+                    buffer.retrieve_similar(query, 5, 0.2f);
+                }
+                ++n;
+            }
+            reads.fetch_add(n);
+        });
+    }
+
+    std::thread writer([&]() {
+        std::mt19937 local(7);
+        auto emb = random_vector(local);
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (locked) {
+                std::lock_guard<std::mutex> lock(external);
+                buffer.add_episode("query", "response", emb);
+            } else {
+                buffer.add_episode("query", "response", emb);
+            }
+            ++writes;
+        }
+    });
+
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    writer.join();
+    for (auto& t : threads) t.join();
+
+    double seconds = std::chrono::duration<double>(kDuration).count();
+    return {reads.load() / seconds, writes / seconds};
+}
+
+} // namespace
+
+int main() {
+    std::cout << "EpisodicBuffer mixed read/write (capacity=" << kCapacity
+              << ", dim=" << kDim << ", 1 writer)\n\n";
+    std::cout << std::setw(8) << "readers"
+              << std::setw(16) << "locked_reads/s" << std::setw(16) << "locked_writes/s"
+              << std::setw(16) << "snap_reads/s" << std::setw(16) << "snap_writes/s" << "\n";
+
+    for (size_t readers : {1, 2, 4, 8}) {
+        auto locked = run(readers, true);
+        auto snap = run(readers, false);
+        std::cout << std::setw(8) << readers << std::fixed << std::setprecision(0)
+                  << std::setw(16) << locked.reads_per_sec
+                  << std::setw(16) << locked.writes_per_sec
+                  << std::setw(16) << snap.reads_per_sec
+                  << std::setw(16) << snap.writes_per_sec << "\n";
+    }
+    return 0;
+}
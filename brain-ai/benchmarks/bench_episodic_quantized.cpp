@@ -0,0 +1,114 @@
+/**
+ * @file bench_episodic_quantized.cpp
+ * @brief Episodic retrieval with fp32 vs int8 embedding storage
+ *
+ * Reports per-query latency, buffer footprint and recall@k of the int8
+ * modes against the fp32 ranking.
+ */
+
+#include "episodic_buffer.hpp"
+#include "quantization.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+constexpr size_t kDim = 1536;
+constexpr size_t kEpisodes = 20000;
+constexpr size_t kQueries = 100;
+constexpr size_t kTopK = 10;
+
+struct RunResult {
+    double query_us = 0.0;
+    size_t bytes = 0;
+    std::vector<std::vector<std::string>> hits;
+};
+
+RunResult run(const EmbeddingStorageConfig& storage,
+              const std::vector<std::vector<float>>& data,
+              const std::vector<std::vector<float>>& queries) {
+    EpisodicBuffer buffer(data.size(), ConsolidationConfig(), storage);
+    for (size_t i = 0; i < data.size(); ++i) {
+        buffer.add_episode("q" + std::to_string(i), "r", data[i]);
+    }
+
+    RunResult result;
+    result.bytes = buffer.memory_usage_bytes();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& q : queries) {
+        std::vector<std::string> ids;
+        for (const auto& ep : buffer.retrieve_similar(q, kTopK, 0.0f)) {
+            ids.push_back(ep.query);
+        }
+        result.hits.push_back(std::move(ids));
+    }
+    result.query_us = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / queries.size();
+    return result;
+}
+
+double recall(const RunResult& truth, const RunResult& approx) {
+    size_t found = 0, total = 0;
+    for (size_t q = 0; q < truth.hits.size(); ++q) {
+        std::set<std::string> expected(truth.hits[q].begin(), truth.hits[q].end());
+        for (const auto& id : approx.hits[q]) {
+            found += expected.count(id);
+        }
+        total += expected.size();
+    }
+    return total ? static_cast<double>(found) / total : 1.0;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    auto random_vector = [&]() {
+        std::vector<float> v(kDim);
+        for (float& x : v) x = dist(rng);
+        return v;
+    };
+
+    std::vector<std::vector<float>> data, queries;
+    for (size_t i = 0; i < kEpisodes; ++i) data.push_back(random_vector());
+    for (size_t i = 0; i < kQueries; ++i) {
+        // Queries near stored episodes so top-k is meaningful
+        auto q = data[(i * 7919) % kEpisodes];
+        for (float& x : q) x += 0.5f * dist(rng);
+        queries.push_back(std::move(q));
+    }
+
+    EmbeddingStorageConfig fp32;
+    EmbeddingStorageConfig int8;
+    int8.precision = EmbeddingPrecision::Int8;
+    EmbeddingStorageConfig int8_rescore = int8;
+    int8_rescore.rescore_candidates = 4 * kTopK;
+
+    auto base = run(fp32, data, queries);
+    auto q8 = run(int8, data, queries);
+    auto q8r = run(int8_rescore, data, queries);
+
+    std::cout << "Episodic storage precision (dim=" << kDim << ", episodes=" << kEpisodes
+              << ", top_k=" << kTopK << ", int8 kernel=" << int8_kernel_name() << ")\n\n";
+    std::cout << std::left << std::setw(16) << "mode" << std::right
+              << std::setw(12) << "query_us" << std::setw(12) << "MiB"
+              << std::setw(12) << "recall" << "\n";
+    auto row = [&](const char* name, const RunResult& r) {
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(1) << r.query_us
+                  << std::setw(12) << std::setprecision(1) << r.bytes / (1024.0 * 1024.0)
+                  << std::setw(12) << std::setprecision(3) << recall(base, r) << "\n";
+    };
+    row("fp32", base);
+    row("int8", q8);
+    row("int8+rescore", q8r);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file bench_episodic_retrieval.cpp
+ * @brief Episodic retrieval latency vs history length, raw ring vs consolidated
+ *
+ * The raw ring keeps the whole history, so every query scans it all. The
+ * consolidated buffer keeps a small ring of recent episodes and folds
+ * evicted ones into a bounded set of centroids.
+ */
+
+#include "episodic_buffer.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+constexpr size_t kDim = 384;
+constexpr size_t kTopics = 32;
+constexpr size_t kQueries = 200;
+
+std::vector<std::vector<float>> make_topics(std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<std::vector<float>> topics(kTopics, std::vector<float>(kDim));
+    for (auto& topic : topics) {
+        for (float& v : topic) v = dist(rng);
+    }
+    return topics;
+}
+
+std::vector<float> sample(const std::vector<float>& topic, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    std::vector<float> v(topic);
+    for (float& x : v) x += noise(rng);
+    return v;
+}
+
+double mean_query_us(EpisodicBuffer& buffer,
+                     const std::vector<std::vector<float>>& topics,
+                     std::mt19937& rng) {
+    std::vector<std::vector<float>> queries;
+    for (size_t i = 0; i < kQueries; ++i) {
+        queries.push_back(sample(topics[i % kTopics], rng));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t hits = 0;
+    for (const auto& q : queries) {
+        hits += buffer.retrieve_similar(q, 5, 0.5f).size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (hits == 0) {
+        std::cerr << "warning: no hits\n";
+    }
+    return std::chrono::duration<double, std::micro>(elapsed).count() / kQueries;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    auto topics = make_topics(rng);
+
+    std::cout << "Episodic retrieval latency (dim=" << kDim << ", " << kQueries
+              << " queries, top_k=5)\n\n";
+    std::cout << std::setw(10) << "history"
+              << std::setw(16) << "raw_us"
+              << std::setw(16) << "consol_us"
+              << std::setw(12) << "entries"
+              << std::setw(14) << "ingest_ms" << "\n";
+
+    for (size_t history : {1000, 4000, 16000, 64000}) {
+        EpisodicBuffer raw(history);
+
+        ConsolidationConfig config;
+        config.enabled = true;
+        config.max_centroids = 64;
+        config.min_batch = 256;
+        EpisodicBuffer consolidated(256, config);
+
+        auto ingest_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < history; ++i) {
+            auto emb = sample(topics[i % kTopics], rng);
+            std::string query = "query " + std::to_string(i);
+            raw.add_episode(query, "response", emb);
+            consolidated.add_episode(query, "response", emb);
+            if (i % 1024 == 1023) {
+                consolidated.consolidate();
+            }
+        }
+        consolidated.consolidate();
+        double ingest_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - ingest_start).count();
+
+        double raw_us = mean_query_us(raw, topics, rng);
+        double consol_us = mean_query_us(consolidated, topics, rng);
+
+        std::cout << std::setw(10) << history
+                  << std::setw(16) << std::fixed << std::setprecision(1) << raw_us
+                  << std::setw(16) << consol_us
+                  << std::setw(12) << consolidated.size() + consolidated.centroid_count()
+                  << std::setw(14) << ingest_ms << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file bench_query_scheduler.cpp
+ * @brief Interactive tail latency next to a bulk job, with and without lanes
+ *
+ * Bulk threads run 2 ms work items back to back while one interactive
+ * client issues 200 us queries; both hold a shared lock while they work,
+ * as index writes and searches do. "unscheduled" leaves the order to the
+ * lock; "scheduled" admits every item through a QueryScheduler, whose
+ * weighted lanes hand the next free slot to the waiting query.
+ */
+
+#include "query_scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kBulkThreads = 8;
+constexpr size_t kQueries = 400;
+constexpr auto kBulkItem = std::chrono::microseconds(2000);
+constexpr auto kQuery = std::chrono::microseconds(200);
+
+std::mutex g_index_lock;
+
+// Work under the shared lock
+void work_for(std::chrono::microseconds duration) {
+    std::lock_guard<std::mutex> lock(g_index_lock);
+    auto until = Clock::now() + duration;
+    while (Clock::now() < until) {
+    }
+}
+
+struct Latency {
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+};
+
+Latency run(QueryScheduler* scheduler) {
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> bulk;
+    for (size_t i = 0; i < kBulkThreads; ++i) {
+        bulk.emplace_back([&]() {
+            while (!stop.load()) {
+                if (scheduler) {
+                    scheduler->run(QueryPriority::BULK, []() { work_for(kBulkItem); return 0; });
+                } else {
+                    work_for(kBulkItem);
+                }
+            }
+        });
+    }
+
+    std::vector<double> samples;
+    samples.reserve(kQueries);
+    for (size_t i = 0; i < kQueries; ++i) {
+        auto start = Clock::now();
+        if (scheduler) {
+            scheduler->run(QueryPriority::INTERACTIVE, []() { work_for(kQuery); return 0; });
+        } else {
+            work_for(kQuery);
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    stop = true;
+    for (auto& thread : bulk) thread.join();
+
+    std::sort(samples.begin(), samples.end());
+    Latency latency;
+    latency.p50_us = samples[samples.size() / 2];
+    latency.p99_us = samples[samples.size() * 99 / 100];
+    return latency;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Interactive latency next to " << kBulkThreads << " bulk threads ("
+              << kQuery.count() << " us queries, " << kBulkItem.count() << " us bulk items)\n\n";
+
+    auto unscheduled = run(nullptr);
+
+    QuerySchedulerConfig config;   // One slot per hardware thread
+    QueryScheduler scheduler(config);
+    auto scheduled = run(&scheduler);
+
+    std::cout << std::setw(14) << "" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << "\n"
+              << std::fixed << std::setprecision(0)
+              << std::setw(14) << "unscheduled" << std::setw(12) << unscheduled.p50_us
+              << std::setw(12) << unscheduled.p99_us << "\n"
+              << std::setw(14) << "scheduled" << std::setw(12) << scheduled.p50_us
+              << std::setw(12) << scheduled.p99_us << "\n";
+    return 0;
+}
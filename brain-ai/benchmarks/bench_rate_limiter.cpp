@@ -0,0 +1,142 @@
+/**
+ * @file bench_rate_limiter.cpp
+ * @brief Multi-threaded throughput of resilience::RateLimiter
+ *
+ * N threads check requests for a pool of client keys as fast as they can.
+ * "sharded" is the lock-free RateLimiter; "locked" is a token bucket per
+ * key in one unordered_map behind one mutex, the shape of the per-request
+ * dictionary update the Python limiter does under the GIL.
+ */
+
+#include "resilience/rate_limiter.hpp"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace brain_ai::resilience;
+
+namespace {
+
+constexpr size_t kKeys = 4096;
+constexpr auto kDuration = std::chrono::milliseconds(1000);
+
+// Reference: one mutex around a map of buckets
+class LockedLimiter {
+public:
+    LockedLimiter(double rate, double burst) : rate_(rate), burst_(burst) {}
+
+    bool try_acquire(const std::string& key) {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, inserted] = buckets_.try_emplace(key, Bucket{burst_, now});
+        Bucket& bucket = it->second;
+        double elapsed = std::chrono::duration<double>(now - bucket.updated).count();
+        bucket.tokens = std::min(burst_, bucket.tokens + elapsed * rate_);
+        bucket.updated = now;
+        if (bucket.tokens < 1.0) {
+            return false;
+        }
+        bucket.tokens -= 1.0;
+        return true;
+    }
+
+private:
+    struct Bucket {
+        double tokens;
+        std::chrono::steady_clock::time_point updated;
+    };
+    double rate_;
+    double burst_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Bucket> buckets_;
+};
+
+struct Result {
+    double checks_per_sec = 0.0;
+    double allowed_ratio = 0.0;
+};
+
+template <typename Check>
+Result run(size_t threads, const std::vector<std::string>& keys, Check check) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> checks{0};
+    std::atomic<uint64_t> allowed{0};
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            uint64_t n = 0;
+            uint64_t ok = 0;
+            size_t i = t * 7919;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Batches of 64 between stop checks
+                for (int j = 0; j < 64; ++j) {
+                    ok += check(keys[i % keys.size()]) ? 1 : 0;
+                    i += 31;
+                }
+                n += 64;
+            }
+            checks.fetch_add(n);
+            allowed.fetch_add(ok);
+        });
+    }
+
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    for (auto& worker : workers) worker.join();
+
+    double seconds = std::chrono::duration<double>(kDuration).count();
+    Result result;
+    result.checks_per_sec = checks.load() / seconds;
+    result.allowed_ratio = checks.load() > 0
+        ? static_cast<double>(allowed.load()) / checks.load() : 0.0;
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < kKeys; ++i) {
+        keys.push_back("10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256));
+    }
+
+    std::cout << "Rate limiter checks (" << kKeys << " client keys, "
+              << "1000/s per key, burst 100)\n\n";
+    std::cout << std::setw(8) << "threads"
+              << std::setw(16) << "locked/s" << std::setw(16) << "sharded/s"
+              << std::setw(12) << "allowed" << "\n";
+
+    for (size_t threads : {1, 2, 4, 8}) {
+        LockedLimiter locked(1000.0, 100.0);
+        auto locked_result = run(threads, keys, [&](const std::string& key) {
+            return locked.try_acquire(key);
+        });
+
+        RateLimiterConfig config;
+        config.rate_per_second = 1000.0;
+        config.burst = 100.0;
+        config.shards = 64;
+        config.buckets_per_shard = 256;
+        RateLimiter sharded(config);
+        auto sharded_result = run(threads, keys, [&](const std::string& key) {
+            return sharded.try_acquire(key);
+        });
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(0)
+                  << std::setw(16) << locked_result.checks_per_sec
+                  << std::setw(16) << sharded_result.checks_per_sec
+                  << std::setprecision(3)
+                  << std::setw(12) << sharded_result.allowed_ratio << "\n";
+        if (sharded.stats().overflows > 0) {
+            std::cout << "         (" << sharded.stats().overflows << " overflow checks)\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file bench_semantic_activation.cpp
+ * @brief Spreading activation cost vs graph size: hop-limited BFS vs push-based PPR
+ *
+ * Graphs have a fixed average out-degree with Zipf-like target popularity,
+ * so a few hub concepts collect most in-edges. BFS work grows with the
+ * reachable neighbourhood inside max_hops; PPR work is bounded by the
+ * residual tolerance. The second table runs batches of 64 BFS queries
+ * one by one and as one batched sweep (bitset masks + lane arrays); the
+ * batch gains with the overlap between the queries' neighbourhoods.
+ * The third table expands one large hub query level-synchronously on
+ * work pools of increasing size (parallel levels vs sequential).
+ */
+
+#include "semantic_activation.hpp"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+constexpr size_t kDegree = 8;
+constexpr size_t kQueries = 200;
+
+std::shared_ptr<const SemanticGraph> make_graph(size_t num_nodes, std::mt19937& rng) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_real_distribution<float> weight(0.5f, 1.0f);
+    std::vector<std::string> names;
+    names.reserve(num_nodes);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        names.push_back("c" + std::to_string(i));
+    }
+    std::vector<EdgeRecord> edges;
+    edges.reserve(num_nodes * kDegree);
+    for (uint32_t u = 0; u < num_nodes; ++u) {
+        for (size_t k = 0; k < kDegree; ++k) {
+            auto v = static_cast<uint32_t>(std::pow(uniform(rng), 3.0) * num_nodes);
+            edges.push_back({u, v, weight(rng)});
+        }
+    }
+    return SemanticGraph::build(std::move(names), std::move(edges));
+}
+
+void run(const char* label, const SemanticGraph& graph, const ActivationConfig& config,
+         const std::vector<uint32_t>& queries) {
+    size_t activated = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t source : queries) {
+        activated += compute_activation(graph, {source}, config).size();
+    }
+    double us = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / queries.size();
+    std::cout << std::setw(10) << graph.num_nodes()
+              << std::setw(18) << label
+              << std::setw(14) << std::fixed << std::setprecision(1) << us
+              << std::setw(14) << activated / queries.size() << "\n";
+}
+
+void run_batch(const char* label, const SemanticGraph& graph, const std::vector<uint32_t>& queries) {
+    ActivationConfig config;
+    config.activation_threshold = 0.05f;
+    config.max_hops = 4;
+    config.parallel_frontier_threshold = 0;   // Compare single-threaded kernels
+
+    std::vector<std::vector<uint32_t>> batch;
+    for (size_t i = 0; i < kMaxActivationBatch; ++i) {
+        batch.push_back({queries[i]});
+    }
+
+    // Warm the batch workspace (reused across calls on a thread)
+    batch_bfs_activation(graph, batch, config);
+
+    constexpr int kReps = 5;
+    auto start = std::chrono::steady_clock::now();
+    size_t single_activated = 0;
+    for (int rep = 0; rep < kReps; ++rep) {
+        for (const auto& sources : batch) {
+            single_activated += bfs_activation(graph, sources, config).size();
+        }
+    }
+    double single_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / kReps;
+
+    start = std::chrono::steady_clock::now();
+    size_t batch_activated = 0;
+    for (int rep = 0; rep < kReps; ++rep) {
+        for (const auto& activations : batch_bfs_activation(graph, batch, config)) {
+            batch_activated += activations.size();
+        }
+    }
+    double batch_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / kReps;
+
+    if (single_activated != batch_activated) {
+        std::cerr << "warning: batch results differ\n";
+    }
+    std::cout << std::setw(10) << graph.num_nodes()
+              << std::setw(10) << label
+              << std::setw(14) << std::fixed << std::setprecision(2) << single_ms
+              << std::setw(14) << batch_ms
+              << std::setw(12) << std::setprecision(1) << single_ms / batch_ms << "x"
+              << std::setw(14) << batch_activated / (kReps * batch.size()) << "\n";
+}
+
+void run_parallel(const SemanticGraph& graph, const std::vector<uint32_t>& sources) {
+    ActivationConfig config;
+    config.activation_threshold = 0.01f;
+    config.max_hops = 5;
+    constexpr int kReps = 3;
+
+    auto time_ms = [&](auto&& fn) {
+        fn();   // Warm-up (also builds the reverse edges used by pull levels)
+        auto start = std::chrono::steady_clock::now();
+        size_t activated = 0;
+        for (int rep = 0; rep < kReps; ++rep) {
+            activated = fn();
+        }
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count() / kReps;
+        return std::make_pair(ms, activated);
+    };
+
+    config.parallel_frontier_threshold = 0;
+    auto [sequential_ms, activated] = time_ms([&] {
+        return bfs_activation(graph, sources, config).size();
+    });
+    std::cout << std::setw(10) << graph.num_nodes()
+              << std::setw(10) << "seq"
+              << std::setw(14) << std::fixed << std::setprecision(2) << sequential_ms
+              << std::setw(13) << "1.0x"
+              << std::setw(14) << activated << "\n";
+
+    config.parallel_frontier_threshold = 1024;
+    for (size_t threads : {2, 4, 8}) {
+        WorkPool pool(threads);
+        auto [ms, parallel_activated] = time_ms([&] {
+            return bfs_activation(graph, sources, config, pool).size();
+        });
+        std::cout << std::setw(10) << graph.num_nodes()
+                  << std::setw(10) << threads
+                  << std::setw(14) << ms
+                  << std::setw(12) << std::setprecision(1) << sequential_ms / ms << "x"
+                  << std::setw(14) << parallel_activated << "\n";
+        std::cout << std::setprecision(2);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+
+    std::cout << "Spreading activation (avg out-degree=" << kDegree << ", " << kQueries
+              << " single-source queries)\n\n";
+    std::cout << std::setw(10) << "nodes"
+              << std::setw(18) << "mode"
+              << std::setw(14) << "us/query"
+              << std::setw(14) << "activated" << "\n";
+
+    std::vector<std::shared_ptr<const SemanticGraph>> graphs;
+    std::vector<std::vector<uint32_t>> query_sets;
+    for (size_t num_nodes : {10000, 100000, 1000000}) {
+        auto graph = make_graph(num_nodes, rng);
+        std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(num_nodes - 1));
+        std::vector<uint32_t> queries(kQueries);
+        for (auto& q : queries) q = pick(rng);
+
+        ActivationConfig bfs;
+        bfs.activation_threshold = 0.05f;
+        run("bfs hops=3", *graph, bfs, queries);
+        bfs.max_hops = 5;
+        run("bfs hops=5", *graph, bfs, queries);
+
+        ActivationConfig ppr;
+        ppr.mode = ActivationMode::PersonalizedPageRank;
+        ppr.activation_threshold = 0.0f;
+        ppr.ppr_epsilon = 1e-3f;
+        run("ppr eps=1e-3", *graph, ppr, queries);
+        ppr.ppr_epsilon = 1e-4f;
+        run("ppr eps=1e-4", *graph, ppr, queries);
+        graphs.push_back(std::move(graph));
+        query_sets.push_back(std::move(queries));
+    }
+
+    std::cout << "\nBatched BFS (" << kMaxActivationBatch << " queries, max_hops=4)\n\n";
+    std::cout << std::setw(10) << "nodes"
+              << std::setw(10) << "sources"
+              << std::setw(14) << "single_ms"
+              << std::setw(14) << "batch_ms"
+              << std::setw(13) << "speedup"
+              << std::setw(14) << "activated" << "\n";
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < graphs.size(); ++i) {
+        run_batch("uniform", *graphs[i], query_sets[i]);
+
+        // Popular concepts as sources, so the batch shares more frontier
+        std::vector<uint32_t> hub_queries(kMaxActivationBatch);
+        for (auto& q : hub_queries) {
+            q = static_cast<uint32_t>(std::pow(uniform(rng), 3.0) * graphs[i]->num_nodes());
+        }
+        run_batch("hub", *graphs[i], hub_queries);
+    }
+
+    std::cout << "\nParallel levels (8 hub sources, max_hops=5, threshold=0.01; hardware threads: "
+              << std::thread::hardware_concurrency() << ")\n\n";
+    std::cout << std::setw(10) << "nodes"
+              << std::setw(10) << "threads"
+              << std::setw(14) << "ms"
+              << std::setw(13) << "speedup"
+              << std::setw(14) << "activated" << "\n";
+    for (const auto& graph : graphs) {
+        // The most popular concepts (low ids collect most in-edges)
+        run_parallel(*graph, {0, 1, 2, 3, 4, 5, 6, 7});
+    }
+
+    return 0;
+}
@@ -4,7 +4,10 @@
 #include <filesystem>
 #include "cognitive_handler.hpp"
 #include "document/document_processor.hpp"
+#include "errors/exceptions.hpp"
 #include "indexing/index_manager.hpp"
+#include "monitoring/memory_pressure.hpp"
+#include "monitoring/slow_query_log.hpp"
 
 namespace py = pybind11;
 using namespace brain_ai;
@@ -23,6 +26,26 @@ PYBIND11_MODULE(brain_ai_py, m) {
         .def_readwrite("episodic_weight", &FusionWeights::episodic_weight)
         .def_readwrite("semantic_weight", &FusionWeights::semantic_weight);
     
+    // Semantic activation
+    py::enum_<ActivationMode>(m, "ActivationMode")
+        .value("BFS", ActivationMode::BFS)
+        .value("PERSONALIZED_PAGERANK", ActivationMode::PersonalizedPageRank);
+    
+    py::class_<ActivationConfig>(m, "ActivationConfig")
+        .def(py::init<>())
+        .def_readwrite("mode", &ActivationConfig::mode)
+        .def_readwrite("activation_threshold", &ActivationConfig::activation_threshold)
+        .def_readwrite("max_hops", &ActivationConfig::max_hops)
+        .def_readwrite("decay_factor", &ActivationConfig::decay_factor)
+        .def_readwrite("ppr_alpha", &ActivationConfig::ppr_alpha)
+        .def_readwrite("ppr_epsilon", &ActivationConfig::ppr_epsilon);
+    
+    // Scheduling lane
+    py::enum_<QueryPriority>(m, "Priority")
+        .value("INTERACTIVE", QueryPriority::INTERACTIVE)
+        .value("BULK", QueryPriority::BULK)
+        .value("INGEST", QueryPriority::INGEST);
+    
     // QueryConfig
     py::class_<QueryConfig>(m, "QueryConfig")
         .def(py::init<>())
@@ -31,7 +54,34 @@ PYBIND11_MODULE(brain_ai_py, m) {
         .def_readwrite("check_hallucination", &QueryConfig::check_hallucination)
         .def_readwrite("generate_explanation", &QueryConfig::generate_explanation)
         .def_readwrite("top_k_results", &QueryConfig::top_k_results)
-        .def_readwrite("hallucination_threshold", &QueryConfig::hallucination_threshold);
+        .def_readwrite("hallucination_threshold", &QueryConfig::hallucination_threshold)
+        .def_readwrite("semantic_activation", &QueryConfig::semantic_activation)
+        .def_readwrite("priority", &QueryConfig::priority);
+    
+    // Request deadline and cancellation (CancelledError is a TimeoutError)
+    py::register_exception<errors::CancelledError>(m, "CancelledError", PyExc_TimeoutError);
+    
+    py::class_<RequestContext>(m, "RequestContext")
+        .def(py::init<>(), "Context that never expires")
+        .def_static("with_timeout", [](double timeout_ms) {
+                return RequestContext::with_timeout(
+                    std::chrono::duration_cast<RequestContext::Clock::duration>(
+                        std::chrono::duration<double, std::milli>(timeout_ms)));
+            },
+            py::arg("timeout_ms"),
+            "Context that expires timeout_ms from now")
+        .def_static("cancellable", &RequestContext::cancellable,
+                    "Context without a deadline that cancel() stops")
+        .def("cancel", &RequestContext::cancel,
+             "Cancel every copy of this context (safe from any thread)")
+        .def("cancelled", &RequestContext::cancelled)
+        .def("expired", &RequestContext::expired)
+        .def("remaining_ms", [](const RequestContext& context) -> py::object {
+            if (!context.has_deadline()) {
+                return py::none();
+            }
+            return py::float_(std::chrono::duration<double, std::milli>(context.remaining()).count());
+        }, "Milliseconds left, or None without a deadline");
     
     // ScoredResult
     py::class_<ScoredResult>(m, "ScoredResult")
@@ -78,7 +128,16 @@ PYBIND11_MODULE(brain_ai_py, m) {
              py::arg("query"),
              py::arg("query_embedding"),
              py::arg("config") = QueryConfig(),
-             "Process query through complete cognitive pipeline")
+             py::arg("session_id") = "",
+             py::arg("context") = RequestContext(),
+             py::call_guard<py::gil_scoped_release>(),
+             "Process query through complete cognitive pipeline (episodic memory scoped to session_id); "
+             "identical concurrent queries share one execution. Raises CancelledError once "
+             "context expires")
+        
+        .def("set_query_coalescing", &CognitiveHandler::set_query_coalescing,
+             py::arg("enabled"),
+             "Enable or disable sharing of identical concurrent queries")
         
         .def("index_document", [](CognitiveHandler& h,
                                   const std::string& doc_id,
@@ -127,7 +186,20 @@ PYBIND11_MODULE(brain_ai_py, m) {
              py::arg("response"),
              py::arg("query_embedding"),
              py::arg("metadata") = std::unordered_map<std::string, std::string>(),
-             "Add episode to episodic memory")
+             py::arg("session_id") = "",
+             "Add episode to the session's episodic memory")
+        
+        .def("add_episode_async", &CognitiveHandler::add_episode_async,
+             py::arg("query"),
+             py::arg("response"),
+             py::arg("query_embedding"),
+             py::arg("metadata") = std::unordered_map<std::string, std::string>(),
+             py::arg("session_id") = "",
+             "Queue an episode for background recording (per-session order preserved)")
+        
+        .def("flush_episodes", &CognitiveHandler::flush_episodes,
+             py::call_guard<py::gil_scoped_release>(),
+             "Wait until all queued episodes are recorded")
         
         .def("save", [](CognitiveHandler& h, const std::string& path) {
             // Create directory if it doesn't exist
@@ -136,39 +208,64 @@ PYBIND11_MODULE(brain_ai_py, m) {
             // Save vector index (primary component)
             bool success = h.vector_index().save(path + "/vector_index.bin");
             
-            // TODO: Add episodic_buffer.save() and semantic_network.save()
-            // when those classes implement persistence methods
+            // Save semantic network snapshot
+            try {
+                h.semantic_network().save_to_file(path + "/semantic_network.bin");
+            } catch (const std::exception&) {
+                success = false;
+            }
+            
+            // TODO: Add episodic_buffer.save() when it implements
+            // full persistence (embeddings are not written yet)
             // success &= h.episodic_buffer().save(path + "/episodic_buffer.bin");
-            // success &= h.semantic_network().save(path + "/semantic_network.bin");
             
             return success;
         }, py::arg("path"),
-        "Save cognitive handler state to disk (vector index + future: episodic/semantic)")
+        "Save cognitive handler state to disk (vector index + semantic network)")
         
         .def("load", [](CognitiveHandler& h, const std::string& path) {
             // Load vector index (primary component)
             bool success = h.vector_index().load(path + "/vector_index.bin");
             
-            // TODO: Add episodic_buffer.load() and semantic_network.load()
-            // when those classes implement persistence methods
+            // Map the semantic network snapshot (absent in older saves)
+            std::string semantic_path = path + "/semantic_network.bin";
+            if (std::filesystem::exists(semantic_path)) {
+                try {
+                    h.semantic_network().load_from_file(semantic_path);
+                } catch (const std::exception&) {
+                    success = false;
+                }
+            }
+            
+            // TODO: Add episodic_buffer.load() when it implements
+            // full persistence (embeddings are not written yet)
             // success &= h.episodic_buffer().load(path + "/episodic_buffer.bin");
-            // success &= h.semantic_network().load(path + "/semantic_network.bin");
             
             return success;
         }, py::arg("path"),
-        "Load cognitive handler state from disk (vector index + future: episodic/semantic)")
+        "Load cognitive handler state from disk (vector index + semantic network)")
         
         .def("get_stats", [](const CognitiveHandler& h) {
             py::dict stats;
             stats["episodic_buffer_size"] = h.episodic_buffer_size();
+            stats["episodic_sessions"] = h.episodic_session_count();
+            stats["episode_queue_backlog"] = h.episode_queue_backlog();
             stats["semantic_network_size"] = h.semantic_network_size();
             stats["vector_index_size"] = h.vector_index_size();
+            auto flights = h.query_coalescing_stats();
+            stats["queries_executed"] = flights.executions;
+            stats["queries_coalesced"] = flights.coalesced;
             return stats;
         }, "Get system statistics")
         
         .def("clear_episodic_buffer", [](CognitiveHandler& h) {
-            h.episodic_buffer().clear();
-        }, "Clear episodic buffer")
+            h.episodic_store().clear();
+        }, "Clear episodic memory for all sessions")
+        
+        .def("clear_session", [](CognitiveHandler& h, const std::string& session_id) {
+            h.episodic_store().clear_session(session_id);
+        }, py::arg("session_id"),
+        "Drop the episodic memory of a single session")
         
         .def("episodic_buffer_size", &CognitiveHandler::episodic_buffer_size,
              "Get current episodic buffer size")
@@ -177,6 +274,37 @@ PYBIND11_MODULE(brain_ai_py, m) {
         .def("vector_index_size", &CognitiveHandler::vector_index_size,
              "Get vector index document count");
     
+    // Slow-query log (process-wide)
+    m.def("set_slow_query_threshold_us", [](uint32_t threshold_us) {
+        monitoring::SlowQueryLog::instance().set_threshold_us(threshold_us);
+    }, py::arg("threshold_us"),
+    "Record queries slower than this many microseconds (0 disables)");
+    
+    m.def("slow_query_log", []() {
+        return monitoring::SlowQueryLog::instance().dump();
+    }, "Recent slow queries, one line per query (oldest first)");
+    
+    m.def("dump_slow_query_log", [](const std::string& path) {
+        if (!monitoring::SlowQueryLog::instance().dump_to_file(path)) {
+            throw std::runtime_error("Failed to write slow-query log to " + path);
+        }
+    }, py::arg("path"),
+    "Write the slow-query log to a file");
+    
+    // Memory pressure (process-wide)
+    m.def("start_memory_pressure_monitor", []() {
+        monitoring::MemoryPressureMonitor::instance().start();
+    }, "Poll RSS, cgroup v2 limits and PSI in the background and shrink caches under pressure");
+    
+    m.def("stop_memory_pressure_monitor", []() {
+        monitoring::MemoryPressureMonitor::instance().stop();
+    }, "Stop background memory-pressure polling");
+    
+    m.def("memory_pressure_level", []() {
+        return std::string(monitoring::memory_pressure_level_to_string(
+            monitoring::MemoryPressureMonitor::instance().level()));
+    }, "Current memory pressure level (NORMAL, MODERATE, HIGH or CRITICAL)");
+    
     // Version info
     m.attr("__version__") = "4.5.0";
     m.attr("__author__") = "Brain-AI Team";
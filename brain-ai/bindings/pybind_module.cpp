@@ -1,19 +1,34 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "errors/exceptions.hpp"
 #include "indexing/index_manager.hpp"
+#include "indexing/search_batcher.hpp"
+#include "query_scheduler.hpp"
+#include "request_context.hpp"
+#include "resilience/rate_limiter.hpp"
+#include "work_pool.hpp"
 
 namespace py = pybind11;
 using brain_ai::indexing::IndexConfig;
 using brain_ai::indexing::IndexManager;
+using brain_ai::indexing::SearchBatcher;
+using brain_ai::indexing::SearchBatcherConfig;
+using brain_ai::QueryPriority;
+using brain_ai::QueryScheduler;
+using brain_ai::RequestContext;
 using brain_ai::vector_search::SearchResult;
 
 namespace {
@@ -34,6 +49,21 @@ IndexManager &ensure_manager() {
     return *g_manager;
 }
 
+// Concurrent searches (sync callers on Python threads and the async
+// executor alike) are batched in front of the manager. Declared after
+// g_manager so it is destroyed first.
+std::unique_ptr<SearchBatcher> g_batcher;
+SearchBatcherConfig g_batcher_config;
+
+SearchBatcher &ensure_batcher() {
+    auto &manager = ensure_manager();
+    std::scoped_lock<std::mutex> lock(g_mutex);
+    if (!g_batcher) {
+        g_batcher = std::make_unique<SearchBatcher>(manager, g_batcher_config);
+    }
+    return *g_batcher;
+}
+
 std::vector<float> to_vector(const py::object &obj) {
     std::vector<float> result;
     if (obj.is_none()) {
@@ -103,13 +133,13 @@ std::vector<float> hashed_embedding(const std::string &text) {
     return vec;
 }
 
-}  // namespace
+using SearchPayload = std::vector<std::pair<std::string, float>>;
 
-void index_document(const std::string &doc_id,
-                    const std::string &text,
-                    const py::object &embedding_obj) {
+// Native halves of the calls: no Python objects, run without the GIL
+
+void index_native(const std::string &doc_id, const std::string &text,
+                  std::vector<float> embedding) {
     auto &manager = ensure_manager();
-    std::vector<float> embedding = to_vector(embedding_obj);
     if (embedding.empty()) {
         embedding = hashed_embedding(text);
     }
@@ -119,11 +149,18 @@ void index_document(const std::string &doc_id,
     }
 }
 
-std::vector<std::pair<std::string, float>> search(const std::string &query,
-                                                  int top_k,
-                                                  const py::object &embedding_obj) {
-    auto &manager = ensure_manager();
-    std::vector<float> embedding = to_vector(embedding_obj);
+// Deadline of a call, counted from when it was made (0 = none)
+RequestContext request_context(int timeout_ms) {
+    if (timeout_ms <= 0) {
+        return RequestContext();
+    }
+    return RequestContext::with_timeout(std::chrono::milliseconds(timeout_ms));
+}
+
+SearchPayload search_native(const std::string &query, int top_k,
+                            std::vector<float> embedding, QueryPriority priority,
+                            const RequestContext &context) {
+    auto &batcher = ensure_batcher();
     if (embedding.empty()) {
         embedding = hashed_embedding(query);
     }
@@ -132,8 +169,12 @@ std::vector<std::pair<std::string, float>> search(const std::string &query,
         top_k = 5;
     }
 
-    auto results = manager.search(embedding, static_cast<std::size_t>(top_k));
-    std::vector<std::pair<std::string, float>> payload;
+    // The batcher takes the scheduler slot per batch and checks the
+    // deadline again once the batch has it
+    context.check("search");
+    auto results = batcher.search(std::move(embedding), static_cast<std::size_t>(top_k), 0.0f,
+                                  priority, context);
+    SearchPayload payload;
     payload.reserve(results.size());
     for (const SearchResult &res : results) {
         payload.emplace_back(res.doc_id, res.similarity);
@@ -141,6 +182,208 @@ std::vector<std::pair<std::string, float>> search(const std::string &query,
     return payload;
 }
 
+// Executor for the *_async calls. Created on first use and shut down
+// from atexit, before the interpreter can no longer take completions.
+std::mutex g_executor_mutex;
+std::unique_ptr<brain_ai::WorkPool> g_executor;
+std::size_t g_executor_threads = 0;   // 0 = hardware concurrency
+
+// Python type of errors::CancelledError (set at module init)
+PyObject *g_cancelled_error = PyExc_TimeoutError;
+
+brain_ai::WorkPool &executor() {
+    std::scoped_lock<std::mutex> lock(g_executor_mutex);
+    if (!g_executor) {
+        g_executor = std::make_unique<brain_ai::WorkPool>(g_executor_threads);
+    }
+    return *g_executor;
+}
+
+// Completes a running concurrent.futures.Future with the outcome of a
+// native call. Must hold the GIL.
+template <typename Result>
+void complete_future(py::object &future, std::optional<Result> &result,
+                     std::exception_ptr error) {
+    if (!error) {
+        future.attr("set_result")(py::cast(std::move(*result)));
+        return;
+    }
+
+    // Same exception types as the synchronous calls
+    py::object exception;
+    try {
+        std::rethrow_exception(error);
+    } catch (const brain_ai::errors::CancelledError &e) {
+        exception = py::reinterpret_borrow<py::object>(g_cancelled_error)(e.what());
+    } catch (const std::invalid_argument &e) {
+        exception = py::reinterpret_borrow<py::object>(PyExc_ValueError)(e.what());
+    } catch (const std::exception &e) {
+        exception = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(e.what());
+    } catch (...) {
+        exception = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)("Unknown native error");
+    }
+    future.attr("set_exception")(exception);
+}
+
+// Run work() on the executor and return a concurrent.futures.Future for
+// its result (await it with asyncio.wrap_future). The future is marked
+// running before the work starts, and work the caller already cancelled
+// is skipped. The work runs without the GIL; only the future calls take it.
+template <typename Result, typename Work>
+py::object submit_async(Work work) {
+    py::object future = py::module_::import("concurrent.futures").attr("Future")();
+    PyObject *handle = future.inc_ref().ptr();   // Released by the task
+
+    executor().submit([work = std::move(work), handle]() mutable {
+        {
+            py::gil_scoped_acquire gil;
+            py::object future = py::reinterpret_borrow<py::object>(handle);
+            bool run = false;
+            try {
+                // False when the caller cancelled the future while it was queued
+                run = future.attr("set_running_or_notify_cancel")().cast<bool>();
+            } catch (py::error_already_set &e) {
+                e.discard_as_unraisable("brain_ai_core async start");
+            }
+            if (!run) {
+                future.dec_ref();   // The task's reference
+                return;
+            }
+        }
+
+        std::optional<Result> result;
+        std::exception_ptr error;
+        try {
+            result.emplace(work());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        py::gil_scoped_acquire gil;
+        py::object future = py::reinterpret_steal<py::object>(handle);
+        try {
+            complete_future(future, result, error);
+        } catch (py::error_already_set &e) {
+            e.discard_as_unraisable("brain_ai_core async completion");
+        }
+    });
+    return future;
+}
+
+}  // namespace
+
+void index_document(const std::string &doc_id,
+                    const std::string &text,
+                    const py::object &embedding_obj) {
+    std::vector<float> embedding = to_vector(embedding_obj);
+    py::gil_scoped_release release;
+    index_native(doc_id, text, std::move(embedding));
+}
+
+std::vector<std::pair<std::string, float>> search(const std::string &query,
+                                                  int top_k,
+                                                  const py::object &embedding_obj,
+                                                  QueryPriority priority,
+                                                  int timeout_ms) {
+    RequestContext context = request_context(timeout_ms);
+    std::vector<float> embedding = to_vector(embedding_obj);
+    py::gil_scoped_release release;
+    return search_native(query, top_k, std::move(embedding), priority, context);
+}
+
+py::object index_document_async(const std::string &doc_id,
+                                const std::string &text,
+                                const py::object &embedding_obj) {
+    // Python objects are read here, while the GIL is held
+    std::vector<float> embedding = to_vector(embedding_obj);
+    return submit_async<std::nullptr_t>(
+        [doc_id, text, embedding = std::move(embedding)]() mutable {
+            index_native(doc_id, text, std::move(embedding));
+            return nullptr;
+        });
+}
+
+py::object search_async(const std::string &query,
+                        int top_k,
+                        const py::object &embedding_obj,
+                        QueryPriority priority,
+                        int timeout_ms) {
+    // The deadline runs from submission, so time queued on the executor counts
+    RequestContext context = request_context(timeout_ms);
+    std::vector<float> embedding = to_vector(embedding_obj);
+    return submit_async<SearchPayload>(
+        [query, top_k, embedding = std::move(embedding), priority, context]() mutable {
+            return search_native(query, top_k, std::move(embedding), priority, context);
+        });
+}
+
+void configure_async_executor(std::size_t threads) {
+    std::scoped_lock<std::mutex> lock(g_executor_mutex);
+    if (g_executor) {
+        throw std::runtime_error("configure_async_executor must be called before the first async call");
+    }
+    g_executor_threads = threads;
+}
+
+void shutdown_async_executor() {
+    std::unique_ptr<brain_ai::WorkPool> pool;
+    {
+        std::scoped_lock<std::mutex> lock(g_executor_mutex);
+        pool = std::move(g_executor);
+    }
+    // Queued tasks finish and take the GIL to complete their futures
+    py::gil_scoped_release release;
+    pool.reset();
+}
+
+void configure_search_batching(std::size_t max_batch, std::int64_t max_linger_us) {
+    std::scoped_lock<std::mutex> lock(g_mutex);
+    if (g_batcher) {
+        throw std::runtime_error("configure_search_batching must be called before the first search");
+    }
+    if (max_linger_us < 0) {
+        throw std::invalid_argument("max_linger_us must be non-negative");
+    }
+    g_batcher_config.max_batch = max_batch;
+    g_batcher_config.max_linger = std::chrono::microseconds(max_linger_us);
+}
+
+void configure_scheduler(std::size_t max_concurrency,
+                         std::uint32_t interactive_weight,
+                         std::uint32_t bulk_weight,
+                         std::uint32_t ingest_weight,
+                         double latency_target_ms) {
+    if (latency_target_ms < 0) {
+        throw std::invalid_argument("latency_target_ms must be non-negative");
+    }
+    auto config = QueryScheduler::shared().config();
+    config.max_concurrency = max_concurrency;
+    config.lanes[static_cast<std::size_t>(QueryPriority::INTERACTIVE)].weight = interactive_weight;
+    config.lanes[static_cast<std::size_t>(QueryPriority::BULK)].weight = bulk_weight;
+    config.lanes[static_cast<std::size_t>(QueryPriority::INGEST)].weight = ingest_weight;
+    config.interactive_latency_target = std::chrono::microseconds(
+        static_cast<std::int64_t>(latency_target_ms * 1000.0));
+    QueryScheduler::shared().reconfigure(config);
+}
+
+py::dict scheduler_stats() {
+    auto stats = QueryScheduler::shared().stats();
+    py::dict out;
+    for (std::size_t i = 0; i < brain_ai::kQueryPriorityCount; ++i) {
+        const auto &lane = stats.lanes[i];
+        py::dict lane_dict;
+        lane_dict["admitted"] = lane.admitted;
+        lane_dict["queued"] = lane.queued;
+        lane_dict["running"] = lane.running;
+        lane_dict["limit"] = lane.limit;
+        lane_dict["average_wait_us"] = lane.average_wait_us();
+        out[brain_ai::query_priority_name(static_cast<QueryPriority>(i))] = lane_dict;
+    }
+    out["interactive_latency_us"] = stats.interactive_latency_us;
+    out["throttle_events"] = stats.throttle_events;
+    return out;
+}
+
 void save_index(const std::string &path) {
     auto &manager = ensure_manager();
     if (path.empty()) {
@@ -171,18 +414,102 @@ void load_index(const std::string &path) {
 PYBIND11_MODULE(brain_ai_core, m) {
     m.doc() = "Brain-AI vector index bridge";
 
+    py::enum_<QueryPriority>(m, "Priority")
+        .value("INTERACTIVE", QueryPriority::INTERACTIVE)
+        .value("BULK", QueryPriority::BULK)
+        .value("INGEST", QueryPriority::INGEST);
+
+    // Raised when a call's timeout_ms runs out (a TimeoutError)
+    g_cancelled_error = py::register_exception<brain_ai::errors::CancelledError>(
+        m, "CancelledError", PyExc_TimeoutError).ptr();
+
     m.def("index_document", &index_document,
           py::arg("doc_id"), py::arg("text"), py::arg("embedding") = py::none(),
           "Index a document using text and optional embedding vector");
 
     m.def("search", &search,
           py::arg("query"), py::arg("top_k") = 5, py::arg("embedding") = py::none(),
-          "Search for documents matching the query");
+          py::arg("priority") = QueryPriority::INTERACTIVE, py::arg("timeout_ms") = 0,
+          "Search for documents matching the query (scheduled in the priority's lane); "
+          "raises CancelledError if it has not finished within timeout_ms (0 = no limit)");
+
+    m.def("index_document_async", &index_document_async,
+          py::arg("doc_id"), py::arg("text"), py::arg("embedding") = py::none(),
+          "Like index_document, but runs on a native thread without the GIL and returns a "
+          "concurrent.futures.Future (await with asyncio.wrap_future)");
+
+    m.def("search_async", &search_async,
+          py::arg("query"), py::arg("top_k") = 5, py::arg("embedding") = py::none(),
+          py::arg("priority") = QueryPriority::INTERACTIVE, py::arg("timeout_ms") = 0,
+          "Like search, but runs on a native thread without the GIL and returns a "
+          "concurrent.futures.Future resolving to the same list");
+
+    m.def("configure_async_executor", &configure_async_executor, py::arg("threads"),
+          "Set the async executor's thread count (0 = hardware) before first use");
+
+    m.def("shutdown_async_executor", &shutdown_async_executor,
+          "Finish queued async calls and stop the executor (also run at exit)");
+
+    m.def("configure_search_batching", &configure_search_batching,
+          py::arg("max_batch") = 32, py::arg("max_linger_us") = 500,
+          "Set the search micro-batcher's batch size and longest linger before the first "
+          "search (max_batch=1 searches every query on its own)");
+
+    // Checks are a single CAS, cheaper than releasing the GIL around them
+    py::class_<brain_ai::resilience::RateLimiter>(m, "RateLimiter",
+        "Per-key token buckets (burst tokens, refilled at rate_per_second)")
+        .def(py::init([](double rate_per_second, double burst,
+                         std::size_t shards, std::size_t buckets_per_shard) {
+                 brain_ai::resilience::RateLimiterConfig config;
+                 config.rate_per_second = rate_per_second;
+                 config.burst = burst;
+                 config.shards = shards;
+                 config.buckets_per_shard = buckets_per_shard;
+                 return std::make_unique<brain_ai::resilience::RateLimiter>(config);
+             }),
+             py::arg("rate_per_second"), py::arg("burst"),
+             py::arg("shards") = 16, py::arg("buckets_per_shard") = 1024)
+        .def("try_acquire",
+             [](brain_ai::resilience::RateLimiter &limiter, const std::string &key, double cost) {
+                 return limiter.try_acquire(key, cost);
+             },
+             py::arg("key"), py::arg("cost") = 1.0,
+             "Take cost tokens from the key's bucket; False if it does not have them")
+        .def("acquire",
+             [](brain_ai::resilience::RateLimiter &limiter, const std::string &key, double cost) {
+                 auto decision = limiter.acquire(key, cost);
+                 double retry_after = std::chrono::duration<double>(decision.retry_after).count();
+                 return py::make_tuple(decision.allowed, decision.remaining, retry_after);
+             },
+             py::arg("key"), py::arg("cost") = 1.0,
+             "Like try_acquire, returning (allowed, tokens_remaining, retry_after_seconds)")
+        .def("stats",
+             [](const brain_ai::resilience::RateLimiter &limiter) {
+                 auto stats = limiter.stats();
+                 py::dict out;
+                 out["allowed"] = stats.allowed;
+                 out["rejected"] = stats.rejected;
+                 out["overflows"] = stats.overflows;
+                 return out;
+             });
+
+    m.def("configure_scheduler", &configure_scheduler,
+          py::arg("max_concurrency") = 0, py::arg("interactive_weight") = 8,
+          py::arg("bulk_weight") = 2, py::arg("ingest_weight") = 1,
+          py::arg("latency_target_ms") = 50.0,
+          "Set the query scheduler's slots (0 = hardware threads), lane weights and the "
+          "interactive latency above which indexing is throttled (0 = never)");
+
+    m.def("scheduler_stats", &scheduler_stats,
+          "Per-lane admissions, queue depth, limits and waits of the query scheduler");
 
     m.def("save_index", &save_index, py::arg("path"),
           "Persist index state to disk");
 
     m.def("load_index", &load_index, py::arg("path"),
           "Load index state from disk if present");
+
+    // Completions need a live interpreter: drain before it shuts down
+    py::module_::import("atexit").attr("register")(py::cpp_function(&shutdown_async_executor));
 }
 
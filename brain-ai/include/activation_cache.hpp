@@ -0,0 +1,131 @@
+#ifndef BRAIN_AI_ACTIVATION_CACHE_HPP
+#define BRAIN_AI_ACTIVATION_CACHE_HPP
+
+#include "semantic_activation.hpp"
+#include "monitoring/memory_pressure.hpp"
+#include "monitoring/metrics.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brain_ai {
+
+// Cache key: sorted, de-duplicated source ids plus every parameter that
+// changes the result
+struct ActivationCacheKey {
+    std::vector<uint32_t> sources;
+    ActivationMode mode = ActivationMode::BFS;
+    size_t max_hops = 0;
+    float decay_factor = 0.0f;
+    float activation_threshold = 0.0f;
+    float ppr_alpha = 0.0f;
+    float ppr_epsilon = 0.0f;
+
+    bool operator==(const ActivationCacheKey& other) const;
+};
+
+struct ActivationCacheKeyHash {
+    size_t operator()(const ActivationCacheKey& key) const;
+};
+
+struct ActivationCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;   // Flushes caused by a graph version change
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+// Memoized spreading-activation results for one SemanticNetwork.
+//
+// Entries are tagged with the graph version they were computed on. A
+// lookup or insert with a newer version drops every entry (the graph
+// changed); results computed on an older snapshot are never stored.
+// LRU eviction keeps the estimated footprint under max_bytes. Hits and
+// misses are also reported to MetricsRegistry (semantic_cache_*); the
+// hit-rate and bytes gauges cover every cache in the process.
+// Under memory pressure the budget is scaled down by
+// memory_pressure_budget_factor() and restored once pressure clears.
+class ActivationCache {
+public:
+    using Ranked = std::vector<std::pair<std::string, float>>;
+
+    // Cached result: node ids (for activation levels) and ranked names
+    struct Entry {
+        ActivationList activations;
+        Ranked ranked;
+    };
+
+    static constexpr size_t kDefaultMaxBytes = 16 * 1024 * 1024;
+
+    explicit ActivationCache(size_t max_bytes = kDefaultMaxBytes);
+    ~ActivationCache();
+
+    ActivationCache(const ActivationCache&) = delete;
+    ActivationCache& operator=(const ActivationCache&) = delete;
+
+    static ActivationCacheKey make_key(std::vector<uint32_t> sources,
+                                       const ActivationConfig& config);
+
+    // nullptr on miss
+    std::shared_ptr<const Entry> find(uint64_t version, const ActivationCacheKey& key);
+
+    void insert(uint64_t version, ActivationCacheKey key, std::shared_ptr<const Entry> entry);
+
+    // 0 disables caching (and drops all entries)
+    void set_max_bytes(size_t max_bytes);
+
+    // Effective budget (the configured one scaled for memory pressure)
+    size_t max_bytes() const;
+
+    // Scale the budget for a pressure level, evicting down to it. Called
+    // by the process-wide MemoryPressureMonitor.
+    void on_memory_pressure(monitoring::MemoryPressureLevel level);
+
+    void clear();
+    ActivationCacheStats stats() const;
+
+private:
+    struct Slot {
+        ActivationCacheKey key;
+        std::shared_ptr<const Entry> entry;
+        size_t bytes;
+    };
+    using LruList = std::list<Slot>;
+
+    mutable std::mutex mutex_;
+    size_t configured_max_bytes_;
+    size_t max_bytes_;
+    double pressure_factor_ = 1.0;
+    uint64_t version_ = 0;
+    LruList lru_;   // Most recently used first
+    std::unordered_map<ActivationCacheKey, LruList::iterator, ActivationCacheKeyHash> index_;
+    ActivationCacheStats stats_;
+
+    monitoring::Counter& hits_metric_;
+    monitoring::Counter& misses_metric_;
+    monitoring::Gauge& hit_rate_metric_;
+    monitoring::Gauge& bytes_metric_;
+    size_t published_bytes_ = 0;   // This cache's share of bytes_metric_
+
+    // Shrinks the budget under pressure; reset first in ~ActivationCache()
+    monitoring::MemoryPressureSubscription pressure_subscription_;
+
+    void sync_version_locked(uint64_t version);
+    void evict_locked();
+    void publish_locked();
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_ACTIVATION_CACHE_HPP
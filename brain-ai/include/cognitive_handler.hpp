@@ -2,11 +2,17 @@
 #define BRAIN_AI_COGNITIVE_HANDLER_HPP
 
 #include "episodic_buffer.hpp"
+#include "session_episodic_store.hpp"
+#include "episode_ingest_queue.hpp"
 #include "semantic_network.hpp"
 #include "hallucination_detector.hpp"
 #include "hybrid_fusion.hpp"
 #include "explanation_engine.hpp"
 #include "vector_search/hnsw_index.hpp"
+#include "single_flight.hpp"
+#include "query_scheduler.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,6 +27,8 @@ struct QueryConfig {
     bool generate_explanation = true;
     size_t top_k_results = 10;
     float hallucination_threshold = 0.5f;
+    ActivationConfig semantic_activation;  // Semantic stage algorithm and limits
+    QueryPriority priority = QueryPriority::INTERACTIVE;  // Scheduler lane
 };
 
 // Complete query response
@@ -36,6 +44,29 @@ struct QueryResponse {
         : query(q), overall_confidence(0.0f) {}
 };
 
+// Identity of a process_query call for coalescing: everything that shapes
+// the response (text, session, embedding bits and config) and its priority
+struct QueryFingerprint {
+    uint64_t hash = 0;
+    std::string query;
+    std::string session_id;
+    std::vector<float> embedding;
+    QueryConfig config;
+    
+    static QueryFingerprint make(
+        const std::string& query,
+        const std::vector<float>& query_embedding,
+        const QueryConfig& config,
+        const std::string& session_id
+    );
+    
+    bool operator==(const QueryFingerprint& other) const;
+};
+
+struct QueryFingerprintHash {
+    size_t operator()(const QueryFingerprint& key) const { return static_cast<size_t>(key.hash); }
+};
+
 // Main cognitive architecture orchestrator
 class CognitiveHandler {
 public:
@@ -45,22 +76,58 @@ public:
         size_t embedding_dim = 1536
     );
     
-    // Process a query through the full cognitive pipeline
+    // Process a query through the full cognitive pipeline.
+    // Episodic retrieval is scoped to session_id (empty = default session).
+    // Throws errors::CancelledError once context expires; each stage
+    // checks it before starting and the long ones while they run.
     QueryResponse process_query(
         const std::string& query,
         const std::vector<float>& query_embedding,
-        const QueryConfig& config = QueryConfig()
+        const QueryConfig& config = QueryConfig(),
+        const std::string& session_id = "",
+        const RequestContext& context = RequestContext()
+    );
+    
+    // Like process_query, but identical concurrent calls (same fingerprint)
+    // share one execution and one immutable response. A caller that joined
+    // another's run stops waiting when its own context expires, and runs
+    // the query itself if the run it joined was cancelled.
+    std::shared_ptr<const QueryResponse> process_query_shared(
+        const std::string& query,
+        const std::vector<float>& query_embedding,
+        const QueryConfig& config = QueryConfig(),
+        const std::string& session_id = "",
+        const RequestContext& context = RequestContext()
     );
     
-    // Add episode after response is generated
+    // Coalescing of identical concurrent queries (on by default)
+    void set_query_coalescing(bool enabled) { coalesce_queries_.store(enabled); }
+    bool query_coalescing() const { return coalesce_queries_.load(); }
+    SingleFlightStats query_coalescing_stats() const { return query_flights_.stats(); }
+    
+    // Add episode after response is generated (empty session_id = default session)
     void add_episode(
         const std::string& query,
         const std::string& response,
         const std::vector<float>& query_embedding,
-        const std::unordered_map<std::string, std::string>& metadata = {}
+        const std::unordered_map<std::string, std::string>& metadata = {},
+        const std::string& session_id = ""
     );
     
-    // Index a document for vector search
+    // Record an episode asynchronously; returns once it is queued.
+    // Episodes of one session are applied in call order.
+    void add_episode_async(
+        const std::string& query,
+        const std::string& response,
+        const std::vector<float>& query_embedding,
+        const std::unordered_map<std::string, std::string>& metadata = {},
+        const std::string& session_id = ""
+    );
+    
+    // Wait until all asynchronously recorded episodes are visible
+    void flush_episodes();
+    
+    // Index a document for vector search (ingest lane of the shared scheduler)
     bool index_document(
         const std::string& doc_id,
         const std::vector<float>& embedding,
@@ -68,7 +135,8 @@ public:
         const nlohmann::json& metadata = {}
     );
     
-    // Batch index documents
+    // Batch index documents, taking an ingest slot per document so queries
+    // interleave with a long batch
     void batch_index_documents(
         const std::vector<std::tuple<std::string, std::vector<float>, std::string>>& documents
     );
@@ -80,18 +148,21 @@ public:
     );
     
     // Get components for direct access (optional)
-    EpisodicBuffer& episodic_buffer() { return episodic_buffer_; }
+    EpisodicBuffer& episodic_buffer() { return episodic_store_.default_buffer(); }
+    SessionEpisodicStore& episodic_store() { return episodic_store_; }
     SemanticNetwork& semantic_network() { return semantic_network_; }
     HybridFusion& fusion() { return fusion_; }
     vector_search::HNSWIndex& vector_index() { return *vector_index_; }
     
     // Statistics
-    size_t episodic_buffer_size() const { return episodic_buffer_.size(); }
+    size_t episodic_buffer_size() const { return episodic_store_.size(); }
+    size_t episodic_session_count() const { return episodic_store_.session_count(); }
     size_t semantic_network_size() const { return semantic_network_.num_nodes(); }
     size_t vector_index_size() const { return vector_index_->size(); }
+    size_t episode_queue_backlog() const { return ingest_queue_->backlog(); }
     
 private:
-    EpisodicBuffer episodic_buffer_;
+    SessionEpisodicStore episodic_store_;
     SemanticNetwork semantic_network_;
     HallucinationDetector hallucination_detector_;
     HybridFusion fusion_;
@@ -99,10 +170,28 @@ private:
     std::unique_ptr<vector_search::HNSWIndex> vector_index_;
     size_t embedding_dim_;
     
+    // Async episode recording (declared after episodic_store_: drains into it on destruction)
+    std::unique_ptr<EpisodeIngestQueue> ingest_queue_;
+    
+    // In-flight process_query calls by fingerprint
+    SingleFlight<QueryFingerprint, QueryResponse, QueryFingerprintHash> query_flights_;
+    std::atomic<bool> coalesce_queries_{true};
+    
+    // The full pipeline behind process_query (runs in the config's lane)
+    QueryResponse run_query(
+        const std::string& query,
+        const std::vector<float>& query_embedding,
+        const QueryConfig& config,
+        const std::string& session_id,
+        const RequestContext& context
+    );
+    
     // Real vector search using HNSWlib
     std::vector<ScoredResult> vector_search(
         const std::vector<float>& query_embedding,
-        size_t top_k
+        size_t top_k,
+        vector_search::SearchCost* cost = nullptr,
+        const RequestContext& context = RequestContext()
     );
     
     // Convert episodes to scored results
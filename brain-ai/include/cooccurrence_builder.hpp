@@ -0,0 +1,151 @@
+#ifndef BRAIN_AI_COOCCURRENCE_BUILDER_HPP
+#define BRAIN_AI_COOCCURRENCE_BUILDER_HPP
+
+#include "semantic_network.hpp"
+#include "work_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace brain_ai {
+
+// Configuration for co-occurrence graph construction
+struct CooccurrenceConfig {
+    size_t window = 5;                     // Following tokens paired with each token
+    size_t min_token_length = 4;           // Query concepts use the same minimum
+    uint32_t min_pair_count = 2;           // Rarer pairs get no edge
+    float min_npmi = 0.1f;                 // Minimum normalized PMI for an edge
+    size_t apply_every_documents = 256;    // Background merge+apply cadence (0 = flush() only)
+    size_t max_pairs = 1 << 20;            // Distinct pairs kept; rarest pruned beyond (0 = unbounded)
+    size_t commit_min_pairs = 4096;        // Touched pairs that trigger a network commit
+    std::chrono::milliseconds commit_interval{10000};  // Max wait for a commit (0 = by size only)
+};
+
+struct CooccurrenceStats {
+    size_t documents = 0;
+    size_t tokens = 0;
+    size_t distinct_terms = 0;
+    size_t distinct_pairs = 0;
+    size_t edges_applied = 0;              // Directed edges written to the network
+    size_t pairs_pending = 0;              // Touched pairs waiting for the next commit
+    size_t applies = 0;                    // Bulk updates committed
+    size_t pairs_pruned = 0;               // Low-count pairs dropped to stay under max_pairs
+    size_t terms_pruned = 0;               // Terms dropped with the last pair using them
+};
+
+// Builds a concept co-occurrence graph from ingested text (map-reduce).
+//
+// Map: documents are tokenized like query concepts (lowercase, stopwords
+// and short tokens dropped) and every pair of terms within `window`
+// tokens is counted into a per-thread shard (sharded by thread id, so
+// concurrent ingestion rarely contends). add_documents() maps a batch on
+// the work pool into chunk-local counts instead.
+//
+// Reduce: every apply_every_documents documents a background pool task
+// merges the shards into global counts. Pairs touched since the last
+// commit are collected, and once commit_min_pairs of them are pending or
+// the oldest has waited commit_interval (checked as documents arrive),
+// an edge is written in both directions for each, weighted by normalized
+// PMI in (0, 1]:
+//   npmi(x, y) = log(p(x, y) / (p(x) p(y))) / -log p(x, y)
+// with p(x) over term occurrences and p(x, y) over counted pairs.
+// Edges go through SemanticNetwork::add_edges and one commit per batch,
+// so each graph rebuild covers a bounded batch rather than every apply;
+// flush() commits whatever is pending. Weights of pairs not touched since
+// the last commit are not revisited as global counts drift.
+//
+// Once more than max_pairs distinct pairs are counted, the lowest counts
+// are pruned (lossy counting): a pruned pair that keeps occurring starts
+// over and can still reach min_pair_count, and its applied edge stays.
+// Terms left in no pair are pruned in the same pass, so max_pairs bounds
+// the vocabulary as well.
+class CooccurrenceBuilder {
+public:
+    explicit CooccurrenceBuilder(SemanticNetwork& network,
+                                 const CooccurrenceConfig& config = CooccurrenceConfig(),
+                                 WorkPool& pool = WorkPool::shared());
+    ~CooccurrenceBuilder();   // Waits for a background apply in flight
+
+    // Non-copyable (referenced by pool tasks)
+    CooccurrenceBuilder(const CooccurrenceBuilder&) = delete;
+    CooccurrenceBuilder& operator=(const CooccurrenceBuilder&) = delete;
+
+    // Count one document (thread-safe)
+    void add_document(const std::string& text);
+
+    // Count many documents in parallel on the pool
+    void add_documents(const std::vector<std::string>& texts);
+
+    // Merge all counts and commit every pending pair before returning
+    void flush();
+
+    // Same as flush(), as a pool task; returns immediately
+    void flush_async();
+
+    CooccurrenceStats stats() const;
+
+    // Terms of a text in order (the map step's tokenizer)
+    static std::vector<std::string> extract_terms(const std::string& text,
+                                                  size_t min_token_length);
+
+private:
+    // Term and pair counts keyed by interned term id
+    struct Counts {
+        std::vector<std::string> terms;
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<uint64_t> term_counts;
+        std::unordered_map<uint64_t, uint64_t> pair_counts;   // (lo id << 32 | hi id)
+        uint64_t tokens = 0;
+        uint64_t pairs = 0;
+        size_t documents = 0;
+
+        uint32_t intern(const std::string& term);
+        void clear();
+    };
+
+    static constexpr size_t kShards = 16;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Counts counts;
+    };
+
+    SemanticNetwork& network_;
+    CooccurrenceConfig config_;
+    WorkPool& pool_;
+
+    Shard shards_[kShards];
+
+    // Reduced state, guarded by merge_mutex_
+    mutable std::mutex merge_mutex_;
+    Counts global_;
+    std::unordered_set<uint64_t> dirty_pairs_;   // Touched since the last commit
+    CooccurrenceStats stats_;
+
+    std::atomic<size_t> unapplied_documents_{0};
+    std::atomic<int64_t> dirty_since_ns_{0};   // Steady clock; 0 = no pair pending
+    std::mutex apply_mutex_;   // One merge+apply at a time
+    std::mutex task_mutex_;
+    std::condition_variable task_cv_;
+    bool task_running_ = false;
+    bool apply_requested_ = false;   // Run the task once more when it finishes
+    bool flush_requested_ = false;   // Next task pass commits every pending pair
+
+    void count_terms(const std::vector<std::string>& terms, Counts& counts) const;
+    void merge_locked(Counts& local);      // Requires merge_mutex_
+    void prune_locked(std::unordered_set<uint64_t>& applied);   // Requires merge_mutex_
+    void merge_and_apply(bool commit_all);
+    bool commit_interval_elapsed() const;
+    void maybe_schedule_apply(size_t documents);
+    void schedule_apply(bool force);
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_COOCCURRENCE_BUILDER_HPP
@@ -3,6 +3,7 @@
 #include "document/ocr_client.hpp"
 #include "document/text_validator.hpp"
 #include "cognitive_handler.hpp"
+#include "cooccurrence_builder.hpp"
 #include <memory>
 #include <functional>
 #include <chrono>
@@ -64,9 +65,15 @@ using ProgressCallback = std::function<void(size_t current, size_t total, const
  * 4. Generate embeddings (via external service)
  * 5. Create memory in episodic buffer
  * 6. Index in vector search store
+ * 7. Count concept co-occurrences into the semantic network
+ *    (see CooccurrenceBuilder; applied in background bulk updates)
  * 
  * Integrates OCRClient, TextValidator, and CognitiveHandler components.
  * 
+ * Each call takes an optional RequestContext. Once it expires the document
+ * fails with its stage named in error_message (OCR, embedding or indexing),
+ * and a batch skips the documents it has not started.
+ * 
  * Thread-safe: Can process documents from multiple threads.
  * 
  * Example usage:
@@ -104,6 +111,8 @@ public:
         bool create_episodic_memory = true;     // Create episodic memory
         bool index_in_vector_store = true;      // Index in vector search
         size_t batch_size = 10;                 // Batch size for parallel processing
+        bool build_cooccurrence_graph = false;  // Mine semantic edges from validated text
+        CooccurrenceConfig cooccurrence_config; // Co-occurrence windows and PMI filters
         
         Config() = default;
     };
@@ -117,7 +126,7 @@ public:
                               const Config& config);
     
     /**
-     * @brief Destructor
+     * @brief Destructor - applies pending co-occurrence edges
      */
     ~DocumentProcessor();
     
@@ -131,31 +140,38 @@ public:
      * @brief Process single document from file
      * @param filepath Path to document file
      * @param doc_id Optional document ID (auto-generated if empty)
+     * @param context Request deadline and cancellation
      * @return Processing result
      */
     DocumentResult process(const std::string& filepath,
-                          const std::string& doc_id = "");
+                          const std::string& doc_id = "",
+                          const RequestContext& context = RequestContext());
     
     /**
      * @brief Process document from image data
      * @param image_data Raw image bytes
      * @param mime_type MIME type
      * @param doc_id Document identifier
+     * @param context Request deadline and cancellation
      * @return Processing result
      */
     DocumentResult process_image(const std::vector<uint8_t>& image_data,
                                  const std::string& mime_type,
-                                 const std::string& doc_id);
+                                 const std::string& doc_id,
+                                 const RequestContext& context = RequestContext());
     
     /**
      * @brief Process multiple documents in batch
      * @param filepaths Vector of file paths
      * @param progress_callback Optional progress callback
+     * @param context Deadline of the whole batch; documents not started
+     *        when it expires get failed results
      * @return Vector of processing results
      */
     std::vector<DocumentResult> process_batch(
         const std::vector<std::string>& filepaths,
-        ProgressCallback progress_callback = nullptr);
+        ProgressCallback progress_callback = nullptr,
+        const RequestContext& context = RequestContext());
     
     /**
      * @brief Process document with custom embedding
@@ -182,6 +198,11 @@ public:
     
     /**
      * @brief Update configuration
+     *
+     * Toggling build_cooccurrence_graph starts or stops the graph builder
+     * (stopping applies its pending edges); cooccurrence_config takes
+     * effect when the builder is started.
+     *
      * @param config New configuration
      */
     void update_config(const Config& config);
@@ -192,6 +213,22 @@ public:
      */
     const Config& get_config() const { return config_; }
     
+    /**
+     * @brief Apply all counted co-occurrences to the semantic network
+     *
+     * Edges are otherwise committed in bounded batches (see
+     * CooccurrenceConfig::commit_min_pairs and commit_interval). The
+     * merge and graph rebuild run on the work pool; this returns
+     * immediately.
+     */
+    void flush_cooccurrence_graph();
+    
+    /**
+     * @brief Co-occurrence counting statistics
+     * @return Current statistics (empty if the graph builder is disabled)
+     */
+    CooccurrenceStats get_cooccurrence_stats() const;
+    
     /**
      * @brief Check if OCR service is healthy
      * @return true if service is reachable and healthy
@@ -203,6 +240,7 @@ private:
     Config config_;
     std::unique_ptr<OCRClient> ocr_client_;
     std::unique_ptr<TextValidator> validator_;
+    std::unique_ptr<CooccurrenceBuilder> cooccurrence_;
     
     mutable std::mutex stats_mutex_;
     ProcessingStats stats_;
@@ -217,9 +255,12 @@ private:
     /**
      * @brief Generate embedding for text (stub - should call external service)
      * @param text Input text
+     * @param context Caps the service call's timeouts at the time left;
+     *        throws errors::CancelledError once expired
      * @return Embedding vector
      */
-    std::vector<float> generate_embedding(const std::string& text);
+    std::vector<float> generate_embedding(const std::string& text,
+                                          const RequestContext& context = RequestContext());
     
     /**
      * @brief Create episodic memory from document
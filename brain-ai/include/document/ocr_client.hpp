@@ -6,6 +6,7 @@
 #include <optional>
 #include <chrono>
 #include "nlohmann/json.hpp"
+#include "request_context.hpp"
 
 namespace brain_ai::document {
 
@@ -33,8 +34,14 @@ struct OCRConfig {
     int max_tokens = 8192;                              // Maximum tokens to generate
     float temperature = 0.0f;                           // Sampling temperature
     std::chrono::seconds timeout{30};                   // Request timeout
-    int max_retries = 3;                                // Max retry attempts
-    std::chrono::milliseconds retry_delay{1000};        // Delay between retries
+    int max_retries = 3;                                // Max attempts (first try included)
+    std::chrono::milliseconds retry_delay{1000};        // Base of the jittered exponential backoff
+    std::chrono::milliseconds max_retry_delay{10000};   // Backoff ceiling
+    std::vector<std::string> replica_urls;              // Extra replicas of service_url (hedging, failover)
+    double hedge_percentile = 0.95;                     // Hedge requests slower than this latency percentile (0 = off)
+    std::chrono::milliseconds hedge_delay{2000};        // Hedge delay until enough latencies are observed
+    int max_hedges = 1;                                 // Duplicate requests per call (needs replica_urls)
+    int max_concurrent_requests = 4;                    // Calls served at once; sizes the attempt pool (more queue)
     std::chrono::milliseconds connect_timeout{1000};    // TCP connect timeout (ms)
     std::chrono::milliseconds read_timeout{5000};       // Read timeout (ms)
     std::chrono::milliseconds write_timeout{5000};      // Write timeout (ms)
@@ -56,6 +63,15 @@ struct OCRConfig {
  * Handles HTTP multipart/form-data uploads, request/response parsing,
  * error handling, retries, and timeout management.
  * 
+ * With replica_urls set, a request still running after the hedge_percentile
+ * of recent latencies is duplicated to the next replica and the first
+ * success wins; failed requests fail over to the next replica after a
+ * jittered exponential backoff (see resilience/hedging.hpp).
+ * 
+ * Each call takes an optional RequestContext: once it expires no further
+ * attempt starts, in-flight attempts are aborted, and the call returns a
+ * failed result ("Request cancelled" or "Deadline exceeded").
+ * 
  * Thread-safe: Multiple threads can use separate instances safely.
  * 
  * Example usage:
@@ -100,25 +116,32 @@ public:
     /**
      * @brief Process document from file path
      * @param filepath Path to document file
+     * @param context Request deadline and cancellation
      * @return OCR processing result
      */
-    OCRResult process_file(const std::string& filepath);
+    OCRResult process_file(const std::string& filepath,
+                           const RequestContext& context = RequestContext());
     
     /**
      * @brief Process document from image data
      * @param image_data Raw image bytes
      * @param mime_type MIME type (e.g., "image/png", "image/jpeg", "application/pdf")
+     * @param context Request deadline and cancellation
      * @return OCR processing result
      */
     OCRResult process_image(const std::vector<uint8_t>& image_data,
-                           const std::string& mime_type);
+                           const std::string& mime_type,
+                           const RequestContext& context = RequestContext());
     
     /**
      * @brief Process multiple documents in batch
      * @param filepaths Vector of file paths
+     * @param context Deadline of the whole batch; files not started when
+     *        it expires get failed results
      * @return Vector of OCR results (same order as input)
      */
-    std::vector<OCRResult> process_batch(const std::vector<std::string>& filepaths);
+    std::vector<OCRResult> process_batch(const std::vector<std::string>& filepaths,
+                                         const RequestContext& context = RequestContext());
     
     /**
      * @brief Check service health
@@ -151,15 +174,17 @@ private:
     OCRConfig config_;
     
     /**
-     * @brief Make HTTP POST request with retries
+     * @brief Make HTTP POST request with hedging and retries
      * @param endpoint API endpoint (e.g., "/ocr/extract")
      * @param body Request body
      * @param content_type Content-Type header
+     * @param context Abandons the request (all attempts) once expired
      * @return Response body or empty on failure
      */
     std::optional<std::string> make_request(const std::string& endpoint,
                                            const std::string& body,
-                                           const std::string& content_type);
+                                           const std::string& content_type,
+                                           const RequestContext& context = RequestContext());
     
     /**
      * @brief Parse OCR response JSON
@@ -0,0 +1,95 @@
+#ifndef BRAIN_AI_EPISODE_INGEST_QUEUE_HPP
+#define BRAIN_AI_EPISODE_INGEST_QUEUE_HPP
+
+#include "episodic_buffer.hpp"
+#include "session_episodic_store.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace brain_ai {
+
+// Configuration for asynchronous episode recording
+struct EpisodeIngestConfig {
+    size_t max_batch = 256;                          // Episodes drained per publish round
+    size_t max_queued = 65536;                       // Producers wait beyond this backlog
+};
+
+// Asynchronous, batched episode recording off the request path.
+//
+// Producers push onto a lock-free intrusive MPSC queue (one atomic
+// exchange per episode) and return immediately. A single worker drains
+// the queue, groups episodes by session, and inserts each group with one
+// EpisodicBuffer publish, which also quantizes embeddings when int8
+// storage is configured. Episodes of a session are applied in enqueue
+// order; flush() waits until everything enqueued before it is visible.
+// A group the store fails to insert is dropped and counted in failed()
+// (and the episodes_dropped metric) rather than stopping the worker.
+class EpisodeIngestQueue {
+public:
+    explicit EpisodeIngestQueue(SessionEpisodicStore& store,
+                                const EpisodeIngestConfig& config = EpisodeIngestConfig());
+    ~EpisodeIngestQueue();   // Drains remaining episodes, then stops
+
+    // Non-copyable (owns a worker thread)
+    EpisodeIngestQueue(const EpisodeIngestQueue&) = delete;
+    EpisodeIngestQueue& operator=(const EpisodeIngestQueue&) = delete;
+
+    // Enqueue an episode (timestamped now); waits only if the backlog is full
+    void enqueue(const std::string& session_id,
+                 const std::string& query,
+                 const std::string& response,
+                 const std::vector<float>& query_embedding,
+                 const std::unordered_map<std::string, std::string>& metadata = {});
+
+    // Block until all episodes enqueued before this call are applied
+    void flush();
+
+    // Stats
+    size_t enqueued() const { return enqueued_.load(std::memory_order_relaxed); }
+    size_t applied() const { return applied_.load(std::memory_order_relaxed); }
+    size_t batches() const { return batches_.load(std::memory_order_relaxed); }
+    size_t failed() const { return failed_.load(std::memory_order_relaxed); }   // Counted in applied()
+    size_t backlog() const { return enqueued() - applied(); }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::string session_id;
+        std::optional<Episode> episode;   // Empty for the stub node
+    };
+
+    SessionEpisodicStore& store_;
+    EpisodeIngestConfig config_;
+
+    // Vyukov MPSC queue: producers exchange head_, the worker owns tail_
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+
+    std::atomic<size_t> enqueued_{0};
+    std::atomic<size_t> applied_{0};
+    std::atomic<size_t> batches_{0};
+    std::atomic<size_t> failed_{0};
+
+    std::atomic<bool> running_{true};
+    std::atomic<bool> worker_idle_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::mutex progress_mutex_;
+    std::condition_variable progress_cv_;
+    std::thread worker_;
+
+    void push(Node* node);
+    Node* pop();            // Worker only; nullptr if empty (or mid-push)
+    void wake_worker();
+    size_t drain_once();    // Apply up to max_batch episodes
+    void worker_loop();
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_EPISODE_INGEST_QUEUE_HPP
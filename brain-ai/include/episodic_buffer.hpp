@@ -1,13 +1,19 @@
 #ifndef BRAIN_AI_EPISODIC_BUFFER_HPP
 #define BRAIN_AI_EPISODIC_BUFFER_HPP
 
+#include "request_context.hpp"
+#include <cstdint>
 #include <deque>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <optional>
+#include <type_traits>
 
 namespace brain_ai {
 
@@ -28,13 +34,72 @@ struct Episode {
     
     // Get current timestamp in milliseconds
     static uint64_t current_timestamp_ms();
+    
+    // Approximate heap footprint (strings, embedding, metadata)
+    size_t memory_usage_bytes() const;
+    
+    // Compact storage (EmbeddingPrecision::Int8): query_embedding is left
+    // empty and the vector is kept as int8 codes with a per-vector scale
+    std::vector<int8_t> quantized_embedding;
+    float quantization_scale = 0.0f;
+    float quantized_norm = 0.0f;              // ||codes||, for cosine without dequantizing
+    std::vector<uint16_t> rescore_embedding;  // Optional bfloat16 copy for fp32 re-scoring
+    
+    bool is_quantized() const { return query_embedding.empty() && !quantized_embedding.empty(); }
+    size_t embedding_dim() const;
+    
+    // fp32 view of the embedding (side store if present, else dequantized codes)
+    std::vector<float> embedding() const;
+    
+    // Replace query_embedding by int8 codes (and a bfloat16 copy if requested)
+    void quantize(bool keep_rescore_copy);
+};
+
+// Storage precision of episode embeddings
+enum class EmbeddingPrecision {
+    Float32,   // Full std::vector<float> per episode
+    Int8       // int8 codes + per-vector scale (~4x smaller)
 };
 
-// Fixed-capacity ring buffer for conversation context
+struct EmbeddingStorageConfig {
+    EmbeddingPrecision precision = EmbeddingPrecision::Float32;
+    size_t rescore_candidates = 0;   // Int8 only: re-rank this many hits in fp32 (0 = off)
+    float rescore_margin = 0.02f;    // Threshold slack for int8 candidates when re-scoring
+};
+
+// Consolidation of aging episodes into centroid episodes.
+// Episodes leaving the ring (and, optionally, ring entries older than
+// min_age_ms) are queued and folded by consolidate() into at most
+// max_centroids clusters using incremental k-means. Each centroid is a
+// retrievable Episode carrying the mean embedding, a representative
+// query/response, a summary of member queries and the member count.
+struct ConsolidationConfig {
+    bool enabled = false;
+    size_t max_centroids = 64;         // Bound on consolidated entries
+    size_t min_batch = 16;             // Pending episodes needed before a pass
+    size_t max_pending = 4096;         // Backlog cap (oldest dropped beyond)
+    uint64_t min_age_ms = 0;           // Also consolidate aged ring entries (0 = evictions only)
+    float merge_threshold = 0.8f;      // Seed a new centroid below this similarity
+    size_t refine_iterations = 3;      // k-means passes over each batch
+    size_t summary_samples = 3;        // Member queries kept in the summary
+};
+
+// Fixed-capacity ring buffer for conversation context.
+//
+// Readers never take a lock: they scan an immutable published Snapshot
+// (RCU style). Episodes live in fixed-size blocks of preallocated slots;
+// a writer constructs episodes in slots beyond every published count,
+// then publishes a new Snapshot whose count covers them. Block storage
+// never moves or resizes, so readers only touch slots the snapshot
+// published. Published slots are never modified, and
+// blocks are reclaimed when the last snapshot referencing them is gone.
+// Writers serialize on a mutex that readers never touch.
 class EpisodicBuffer {
 public:
     // Constructor
-    explicit EpisodicBuffer(size_t capacity = 128);
+    explicit EpisodicBuffer(size_t capacity = 128,
+                            const ConsolidationConfig& consolidation = ConsolidationConfig(),
+                            const EmbeddingStorageConfig& storage = EmbeddingStorageConfig());
     
     // Add new episode (auto-evicts oldest if full)
     void add_episode(const std::string& query,
@@ -42,19 +107,32 @@ public:
                      const std::vector<float>& query_embedding,
                      const std::unordered_map<std::string, std::string>& metadata = {});
     
-    // Retrieve k most similar past episodes
+    // Add a batch with a single publish (episodes keep their timestamps)
+    void add_episodes(std::vector<Episode> episodes);
+    
+    // Retrieve k most similar past episodes. The scan checks the context
+    // every kCancelCheckEpisodes episodes and throws errors::CancelledError
+    // once it expires.
     std::vector<Episode> retrieve_similar(
         const std::vector<float>& query_embedding,
         size_t top_k = 5,
-        float similarity_threshold = 0.7f
+        float similarity_threshold = 0.7f,
+        const RequestContext& context = RequestContext()
     ) const;
     
     // Get recent episodes by time
     std::vector<Episode> get_recent(size_t count) const;
     
-    // Clear all episodes
+    // Clear all episodes (including pending and consolidated ones)
     void clear();
     
+    // Fold pending/aged episodes into centroids; returns episodes consolidated.
+    // Clustering runs outside the buffer lock, so readers are not blocked.
+    size_t consolidate();
+    
+    // Consolidated centroid episodes
+    std::vector<Episode> get_centroids() const;
+    
     // Persistence
     void save_to_file(const std::string& filepath) const;
     void load_from_file(const std::string& filepath);
@@ -63,11 +141,109 @@ public:
     size_t size() const;
     bool is_full() const;
     size_t capacity() const { return max_capacity_; }
+    size_t memory_usage_bytes() const;
+    size_t centroid_count() const;
+    size_t pending_count() const;
+    size_t consolidated_episodes() const;   // Episodes folded into centroids
+    const ConsolidationConfig& consolidation_config() const { return consolidation_; }
+    const EmbeddingStorageConfig& storage_config() const { return storage_; }
+    
+    // Metadata keys set on centroid episodes
+    static constexpr const char* kConsolidatedKey = "consolidated";
+    static constexpr const char* kEpisodeCountKey = "episode_count";
+    static constexpr const char* kSummaryKey = "summary";
+    
+    // Episodes scanned between cancellation checks in retrieve_similar
+    static constexpr size_t kCancelCheckEpisodes = 1024;
     
 private:
-    std::deque<Episode> buffer_;
+    struct Centroid {
+        Episode episode;                  // Mean embedding, representative text
+        size_t count = 0;                 // Episodes folded in
+        float representative_score = -1.0f;
+        std::vector<std::string> samples; // Member queries for the summary
+    };
+    
+    static constexpr size_t kBlockSize = 64;
+    
+    // Fixed-size block of episode slots, constructed in order by writers.
+    // Slots below any published count are immutable.
+    struct Block {
+        Block() = default;
+        ~Block();
+        
+        // Non-copyable (shared by snapshots)
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+        
+        const Episode& operator[](size_t index) const {
+            return *std::launder(reinterpret_cast<const Episode*>(&slots[index]));
+        }
+        
+        // Fill a slot no published snapshot covers (writer lock held)
+        void put(size_t index, Episode&& episode);
+        
+        // Episode::memory_usage_bytes() of every constructed slot, evicted
+        // or not (writer lock held)
+        size_t bytes() const { return bytes_; }
+        
+    private:
+        std::aligned_storage_t<sizeof(Episode), alignof(Episode)> slots[kBlockSize];
+        size_t constructed_ = 0;   // Slots [0, constructed_) hold episodes
+        size_t bytes_ = 0;
+    };
+    
+    // Immutable view published to readers
+    struct Snapshot {
+        std::vector<std::shared_ptr<Block>> blocks;
+        size_t head = 0;    // Evicted slots at the front of blocks[0]
+        size_t count = 0;   // Live episodes
+        std::shared_ptr<const std::vector<Centroid>> centroids =
+            std::make_shared<const std::vector<Centroid>>();
+        
+        const Episode& at(size_t index) const;
+        
+        // Visit live episodes oldest first
+        template <typename Fn>
+        void for_each(Fn&& fn) const;
+    };
+    
     size_t max_capacity_;
-    mutable std::mutex mutex_;  // Thread safety for add/retrieve
+    ConsolidationConfig consolidation_;
+    EmbeddingStorageConfig storage_;
+    
+    // Read with atomic_load/atomic_store only
+    std::shared_ptr<const Snapshot> snapshot_;
+    // Running sum of Episode::memory_usage_bytes(). Evicted ring slots stay
+    // charged until drop_front() releases their block.
+    std::atomic<size_t> memory_bytes_{0};
+    
+    // Writer-side state
+    mutable std::mutex mutex_;           // Serializes writers; never taken by readers
+    std::deque<Episode> pending_;        // Evicted, awaiting consolidation
+    size_t consolidated_total_ = 0;
+    uint64_t epoch_ = 0;                 // Bumped by clear()/load to discard in-flight passes
+    std::mutex consolidate_mutex_;       // Serializes consolidate() calls
+    
+    std::shared_ptr<const Snapshot> load_snapshot() const;
+    void publish(std::shared_ptr<const Snapshot> snapshot);
+    
+    // Drop the n oldest live episodes from a snapshot being built; returns
+    // the bytes of the blocks released
+    static size_t drop_front(Snapshot& snapshot, size_t n);
+    
+    // Append prepared episodes and publish once
+    void append(std::vector<Episode>&& episodes);
+    
+    // Queue an evicted episode for consolidation (writer lock held)
+    void queue_for_consolidation(Episode&& episode);
+    
+    // Incremental k-means of a batch into centroids; returns episodes folded
+    size_t fold_batch(const std::vector<Episode>& batch,
+                      std::vector<Centroid>& centroids) const;
+    
+    // Rebuild summary metadata of a centroid episode
+    static void refresh_centroid_metadata(Centroid& centroid);
     
     // Helper: Compute temporal decay
     float compute_temporal_decay(uint64_t episode_timestamp_ms,
@@ -0,0 +1,59 @@
+#ifndef BRAIN_AI_EPISODIC_CONSOLIDATOR_HPP
+#define BRAIN_AI_EPISODIC_CONSOLIDATOR_HPP
+
+#include "episodic_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace brain_ai {
+
+// Background job that periodically consolidates watched episodic buffers.
+// Buffers are held weakly, so dropped sessions are pruned automatically.
+class EpisodicConsolidator {
+public:
+    explicit EpisodicConsolidator(
+        std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+    ~EpisodicConsolidator();
+
+    // Non-copyable (owns a worker thread)
+    EpisodicConsolidator(const EpisodicConsolidator&) = delete;
+    EpisodicConsolidator& operator=(const EpisodicConsolidator&) = delete;
+
+    // Register a buffer for periodic consolidation
+    void watch(const std::shared_ptr<EpisodicBuffer>& buffer);
+
+    // Start/stop the worker thread
+    void start();
+    void stop();
+    bool running() const { return running_.load(); }
+
+    // Consolidate all watched buffers now; returns episodes consolidated
+    size_t run_once();
+
+    // Stats
+    size_t watched_count() const;
+    size_t total_consolidated() const { return total_consolidated_.load(); }
+
+private:
+    std::chrono::milliseconds interval_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::weak_ptr<EpisodicBuffer>> buffers_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> total_consolidated_{0};
+    std::thread worker_;
+
+    void worker_loop();
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_EPISODIC_CONSOLIDATOR_HPP
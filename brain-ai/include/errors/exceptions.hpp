@@ -160,6 +160,22 @@ public:
                           "timeout") {}
 };
 
+// Work abandoned because its request was cancelled or ran out of time
+class CancelledError : public BrainAIException {
+public:
+    CancelledError(const std::string& stage, bool deadline_exceeded)
+        : BrainAIException(std::string(deadline_exceeded ? "Deadline exceeded" : "Request cancelled") +
+                          " during " + stage, "request"),
+          stage_(stage), deadline_exceeded_(deadline_exceeded) {}
+
+    const std::string& stage() const { return stage_; }
+    bool deadline_exceeded() const { return deadline_exceeded_; }
+
+private:
+    std::string stage_;
+    bool deadline_exceeded_;
+};
+
 // Validation errors
 class ValidationError : public BrainAIException {
 public:
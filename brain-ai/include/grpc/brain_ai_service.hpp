@@ -2,6 +2,7 @@
 
 #include "cognitive_handler.hpp"
 #include "document/document_processor.hpp"
+#include "resilience/rate_limiter.hpp"
 #include <memory>
 #include <atomic>
 #include <chrono>
@@ -52,6 +53,7 @@ struct ServiceStats {
     std::atomic<uint64_t> failed_queries{0};
     std::atomic<uint64_t> successful_documents{0};
     std::atomic<uint64_t> failed_documents{0};
+    std::atomic<uint64_t> rate_limited{0};
     std::chrono::steady_clock::time_point start_time;
     
     ServiceStats() : start_time(std::chrono::steady_clock::now()) {}
@@ -79,6 +81,16 @@ struct ServiceConfig {
     // Document processor config
     document::DocumentProcessor::Config document_config;
     
+    // Query scheduler lanes (applied to the process-wide scheduler)
+    QuerySchedulerConfig scheduler;
+    
+    // Per-client rate limiting (keyed by peer address or tenant)
+    bool enable_rate_limit = false;
+    resilience::RateLimiterConfig rate_limit;
+    
+    // Server-side cap on a request's time (0 = only the client's deadline)
+    std::chrono::milliseconds default_request_timeout{0};
+    
     ServiceConfig() = default;
 };
 
@@ -152,6 +164,41 @@ public:
      */
     ServiceStats get_stats() const { return stats_; }
     
+    /**
+     * @brief Admit or reject a request from a client
+     * 
+     * RPC handlers call this first with the caller's key (peer address or
+     * tenant id) and answer RESOURCE_EXHAUSTED when it returns false.
+     * Lock-free; always admits when rate limiting is disabled.
+     * 
+     * @param client_key Client or tenant identifier
+     * @param cost Tokens the request takes (e.g. batch size)
+     * @return true if the request may proceed
+     */
+    bool admit_request(const std::string& client_key, double cost = 1.0);
+    
+    /**
+     * @brief Map a request's proto Priority to a scheduler lane
+     * 
+     * Unknown values (newer clients) fall back to interactive.
+     * 
+     * @param proto_priority Priority field of QueryRequest/SearchRequest
+     * @return Lane for QueryConfig::priority / QueryScheduler::admit
+     */
+    static QueryPriority to_query_priority(int proto_priority);
+    
+    /**
+     * @brief Build the RequestContext a handler passes down the pipeline
+     * 
+     * Handlers pass the time left on the ServerContext's deadline and
+     * cancel() the context when ServerContext::IsCancelled() (client gone).
+     * The earlier of that and default_request_timeout applies.
+     * 
+     * @param client_timeout Time left on the client's deadline (0 = none)
+     * @return Context for process_query, search and document processing
+     */
+    RequestContext make_request_context(std::chrono::milliseconds client_timeout) const;
+    
     /**
      * @brief Get server address
      * @return Server address string
@@ -163,6 +210,7 @@ private:
     std::unique_ptr<CognitiveHandler> cognitive_;
     std::unique_ptr<document::DocumentProcessor> doc_processor_;
     std::unique_ptr<::grpc::Server> server_;
+    std::unique_ptr<resilience::RateLimiter> rate_limiter_;
     std::atomic<bool> running_{false};
     ServiceStats stats_;
     
@@ -203,6 +251,13 @@ public:
         return *this;
     }
     
+    ServiceBuilder& with_rate_limit(double requests_per_second, double burst) {
+        config_.enable_rate_limit = true;
+        config_.rate_limit.rate_per_second = requests_per_second;
+        config_.rate_limit.burst = burst;
+        return *this;
+    }
+    
     ServiceBuilder& enable_reflection(bool enable = true) {
         config_.enable_reflection = enable;
         return *this;
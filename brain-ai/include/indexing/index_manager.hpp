@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vector_search/hnsw_index.hpp"
+#include "cooccurrence_builder.hpp"
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,6 +10,10 @@
 #include <chrono>
 #include "nlohmann/json.hpp"
 
+namespace brain_ai::monitoring {
+class SlowQueryTimer;
+}
+
 namespace brain_ai::indexing {
 
 /**
@@ -31,6 +36,7 @@ struct BatchResult {
     size_t total = 0;
     size_t successful = 0;
     size_t failed = 0;
+    size_t cancelled = 0;   // Not attempted: the request expired first
     std::vector<std::string> error_messages;
     std::chrono::milliseconds total_time{0};
     
@@ -56,7 +62,7 @@ struct IndexConfig {
     std::chrono::seconds save_interval{300};  // 5 minutes
     
     // Batch processing
-    size_t batch_size = 100;
+    size_t batch_size = 100;  // Documents per add_batch chunk
     int num_threads = 4;
     
     IndexConfig() = default;
@@ -71,6 +77,7 @@ struct IndexConfig {
  * - Document metadata tracking
  * - Index statistics
  * - Transaction-like operations
+ * - Optional concept co-occurrence mining of added content
  * 
  * Thread-safe: All methods use mutex protection.
  * 
@@ -118,7 +125,7 @@ public:
     IndexManager& operator=(IndexManager&&) = delete;
     
     /**
-     * @brief Add single document
+     * @brief Add single document (ingest lane of the shared QueryScheduler)
      * @param doc_id Document identifier
      * @param embedding Embedding vector
      * @param content Document content
@@ -132,31 +139,47 @@ public:
     
     /**
      * @brief Add multiple documents in batch
+     * 
+     * Documents are added batch_size at a time, each chunk in an ingest
+     * slot of the shared QueryScheduler and under its own lock, so
+     * searches are not held up for the whole batch and ingestion backs
+     * off while interactive latency is high. Once the context expires the
+     * remaining chunks are skipped and counted in BatchResult::cancelled.
+     * 
      * @param doc_ids Document identifiers
      * @param embeddings Embedding vectors
      * @param contents Document contents
      * @param metadatas Document metadata (optional)
+     * @param context Request deadline and cancellation
      * @return Batch operation result
      */
     BatchResult add_batch(const std::vector<std::string>& doc_ids,
                          const std::vector<std::vector<float>>& embeddings,
                          const std::vector<std::string>& contents,
-                         const std::vector<nlohmann::json>& metadatas = {});
+                         const std::vector<nlohmann::json>& metadatas = {},
+                         const RequestContext& context = RequestContext());
     
     /**
      * @brief Search for similar documents
      * @param query_embedding Query vector
      * @param top_k Number of results
      * @param similarity_threshold Minimum similarity score
+     * @param context Request deadline (throws errors::CancelledError once expired)
      * @return Search results
      */
     std::vector<vector_search::SearchResult> search(
         const std::vector<float>& query_embedding,
         size_t top_k = 10,
-        float similarity_threshold = 0.0f);
+        float similarity_threshold = 0.0f,
+        const RequestContext& context = RequestContext());
     
     /**
      * @brief Batch search multiple queries
+     * 
+     * Takes the lock once and hands the whole batch to the index, which
+     * normalizes the queries together and searches them in parallel on
+     * the shared work pool (serially when num_threads <= 1).
+     * 
      * @param query_embeddings Query vectors
      * @param top_k Number of results per query
      * @return Search results for each query
@@ -262,6 +285,16 @@ public:
      * @return Current configuration
      */
     const IndexConfig& get_config() const { return config_; }
+    
+    /**
+     * @brief Feed the content of added documents to a co-occurrence graph builder
+     * 
+     * Counting happens after the index lock is released; add_batch maps
+     * the batch contents on the builder's work pool.
+     * 
+     * @param builder Shared builder (nullptr detaches)
+     */
+    void set_cooccurrence_builder(std::shared_ptr<CooccurrenceBuilder> builder);
 
 private:
     // Internal unlocked versions for use by save_as/load_from
@@ -276,12 +309,31 @@ private:
     // Document metadata storage
     std::unordered_map<std::string, nlohmann::json> documents_;
     
+    // Optional co-occurrence mining of added content
+    std::shared_ptr<CooccurrenceBuilder> cooccurrence_;
+    
     // Statistics
     IndexStats stats_;
     
     // Auto-save tracking
     std::chrono::steady_clock::time_point last_save_;
     
+    /**
+     * @brief Add a search to the slow query log if it crossed the threshold
+     * @param timer Stage timings of the search
+     * @param query_embedding Query vector (fingerprinted)
+     * @param top_k Requested result count
+     * @param candidates Results before filtering
+     * @param returned Results after filtering
+     * @param cost Graph work, or nullptr when not known per query
+     */
+    void record_if_slow(const monitoring::SlowQueryTimer& timer,
+                        const std::vector<float>& query_embedding,
+                        size_t top_k,
+                        size_t candidates,
+                        size_t returned,
+                        const vector_search::SearchCost* cost) const;
+    
     /**
      * @brief Check if auto-save is needed
      * @return true if should save
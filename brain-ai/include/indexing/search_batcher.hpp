@@ -0,0 +1,196 @@
+#pragma once
+
+#include "indexing/index_manager.hpp"
+#include "query_scheduler.hpp"
+#include "request_context.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace brain_ai::indexing {
+
+/**
+ * @brief Configuration for the search batcher
+ */
+struct SearchBatcherConfig {
+    size_t max_batch = 32;                          // Requests per batched search (N)
+    std::chrono::microseconds max_linger{500};      // Longest wait for a batch to fill (T)
+    double arrival_smoothing = 0.2;                 // EWMA weight of the newest arrival gap
+};
+
+/**
+ * @brief Batcher counters
+ */
+struct SearchBatcherStats {
+    uint64_t requests = 0;        // Requests dispatched
+    uint64_t batches = 0;         // Batched searches executed
+    size_t largest_batch = 0;
+
+    double average_batch() const {
+        return batches > 0 ? static_cast<double>(requests) / batches : 0.0;
+    }
+};
+
+/**
+ * @brief Dynamic micro-batcher in front of IndexManager::search
+ *
+ * Concurrent callers submit single queries; a dispatcher thread gathers
+ * them into batches of up to max_batch and runs each batch as one
+ * IndexManager::search_batch call (one lock acquisition, one normalization
+ * pass, one parallel dispatch), then completes every caller's future.
+ *
+ * The batcher lingers after the first queued request only while more are
+ * likely to arrive: it tracks a moving average of the gap between
+ * arrivals and waits long enough to fill the batch at that rate, capped
+ * at max_linger. When the expected gap exceeds max_linger (low traffic)
+ * the linger is zero, so a lone request goes straight to the index.
+ * Requests that arrive while a batch is executing are picked up as soon
+ * as it finishes.
+ *
+ * A batch is searched with the largest top_k in it; each caller gets its
+ * own top_k prefix with its threshold applied.
+ *
+ * The dispatcher takes one slot of the shared QueryScheduler per batch,
+ * in the most urgent lane of its requests, and holds it only for the
+ * index call; queued and lingering requests hold no slot. Requests whose
+ * context expired fail with errors::CancelledError instead of being
+ * searched, both before the batch asks for a slot and once it has one.
+ * While waiting, the batch gives up at the latest deadline among its
+ * requests.
+ *
+ * Example usage:
+ * @code
+ *   IndexManager manager(config);
+ *   SearchBatcher batcher(manager);
+ *
+ *   auto future = batcher.submit(query_embedding, 10);
+ *   auto results = future.get();
+ * @endcode
+ */
+class SearchBatcher {
+public:
+    /**
+     * @brief Start the dispatcher
+     * @param manager Index to search (must outlive the batcher)
+     * @param config Batching configuration
+     */
+    explicit SearchBatcher(IndexManager& manager,
+                           const SearchBatcherConfig& config = SearchBatcherConfig());
+
+    /**
+     * @brief Destructor - completes queued requests, then stops
+     */
+    ~SearchBatcher();
+
+    // Non-copyable and non-movable (owns the dispatcher thread)
+    SearchBatcher(const SearchBatcher&) = delete;
+    SearchBatcher& operator=(const SearchBatcher&) = delete;
+
+    /**
+     * @brief Queue a search
+     *
+     * A query of the wrong dimension fails its own future without
+     * joining a batch.
+     *
+     * @param query_embedding Query vector
+     * @param top_k Number of results
+     * @param similarity_threshold Minimum similarity score
+     * @param priority Scheduler lane of the request
+     * @param context Deadline and cancellation, checked before the search
+     * @return Future for the results
+     */
+    std::future<std::vector<vector_search::SearchResult>> submit(
+        std::vector<float> query_embedding,
+        size_t top_k = 10,
+        float similarity_threshold = 0.0f,
+        QueryPriority priority = QueryPriority::INTERACTIVE,
+        const RequestContext& context = RequestContext());
+
+    /**
+     * @brief Queue a search and wait for it
+     *
+     * Stops waiting with errors::CancelledError within
+     * QueryScheduler::kExpiryPoll of the context expiring, even while the
+     * request is still queued.
+     *
+     * @return Same results as IndexManager::search
+     */
+    std::vector<vector_search::SearchResult> search(
+        std::vector<float> query_embedding,
+        size_t top_k = 10,
+        float similarity_threshold = 0.0f,
+        QueryPriority priority = QueryPriority::INTERACTIVE,
+        const RequestContext& context = RequestContext());
+
+    /**
+     * @brief Linger the dispatcher would use for a batch of one right now
+     * @return Linger time
+     */
+    std::chrono::microseconds current_linger() const;
+
+    /**
+     * @brief Get batcher counters
+     * @return Current stats
+     */
+    SearchBatcherStats get_stats() const;
+
+    /**
+     * @brief Get configuration
+     * @return Current configuration
+     */
+    const SearchBatcherConfig& get_config() const { return config_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        std::vector<float> query;
+        size_t top_k = 0;
+        float similarity_threshold = 0.0f;
+        QueryPriority priority = QueryPriority::INTERACTIVE;
+        RequestContext context;
+        Clock::time_point arrival;
+        std::promise<std::vector<vector_search::SearchResult>> promise;
+    };
+
+    IndexManager& manager_;
+    SearchBatcherConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request> queue_;
+    bool stopping_ = false;
+
+    // Arrival rate estimate
+    Clock::time_point last_arrival_;
+    double gap_ewma_us_;
+
+    SearchBatcherStats stats_;
+    std::thread dispatcher_;
+
+    /**
+     * @brief Dispatcher thread: gather, search, complete
+     */
+    void dispatch_loop();
+
+    /**
+     * @brief Run one batch and complete its futures (without the lock)
+     * @param batch Requests to serve
+     */
+    void execute(std::vector<Request>& batch);
+
+    /**
+     * @brief Linger for a batch that has queued requests (caller holds mutex_)
+     * @param queued Requests already waiting
+     * @return Time to wait after the oldest request's arrival
+     */
+    std::chrono::microseconds linger_for(size_t queued) const;
+};
+
+} // namespace brain_ai::indexing
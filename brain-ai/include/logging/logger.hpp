@@ -1,7 +1,15 @@
 #ifndef BRAIN_AI_LOGGING_LOGGER_HPP
 #define BRAIN_AI_LOGGING_LOGGER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <fstream>
 #include <mutex>
 #include <chrono>
@@ -36,6 +44,52 @@ inline const char* log_level_to_string(LogLevel level) {
     }
 }
 
+// Lowest level compiled into LOG_* call sites (0 = TRACE ... 5 = FATAL).
+// Set by the build (CMake BRAIN_AI_LOG_MIN_LEVEL; INFO for Release).
+#ifndef BRAIN_AI_LOG_MIN_LEVEL
+#define BRAIN_AI_LOG_MIN_LEVEL 0
+#endif
+
+constexpr bool log_level_compiled_in(LogLevel level) {
+    return static_cast<int>(level) >= BRAIN_AI_LOG_MIN_LEVEL;
+}
+
+// ============================================================================
+// Deferred Formatting
+// ============================================================================
+
+// Replace each "{}" in fmt with the next argument (operator<<); surplus
+// placeholders are kept as-is, surplus arguments are ignored
+inline void format_arguments(std::ostringstream& out, const char* fmt) {
+    out << fmt;
+}
+
+template <typename T, typename... Rest>
+void format_arguments(std::ostringstream& out, const char* fmt,
+                      const T& value, const Rest&... rest) {
+    for (const char* p = fmt; *p != '\0'; ++p) {
+        if (p[0] == '{' && p[1] == '}') {
+            out << value;
+            format_arguments(out, p + 2, rest...);
+            return;
+        }
+        out << *p;
+    }
+}
+
+template <typename... Args>
+std::string format_message(const char* fmt, const Args&... args) {
+    std::ostringstream out;
+    format_arguments(out, fmt, args...);
+    return out.str();
+}
+
+// Captured argument type: values are copied, C strings become std::string
+// so nothing dangles until the line is formatted
+template <typename T>
+using captured_arg_t = std::conditional_t<
+    std::is_convertible_v<std::decay_t<T>, const char*>, std::string, std::decay_t<T>>;
+
 // Log message structure
 struct LogMessage {
     LogLevel level;
@@ -46,6 +100,13 @@ struct LogMessage {
     int line;
     std::string function;
     
+    // Set by deferred calls until resolve() fills message and timestamp
+    std::function<std::string()> formatter;
+    std::chrono::system_clock::time_point time;
+    
+    // Run the deferred formatting (no-op once resolved)
+    void resolve();
+    
     std::string format() const;
 };
 
@@ -55,9 +116,14 @@ public:
     virtual ~LogSink() = default;
     virtual void write(const LogMessage& msg) = 0;
     virtual void flush() = 0;
+    
+    // True if write() accepts unresolved deferred messages (formats later)
+    virtual bool defers_formatting() const { return false; }
 };
 
-// Console sink - writes to stdout/stderr
+// Console sink - writes to stdout/stderr. Lines below WARN stay buffered
+// until flush() (the registry flushes periodically); WARN and above are
+// flushed as they are written.
 class ConsoleSink : public LogSink {
 public:
     ConsoleSink() = default;
@@ -65,6 +131,36 @@ public:
     void flush() override;
 };
 
+// Async sink - queues messages and writes them to another sink from a
+// background thread, which also runs deferred formatting. When the queue
+// is full new messages are dropped and later reported in one line.
+class AsyncSink : public LogSink {
+public:
+    explicit AsyncSink(std::shared_ptr<LogSink> target, size_t max_queue = 8192);
+    ~AsyncSink() override;   // Drains the queue
+    
+    void write(const LogMessage& msg) override;
+    void flush() override;   // Waits until everything queued is written
+    bool defers_formatting() const override { return true; }
+    
+    size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    
+private:
+    void writer_loop();
+    
+    std::shared_ptr<LogSink> target_;
+    size_t max_queue_;
+    std::deque<LogMessage> queue_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    bool stop_ = false;
+    bool busy_ = false;
+    std::atomic<size_t> dropped_{0};
+    size_t reported_dropped_ = 0;
+    std::thread writer_;
+};
+
 // File sink - writes to file with rotation
 class FileSink : public LogSink {
 public:
@@ -87,6 +183,77 @@ private:
     std::mutex mutex_;
 };
 
+// ============================================================================
+// Call-Site Sampling
+// ============================================================================
+//
+// State for one sampled log statement (a function-local static created by
+// LOG_SAMPLED). Within each window the first first_n hits are written,
+// then one in every_m (every_m = 0 drops the rest, i.e. a plain rate
+// limit). Dropped hits are counted: the next written line carries the
+// count, and Logger::report_suppressed() writes a summary for sites that
+// went quiet with hits still pending.
+
+class Logger;
+
+class LogSite {
+public:
+    static constexpr uint32_t kDefaultWindowMs = 10000;
+
+    constexpr LogSite(LogLevel level, const char* file, int line,
+                      uint32_t first_n, uint32_t every_m,
+                      uint32_t window_ms = kDefaultWindowMs)
+        : level_(level), file_(file), line_(line),
+          first_n_(first_n), every_m_(every_m), window_ms_(window_ms) {}
+
+    LogSite(const LogSite&) = delete;
+    LogSite& operator=(const LogSite&) = delete;
+
+    // Whether this hit is written. On true, suppressed is set to the hits
+    // dropped since the previous written one.
+    bool admit(uint64_t& suppressed);
+
+    // Dropped hits not yet reported / dropped over the site's lifetime
+    uint64_t pending_suppressed() const { return pending_.load(std::memory_order_relaxed); }
+    uint64_t total_suppressed() const { return total_.load(std::memory_order_relaxed); }
+
+    LogLevel level() const { return level_; }
+    const char* file() const { return file_; }
+    int line() const { return line_; }
+
+private:
+    friend class Logger;
+
+    const LogLevel level_;
+    const char* const file_;
+    const int line_;
+    const uint32_t first_n_;
+    const uint32_t every_m_;
+    const uint32_t window_ms_;
+
+    std::atomic<uint64_t> window_start_ms_{0};
+    std::atomic<uint64_t> hits_{0};          // In the current window
+    std::atomic<uint64_t> pending_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<Logger*> owner_{nullptr};    // Logger that reports this site
+};
+
+// message annotated with a suppressed count (unchanged when 0)
+std::string with_suppressed(const std::string& message, uint64_t suppressed);
+
+// Sampling policies shared by per-item LOG_*_SAMPLED call sites
+namespace sampling {
+
+// Progress lines: the first few per window, then 1 in 1000
+constexpr uint32_t kProgressFirstN = 5;
+constexpr uint32_t kProgressEveryM = 1000;
+
+// Failures: more context before sampling kicks in
+constexpr uint32_t kFailureFirstN = 20;
+constexpr uint32_t kFailureEveryM = 100;
+
+} // namespace sampling
+
 // Logger class
 class Logger {
 public:
@@ -109,6 +276,39 @@ public:
     void log(LogLevel level, const std::string& message,
              const char* file = "", int line = 0, const char* func = "");
     
+    // Deferred formatting (see LOG_INFOF); fmt must outlive the write
+    template <typename... Args>
+    void logf(LogLevel level, const char* file, int line, const char* func,
+              const char* fmt, Args&&... args) {
+        logf_sampled(level, 0, file, line, func, fmt, std::forward<Args>(args)...);
+    }
+    
+    // logf for a sampled site (see LOG_INFOF_SAMPLED): the line carries the
+    // suppressed count from admit()
+    template <typename... Args>
+    void logf_sampled(LogLevel level, uint64_t suppressed,
+                      const char* file, int line, const char* func,
+                      const char* fmt, Args&&... args) {
+        if (!should_log(level)) {
+            return;
+        }
+        log_deferred(level,
+                     [fmt, suppressed, captured = std::tuple<captured_arg_t<Args>...>(
+                               std::forward<Args>(args)...)]() {
+                         std::string message = std::apply([fmt](const auto&... values) {
+                             return format_message(fmt, values...);
+                         }, captured);
+                         if (suppressed != 0) {
+                             message = with_suppressed(message, suppressed);
+                         }
+                         return message;
+                     },
+                     file, line, func);
+    }
+    
+    void log_deferred(LogLevel level, std::function<std::string()> formatter,
+                      const char* file = "", int line = 0, const char* func = "");
+    
     void trace(const std::string& message,
                const char* file = "", int line = 0, const char* func = "");
     void debug(const std::string& message,
@@ -122,92 +322,163 @@ public:
     void fatal(const std::string& message,
                const char* file = "", int line = 0, const char* func = "");
     
-    // Flush all sinks
+    // Sampling decision for a LOG_SAMPLED site (registers the site with
+    // this logger for report_suppressed() on first use)
+    bool admit(LogSite& site, uint64_t& suppressed);
+    
+    // Write one summary line per site with suppressed hits still pending
+    void report_suppressed();
+    
+    // Flush all sinks (reports pending suppressed counts first)
     void flush();
     
 private:
     std::string name_;
     LogLevel level_;
     std::vector<std::shared_ptr<LogSink>> sinks_;
+    std::vector<LogSite*> sites_;   // Sampled sites reporting through this logger
     std::mutex mutex_;
 };
 
-// Logger registry - manages all loggers
+// Logger registry - manages all loggers. Loggers write to a ConsoleSink
+// until initialize_logging() or the *_global_sink* calls replace it.
+// A background thread flushes every logger each flush interval, which
+// also writes pending suppressed-count summaries.
 class LoggerRegistry {
 public:
+    static constexpr std::chrono::milliseconds kDefaultFlushInterval{1000};
+    
     static LoggerRegistry& instance();
     
+    ~LoggerRegistry();
+    
     // Get or create logger
     std::shared_ptr<Logger> get_logger(const std::string& name);
     
     // Set global log level for all loggers
     void set_global_level(LogLevel level);
     
-    // Add sink to all loggers
+    // Add sink to all loggers (including ones created later)
     void add_global_sink(std::shared_ptr<LogSink> sink);
     
+    // Replace every logger's sinks (including ones created later)
+    void set_global_sinks(std::vector<std::shared_ptr<LogSink>> sinks);
+    
     // Flush all loggers
     void flush_all();
     
+    // Period of the background flush (0 stops it)
+    void set_flush_interval(std::chrono::milliseconds interval);
+    
 private:
     LoggerRegistry();
     
+    void start_flusher();
+    void flusher_loop();
+    
     std::unordered_map<std::string, std::shared_ptr<Logger>> loggers_;
+    std::vector<std::shared_ptr<LogSink>> global_sinks_;   // Console until replaced
+    LogLevel global_level_ = LogLevel::INFO;
     std::mutex mutex_;
+    
+    // Periodic flush, guarded by flush_mutex_ (never held with mutex_)
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cv_;
+    std::chrono::milliseconds flush_interval_{kDefaultFlushInterval};
+    bool flusher_stop_ = false;
+    std::thread flusher_;
 };
 
 // Helper function to get current timestamp
 std::string get_timestamp();
 
-// Convenience macros for logging
-#define LOG_TRACE(logger, msg) \
+// Convenience macros for logging. msg is only evaluated when the level is
+// enabled; levels below BRAIN_AI_LOG_MIN_LEVEL are compiled out.
+#define BRAIN_AI_LOG_AT(logger, level, msg) \
     do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::TRACE)) { \
-            (logger)->trace(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
+        if constexpr (brain_ai::logging::log_level_compiled_in(level)) { \
+            if ((logger)->should_log(level)) { \
+                (logger)->log((level), (msg), __FILE__, __LINE__, __FUNCTION__); \
+            } \
         } \
     } while(0)
 
-#define LOG_DEBUG(logger, msg) \
-    do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::DEBUG)) { \
-            (logger)->debug(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
-        } \
-    } while(0)
+#define LOG_TRACE(logger, msg) BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::TRACE, msg)
+#define LOG_DEBUG(logger, msg) BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::DEBUG, msg)
+#define LOG_INFO(logger, msg)  BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::INFO, msg)
+#define LOG_WARN(logger, msg)  BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::WARN, msg)
+#define LOG_ERROR(logger, msg) BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::ERROR, msg)
+#define LOG_FATAL(logger, msg) BRAIN_AI_LOG_AT(logger, brain_ai::logging::LogLevel::FATAL, msg)
 
-#define LOG_INFO(logger, msg) \
+// Deferred formatting: LOG_INFOF(logger, "loaded {} nodes in {} ms", n, ms).
+// The format must be a string literal; arguments are copied and only
+// formatted once a sink writes the line (on the writer thread for an
+// AsyncSink).
+#define BRAIN_AI_LOGF_AT(logger, level, ...) \
     do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::INFO)) { \
-            (logger)->info(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
+        if constexpr (brain_ai::logging::log_level_compiled_in(level)) { \
+            if ((logger)->should_log(level)) { \
+                (logger)->logf((level), __FILE__, __LINE__, __FUNCTION__, __VA_ARGS__); \
+            } \
         } \
     } while(0)
 
-#define LOG_WARN(logger, msg) \
-    do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::WARN)) { \
-            (logger)->warn(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
-        } \
-    } while(0)
+#define LOG_TRACEF(logger, ...) BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::TRACE, __VA_ARGS__)
+#define LOG_DEBUGF(logger, ...) BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFOF(logger, ...)  BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARNF(logger, ...)  BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERRORF(logger, ...) BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::ERROR, __VA_ARGS__)
+#define LOG_FATALF(logger, ...) BRAIN_AI_LOGF_AT(logger, brain_ai::logging::LogLevel::FATAL, __VA_ARGS__)
 
-#define LOG_ERROR(logger, msg) \
+// Sampled logging for hot paths: first_n per window, then 1 in every_m.
+// msg is only evaluated for lines that are written.
+#define LOG_SAMPLED(logger, level, first_n, every_m, msg) \
     do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::ERROR)) { \
-            (logger)->error(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
+        if constexpr (brain_ai::logging::log_level_compiled_in(level)) { \
+            static brain_ai::logging::LogSite _log_site((level), __FILE__, __LINE__, \
+                                                        (first_n), (every_m)); \
+            uint64_t _log_suppressed = 0; \
+            if ((logger)->should_log(level) && (logger)->admit(_log_site, _log_suppressed)) { \
+                (logger)->log((level), \
+                              brain_ai::logging::with_suppressed((msg), _log_suppressed), \
+                              __FILE__, __LINE__, __FUNCTION__); \
+            } \
         } \
     } while(0)
 
-#define LOG_FATAL(logger, msg) \
+#define LOG_INFO_SAMPLED(logger, first_n, every_m, msg) \
+    LOG_SAMPLED(logger, brain_ai::logging::LogLevel::INFO, first_n, every_m, msg)
+
+#define LOG_WARN_SAMPLED(logger, first_n, every_m, msg) \
+    LOG_SAMPLED(logger, brain_ai::logging::LogLevel::WARN, first_n, every_m, msg)
+
+#define LOG_ERROR_SAMPLED(logger, first_n, every_m, msg) \
+    LOG_SAMPLED(logger, brain_ai::logging::LogLevel::ERROR, first_n, every_m, msg)
+
+// Sampled deferred formatting: LOG_INFOF_SAMPLED(logger, first_n, every_m,
+// "read {} bytes", n). Arguments are captured only for lines that are written.
+#define LOGF_SAMPLED(logger, level, first_n, every_m, ...) \
     do { \
-        const auto& _log_msg = (msg); \
-        if ((logger)->should_log(brain_ai::logging::LogLevel::FATAL)) { \
-            (logger)->fatal(_log_msg, __FILE__, __LINE__, __FUNCTION__); \
+        if constexpr (brain_ai::logging::log_level_compiled_in(level)) { \
+            static brain_ai::logging::LogSite _log_site((level), __FILE__, __LINE__, \
+                                                        (first_n), (every_m)); \
+            uint64_t _log_suppressed = 0; \
+            if ((logger)->should_log(level) && (logger)->admit(_log_site, _log_suppressed)) { \
+                (logger)->logf_sampled((level), _log_suppressed, \
+                                       __FILE__, __LINE__, __FUNCTION__, __VA_ARGS__); \
+            } \
         } \
     } while(0)
 
+#define LOG_INFOF_SAMPLED(logger, first_n, every_m, ...) \
+    LOGF_SAMPLED(logger, brain_ai::logging::LogLevel::INFO, first_n, every_m, __VA_ARGS__)
+
+#define LOG_WARNF_SAMPLED(logger, first_n, every_m, ...) \
+    LOGF_SAMPLED(logger, brain_ai::logging::LogLevel::WARN, first_n, every_m, __VA_ARGS__)
+
+#define LOG_ERRORF_SAMPLED(logger, first_n, every_m, ...) \
+    LOGF_SAMPLED(logger, brain_ai::logging::LogLevel::ERROR, first_n, every_m, __VA_ARGS__)
+
 // Get logger by name
 #define GET_LOGGER(name) \
     brain_ai::logging::LoggerRegistry::instance().get_logger(name)
@@ -221,11 +492,16 @@ namespace logger_names {
     constexpr const char* FUSION = "brain_ai.hybrid_fusion";
     constexpr const char* EXPLANATION = "brain_ai.explanation_engine";
     constexpr const char* COGNITIVE = "brain_ai.cognitive_handler";
+    constexpr const char* DOCUMENT = "brain_ai.document_processor";
+    constexpr const char* OCR = "brain_ai.ocr_client";
+    constexpr const char* VALIDATOR = "brain_ai.text_validator";
 }
 
-// Initialize logging system with default configuration
+// Initialize logging system with default configuration. With async the
+// sinks are written (and messages formatted) on a background thread.
 void initialize_logging(LogLevel level = LogLevel::INFO,
-                        const std::string& log_file = "");
+                        const std::string& log_file = "",
+                        bool async = false);
 
 } // namespace logging
 } // namespace brain_ai
@@ -0,0 +1,41 @@
+#ifndef BRAIN_AI_MAPPED_FILE_HPP
+#define BRAIN_AI_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace brain_ai {
+
+// Read-only memory mapping of a whole file (POSIX mmap).
+// Pages are shared with every other process mapping the same file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);   // Throws std::runtime_error
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return data_ != nullptr || opened_empty_; }
+    const std::string& path() const { return path_; }
+
+    // Hint the kernel that the mapping will be read sequentially
+    void advise_sequential() const;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool opened_empty_ = false;
+    std::string path_;
+
+    void release();
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_MAPPED_FILE_HPP
@@ -8,6 +8,9 @@
 #include <mutex>
 #include <chrono>
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 
 namespace brain_ai {
 namespace monitoring {
@@ -40,10 +43,16 @@ struct HealthCheckResult {
     std::chrono::system_clock::time_point timestamp;
     int64_t check_duration_ms;
     
+    // Set when served from the background prober's cache
+    int64_t age_ms;       // Time since the check completed
+    bool stale;           // No fresh result within interval + timeout
+    
     HealthCheckResult()
         : status(HealthStatus::UNKNOWN)
         , timestamp(std::chrono::system_clock::now())
-        , check_duration_ms(0) {}
+        , check_duration_ms(0)
+        , age_ms(0)
+        , stale(false) {}
     
     // Format as JSON-like string
     std::string to_json() const;
@@ -53,39 +62,93 @@ struct HealthCheckResult {
 using HealthCheckFunction = std::function<HealthCheckResult()>;
 
 // Individual health check
+//
+// execute() runs the check function on the shared WorkPool and waits at
+// most timeout_ms; a check that overruns is reported UNHEALTHY and keeps
+// running without blocking the caller. Only one run per check is ever
+// queued or running, so a hung check ties up at most one pool worker;
+// while it runs, execute() returns the last result without recording a
+// new one. A check that throws is reported UNHEALTHY.
 class HealthCheck {
 public:
     HealthCheck(const std::string& name,
                 HealthCheckFunction check_func,
-                int timeout_ms = 5000)
+                int timeout_ms = 5000,
+                int interval_ms = 0)
         : name_(name)
         , check_func_(check_func)
         , timeout_ms_(timeout_ms)
+        , interval_ms_(interval_ms)
+        , run_(std::make_shared<RunSlot>())
         , last_result_()
         , consecutive_failures_(0) {}
     
     // Execute health check
     HealthCheckResult execute();
     
+    // Run the check on the calling thread (used by the background prober)
+    HealthCheckResult probe();
+    
     // Get last result (cached)
     HealthCheckResult get_last_result() const {
         std::lock_guard<std::mutex> lock(mutex_);
         return last_result_;
     }
     
+    // Last completed result, lock-free (nullptr before the first run)
+    std::shared_ptr<const HealthCheckResult> cached_result() const {
+        return std::atomic_load_explicit(&cached_, std::memory_order_acquire);
+    }
+    
     const std::string& name() const { return name_; }
+    int timeout_ms() const { return timeout_ms_; }
+    int interval_ms() const { return interval_ms_; }   // 0 = prober default
+    bool in_flight() const { return run_->in_flight.load(std::memory_order_acquire); }
+    
+    // Make a queued run skip the check function and wait up to limit for
+    // a running one. Returns false if it is still running: it is abandoned
+    // and clears the cancellation itself when it finishes.
+    bool cancel_and_wait(std::chrono::milliseconds limit);
+    
     int consecutive_failures() const {
         std::lock_guard<std::mutex> lock(mutex_);
         return consecutive_failures_;
     }
     
 private:
+    friend class HealthCheckRegistry;
+    
+    // Shared with the pool task, which may outlive this HealthCheck
+    struct RunSlot {
+        std::atomic<bool> in_flight{false};
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::condition_variable idle;
+        
+        bool try_start();
+        void finish();
+    };
+    
     std::string name_;
     HealthCheckFunction check_func_;
     int timeout_ms_;
+    int interval_ms_;
+    std::shared_ptr<RunSlot> run_;
+    std::shared_ptr<const HealthCheckResult> cached_;
+    
+    // Prober thread only
+    std::chrono::steady_clock::time_point next_probe_;
+    std::chrono::steady_clock::time_point probe_started_;
+    std::chrono::system_clock::time_point probe_started_wall_;
+    std::shared_ptr<std::atomic<bool>> probe_done_;   // Current prober run, nullptr once handled
+    
     mutable std::mutex mutex_;
     HealthCheckResult last_result_;
     int consecutive_failures_;
+    
+    // Timing, failure tracking and cache publication for a finished run
+    HealthCheckResult record(HealthCheckResult result,
+                             std::chrono::steady_clock::time_point start);
 };
 
 // System-wide health status
@@ -93,31 +156,52 @@ struct SystemHealth {
     HealthStatus overall_status;
     std::vector<HealthCheckResult> component_results;
     std::chrono::system_clock::time_point timestamp;
+    bool from_cache;      // Served by the background prober
     
     SystemHealth()
         : overall_status(HealthStatus::UNKNOWN)
-        , timestamp(std::chrono::system_clock::now()) {}
+        , timestamp(std::chrono::system_clock::now())
+        , from_cache(false) {}
     
     // Format as JSON string
     std::string to_json() const;
     
-    // Determine overall status from components
+    // Determine overall status from components (stale results count as
+    // DEGRADED at best)
     void compute_overall_status();
 };
 
 // Health check registry
+//
+// Without the prober, check_all() runs every check in turn. After
+// start_prober(), a scheduler thread submits each check to the shared
+// WorkPool every interval_ms (or the prober default) and check_all() only
+// reads the checks' cached results, tagging each with its age and a
+// stale flag once no result has arrived within interval + timeout. A
+// probe still running after timeout_ms is recorded as an UNHEALTHY
+// timeout (dated from its start, so it still turns stale). stop_prober()
+// and the destructor cancel queued runs and wait for running ones for at
+// most the longest check timeout, then abandon them.
 class HealthCheckRegistry {
 public:
     static HealthCheckRegistry& instance();
     
-    // Register a health check
+    ~HealthCheckRegistry();
+    
+    // Register a health check (interval_ms = 0 uses the prober default)
     void register_check(const std::string& name,
                        HealthCheckFunction check_func,
-                       int timeout_ms = 5000);
+                       int timeout_ms = 5000,
+                       int interval_ms = 0);
     
-    // Execute all health checks
+    // Execute all health checks (from cache while the prober runs)
     SystemHealth check_all();
     
+    // Background probing
+    void start_prober(std::chrono::milliseconds default_interval = std::chrono::seconds(10));
+    void stop_prober();
+    bool prober_running() const;
+    
     // Execute specific health check
     HealthCheckResult check_one(const std::string& name);
     
@@ -134,7 +218,21 @@ private:
     HealthCheckRegistry() = default;
     
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::unique_ptr<HealthCheck>> checks_;
+    std::unordered_map<std::string, std::shared_ptr<HealthCheck>> checks_;
+    
+    // Prober state, guarded by mutex_ (control_mutex_ serializes start/stop)
+    std::mutex control_mutex_;
+    std::thread prober_;
+    std::condition_variable prober_cv_;
+    bool prober_stop_ = false;
+    bool prober_active_ = false;
+    std::chrono::milliseconds default_interval_{10000};
+    std::chrono::system_clock::time_point prober_started_;
+    
+    SystemHealth cached_health() const;   // Requires mutex_
+    void drain_checks();                  // Cancels every check's run; bounded wait
+    std::chrono::milliseconds interval_of(const HealthCheck& check) const;
+    void prober_loop();
 };
 
 // Predefined health checks for Brain-AI components
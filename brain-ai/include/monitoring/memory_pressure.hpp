@@ -0,0 +1,200 @@
+#ifndef BRAIN_AI_MONITORING_MEMORY_PRESSURE_HPP
+#define BRAIN_AI_MONITORING_MEMORY_PRESSURE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace brain_ai {
+namespace monitoring {
+
+// ============================================================================
+// Memory Pressure Levels
+// ============================================================================
+
+enum class MemoryPressureLevel {
+    NORMAL = 0,
+    MODERATE = 1,   // Trim caches
+    HIGH = 2,       // Shrink caches hard
+    CRITICAL = 3    // Keep only what is needed to answer queries
+};
+
+const char* memory_pressure_level_to_string(MemoryPressureLevel level);
+
+// Fraction of its configured budget a cache should keep at a level
+// (1, 1/2, 1/4, 1/10)
+double memory_pressure_budget_factor(MemoryPressureLevel level);
+
+// ============================================================================
+// Memory Sample
+// ============================================================================
+
+// One reading of the process's memory situation. Fields that could not be
+// read are left at zero with the matching *_available flag cleared.
+struct MemorySample {
+    size_t rss_bytes = 0;               // /proc/self/statm resident pages
+    size_t rss_limit_bytes = 0;         // MemoryPressureConfig::rss_limit_bytes
+
+    bool cgroup_available = false;      // cgroup v2 memory controller found
+    size_t cgroup_current_bytes = 0;    // memory.current
+    size_t cgroup_max_bytes = 0;        // memory.max (0 = "max", no limit)
+
+    bool system_available = false;      // /proc/meminfo
+    size_t system_total_bytes = 0;      // MemTotal
+    size_t system_available_bytes = 0;  // MemAvailable
+
+    bool psi_available = false;         // cgroup memory.pressure or /proc/pressure/memory
+    double psi_some_avg10 = 0.0;        // % of the last 10s some tasks stalled on memory
+    double psi_full_avg10 = 0.0;        // % of the last 10s all tasks stalled on memory
+
+    // Usage as a fraction of the process's own limit: the cgroup limit if
+    // there is one, otherwise RSS against rss_limit_bytes. 0 (no signal)
+    // when neither is set; system-wide memory is not ours to budget.
+    double usage_ratio() const;
+};
+
+struct MemoryPressureConfig {
+    // usage_ratio() thresholds
+    double moderate_ratio = 0.75;
+    double high_ratio = 0.85;
+    double critical_ratio = 0.95;
+
+    // Memory budget of this process when no cgroup limit applies
+    // (0 = no usage signal; PSI still counts)
+    size_t rss_limit_bytes = 0;
+
+    // PSI thresholds (avg10 percent)
+    double moderate_psi_some = 10.0;
+    double high_psi_some = 30.0;
+    double critical_psi_full = 20.0;
+
+    // A level is only left once its signals drop this fraction below the
+    // thresholds that raised it
+    double hysteresis = 0.1;
+
+    std::chrono::milliseconds poll_interval{1000};
+
+    // Overridable for tests
+    std::string proc_root = "/proc";
+    std::string cgroup_root = "/sys/fs/cgroup";
+};
+
+// Read the current sample from config.proc_root / config.cgroup_root
+MemorySample read_memory_sample(const MemoryPressureConfig& config);
+
+// Level implied by a sample. Thresholds of levels at or below `current`
+// are scaled down by (1 - hysteresis), so a level sticks until the
+// signals clearly fall away.
+MemoryPressureLevel classify_memory_pressure(const MemorySample& sample,
+                                             const MemoryPressureConfig& config,
+                                             MemoryPressureLevel current = MemoryPressureLevel::NORMAL);
+
+// ============================================================================
+// Memory Pressure Monitor
+// ============================================================================
+//
+// Samples RSS, the cgroup v2 memory controller and PSI, classifies them
+// into a MemoryPressureLevel and notifies subscribers whenever the level
+// changes, so caches shrink before the kernel OOM killer gets involved.
+// poll() samples once; start() polls from a background thread.
+//
+// Listeners run on the polling thread under the monitor's listener lock:
+// they should only adjust their own budgets and must not subscribe or
+// unsubscribe from inside the callback.
+
+namespace detail {
+struct MemoryPressureListeners;
+}
+
+// Keeps a listener registered; unsubscribes on destruction (or reset()).
+// Safe to outlive the monitor. reset() waits for a notification in
+// progress, so an owner whose listener captures `this` must unsubscribe
+// before the state the listener touches is destroyed: call reset() first
+// in its destructor, or declare the subscription as its last member.
+class MemoryPressureSubscription {
+public:
+    MemoryPressureSubscription() = default;
+    ~MemoryPressureSubscription() { reset(); }
+
+    MemoryPressureSubscription(MemoryPressureSubscription&& other) noexcept;
+    MemoryPressureSubscription& operator=(MemoryPressureSubscription&& other) noexcept;
+
+    MemoryPressureSubscription(const MemoryPressureSubscription&) = delete;
+    MemoryPressureSubscription& operator=(const MemoryPressureSubscription&) = delete;
+
+    void reset();
+
+    bool active() const { return listeners_ != nullptr; }
+
+private:
+    friend class MemoryPressureMonitor;
+
+    std::shared_ptr<detail::MemoryPressureListeners> listeners_;
+    uint64_t id_ = 0;
+};
+
+class MemoryPressureMonitor {
+public:
+    using Listener = std::function<void(MemoryPressureLevel)>;
+
+    explicit MemoryPressureMonitor(const MemoryPressureConfig& config = MemoryPressureConfig());
+    ~MemoryPressureMonitor();
+
+    MemoryPressureMonitor(const MemoryPressureMonitor&) = delete;
+    MemoryPressureMonitor& operator=(const MemoryPressureMonitor&) = delete;
+
+    // Process-wide monitor the caches subscribe to
+    static MemoryPressureMonitor& instance();
+
+    // Register a listener. It is called right away if the current level
+    // is above NORMAL, then on every change.
+    MemoryPressureSubscription subscribe(Listener listener);
+
+    // Sample, classify, publish gauges and notify on change
+    MemoryPressureLevel poll();
+
+    // Force a level (external signal or tests); notifies on change
+    void publish(MemoryPressureLevel level);
+
+    MemoryPressureLevel level() const {
+        return static_cast<MemoryPressureLevel>(level_.load(std::memory_order_acquire));
+    }
+
+    // Most recent sample taken by poll()
+    MemorySample last_sample() const;
+
+    // Background polling every config.poll_interval (idempotent)
+    void start();
+    void stop();
+    bool running() const;
+
+    const MemoryPressureConfig& config() const { return config_; }
+
+private:
+    MemoryPressureConfig config_;
+    std::shared_ptr<detail::MemoryPressureListeners> listeners_;
+    std::atomic<int> level_{static_cast<int>(MemoryPressureLevel::NORMAL)};
+
+    mutable std::mutex sample_mutex_;
+    MemorySample last_sample_;
+
+    mutable std::mutex control_mutex_;   // Guards start/stop
+    std::mutex poller_mutex_;
+    std::condition_variable poller_cv_;
+    bool poller_stop_ = false;
+    std::thread poller_;
+
+    void poller_loop();
+};
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#endif // BRAIN_AI_MONITORING_MEMORY_PRESSURE_HPP
@@ -199,10 +199,12 @@ namespace metric_names {
     inline constexpr std::string_view QUERIES_TOTAL = "queries_total";
     inline constexpr std::string_view QUERIES_FAILED = "queries_failed";
     inline constexpr std::string_view QUERY_LATENCY = "query_latency_us";
+    inline constexpr std::string_view SLOW_QUERIES = "slow_queries_total";
     
     // Episodic buffer
     inline constexpr std::string_view EPISODES_STORED = "episodes_stored";
     inline constexpr std::string_view EPISODES_RETRIEVED = "episodes_retrieved";
+    inline constexpr std::string_view EPISODES_DROPPED = "episodes_dropped";
     inline constexpr std::string_view EPISODIC_CACHE_HITS = "episodic_cache_hits";
     inline constexpr std::string_view EPISODIC_CACHE_MISSES = "episodic_cache_misses";
     
@@ -210,19 +212,60 @@ namespace metric_names {
     inline constexpr std::string_view SEMANTIC_ACTIVATIONS = "semantic_activations";
     inline constexpr std::string_view SEMANTIC_NODES = "semantic_nodes_count";
     inline constexpr std::string_view SEMANTIC_EDGES = "semantic_edges_count";
+    inline constexpr std::string_view SEMANTIC_CACHE_HITS = "semantic_cache_hits";
+    inline constexpr std::string_view SEMANTIC_CACHE_MISSES = "semantic_cache_misses";
+    inline constexpr std::string_view SEMANTIC_CACHE_HIT_RATE = "semantic_cache_hit_rate";
+    inline constexpr std::string_view SEMANTIC_CACHE_BYTES = "semantic_cache_bytes";
     
     // Hallucination detection
     inline constexpr std::string_view HALLUCINATIONS_DETECTED = "hallucinations_detected";
     inline constexpr std::string_view VALIDATION_CONFIDENCE = "validation_confidence";
     
+    // Query coalescing
+    inline constexpr std::string_view QUERIES_COALESCED = "queries_coalesced";
+    
+    // Admission control
+    inline constexpr std::string_view REQUESTS_RATE_LIMITED = "requests_rate_limited";
+    inline constexpr std::string_view SCHEDULER_INTERACTIVE_WAIT_US = "scheduler_interactive_wait_us";
+    inline constexpr std::string_view SCHEDULER_BULK_WAIT_US = "scheduler_bulk_wait_us";
+    inline constexpr std::string_view SCHEDULER_INGEST_WAIT_US = "scheduler_ingest_wait_us";
+    inline constexpr std::string_view SCHEDULER_INGEST_LIMIT = "scheduler_ingest_limit";
+    inline constexpr std::string_view SCHEDULER_INGEST_THROTTLED = "scheduler_ingest_throttled";
+    
+    // Cancellation (per stage: cancelled_<stage>, see request_context.hpp)
+    inline constexpr std::string_view REQUESTS_CANCELLED = "requests_cancelled";
+    inline constexpr std::string_view REQUESTS_DEADLINE_EXCEEDED = "requests_deadline_exceeded";
+    inline constexpr std::string_view CANCELLED_PREFIX = "cancelled_";
+    inline constexpr std::string_view CANCELLED_BATCH_ITEMS = "cancelled_batch_items";
+    
+    // Search micro-batching
+    inline constexpr std::string_view SEARCH_BATCHES = "search_batches";
+    inline constexpr std::string_view SEARCH_BATCHED_REQUESTS = "search_batched_requests";
+    inline constexpr std::string_view SEARCH_BATCH_SIZE = "search_batch_size";
+    
+    // OCR requests
+    inline constexpr std::string_view OCR_REQUESTS_FAILED = "ocr_requests_failed";
+    inline constexpr std::string_view OCR_RETRIES = "ocr_retries";
+    inline constexpr std::string_view OCR_HEDGED_REQUESTS = "ocr_hedged_requests";
+    inline constexpr std::string_view OCR_HEDGE_WINS = "ocr_hedge_wins";
+    
     // System health
     inline constexpr std::string_view MEMORY_USAGE_MB = "memory_usage_mb";
     inline constexpr std::string_view CPU_USAGE_PERCENT = "cpu_usage_percent";
     inline constexpr std::string_view THREAD_COUNT = "thread_count";
+    inline constexpr std::string_view MEMORY_RSS_BYTES = "memory_rss_bytes";
+    inline constexpr std::string_view MEMORY_USAGE_RATIO = "memory_usage_ratio";
+    inline constexpr std::string_view MEMORY_PSI_SOME_AVG10 = "memory_psi_some_avg10";
+    inline constexpr std::string_view MEMORY_PRESSURE_LEVEL = "memory_pressure_level";
+    inline constexpr std::string_view MEMORY_PRESSURE_CHANGES = "memory_pressure_changes";
     
     // Performance
     inline constexpr std::string_view QPS_CURRENT = "qps_current";
     inline constexpr std::string_view THROUGHPUT_TOTAL = "throughput_total";
+    
+    // Hardware counters (per stage: perf_<stage>_<event>, see perf_counters.hpp)
+    inline constexpr std::string_view PERF_PREFIX = "perf_";
+    inline constexpr std::string_view PERF_COUNTERS_UNAVAILABLE = "perf_counters_unavailable";
 }
 
 } // namespace monitoring
@@ -0,0 +1,136 @@
+#ifndef BRAIN_AI_MONITORING_PERF_COUNTERS_HPP
+#define BRAIN_AI_MONITORING_PERF_COUNTERS_HPP
+
+#include "monitoring/metrics.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace brain_ai {
+namespace monitoring {
+
+// ============================================================================
+// Hardware Performance Counters
+// ============================================================================
+//
+// Optional perf_event_open(2) counters scoped around pipeline stages.
+// Each thread lazily opens one event group (user-space only, so the
+// default perf_event_paranoid=2 suffices) and a PerfScope reads the group
+// at entry and exit. Deltas are summed per stage into MetricsRegistry
+// counters named perf_<stage>_<event>, plus perf_<stage>_samples.
+//
+// Off by default; set_enabled(true) or BRAIN_AI_PERF_COUNTERS=1 turns it
+// on. When disabled a scope costs one relaxed load. If perf events are
+// not permitted (container seccomp, paranoid level, no PMU in a VM) or
+// the platform is not Linux, scopes record nothing and the
+// perf_counters_unavailable counter is bumped once per thread.
+
+enum class PerfEvent : size_t {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    LLC_MISSES,       // Last-level cache read misses
+    DTLB_MISSES,      // Data TLB read misses
+    BRANCH_MISSES
+};
+
+inline constexpr size_t kNumPerfEvents = 5;
+
+// Metric suffix for an event ("cycles", "llc_misses", ...)
+const char* perf_event_name(PerfEvent event);
+
+// Counter values for the calling thread (scaled if the kernel multiplexed
+// the group). Events the CPU does not support are left out of valid_mask.
+struct PerfReading {
+    uint64_t values[kNumPerfEvents];
+    uint32_t valid_mask;
+
+    bool valid(PerfEvent event) const {
+        return (valid_mask >> static_cast<size_t>(event)) & 1u;
+    }
+    uint64_t value(PerfEvent event) const {
+        return values[static_cast<size_t>(event)];
+    }
+};
+
+class PerfCounters {
+public:
+    static void set_enabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // Whether the calling thread's counter group could be opened
+    // (opens it on first call)
+    static bool available();
+
+    // errno text of the failed open on this thread (empty if available)
+    static std::string unavailable_reason();
+
+    // Read the calling thread's counters; false if unavailable
+    static bool read(PerfReading& reading);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+// Named pipeline stage. Constant-initialized, so it can live at namespace
+// scope; its metrics are registered on the first recorded sample.
+class PerfStage {
+public:
+    constexpr explicit PerfStage(const char* name) : name_(name) {}
+
+    PerfStage(const PerfStage&) = delete;
+    PerfStage& operator=(const PerfStage&) = delete;
+
+    const char* name() const { return name_; }
+
+    // Add one scope's deltas
+    void record(const PerfReading& delta);
+
+private:
+    const char* name_;
+    std::once_flag metrics_once_;
+    Counter* samples_ = nullptr;
+    Counter* counters_[kNumPerfEvents] = {};
+};
+
+// RAII helper: counts the enclosed code into a stage
+class PerfScope {
+public:
+    explicit PerfScope(PerfStage& stage) : stage_(nullptr) {
+        if (PerfCounters::enabled()) {
+            begin(stage);
+        }
+    }
+
+    ~PerfScope() {
+        stop();
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+    // End the scope early (idempotent)
+    void stop() {
+        if (stage_) {
+            end();
+        }
+    }
+
+private:
+    PerfStage* stage_;
+    PerfReading start_;   // Only filled while stage_ is set
+
+    void begin(PerfStage& stage);
+    void end();
+};
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#endif // BRAIN_AI_MONITORING_PERF_COUNTERS_HPP
@@ -0,0 +1,203 @@
+#ifndef BRAIN_AI_MONITORING_SLOW_QUERY_LOG_HPP
+#define BRAIN_AI_MONITORING_SLOW_QUERY_LOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brain_ai {
+namespace monitoring {
+
+// ============================================================================
+// Slow Query Records
+// ============================================================================
+
+enum class SlowQuerySource : uint32_t {
+    PROCESS_QUERY = 0,   // CognitiveHandler::process_query
+    INDEX_SEARCH = 1     // IndexManager::search
+};
+
+inline constexpr size_t kSlowQueryStages = 6;
+inline constexpr size_t kSlowQueryResultCounts = 4;
+
+// Stage timings and result counts are indexed by these per source
+enum class QueryStage : size_t {
+    VECTOR = 0, EPISODIC, SEMANTIC, FUSION, HALLUCINATION, EXPLANATION
+};
+enum class QueryResultCount : size_t {
+    VECTOR = 0, EPISODIC, SEMANTIC, FUSED
+};
+enum class SearchStage : size_t {
+    LOCK_WAIT = 0, HNSW, FILTER
+};
+enum class SearchResultCount : size_t {
+    CANDIDATES = 0, RETURNED
+};
+
+// Fixed-size, trivially copyable so it can be stored in the lock-free ring
+struct SlowQueryRecord {
+    uint64_t sequence = 0;                 // Assigned by the log
+    uint64_t timestamp_ms = 0;             // Wall clock at completion
+    uint64_t fingerprint = 0;              // See fingerprint_text/fingerprint_embedding
+    uint64_t hops = 0;                     // HNSW graph hops (upper-layer descent)
+    uint64_t distance_computations = 0;    // HNSW distances during that descent
+    uint32_t total_us = 0;
+    uint32_t stage_us[kSlowQueryStages] = {};
+    uint32_t result_counts[kSlowQueryResultCounts] = {};
+    uint32_t top_k = 0;
+    uint32_t ef_search = 0;
+    SlowQuerySource source = SlowQuerySource::PROCESS_QUERY;
+
+    // index is a QueryResultCount or SearchResultCount
+    template <typename Index>
+    void set_result_count(Index index, size_t count) {
+        result_counts[static_cast<size_t>(index)] =
+            count > 0xffffffffu ? 0xffffffffu : static_cast<uint32_t>(count);
+    }
+};
+
+// Stable hash of a query with case and runs of whitespace folded, so
+// repeats of the same question share a fingerprint
+uint64_t fingerprint_text(const std::string& text);
+
+// Hash of the embedding's bits (for queries that arrive without text)
+uint64_t fingerprint_embedding(const std::vector<float>& embedding);
+
+// Stage / result count labels used in dumps ("" past the source's last one)
+const char* slow_query_stage_name(SlowQuerySource source, size_t stage);
+const char* slow_query_result_name(SlowQuerySource source, size_t index);
+
+// One line, logfmt style:
+//   seq=12 ts=1700000000000 src=query fp=9f3ac1... total_us=183002
+//   stages=vector:170100,episodic:40,... results=vector:10,... k=10 ef=50 hops=7 dists=112
+std::string format_slow_query(const SlowQueryRecord& record);
+
+// ============================================================================
+// Slow Query Log
+// ============================================================================
+//
+// Bounded ring of the most recent queries slower than a threshold.
+// Recording is lock-free: a writer claims a ticket with one fetch_add and
+// publishes the record under the slot's sequence lock. If a writer laps a
+// slot that another writer is still filling, the newer record is dropped,
+// and a slow writer that finds its slot already holding a newer ticket
+// drops its own (both counted in dropped()). Readers copy each slot
+// optimistically and skip slots that were rewritten during the copy.
+//
+// Callers time their stages unconditionally (a few steady_clock reads)
+// and only build a record when is_slow() says so, so fast queries pay a
+// relaxed load and a compare.
+
+class SlowQueryLog {
+public:
+    static constexpr size_t kDefaultCapacity = 256;
+    static constexpr uint32_t kDefaultThresholdUs = 100000;   // 100 ms
+
+    explicit SlowQueryLog(size_t capacity = kDefaultCapacity,
+                          uint32_t threshold_us = kDefaultThresholdUs);
+
+    SlowQueryLog(const SlowQueryLog&) = delete;
+    SlowQueryLog& operator=(const SlowQueryLog&) = delete;
+
+    // Process-wide log used by the query paths
+    static SlowQueryLog& instance();
+
+    // 0 disables recording
+    void set_threshold_us(uint32_t threshold_us) {
+        threshold_us_.store(threshold_us, std::memory_order_relaxed);
+    }
+
+    uint32_t threshold_us() const {
+        return threshold_us_.load(std::memory_order_relaxed);
+    }
+
+    bool is_slow(uint32_t total_us) const {
+        uint32_t threshold = threshold_us();
+        return threshold != 0 && total_us >= threshold;
+    }
+
+    // Store a record (sequence and timestamp are filled in)
+    void record(SlowQueryRecord record);
+
+    // Records currently held, oldest first
+    std::vector<SlowQueryRecord> snapshot() const;
+
+    // snapshot() formatted one record per line
+    std::string dump() const;
+
+    // Write dump() to a file (truncates); false on I/O error
+    bool dump_to_file(const std::string& path) const;
+
+    // Hide every record stored so far
+    void clear();
+
+    size_t capacity() const { return capacity_; }
+    uint64_t recorded() const { return next_ticket_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kRecordWords = (sizeof(SlowQueryRecord) + 7) / 8;
+
+    // Even sequence = stable, odd = being written, 0 = never written
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> ticket{0};   // Ticket + 1 of the stored record, 0 = none
+        std::atomic<uint64_t> words[kRecordWords];
+    };
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> next_ticket_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> cleared_before_{0};   // Tickets below this are hidden
+    std::atomic<uint32_t> threshold_us_;
+};
+
+// ============================================================================
+// Stage Timing Helper
+// ============================================================================
+
+// Splits a query's wall time into stages: each lap() charges the time
+// since the previous lap (or construction) to a stage.
+class SlowQueryTimer {
+public:
+    SlowQueryTimer() : start_(std::chrono::steady_clock::now()), last_(start_) {}
+
+    // stage is a QueryStage or SearchStage
+    template <typename Stage>
+    void lap(Stage stage) {
+        auto now = std::chrono::steady_clock::now();
+        stage_us_[static_cast<size_t>(stage)] += to_us(now - last_);
+        last_ = now;
+    }
+
+    uint32_t elapsed_us() const {
+        return to_us(std::chrono::steady_clock::now() - start_);
+    }
+
+    // Copy the stage timings into a record
+    void fill(SlowQueryRecord& record) const {
+        for (size_t stage = 0; stage < kSlowQueryStages; ++stage) {
+            record.stage_us[stage] = stage_us_[stage];
+        }
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_;
+    uint32_t stage_us_[kSlowQueryStages] = {};
+
+    static uint32_t to_us(std::chrono::steady_clock::duration duration) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        return us > 0xffffffffLL ? 0xffffffffu : static_cast<uint32_t>(us);
+    }
+};
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#endif // BRAIN_AI_MONITORING_SLOW_QUERY_LOG_HPP
@@ -0,0 +1,47 @@
+#ifndef BRAIN_AI_QUANTIZATION_HPP
+#define BRAIN_AI_QUANTIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace brain_ai {
+
+// Symmetric int8 quantization with a per-vector scale:
+// x[i] ~= codes[i] * scale, codes in [-127, 127]. Returns the scale
+// (0 for an all-zero vector).
+float quantize_int8(const float* src, size_t n, int8_t* codes);
+
+// Expand int8 codes back to fp32
+void dequantize_int8(const int8_t* codes, size_t n, float scale, float* dst);
+
+// Exact int32 dot product of two int8 code vectors.
+// Uses AVX-VNNI / AVX512-VNNI or AVX2 when the build targets them
+// (e.g. -march=native in Release), with a scalar fallback.
+int32_t dot_product_int8(const int8_t* a, const int8_t* b, size_t n);
+
+// Name of the dot_product_int8 kernel compiled in ("avx512-vnni", ...)
+const char* int8_kernel_name();
+
+// bfloat16 conversion (round-to-nearest-even), used for compact fp32 side stores
+inline uint16_t float_to_bf16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7f800000u) == 0x7f800000u && (bits & 0x007fffffu)) {
+        return static_cast<uint16_t>((bits >> 16) | 0x0040u);  // Quiet NaN
+    }
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float bf16_to_float(uint16_t value) {
+    uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_QUANTIZATION_HPP
@@ -0,0 +1,182 @@
+#ifndef BRAIN_AI_QUERY_SCHEDULER_HPP
+#define BRAIN_AI_QUERY_SCHEDULER_HPP
+
+#include "request_context.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace brain_ai {
+
+// Scheduling lane of a request
+enum class QueryPriority : uint8_t {
+    INTERACTIVE = 0,   // User-facing queries
+    BULK = 1,          // Re-ranking and other batch jobs
+    INGEST = 2         // Indexing; throttled while interactive latency is high
+};
+
+constexpr size_t kQueryPriorityCount = 3;
+
+const char* query_priority_name(QueryPriority priority);
+
+struct QueryLaneConfig {
+    uint32_t weight = 1;          // Share of contended slots
+    size_t max_concurrency = 0;   // 0 = lane default (see QuerySchedulerConfig)
+};
+
+struct QuerySchedulerConfig {
+    // Requests running at once across all lanes (0 = hardware threads)
+    size_t max_concurrency = 0;
+
+    // Lane defaults: interactive may use every slot, bulk half, ingest a quarter
+    std::array<QueryLaneConfig, kQueryPriorityCount> lanes = {{
+        {8, 0},   // INTERACTIVE
+        {2, 0},   // BULK
+        {1, 0}    // INGEST
+    }};
+
+    // Ingest throttling: while the moving average of interactive latency
+    // (queueing plus execution) exceeds the target, the ingest limit is
+    // halved once per interval, down to one; below half the target it
+    // grows back by one per interval. A zero target disables throttling.
+    std::chrono::microseconds interactive_latency_target{50000};
+    std::chrono::milliseconds throttle_interval{100};
+    double latency_smoothing = 0.1;   // EWMA weight of the newest sample
+};
+
+struct QueryLaneStats {
+    uint64_t admitted = 0;
+    size_t queued = 0;
+    size_t running = 0;
+    size_t limit = 0;              // Effective concurrency limit
+    double total_wait_us = 0.0;    // Queueing time of admitted requests
+
+    double average_wait_us() const {
+        return admitted > 0 ? total_wait_us / static_cast<double>(admitted) : 0.0;
+    }
+};
+
+struct QuerySchedulerStats {
+    std::array<QueryLaneStats, kQueryPriorityCount> lanes;
+    double interactive_latency_us = 0.0;   // Moving average
+    uint64_t throttle_events = 0;          // Times the ingest limit was cut
+};
+
+// Admission control for the query and ingestion paths.
+//
+// Callers take a slot before doing work and give it back when done; a
+// request that finds no free slot waits in its lane. Freed slots go to
+// the lanes by weighted fair queuing (stride scheduling: each lane
+// advances a virtual clock by 1/weight per admission, and the waiting
+// lane with the earliest clock goes next), skipping lanes at their own
+// concurrency limit. An idle lane rejoins at the current virtual time, so
+// it cannot bank credit while idle.
+//
+// Slots are re-entrant per thread: work already holding a slot (say an
+// ingest job that calls back into index_document) is not queued again.
+// A slot must be released on the thread that took it.
+class QueryScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Longest wait between expiry checks of a queued request
+    static constexpr std::chrono::milliseconds kExpiryPoll{10};
+
+    // Held while a request runs; released on destruction
+    class Slot {
+    public:
+        Slot() = default;
+        Slot(Slot&& other) noexcept { *this = std::move(other); }
+        Slot& operator=(Slot&& other) noexcept;
+        ~Slot() { release(); }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        void release();
+
+    private:
+        friend class QueryScheduler;
+        Slot(QueryScheduler* scheduler, QueryPriority priority, Clock::time_point enqueued)
+            : scheduler_(scheduler), priority_(priority), enqueued_(enqueued) {}
+
+        QueryScheduler* scheduler_ = nullptr;
+        QueryPriority priority_ = QueryPriority::INTERACTIVE;
+        Clock::time_point enqueued_;
+    };
+
+    explicit QueryScheduler(const QuerySchedulerConfig& config = QuerySchedulerConfig());
+    ~QueryScheduler();
+
+    // Non-copyable (waiters point into it)
+    QueryScheduler(const QueryScheduler&) = delete;
+    QueryScheduler& operator=(const QueryScheduler&) = delete;
+
+    // Process-wide scheduler used by CognitiveHandler and IndexManager
+    static QueryScheduler& shared();
+
+    // Wait for a slot in the priority's lane. A request whose context
+    // expires while queued leaves the queue and throws
+    // errors::CancelledError (noticed within kExpiryPoll of a cancel()).
+    Slot admit(QueryPriority priority, const RequestContext& context = RequestContext());
+
+    // Run fn() holding a slot
+    template <typename Fn>
+    auto run(QueryPriority priority, Fn&& fn, const RequestContext& context = RequestContext()) {
+        Slot slot = admit(priority, context);
+        return std::forward<Fn>(fn)();
+    }
+
+    // Replace limits and weights; waiting requests are re-dispatched
+    void reconfigure(const QuerySchedulerConfig& config);
+    QuerySchedulerConfig config() const;
+
+    // Effective concurrency limit of a lane (ingest moves with throttling)
+    size_t lane_limit(QueryPriority priority) const;
+
+    QuerySchedulerStats stats() const;
+
+private:
+    struct Waiter {
+        std::condition_variable cv;
+        bool granted = false;
+    };
+
+    struct Lane {
+        std::deque<Waiter*> queue;
+        size_t running = 0;
+        size_t limit = 0;
+        double pass = 0.0;     // Virtual time of the next admission
+        double stride = 1.0;   // 1 / weight
+        uint64_t admitted = 0;
+        double total_wait_us = 0.0;
+    };
+
+    mutable std::mutex mutex_;
+    QuerySchedulerConfig config_;
+    size_t capacity_ = 0;   // Resolved max_concurrency
+    size_t running_ = 0;
+    double virtual_time_ = 0.0;
+    std::array<Lane, kQueryPriorityCount> lanes_;
+
+    // Ingest throttling
+    size_t ingest_max_ = 0;   // Configured ingest limit
+    double interactive_latency_us_ = 0.0;
+    Clock::time_point last_interactive_;
+    Clock::time_point last_adjust_;
+    uint64_t throttle_events_ = 0;
+
+    void apply_config_locked(const QuerySchedulerConfig& config);
+    void dispatch_locked();
+    void release_slot(QueryPriority priority, Clock::time_point enqueued);
+    void adjust_ingest_locked(Clock::time_point now);
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_QUERY_SCHEDULER_HPP
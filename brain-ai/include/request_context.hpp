@@ -0,0 +1,83 @@
+#ifndef BRAIN_AI_REQUEST_CONTEXT_HPP
+#define BRAIN_AI_REQUEST_CONTEXT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+namespace brain_ai {
+
+// Deadline and cancellation token of one request.
+//
+// Long-running stages poll the context and stop once the caller has given
+// up: the deadline passed, or someone called cancel() (say the transport
+// saw the client disconnect). Copies share one token, so a context can be
+// handed to other threads and cancelled from outside.
+//
+// The default context never expires and checking it costs a null test,
+// so callers that pass none keep running to completion.
+class RequestContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RequestContext() = default;
+
+    // Expires after timeout (a non-positive timeout is already expired)
+    static RequestContext with_timeout(Clock::duration timeout);
+    static RequestContext with_deadline(Clock::time_point deadline);
+
+    // No deadline, but cancel() works
+    static RequestContext cancellable();
+
+    // Like with_deadline, but left out of the cancellation metrics: for a
+    // context standing in for requests that count themselves (a batch)
+    static RequestContext derived(Clock::time_point deadline);
+
+    // Cancel every copy of this context (no-op on the default context)
+    void cancel() const;
+
+    bool cancelled() const {
+        return state_ && state_->cancelled.load(std::memory_order_acquire);
+    }
+
+    // Cancelled or past the deadline
+    bool expired() const {
+        return state_ && (state_->cancelled.load(std::memory_order_acquire) ||
+                          Clock::now() >= state_->deadline);
+    }
+
+    // False for the default context (hot loops can skip polling)
+    bool can_expire() const { return state_ != nullptr; }
+
+    bool has_deadline() const { return state_ && state_->deadline != Clock::time_point::max(); }
+    Clock::time_point deadline() const { return state_ ? state_->deadline : Clock::time_point::max(); }
+
+    // Time left (duration::max() without a deadline, zero once expired)
+    Clock::duration remaining() const;
+
+    // Stop point of a stage: true once expired. The first stage to notice
+    // counts the request as cancelled (metrics requests_cancelled,
+    // requests_deadline_exceeded and cancelled_<stage>).
+    bool should_stop(const char* stage) const;
+
+    // Throws errors::CancelledError once should_stop(stage)
+    void check(const char* stage) const;
+
+private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> reported{false};
+        Clock::time_point deadline = Clock::time_point::max();
+    };
+
+    explicit RequestContext(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    bool deadline_exceeded() const;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_REQUEST_CONTEXT_HPP
@@ -0,0 +1,188 @@
+#ifndef BRAIN_AI_RESILIENCE_HEDGING_HPP
+#define BRAIN_AI_RESILIENCE_HEDGING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace brain_ai {
+
+class WorkPool;
+
+namespace resilience {
+
+// ============================================================================
+// Jittered Exponential Backoff
+// ============================================================================
+
+struct BackoffPolicy {
+    std::chrono::milliseconds base{100};     // Ceiling of the first retry's delay
+    std::chrono::milliseconds max{10000};    // Ceiling never grows past this
+    double multiplier = 2.0;
+};
+
+// "Full jitter": uniform in [0, min(max, base * multiplier^retry)], so
+// clients that failed together do not retry together. retry counts from 0.
+std::chrono::milliseconds backoff_delay(const BackoffPolicy& policy, size_t retry,
+                                        std::mt19937_64& rng);
+
+// ============================================================================
+// Latency Tracker
+// ============================================================================
+
+// Sliding window of recent latencies for percentile estimates
+class LatencyTracker {
+public:
+    explicit LatencyTracker(size_t window = 128);
+
+    void record(std::chrono::microseconds latency);
+
+    // Latency at percentile p in (0, 1], or nullopt with fewer than
+    // min_samples recorded
+    std::optional<std::chrono::microseconds> percentile(double p, size_t min_samples = 1) const;
+
+    size_t count() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::chrono::microseconds> samples_;
+    size_t window_;
+    size_t next_ = 0;
+};
+
+// ============================================================================
+// Hedged Requests
+// ============================================================================
+//
+// Runs an idempotent request against a set of interchangeable targets
+// (replicas). The first attempt goes to the next target in rotation; if it
+// is still running after the hedge delay (the configured percentile of
+// recently observed attempt latencies), a duplicate goes to another target
+// and the first success wins. Failed attempts are retried on the next
+// target after a jittered exponential backoff.
+//
+// Attempts run on the executor's own pool. Hedges, retries after their
+// backoff, the deadline and cancellation polls are driven by a timer
+// thread, so no thread sleeps through a backoff: a request advances when
+// an attempt finishes or a timer fires, and a backoff ends early when an
+// attempt still in flight succeeds. Losing attempts are cancelled, and a
+// request completes only once every attempt it launched has returned.
+// The latency of every attempt is recorded (a cancelled loser's run time
+// is a lower bound of its latency), so slow replicas that lose still
+// count towards the hedge delay.
+//
+// The caller may also give up: past the deadline, or once the cancelled
+// predicate turns true, no further attempt starts and the running ones are
+// cancelled the same way losers are.
+
+struct HedgingConfig {
+    size_t max_attempts = 3;       // Non-hedge attempts (first try + retries)
+    size_t max_hedges = 1;         // Duplicates per request (0 disables hedging)
+    double hedge_percentile = 0.95;
+    size_t min_samples = 20;       // Latencies needed before the percentile is trusted
+    std::chrono::milliseconds initial_hedge_delay{2000};   // Used until then
+    std::chrono::milliseconds min_hedge_delay{10};
+    BackoffPolicy backoff;
+    size_t attempt_threads = 0;    // Attempt pool (0 = hardware threads x (1 + max_hedges))
+};
+
+// Handed to each attempt. The executor cancels losing attempts; an attempt
+// that blocks in I/O registers a canceller that aborts it (e.g. closes its
+// socket).
+class AttemptContext {
+public:
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+    // Runs immediately if the attempt was already cancelled
+    void on_cancel(std::function<void()> canceller);
+
+    void cancel();
+
+private:
+    std::atomic<bool> cancelled_{false};
+    std::mutex mutex_;
+    std::function<void()> canceller_;
+};
+
+struct HedgedResult {
+    std::optional<std::string> value;   // Winning attempt's payload
+    size_t attempts = 0;                // Attempts launched, hedges included
+    size_t hedges = 0;                  // Of which hedges
+    size_t target = 0;                  // Target that answered
+    bool hedge_won = false;
+    bool abandoned = false;             // Caller's deadline passed or it cancelled
+};
+
+class HedgedExecutor {
+public:
+    // Returns the payload, or nullopt for a failed attempt
+    using Attempt = std::function<std::optional<std::string>(size_t target, AttemptContext& context)>;
+
+    HedgedExecutor(const HedgingConfig& config, size_t targets);
+    ~HedgedExecutor();   // Waits for attempts still running
+
+    HedgedExecutor(const HedgedExecutor&) = delete;
+    HedgedExecutor& operator=(const HedgedExecutor&) = delete;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Longest wait between checks of the cancelled predicate
+    static constexpr std::chrono::milliseconds kCancelPoll{10};
+
+    // Start a request; the future is ready once it is decided and all of
+    // its attempts have returned. attempt and cancelled are copied and
+    // called from pool and timer threads.
+    std::future<HedgedResult> execute_async(Attempt attempt,
+                                            Clock::time_point deadline = Clock::time_point::max(),
+                                            std::function<bool()> cancelled = nullptr);
+
+    // execute_async() and wait
+    HedgedResult execute(const Attempt& attempt,
+                         Clock::time_point deadline = Clock::time_point::max(),
+                         const std::function<bool()>& cancelled = nullptr);
+
+    // Delay after which an attempt is hedged right now
+    std::chrono::microseconds hedge_delay() const;
+
+    const LatencyTracker& latencies() const { return latencies_; }
+    const HedgingConfig& config() const { return config_; }
+    size_t targets() const { return targets_; }
+
+private:
+    struct Request;
+    class Timer;
+
+    HedgingConfig config_;
+    size_t targets_;
+    LatencyTracker latencies_;
+    std::atomic<size_t> next_target_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex rng_mutex_;
+    std::mt19937_64 rng_;
+
+    std::unique_ptr<Timer> timer_;
+    std::unique_ptr<WorkPool> pool_;
+
+    std::chrono::milliseconds next_backoff(size_t retry);
+
+    // Launch due attempts, decide the request or arm its next timer
+    void advance(const std::shared_ptr<Request>& request);
+    void launch(const std::shared_ptr<Request>& request, size_t target, bool hedge);
+    void finish_attempt(const std::shared_ptr<Request>& request, size_t target, bool hedge,
+                        std::optional<std::string> value);
+};
+
+} // namespace resilience
+} // namespace brain_ai
+
+#endif // BRAIN_AI_RESILIENCE_HEDGING_HPP
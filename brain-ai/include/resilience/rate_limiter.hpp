@@ -0,0 +1,114 @@
+#ifndef BRAIN_AI_RESILIENCE_RATE_LIMITER_HPP
+#define BRAIN_AI_RESILIENCE_RATE_LIMITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace brain_ai {
+namespace resilience {
+
+// ============================================================================
+// Rate Limiter
+// ============================================================================
+//
+// Per-key (client, tenant, ...) token buckets. Every key gets burst tokens
+// that refill at rate_per_second; a request costing more tokens than the
+// key has left is rejected.
+//
+// A bucket is a single 64-bit word holding a tag of the key's hash and the
+// bucket's "theoretical arrival time": the monotonic time at which it would
+// be full again. Refill is lazy, computed from that time on each request,
+// and a request is one compare-and-swap on the word, so acquisition never
+// takes a lock. Buckets are padded to a cache line, and keys hash to one of
+// several shards, each a small open-addressed table.
+//
+// Buckets are not freed; a full bucket holds no state, so its slot is
+// reused by the next new key that probes it. A key whose probed slots all
+// hold buckets that are still refilling is charged to its shard's shared
+// overflow bucket and counted as an overflow, so a crowded table throttles
+// harder instead of letting keys through (size buckets_per_shard for the
+// number of active keys). Keys are told apart by the shard, slot and a
+// 16-bit tag of their hash; keys that collide in all three share a bucket.
+//
+// Decisions are counted in the bucket that made them, on the cache line
+// the request already touched, and summed across buckets by stats().
+
+struct RateLimiterConfig {
+    double rate_per_second = 10.0;    // Sustained refill per key
+    double burst = 20.0;              // Bucket capacity in tokens
+    size_t shards = 16;               // Rounded up to a power of two
+    size_t buckets_per_shard = 1024;  // Rounded up to a power of two
+    size_t max_probes = 8;            // Slots examined per lookup
+};
+
+struct RateLimitDecision {
+    bool allowed = false;
+    double remaining = 0.0;                      // Tokens left after this request
+    std::chrono::microseconds retry_after{0};    // Until the request would fit (when rejected)
+};
+
+struct RateLimiterStats {
+    uint64_t allowed = 0;
+    uint64_t rejected = 0;
+    uint64_t overflows = 0;   // Requests charged to an overflow bucket
+};
+
+class RateLimiter {
+public:
+    explicit RateLimiter(const RateLimiterConfig& config = RateLimiterConfig());
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Take cost tokens from the key's bucket if it has them
+    bool try_acquire(std::string_view key, double cost = 1.0) {
+        return acquire(key, cost).allowed;
+    }
+
+    RateLimitDecision acquire(std::string_view key, double cost = 1.0) {
+        return acquire_hashed(hash_key(key), cost);
+    }
+
+    // For callers that key by an id they already hashed
+    RateLimitDecision acquire_hashed(uint64_t key_hash, double cost = 1.0);
+
+    static uint64_t hash_key(std::string_view key);
+
+    RateLimiterStats stats() const;
+    const RateLimiterConfig& config() const { return config_; }
+
+    // Total bucket slots
+    size_t capacity() const { return shard_count_ * buckets_per_shard_; }
+
+private:
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> state{0};   // 0 = never used
+        std::atomic<uint64_t> allowed{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    struct alignas(64) Shard {
+        std::unique_ptr<Bucket[]> buckets;
+        Bucket overflow;   // Shared by keys that find no slot
+    };
+
+    RateLimiterConfig config_;
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    size_t shard_bits_;
+    size_t buckets_per_shard_;
+    double interval_us_;      // Refill time of one token
+    uint64_t tolerance_us_;   // Refill time of a full bucket
+    std::chrono::steady_clock::time_point epoch_;
+
+    uint64_t now_us() const;
+};
+
+} // namespace resilience
+} // namespace brain_ai
+
+#endif // BRAIN_AI_RESILIENCE_RATE_LIMITER_HPP
@@ -0,0 +1,109 @@
+#ifndef BRAIN_AI_SEMANTIC_ACTIVATION_HPP
+#define BRAIN_AI_SEMANTIC_ACTIVATION_HPP
+
+#include "request_context.hpp"
+#include "semantic_graph.hpp"
+#include "work_pool.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace brain_ai {
+
+// Activation spreading algorithm
+enum class ActivationMode {
+    BFS,                    // Hop-limited BFS with multiplicative decay
+    PersonalizedPageRank    // Local push-based PPR (Andersen-Chung-Lang)
+};
+
+struct ActivationConfig {
+    ActivationMode mode = ActivationMode::BFS;
+    float activation_threshold = 0.1f;  // Minimum reported activation
+    
+    // BFS
+    size_t max_hops = 3;
+    float decay_factor = 0.7f;
+    
+    // Levels whose frontier has at least this many nodes are expanded in
+    // parallel on the work pool (0 = always sequential)
+    size_t parallel_frontier_threshold = 4096;
+    
+    // PPR: restart probability and residual tolerance. Work is bounded by
+    // O(1 / (ppr_epsilon * ppr_alpha)) pushes regardless of graph size;
+    // max_hops is ignored. Scores are normalized so the strongest node is 1.
+    float ppr_alpha = 0.15f;
+    float ppr_epsilon = 1e-4f;
+};
+
+// Sparse activation levels: (node id, activation) pairs in no particular order
+using ActivationList = std::vector<std::pair<uint32_t, float>>;
+
+// Level-synchronous BFS spreading activation: sources start at 1.0 and
+// each hop multiplies by decay_factor * edge weight. A node expands once,
+// in the level after it is first reached, carrying the maximum over its
+// parents in that level; stronger paths found later only raise its own
+// activation.
+//
+// Once a frontier reaches parallel_frontier_threshold the remaining
+// levels switch to dense per-node state and run on the shared work pool
+// (if it has more than one thread): top-down levels push from frontier
+// chunks with an atomic max-merge, and levels whose frontier out-edges
+// cover a large share of the graph pull over incoming edges instead
+// (direction-optimizing). Results are identical to the sequential run.
+//
+// The context is checked before each level; an expired request throws
+// errors::CancelledError.
+ActivationList bfs_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             const RequestContext& context = RequestContext());
+
+// Same, with large levels expanded on the given pool regardless of its size
+ActivationList bfs_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             WorkPool& pool);
+
+// Push-based Personalized PageRank with restart mass split evenly over
+// sources. A node is pushed while its residual is at least
+// ppr_epsilon * out-degree; each push keeps ppr_alpha of the residual and
+// spreads the rest over out-edges in proportion to their weights
+// (dangling nodes keep all of it). Sources are always pushed once.
+// Returns estimates scaled to a maximum of 1 and filtered by
+// activation_threshold. The context is checked every kCancelCheckPushes
+// pushes.
+ActivationList ppr_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             const RequestContext& context = RequestContext());
+
+constexpr size_t kCancelCheckPushes = 256;
+
+// Dispatch on config.mode
+ActivationList compute_activation(const SemanticGraph& graph,
+                                 const std::vector<uint32_t>& sources,
+                                 const ActivationConfig& config,
+                                 const RequestContext& context = RequestContext());
+
+// Largest batch served by one batched BFS sweep
+constexpr size_t kMaxActivationBatch = 64;
+
+// BFS for up to kMaxActivationBatch queries in one graph sweep, with the
+// same results as bfs_activation per query. Each touched node carries a
+// 64-bit mask of the queries that reached it and their activations in
+// 8-lane blocks (allocated per lane group that reaches the node), so one
+// edge relaxation updates a whole group of queries at once. Throws
+// std::invalid_argument for larger batches.
+std::vector<ActivationList> batch_bfs_activation(const SemanticGraph& graph,
+                                                const std::vector<std::vector<uint32_t>>& batch_sources,
+                                                const ActivationConfig& config);
+
+// Any batch size: BFS runs in sweeps of kMaxActivationBatch queries,
+// PPR runs per query
+std::vector<ActivationList> compute_activation_batch(const SemanticGraph& graph,
+                                                    const std::vector<std::vector<uint32_t>>& batch_sources,
+                                                    const ActivationConfig& config);
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_SEMANTIC_ACTIVATION_HPP
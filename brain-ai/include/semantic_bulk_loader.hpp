@@ -0,0 +1,72 @@
+#ifndef BRAIN_AI_SEMANTIC_BULK_LOADER_HPP
+#define BRAIN_AI_SEMANTIC_BULK_LOADER_HPP
+
+#include "semantic_graph.hpp"
+#include <memory>
+#include <string>
+
+namespace brain_ai {
+
+// On-disk edge list layouts
+//   TSV/CSV: "source<sep>target[<sep>weight]" per line; blank lines and
+//            lines starting with '#' are ignored
+//   Binary:  packed little-endian records {uint32 source, uint32 target,
+//            float32 weight}; names come from names_path (one per line,
+//            line number = id) or default to the decimal id. Ids are
+//            checked against max_nodes before any per-node allocation.
+enum class EdgeListFormat {
+    Auto,      // By extension: .csv -> CSV, .bin -> Binary, else TSV
+    TSV,
+    CSV,
+    Binary
+};
+
+struct BulkLoadOptions {
+    EdgeListFormat format = EdgeListFormat::Auto;
+    size_t num_threads = 0;           // 0 = hardware concurrency
+    bool skip_header = false;         // Text formats: ignore the first line
+    float default_weight = 1.0f;      // Text formats: weight when the column is missing
+    std::string names_path;           // Binary format: optional concept names
+    size_t max_nodes = 0;             // Binary format: ids must be below this; 0 = the
+                                      // names file's entry count, or 2 * records without one
+};
+
+struct BulkLoadStats {
+    size_t nodes = 0;
+    size_t edges = 0;                 // Unique edges after dedupe
+    size_t records = 0;               // Edge records parsed
+    size_t skipped = 0;               // Malformed lines
+    size_t threads = 0;
+    double parse_seconds = 0.0;       // Parse + intern
+    double build_seconds = 0.0;       // CSR construction
+    double total_seconds = 0.0;
+    double edges_per_sec = 0.0;       // records / total_seconds
+};
+
+// Memory-maps an edge list, parses newline-aligned chunks in parallel
+// (each thread interns names into a local table), merges the tables
+// into dense global ids and builds the CSR graph in one counting-sort
+// pass.
+class SemanticBulkLoader {
+public:
+    explicit SemanticBulkLoader(BulkLoadOptions options = {});
+    
+    // Throws errors::SemanticNetworkError on I/O or format errors
+    std::shared_ptr<const SemanticGraph> load(const std::string& path);
+    
+    const BulkLoadStats& stats() const { return stats_; }
+    
+    static EdgeListFormat detect_format(const std::string& path);
+    
+private:
+    BulkLoadOptions options_;
+    BulkLoadStats stats_;
+    
+    size_t resolve_threads(size_t bytes) const;
+    std::shared_ptr<const SemanticGraph> load_text(const std::string& path, char separator);
+    std::shared_ptr<const SemanticGraph> load_binary(const std::string& path);
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_SEMANTIC_BULK_LOADER_HPP
@@ -0,0 +1,137 @@
+#ifndef BRAIN_AI_SEMANTIC_GRAPH_HPP
+#define BRAIN_AI_SEMANTIC_GRAPH_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brain_ai {
+
+// Edge between interned concept ids (used while building a graph)
+struct EdgeRecord {
+    uint32_t source;
+    uint32_t target;
+    float weight;
+};
+
+// Immutable CSR (compressed sparse row) view of a semantic graph.
+//
+// Concepts are interned to dense uint32 ids. Outgoing edges of node u
+// are targets()/weights() in [edge_begin(u), edge_end(u)), sorted by
+// target. Names live in one string table with a stable open-addressing
+// hash index, and embeddings (if any) in one dim-strided block. All
+// arrays are flat, so the same layout can be backed by owned vectors
+// or by a read-only file mapping.
+//
+// Snapshot file (version 1, native byte order): a fixed header followed
+// by 64-byte aligned sections in the in-memory layout: CSR offsets,
+// targets, weights, string offsets, string data, name hash slots,
+// embedding flags and the embedding block.
+class SemanticGraph {
+public:
+    static constexpr uint32_t kInvalidId = std::numeric_limits<uint32_t>::max();
+
+    // Build from interned names and an unsorted edge list with a counting
+    // sort by source. Duplicate (source, target) pairs keep the weight
+    // that appears last. embeddings is empty or has one (possibly empty)
+    // vector per node; non-empty vectors must share one dimension.
+    static std::shared_ptr<const SemanticGraph> build(
+        std::vector<std::string> names,
+        std::vector<EdgeRecord> edges,
+        std::vector<std::vector<float>> embeddings = {});
+
+    // Empty graph
+    static std::shared_ptr<const SemanticGraph> empty();
+
+    uint32_t num_nodes() const { return num_nodes_; }
+    uint64_t num_edges() const { return num_edges_; }
+
+    // Concept lookup (kInvalidId if absent)
+    uint32_t find(std::string_view name) const;
+    std::string_view name(uint32_t id) const;
+
+    // Adjacency
+    uint64_t edge_begin(uint32_t id) const { return offsets_[id]; }
+    uint64_t edge_end(uint32_t id) const { return offsets_[id + 1]; }
+    uint32_t degree(uint32_t id) const {
+        return static_cast<uint32_t>(offsets_[id + 1] - offsets_[id]);
+    }
+    const uint64_t* offsets() const { return offsets_; }
+    const uint32_t* targets() const { return targets_; }
+    const float* weights() const { return weights_; }
+    
+    // Incoming edges (CSR of the transposed graph, rows sorted by source),
+    // built on first use and cached for the lifetime of the graph
+    struct ReverseEdges {
+        std::vector<uint64_t> offsets;   // num_nodes + 1
+        std::vector<uint32_t> sources;
+        std::vector<float> weights;
+    };
+    const ReverseEdges& reverse_edges() const;
+
+    // Embeddings (nullptr if the node has none)
+    uint32_t embedding_dim() const { return embedding_dim_; }
+    const float* embedding(uint32_t id) const;
+
+    // Stable 64-bit FNV-1a hash used by the name index
+    static uint64_t hash_name(std::string_view name);
+    
+    // Persistence. save_to_file writes a temporary file and renames it
+    // over path, so processes mapping the previous snapshot are not
+    // disturbed. load_from_file maps the snapshot read-only (pages are
+    // shared between processes) after validating the header and the
+    // graph structure. Both throw errors::SemanticNetworkError.
+    static constexpr uint32_t kSnapshotVersion = 1;
+    void save_to_file(const std::string& path) const;
+    static std::shared_ptr<const SemanticGraph> load_from_file(const std::string& path);
+    
+    // True when the arrays are backed by a file mapping
+    bool is_mapped() const { return mapped_; }
+
+private:
+    SemanticGraph() = default;
+
+    // Owned backing arrays (unused when mapped from a snapshot)
+    struct Storage {
+        std::vector<uint64_t> offsets;
+        std::vector<uint32_t> targets;
+        std::vector<float> weights;
+        std::vector<char> string_data;
+        std::vector<uint64_t> string_offsets;
+        std::vector<uint32_t> hash_slots;      // id + 1, 0 = empty
+        std::vector<float> embeddings;
+        std::vector<uint8_t> has_embedding;
+    };
+
+    uint32_t num_nodes_ = 0;
+    uint64_t num_edges_ = 0;
+    uint32_t embedding_dim_ = 0;
+    uint64_t hash_mask_ = 0;
+    bool mapped_ = false;
+
+    const uint64_t* offsets_ = nullptr;         // num_nodes + 1
+    const uint32_t* targets_ = nullptr;         // num_edges
+    const float* weights_ = nullptr;            // num_edges
+    const char* string_data_ = nullptr;
+    const uint64_t* string_offsets_ = nullptr;  // num_nodes + 1
+    const uint32_t* hash_slots_ = nullptr;      // hash_mask + 1
+    const float* embeddings_ = nullptr;         // num_nodes * embedding_dim
+    const uint8_t* has_embedding_ = nullptr;    // num_nodes (when embedding_dim > 0)
+
+    std::shared_ptr<const void> backing_;       // Keeps storage/mapping alive
+    
+    mutable std::once_flag reverse_once_;
+    mutable std::unique_ptr<ReverseEdges> reverse_;
+
+    void attach(std::shared_ptr<Storage> storage);
+    static std::vector<uint32_t> build_hash_index(const std::vector<char>& string_data,
+                                                  const std::vector<uint64_t>& string_offsets);
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_SEMANTIC_GRAPH_HPP
@@ -1,12 +1,19 @@
 #ifndef BRAIN_AI_SEMANTIC_NETWORK_HPP
 #define BRAIN_AI_SEMANTIC_NETWORK_HPP
 
+#include "activation_cache.hpp"
+#include "semantic_activation.hpp"
+#include "semantic_bulk_loader.hpp"
+#include "semantic_graph.hpp"
 #include <unordered_map>
 #include <vector>
 #include <string>
 #include <queue>
 #include <optional>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <tuple>
 
 namespace brain_ai {
 
@@ -24,12 +31,30 @@ struct SemanticNode {
         : concept(c), embedding(emb) {}
 };
 
-// Directed weighted graph with spreading activation
+// Directed weighted graph with spreading activation.
+//
+// Adjacency lives in an immutable CSR SemanticGraph. add_node/add_edge/
+// add_edges buffer their edits, and the first read that finds any merges
+// them into a fresh CSR (one O(V+E) rebuild), so every read sees the
+// writes before it. Bulk writers batch their edits with add_edges() and
+// merge them with commit(); a background task on the shared WorkPool
+// also merges once commit_threshold edits are pending. The rebuild runs
+// outside the lock and is swapped in; edits made meanwhile stay pending
+// for the next one. Traversals run on the shared CSR snapshot without
+// holding the lock.
+//
+// Activation results are memoized per graph version (see
+// ActivationCache); each commit bumps the version and so invalidates them.
 class SemanticNetwork {
 public:
+    // Pending edits that trigger a background commit by default
+    static constexpr size_t kDefaultCommitThreshold = 65536;
+    
     SemanticNetwork() = default;
+    ~SemanticNetwork();   // Waits for a background commit in flight
     
-    // Add node (concept)
+    // Add node (concept). Node embeddings must share one dimension
+    // (throws std::invalid_argument otherwise)
     void add_node(const std::string& concept,
                   const std::vector<float>& embedding = {});
     
@@ -38,6 +63,19 @@ public:
                   const std::string& target,
                   float weight = 1.0f);
     
+    // Add many edges at once (e.g. mined relations) under one lock
+    void add_edges(const std::vector<std::tuple<std::string, std::string, float>>& relations);
+    
+    // Merge pending edits now rather than on the next read (a rebuild in
+    // flight is waited for first)
+    void commit();
+    
+    // Pending edits that schedule a background commit (0 = commit() only)
+    void set_commit_threshold(size_t edits);
+    
+    // Nodes and edges added since the last commit
+    size_t pending_edits() const;
+    
     // Spreading activation: BFS with exponential decay
     std::vector<std::pair<std::string, float>> spread_activation(
         const std::vector<std::string>& source_concepts,
@@ -46,6 +84,23 @@ public:
         float activation_threshold = 0.1f
     );
     
+    // Spreading activation with an explicit algorithm (see ActivationConfig).
+    // Throws errors::CancelledError if the context has expired, even on a
+    // cache hit, or expires mid-traversal (nothing is cached then).
+    std::vector<std::pair<std::string, float>> spread_activation(
+        const std::vector<std::string>& source_concepts,
+        const ActivationConfig& config,
+        const RequestContext& context = RequestContext()
+    );
+    
+    // Spreading activation for many queries at once (BFS shares graph
+    // sweeps across up to 64 queries). Results match per-query calls, but
+    // node activation levels are left unchanged.
+    std::vector<std::vector<std::pair<std::string, float>>> spread_activation_batch(
+        const std::vector<std::vector<std::string>>& batch_concepts,
+        const ActivationConfig& config = ActivationConfig()
+    ) const;
+    
     // Find related concepts by embedding similarity
     std::vector<std::string> find_similar_concepts(
         const std::vector<float>& query_embedding,
@@ -63,12 +118,66 @@ public:
     size_t num_nodes() const;
     size_t num_edges() const;
     
-    // Get node (const)
-    std::optional<const SemanticNode*> get_node(const std::string& concept) const;
+    // Node materialized from its CSR row; the snapshot does not change
+    // with later edits
+    std::optional<std::shared_ptr<const SemanticNode>> get_node(const std::string& concept) const;
+    
+    // Bulk load an edge list (see SemanticBulkLoader). An empty network
+    // adopts the loaded graph directly; otherwise its edges are merged
+    // and committed along with any pending edits.
+    BulkLoadStats load_edge_list(const std::string& path,
+                                 const BulkLoadOptions& options = {});
+    
+    // Persistence via SemanticGraph snapshots. Loading replaces the graph
+    // and resets activations; the loaded graph stays mapped until the next
+    // edit is merged.
+    void save_to_file(const std::string& filepath) const;
+    void load_from_file(const std::string& filepath);
+    
+    // Current graph, pending edits merged
+    std::shared_ptr<const SemanticGraph> graph() const;
+    
+    // Edit version, bumped by every edit or load
+    uint64_t version() const;
+    
+    // Activation result cache budget in bytes (0 disables the cache)
+    void set_activation_cache_bytes(size_t max_bytes);
+    ActivationCacheStats activation_cache_stats() const;
     
 private:
-    std::unordered_map<std::string, SemanticNode> nodes_;
-    mutable std::mutex mutex_;  // Thread safety
+    mutable std::shared_ptr<const SemanticGraph> graph_ = SemanticGraph::empty();
+    
+    // Edits not yet merged into graph_; new ids continue after graph_'s
+    mutable std::vector<std::string> new_names_;
+    mutable std::vector<std::vector<float>> new_embeddings_;
+    mutable std::unordered_map<std::string, uint32_t> new_ids_;
+    mutable std::vector<EdgeRecord> pending_edges_;
+    mutable uint32_t compiling_nodes_ = 0;   // New nodes taken by a rebuild in flight (still in new_ids_)
+    uint32_t embedding_dim_ = 0;
+    uint64_t version_ = 0;
+    mutable uint64_t graph_version_ = 0;     // version_ that graph_ reflects
+    size_t commit_threshold_ = kDefaultCommitThreshold;
+    bool commit_scheduled_ = false;          // Background commit queued or running
+    bool closing_ = false;                   // Destructor waiting; skip further commits
+    std::condition_variable commit_done_;    // Signalled when commit_scheduled_ clears
+    
+    mutable ActivationCache cache_;
+    
+    // Activation level by node id; touched_ lists the non-zero entries
+    std::vector<float> activations_;
+    std::vector<uint32_t> touched_;
+    
+    mutable std::mutex mutex_;          // Thread safety
+    mutable std::mutex rebuild_mutex_;  // Serializes rebuilds and loads (taken before mutex_)
+    
+    uint32_t find_locked(const std::string& concept) const;
+    uint32_t intern_locked(const std::string& concept);
+    size_t pending_locked() const;
+    void compile() const;               // Requires rebuild_mutex_, not mutex_
+    void maybe_schedule_commit_locked();
+    void background_commit();
+    void clear_activations_locked();
+    std::shared_ptr<const SemanticGraph> snapshot(uint64_t& version) const;   // Merges pending edits
 };
 
 } // namespace brain_ai
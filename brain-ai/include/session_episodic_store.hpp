@@ -0,0 +1,153 @@
+#ifndef BRAIN_AI_SESSION_EPISODIC_STORE_HPP
+#define BRAIN_AI_SESSION_EPISODIC_STORE_HPP
+
+#include "episodic_buffer.hpp"
+#include "episodic_consolidator.hpp"
+#include "monitoring/memory_pressure.hpp"
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brain_ai {
+
+// Configuration for the session-partitioned episodic store
+struct SessionStoreConfig {
+    size_t num_shards = 16;                          // Independent lock domains
+    size_t session_capacity = 128;                   // Ring size per session
+    size_t memory_budget_bytes = 256 * 1024 * 1024;  // Named sessions' budget (0 = unlimited)
+    ConsolidationConfig consolidation;               // Per-session centroid consolidation
+    EmbeddingStorageConfig embedding_storage;        // fp32 or int8 episode embeddings
+    std::chrono::milliseconds consolidation_interval{1000};
+
+    SessionStoreConfig() = default;
+    
+    explicit SessionStoreConfig(size_t capacity_per_session)
+        : session_capacity(capacity_per_session) {}
+};
+
+// Episodic memory partitioned by session/user id.
+//
+// Each session owns its own EpisodicBuffer ring, so retrieval only scans
+// that session's episodes (O(session_capacity)) and never returns other
+// users' context. Sessions are spread over sharded maps with one mutex
+// per shard; the shard lock is held only for lookup, never for a scan.
+// When the approximate footprint of named sessions exceeds the memory
+// budget, the least recently used ones are evicted. The empty session id
+// addresses a pinned default session that is never evicted; its ring
+// (session_capacity) caps it instead, so it does not count toward the
+// budget.
+//
+// Under memory pressure the budget is scaled down by
+// memory_pressure_budget_factor() (an unlimited budget is capped at the
+// usage when pressure set in) and LRU sessions are evicted right away.
+class SessionEpisodicStore {
+public:
+    explicit SessionEpisodicStore(const SessionStoreConfig& config = SessionStoreConfig());
+    ~SessionEpisodicStore();
+
+    // Non-copyable (contains mutexes)
+    SessionEpisodicStore(const SessionEpisodicStore&) = delete;
+    SessionEpisodicStore& operator=(const SessionEpisodicStore&) = delete;
+
+    // Add episode to the session's ring (creates the session on first use)
+    void add_episode(const std::string& session_id,
+                     const std::string& query,
+                     const std::string& response,
+                     const std::vector<float>& query_embedding,
+                     const std::unordered_map<std::string, std::string>& metadata = {});
+
+    // Add prepared episodes to a session in one batch (keeps their order)
+    void add_episodes(const std::string& session_id, std::vector<Episode> episodes);
+
+    // Retrieve k most similar episodes from this session only
+    std::vector<Episode> retrieve_similar(
+        const std::string& session_id,
+        const std::vector<float>& query_embedding,
+        size_t top_k = 5,
+        float similarity_threshold = 0.7f,
+        const RequestContext& context = RequestContext()
+    );
+
+    // Most recent episodes of a session
+    std::vector<Episode> get_recent(const std::string& session_id, size_t count);
+
+    // Buffer for a session (nullptr if it does not exist)
+    std::shared_ptr<EpisodicBuffer> find_session(const std::string& session_id) const;
+
+    // Pinned default session buffer
+    EpisodicBuffer& default_buffer() { return *default_buffer_; }
+    const EpisodicBuffer& default_buffer() const { return *default_buffer_; }
+
+    // Drop a single session (the default session is cleared instead)
+    void clear_session(const std::string& session_id);
+
+    // Drop all sessions
+    void clear();
+
+    // Stats
+    size_t size() const;                                  // Episodes across sessions
+    size_t session_size(const std::string& session_id) const;
+    size_t session_count() const;                         // Excludes default session
+    size_t memory_usage_bytes() const;                    // Including the default session
+    size_t memory_budget_bytes() const { return budget_bytes_.load(std::memory_order_relaxed); }
+    size_t evicted_sessions() const { return evicted_sessions_.load(std::memory_order_relaxed); }
+    const SessionStoreConfig& config() const { return config_; }
+    EpisodicConsolidator* consolidator() { return consolidator_.get(); }
+
+    // Scale the budget for a pressure level and evict down to it. Called
+    // by the process-wide MemoryPressureMonitor.
+    void on_memory_pressure(monitoring::MemoryPressureLevel level);
+
+private:
+    struct SessionEntry {
+        std::shared_ptr<EpisodicBuffer> buffer;
+        std::list<std::string>::iterator lru_pos;
+        uint64_t last_access = 0;
+        size_t accounted_bytes = 0;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, SessionEntry> sessions;
+        std::list<std::string> lru;   // Front = most recently used
+    };
+
+    SessionStoreConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::shared_ptr<EpisodicBuffer> default_buffer_;
+
+    std::atomic<uint64_t> access_clock_{0};
+    std::atomic<int64_t> total_bytes_{0};   // Partitioned sessions only
+    std::atomic<size_t> evicted_sessions_{0};
+    std::atomic<size_t> budget_bytes_;   // Effective budget (0 = unlimited)
+    size_t pressure_base_bytes_ = 0;     // Usage when pressure set in (unlimited budget only)
+
+    // Background consolidation of session buffers (null when disabled)
+    std::unique_ptr<EpisodicConsolidator> consolidator_;
+
+    // Tightens budget_bytes_ under pressure; reset first in the destructor
+    monitoring::MemoryPressureSubscription pressure_subscription_;
+
+    Shard& shard_for(const std::string& session_id) const;
+
+    // Lookup (and optionally create) a session, bumping it to MRU
+    std::shared_ptr<EpisodicBuffer> acquire(const std::string& session_id, bool create);
+
+    // Re-sync accounted bytes of a session after a write
+    void account(const std::string& session_id, const std::shared_ptr<EpisodicBuffer>& buffer);
+
+    // Accounted bytes of named sessions (what the budget limits)
+    size_t session_bytes() const;
+
+    // Evict least recently used sessions until under budget
+    void enforce_budget(const std::string& keep_session_id);
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_SESSION_EPISODIC_STORE_HPP
@@ -0,0 +1,116 @@
+#ifndef BRAIN_AI_SINGLE_FLIGHT_HPP
+#define BRAIN_AI_SINGLE_FLIGHT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace brain_ai {
+
+struct SingleFlightStats {
+    uint64_t executions = 0;   // Calls that ran the work
+    uint64_t coalesced = 0;    // Calls that waited on another call's result
+};
+
+// Collapses concurrent calls for the same key into one execution.
+//
+// The first caller for a key runs the work; callers arriving while it is
+// in flight wait on a shared future and get the same immutable result (or
+// the same exception). The key is forgotten as soon as the work finishes,
+// so nothing is cached: a later call runs again. A result cache composes
+// by checking itself first and inserting what run() returns.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SingleFlight {
+public:
+    using Result = std::shared_ptr<const Value>;
+
+    SingleFlight() = default;
+
+    // Non-copyable (callers hold futures into the in-flight table)
+    SingleFlight(const SingleFlight&) = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    // Run fn() for key, or join the call already running it. joined (if
+    // given) reports whether this call waited on another one.
+    template <typename Fn>
+    Result run(const Key& key, Fn&& fn, bool* joined = nullptr) {
+        return run(key, std::forward<Fn>(fn), joined, []() {}, std::chrono::milliseconds(0));
+    }
+
+    // Same, but a joined call runs poll() every poll_interval while it
+    // waits; poll() throws to stop waiting. The work keeps running for
+    // the leader and any other waiters.
+    template <typename Fn, typename Poll>
+    Result run(const Key& key, Fn&& fn, bool* joined, Poll&& poll,
+               std::chrono::milliseconds poll_interval) {
+        std::promise<Result> promise;
+        std::shared_future<Result> future;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = in_flight_.find(key);
+            if (it != in_flight_.end()) {
+                future = it->second;
+            } else {
+                future = promise.get_future().share();
+                in_flight_.emplace(key, future);
+                leader = true;
+            }
+        }
+        if (joined) {
+            *joined = !leader;
+        }
+
+        if (!leader) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            if (poll_interval.count() > 0) {
+                while (future.wait_for(poll_interval) != std::future_status::ready) {
+                    poll();
+                }
+            }
+            return future.get();
+        }
+
+        executions_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            promise.set_value(std::make_shared<const Value>(std::forward<Fn>(fn)()));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_flight_.erase(key);
+        }
+        return future.get();
+    }
+
+    // Keys currently executing
+    size_t in_flight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return in_flight_.size();
+    }
+
+    SingleFlightStats stats() const {
+        SingleFlightStats stats;
+        stats.executions = executions_.load(std::memory_order_relaxed);
+        stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::shared_future<Result>, Hash> in_flight_;
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> coalesced_{0};
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_SINGLE_FLIGHT_HPP
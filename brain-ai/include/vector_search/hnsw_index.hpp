@@ -7,8 +7,12 @@
 #include <unordered_map>
 #include <nlohmann/json.hpp>
 #include <hnswlib/hnswlib.h>
+#include "request_context.hpp"
 
 namespace brain_ai {
+
+class WorkPool;
+
 namespace vector_search {
 
 /**
@@ -43,6 +47,18 @@ struct DocumentMetadata {
         : doc_id(id), content(text), metadata(meta), internal_id(iid) {}
 };
 
+/**
+ * SearchCost reports the graph work done by one search
+ * 
+ * Counts come from hnswlib's own metrics, which cover the greedy descent
+ * through the upper layers (the base-layer beam search is not counted).
+ */
+struct SearchCost {
+    size_t hops = 0;                   // Neighbor lists visited
+    size_t distance_computations = 0;  // Distances evaluated on those lists
+    size_t ef_search = 0;              // Beam width used
+};
+
 /**
  * IndexStatistics provides metrics about the index
  */
@@ -132,10 +148,33 @@ public:
      * Search for similar documents
      * @param query Query embedding vector
      * @param top_k Number of results to return
+     * @param cost Optional output for the search's graph work
+     * @param context Request deadline, checked every 64 base-layer hops;
+     *        throws errors::CancelledError once it expires
      * @return Vector of search results sorted by similarity (highest first)
      */
     std::vector<SearchResult> search(const std::vector<float>& query,
-                                    size_t top_k = 10);
+                                    size_t top_k = 10,
+                                    SearchCost* cost = nullptr,
+                                    const RequestContext& context = RequestContext());
+    
+    /**
+     * Search for several queries under one lock
+     * 
+     * The queries are validated and normalized together into one buffer,
+     * then searched on the pool (on the calling thread when it is null).
+     * Each query gets the results search() would return for it.
+     * @param queries Query embedding vectors
+     * @param top_k Number of results per query
+     * @param cost Optional output for the graph work of the whole batch
+     * @param pool Work pool to spread the queries over (nullptr = serial)
+     * @return One result list per query, in query order
+     */
+    std::vector<std::vector<SearchResult>> search_batch(
+        const std::vector<std::vector<float>>& queries,
+        size_t top_k = 10,
+        SearchCost* cost = nullptr,
+        WorkPool* pool = nullptr);
     
     /**
      * Remove a document from the index
@@ -234,6 +273,7 @@ private:
      * @param vec Vector to normalize
      */
     void normalize_vector(std::vector<float>& vec) const;
+    void normalize_vector(float* vec, size_t size) const;
     
     /**
      * Convert Inner Product distance to cosine similarity
@@ -241,6 +281,15 @@ private:
      * @return Cosine similarity in [0, 1]
      */
     float ip_to_similarity(float ip_distance) const;
+    
+    /**
+     * Convert a searchKnn result queue to results, highest similarity first
+     * (caller holds mutex_; only reads, so concurrent calls are safe)
+     * @param result Result queue from HNSWlib
+     * @return Search results
+     */
+    std::vector<SearchResult> to_search_results(
+        std::priority_queue<std::pair<float, hnswlib::labeltype>> result) const;
 };
 
 /**
@@ -0,0 +1,56 @@
+#ifndef BRAIN_AI_WORK_POOL_HPP
+#define BRAIN_AI_WORK_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace brain_ai {
+
+// Fixed-size pool of worker threads shared by CPU-bound kernels.
+//
+// submit() queues a fire-and-forget task. parallel_for() splits a range
+// into grain-sized chunks that workers and the calling thread claim from
+// an atomic cursor; it returns once every chunk has run, without waiting
+// for workers that are still busy elsewhere, so it is safe to call from
+// inside a pool task.
+class WorkPool {
+public:
+    explicit WorkPool(size_t num_threads = 0);   // 0 = hardware concurrency
+    ~WorkPool();                                 // Finishes queued tasks, then stops
+
+    // Non-copyable (owns worker threads)
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    // Number of worker threads
+    size_t size() const { return workers_.size(); }
+
+    void submit(std::function<void()> task);
+
+    // Run body(begin, end) over [0, count) in chunks of at most grain
+    // items. The first exception thrown by a chunk is rethrown here after
+    // all chunks have finished.
+    void parallel_for(size_t count, size_t grain,
+                      const std::function<void(size_t, size_t)>& body);
+
+    // Process-wide pool sized to the hardware
+    static WorkPool& shared();
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    void worker_loop();
+};
+
+} // namespace brain_ai
+
+#endif // BRAIN_AI_WORK_POOL_HPP
@@ -0,0 +1,223 @@
+#include "activation_cache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace brain_ai {
+
+namespace {
+
+uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void hash_combine(size_t& seed, uint64_t value) {
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+// Rough heap footprint of an entry (the key is held by the LRU slot and
+// the index; node overhead included)
+size_t estimate_bytes(const ActivationCacheKey& key, const ActivationCache::Entry& entry) {
+    size_t bytes = 2 * (sizeof(ActivationCacheKey) + key.sources.capacity() * sizeof(uint32_t));
+    bytes += sizeof(ActivationCache::Entry) + 64;
+    bytes += entry.activations.capacity() * sizeof(ActivationList::value_type);
+    bytes += entry.ranked.capacity() * sizeof(ActivationCache::Ranked::value_type);
+    for (const auto& [name, activation] : entry.ranked) {
+        if (name.capacity() > 15) {   // Beyond the small-string buffer
+            bytes += name.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+bool ActivationCacheKey::operator==(const ActivationCacheKey& other) const {
+    return sources == other.sources && mode == other.mode && max_hops == other.max_hops &&
+           float_bits(decay_factor) == float_bits(other.decay_factor) &&
+           float_bits(activation_threshold) == float_bits(other.activation_threshold) &&
+           float_bits(ppr_alpha) == float_bits(other.ppr_alpha) &&
+           float_bits(ppr_epsilon) == float_bits(other.ppr_epsilon);
+}
+
+size_t ActivationCacheKeyHash::operator()(const ActivationCacheKey& key) const {
+    size_t seed = key.sources.size();
+    for (uint32_t id : key.sources) {
+        hash_combine(seed, id);
+    }
+    hash_combine(seed, static_cast<uint64_t>(key.mode));
+    hash_combine(seed, key.max_hops);
+    hash_combine(seed, (static_cast<uint64_t>(float_bits(key.decay_factor)) << 32) |
+                       float_bits(key.activation_threshold));
+    hash_combine(seed, (static_cast<uint64_t>(float_bits(key.ppr_alpha)) << 32) |
+                       float_bits(key.ppr_epsilon));
+    return seed;
+}
+
+ActivationCache::ActivationCache(size_t max_bytes)
+    : configured_max_bytes_(max_bytes),
+      max_bytes_(max_bytes),
+      hits_metric_(monitoring::MetricsRegistry::instance().get_counter(
+          monitoring::metric_names::SEMANTIC_CACHE_HITS)),
+      misses_metric_(monitoring::MetricsRegistry::instance().get_counter(
+          monitoring::metric_names::SEMANTIC_CACHE_MISSES)),
+      hit_rate_metric_(monitoring::MetricsRegistry::instance().get_gauge(
+          monitoring::metric_names::SEMANTIC_CACHE_HIT_RATE)),
+      bytes_metric_(monitoring::MetricsRegistry::instance().get_gauge(
+          monitoring::metric_names::SEMANTIC_CACHE_BYTES)) {
+    pressure_subscription_ = monitoring::MemoryPressureMonitor::instance().subscribe(
+        [this](monitoring::MemoryPressureLevel level) { on_memory_pressure(level); });
+}
+
+ActivationCache::~ActivationCache() {
+    // No pressure callback may publish after our share is withdrawn
+    pressure_subscription_.reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_metric_.decrement(static_cast<double>(published_bytes_));
+}
+
+ActivationCacheKey ActivationCache::make_key(std::vector<uint32_t> sources,
+                                             const ActivationConfig& config) {
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+
+    ActivationCacheKey key;
+    key.sources = std::move(sources);
+    key.mode = config.mode;
+    key.activation_threshold = config.activation_threshold;
+    if (config.mode == ActivationMode::BFS) {
+        key.max_hops = config.max_hops;
+        key.decay_factor = config.decay_factor;
+    } else {
+        key.ppr_alpha = config.ppr_alpha;
+        key.ppr_epsilon = config.ppr_epsilon;
+    }
+    return key;
+}
+
+void ActivationCache::sync_version_locked(uint64_t version) {
+    if (version <= version_) {
+        return;
+    }
+    version_ = version;
+    if (!lru_.empty()) {
+        index_.clear();
+        lru_.clear();
+        stats_.bytes = 0;
+        ++stats_.invalidations;
+    }
+}
+
+std::shared_ptr<const ActivationCache::Entry> ActivationCache::find(uint64_t version,
+                                                                    const ActivationCacheKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0) {
+        return nullptr;
+    }
+    sync_version_locked(version);
+
+    auto it = version == version_ ? index_.find(key) : index_.end();
+    if (it == index_.end()) {
+        ++stats_.misses;
+        misses_metric_.increment();
+        publish_locked();
+        return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++stats_.hits;
+    hits_metric_.increment();
+    publish_locked();
+    return it->second->entry;
+}
+
+void ActivationCache::insert(uint64_t version, ActivationCacheKey key,
+                             std::shared_ptr<const Entry> entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0) {
+        return;
+    }
+    sync_version_locked(version);
+    if (version != version_) {
+        return;  // Computed on a graph that has since changed
+    }
+
+    size_t bytes = estimate_bytes(key, *entry);
+    if (bytes > max_bytes_) {
+        return;
+    }
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        stats_.bytes -= it->second->bytes;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    lru_.push_front(Slot{key, std::move(entry), bytes});
+    index_.emplace(std::move(key), lru_.begin());
+    stats_.bytes += bytes;
+    evict_locked();
+    publish_locked();
+}
+
+void ActivationCache::evict_locked() {
+    while (stats_.bytes > max_bytes_ && !lru_.empty()) {
+        const Slot& victim = lru_.back();
+        stats_.bytes -= victim.bytes;
+        index_.erase(victim.key);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+void ActivationCache::publish_locked() {
+    // Process-wide: the rate over every cache's hits and misses, and the
+    // sum of their footprints
+    double hits = static_cast<double>(hits_metric_.value());
+    double total = hits + static_cast<double>(misses_metric_.value());
+    hit_rate_metric_.set(total > 0.0 ? hits / total : 0.0);
+
+    bytes_metric_.increment(static_cast<double>(stats_.bytes) - static_cast<double>(published_bytes_));
+    published_bytes_ = stats_.bytes;
+}
+
+void ActivationCache::set_max_bytes(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    configured_max_bytes_ = max_bytes;
+    max_bytes_ = static_cast<size_t>(configured_max_bytes_ * pressure_factor_);
+    evict_locked();
+    publish_locked();
+}
+
+void ActivationCache::on_memory_pressure(monitoring::MemoryPressureLevel level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pressure_factor_ = monitoring::memory_pressure_budget_factor(level);
+    max_bytes_ = static_cast<size_t>(configured_max_bytes_ * pressure_factor_);
+    evict_locked();
+    publish_locked();
+}
+
+size_t ActivationCache::max_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_;
+}
+
+void ActivationCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    lru_.clear();
+    stats_.bytes = 0;
+    publish_locked();
+}
+
+ActivationCacheStats ActivationCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ActivationCacheStats stats = stats_;
+    stats.entries = index_.size();
+    return stats;
+}
+
+} // namespace brain_ai
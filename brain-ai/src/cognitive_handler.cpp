@@ -1,14 +1,66 @@
 #include "cognitive_handler.hpp"
 #include "utils.hpp"
+#include "cooccurrence_builder.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/metrics.hpp"
+#include "monitoring/perf_counters.hpp"
+#include "monitoring/slow_query_log.hpp"
 #include <algorithm>
+#include <cstring>
+#include <functional>
 
 namespace brain_ai {
 
+namespace {
+
+// Hardware counter stages of process_query (metrics perf_<stage>_<event>)
+monitoring::PerfStage kVectorStage("query_vector_search");
+monitoring::PerfStage kEpisodicStage("query_episodic");
+monitoring::PerfStage kSemanticStage("query_semantic");
+monitoring::PerfStage kFusionStage("query_fusion");
+monitoring::PerfStage kHallucinationStage("query_hallucination");
+monitoring::PerfStage kExplanationStage("query_explanation");
+
+uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void hash_combine(uint64_t& seed, uint64_t value) {
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+// Compared bit for bit, so NaN and -0.0 match only themselves
+bool same_floats(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() &&
+           (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+}
+
+// Fields of QueryConfig that change the response (not parallelism), plus
+// the lane, so a duplicate never waits behind a lower-priority leader
+bool same_config(const QueryConfig& a, const QueryConfig& b) {
+    const auto& x = a.semantic_activation;
+    const auto& y = b.semantic_activation;
+    return a.use_episodic == b.use_episodic && a.use_semantic == b.use_semantic &&
+           a.check_hallucination == b.check_hallucination &&
+           a.generate_explanation == b.generate_explanation &&
+           a.top_k_results == b.top_k_results && a.priority == b.priority &&
+           float_bits(a.hallucination_threshold) == float_bits(b.hallucination_threshold) &&
+           x.mode == y.mode && x.max_hops == y.max_hops &&
+           float_bits(x.activation_threshold) == float_bits(y.activation_threshold) &&
+           float_bits(x.decay_factor) == float_bits(y.decay_factor) &&
+           float_bits(x.ppr_alpha) == float_bits(y.ppr_alpha) &&
+           float_bits(x.ppr_epsilon) == float_bits(y.ppr_epsilon);
+}
+
+} // namespace
+
 CognitiveHandler::CognitiveHandler(
     size_t episodic_capacity,
     const FusionWeights& fusion_weights,
     size_t embedding_dim
-) : episodic_buffer_(episodic_capacity),
+) : episodic_store_(SessionStoreConfig(episodic_capacity)),
     fusion_(fusion_weights),
     embedding_dim_(embedding_dim) {
     // Initialize HNSWlib vector index with configurable dimension
@@ -20,18 +72,118 @@ CognitiveHandler::CognitiveHandler(
         200      // ef_construction
     );
     vector_index_->set_ef_search(50);  // Default search precision
+    
+    ingest_queue_ = std::make_unique<EpisodeIngestQueue>(episodic_store_);
+}
+
+QueryFingerprint QueryFingerprint::make(
+    const std::string& query,
+    const std::vector<float>& query_embedding,
+    const QueryConfig& config,
+    const std::string& session_id
+) {
+    QueryFingerprint key;
+    key.query = query;
+    key.session_id = session_id;
+    key.embedding = query_embedding;
+    key.config = config;
+    
+    uint64_t seed = query_embedding.size();
+    hash_combine(seed, std::hash<std::string>()(query));
+    hash_combine(seed, std::hash<std::string>()(session_id));
+    for (float value : query_embedding) {
+        hash_combine(seed, float_bits(value));
+    }
+    const auto& activation = config.semantic_activation;
+    hash_combine(seed, (uint64_t(config.use_episodic) << 3) | (uint64_t(config.use_semantic) << 2) |
+                       (uint64_t(config.check_hallucination) << 1) |
+                       uint64_t(config.generate_explanation));
+    hash_combine(seed, (uint64_t(config.top_k_results) << 8) | static_cast<uint64_t>(config.priority));
+    hash_combine(seed, (uint64_t(float_bits(config.hallucination_threshold)) << 32) |
+                       static_cast<uint64_t>(activation.mode));
+    hash_combine(seed, activation.max_hops);
+    hash_combine(seed, (uint64_t(float_bits(activation.activation_threshold)) << 32) |
+                       float_bits(activation.decay_factor));
+    hash_combine(seed, (uint64_t(float_bits(activation.ppr_alpha)) << 32) |
+                       float_bits(activation.ppr_epsilon));
+    key.hash = seed;
+    return key;
+}
+
+bool QueryFingerprint::operator==(const QueryFingerprint& other) const {
+    return hash == other.hash && query == other.query && session_id == other.session_id &&
+           same_floats(embedding, other.embedding) && same_config(config, other.config);
 }
 
 QueryResponse CognitiveHandler::process_query(
     const std::string& query,
     const std::vector<float>& query_embedding,
-    const QueryConfig& config
+    const QueryConfig& config,
+    const std::string& session_id,
+    const RequestContext& context
+) {
+    if (!coalesce_queries_.load()) {
+        return run_query(query, query_embedding, config, session_id, context);
+    }
+    return *process_query_shared(query, query_embedding, config, session_id, context);
+}
+
+std::shared_ptr<const QueryResponse> CognitiveHandler::process_query_shared(
+    const std::string& query,
+    const std::vector<float>& query_embedding,
+    const QueryConfig& config,
+    const std::string& session_id,
+    const RequestContext& context
+) {
+    if (!coalesce_queries_.load()) {
+        return std::make_shared<const QueryResponse>(
+            run_query(query, query_embedding, config, session_id, context));
+    }
+    
+    auto key = QueryFingerprint::make(query, query_embedding, config, session_id);
+    while (true) {
+        bool joined = false;
+        try {
+            auto response = query_flights_.run(
+                key,
+                [&]() { return run_query(query, query_embedding, config, session_id, context); },
+                &joined,
+                [&]() { context.check("coalesced_wait"); },
+                QueryScheduler::kExpiryPoll);
+            if (joined) {
+                monitoring::MetricsRegistry::instance()
+                    .get_counter(monitoring::metric_names::QUERIES_COALESCED).increment();
+            }
+            return response;
+        } catch (const errors::CancelledError&) {
+            // The run we joined was cancelled by its own caller; ours is
+            // still live, so start (or join) a fresh one
+            if (!joined || context.expired()) {
+                throw;
+            }
+        }
+    }
+}
+
+QueryResponse CognitiveHandler::run_query(
+    const std::string& query,
+    const std::vector<float>& query_embedding,
+    const QueryConfig& config,
+    const std::string& session_id,
+    const RequestContext& context
 ) {
+    auto slot = QueryScheduler::shared().admit(config.priority, context);
+    
     QueryResponse response(query);
     std::vector<ReasoningStep> reasoning_trace;
+    monitoring::SlowQueryTimer timer;
     
     // Step 1: Vector search (baseline - simulated here)
-    auto vector_results = vector_search(query_embedding, config.top_k_results);
+    monitoring::PerfScope vector_scope(kVectorStage);
+    vector_search::SearchCost search_cost;
+    auto vector_results = vector_search(query_embedding, config.top_k_results, &search_cost,
+                                        context);
+    vector_scope.stop();
     
     if (!vector_results.empty()) {
         float avg_sim = 0.0f;
@@ -49,10 +201,14 @@ QueryResponse CognitiveHandler::process_query(
         );
     }
     
-    // Step 2: Episodic buffer retrieval (if enabled)
+    timer.lap(monitoring::QueryStage::VECTOR);
+    
+    // Step 2: Episodic retrieval, scoped to the caller's session (if enabled)
     std::vector<ScoredResult> episodic_results;
-    if (config.use_episodic && episodic_buffer_.size() > 0) {
-        auto episodes = episodic_buffer_.retrieve_similar(query_embedding, 5, 0.6f);
+    if (config.use_episodic) {
+        monitoring::PerfScope episodic_scope(kEpisodicStage);
+        auto episodes = episodic_store_.retrieve_similar(session_id, query_embedding, 5, 0.6f,
+                                                         context);
         episodic_results = episodes_to_results(episodes);
         
         if (!episodic_results.empty()) {
@@ -72,14 +228,20 @@ QueryResponse CognitiveHandler::process_query(
         }
     }
     
+    timer.lap(monitoring::QueryStage::EPISODIC);
+    
     // Step 3: Semantic network activation (if enabled)
     std::vector<ScoredResult> semantic_results;
     if (config.use_semantic && semantic_network_.num_nodes() > 0) {
+        monitoring::PerfScope semantic_scope(kSemanticStage);
+        
         // Extract concepts from query
         auto query_concepts = extract_concepts(query);
         
         // Spread activation
-        auto activated = semantic_network_.spread_activation(query_concepts, 3, 0.7f, 0.1f);
+        auto activated = semantic_network_.spread_activation(query_concepts,
+                                                             config.semantic_activation,
+                                                             context);
         
         // Convert to scored results
         for (const auto& [concept, activation] : activated) {
@@ -102,13 +264,18 @@ QueryResponse CognitiveHandler::process_query(
         }
     }
     
+    timer.lap(monitoring::QueryStage::SEMANTIC);
+    
     // Step 4: Hybrid fusion
+    context.check("fusion");
+    monitoring::PerfScope fusion_scope(kFusionStage);
     auto fused_results = fusion_.fuse(
         vector_results,
         episodic_results,
         semantic_results,
         config.top_k_results
     );
+    fusion_scope.stop();
     
     response.results = fused_results;
     
@@ -131,8 +298,13 @@ QueryResponse CognitiveHandler::process_query(
         response.overall_confidence = 0.0f;
     }
     
+    timer.lap(monitoring::QueryStage::FUSION);
+    
     // Step 5: Hallucination detection (if enabled)
     if (config.check_hallucination && !response.response.empty()) {
+        context.check("hallucination");
+        monitoring::PerfScope hallucination_scope(kHallucinationStage);
+        
         // Collect evidence from all sources
         std::vector<Evidence> evidence;
         
@@ -159,12 +331,37 @@ QueryResponse CognitiveHandler::process_query(
         );
     }
     
+    timer.lap(monitoring::QueryStage::HALLUCINATION);
+    
     // Step 6: Generate explanation (if enabled)
     if (config.generate_explanation) {
+        context.check("explanation");
+        monitoring::PerfScope explanation_scope(kExplanationStage);
         response.explanation = explanation_engine_.generate_explanation(
             query, response.response, reasoning_trace
         );
     }
+    timer.lap(monitoring::QueryStage::EXPLANATION);
+    
+    // Slow-query capture (fast queries stop at the threshold check)
+    auto& slow_log = monitoring::SlowQueryLog::instance();
+    uint32_t total_us = timer.elapsed_us();
+    if (slow_log.is_slow(total_us)) {
+        monitoring::SlowQueryRecord record;
+        record.source = monitoring::SlowQuerySource::PROCESS_QUERY;
+        record.fingerprint = monitoring::fingerprint_text(query);
+        record.total_us = total_us;
+        timer.fill(record);
+        record.set_result_count(monitoring::QueryResultCount::VECTOR, vector_results.size());
+        record.set_result_count(monitoring::QueryResultCount::EPISODIC, episodic_results.size());
+        record.set_result_count(monitoring::QueryResultCount::SEMANTIC, semantic_results.size());
+        record.set_result_count(monitoring::QueryResultCount::FUSED, fused_results.size());
+        record.top_k = static_cast<uint32_t>(config.top_k_results);
+        record.ef_search = static_cast<uint32_t>(search_cost.ef_search);
+        record.hops = search_cost.hops;
+        record.distance_computations = search_cost.distance_computations;
+        slow_log.record(record);
+    }
     
     return response;
 }
@@ -173,9 +370,24 @@ void CognitiveHandler::add_episode(
     const std::string& query,
     const std::string& response,
     const std::vector<float>& query_embedding,
-    const std::unordered_map<std::string, std::string>& metadata
+    const std::unordered_map<std::string, std::string>& metadata,
+    const std::string& session_id
 ) {
-    episodic_buffer_.add_episode(query, response, query_embedding, metadata);
+    episodic_store_.add_episode(session_id, query, response, query_embedding, metadata);
+}
+
+void CognitiveHandler::add_episode_async(
+    const std::string& query,
+    const std::string& response,
+    const std::vector<float>& query_embedding,
+    const std::unordered_map<std::string, std::string>& metadata,
+    const std::string& session_id
+) {
+    ingest_queue_->enqueue(session_id, query, response, query_embedding, metadata);
+}
+
+void CognitiveHandler::flush_episodes() {
+    ingest_queue_->flush();
 }
 
 void CognitiveHandler::populate_semantic_network(
@@ -188,18 +400,21 @@ void CognitiveHandler::populate_semantic_network(
     }
     
     // Add relations
-    for (const auto& [source, target, weight] : relations) {
-        semantic_network_.add_edge(source, target, weight);
-    }
+    semantic_network_.add_edges(relations);
+    
+    // One rebuild for the whole batch, before the next query needs it
+    semantic_network_.commit();
 }
 
 // Real vector search using HNSWlib
 std::vector<ScoredResult> CognitiveHandler::vector_search(
     const std::vector<float>& query_embedding,
-    size_t top_k
+    size_t top_k,
+    vector_search::SearchCost* cost,
+    const RequestContext& context
 ) {
     // Query the HNSW index for nearest neighbors
-    auto hnsw_results = vector_index_->search(query_embedding, top_k);
+    auto hnsw_results = vector_index_->search(query_embedding, top_k, cost, context);
     
     // Convert HNSWlib results to ScoredResult format
     std::vector<ScoredResult> results;
@@ -237,26 +452,10 @@ std::vector<ScoredResult> CognitiveHandler::episodes_to_results(
 }
 
 std::vector<std::string> CognitiveHandler::extract_concepts(const std::string& query) {
-    // Simple tokenization and filtering
-    // Real implementation would use NLP/NER
-    
-    std::vector<std::string> concepts;
-    auto tokens = tokenize(to_lowercase(query));
-    
-    // Filter out stopwords (simplified)
-    std::unordered_set<std::string> stopwords = {
-        "the", "is", "at", "which", "on", "a", "an", "and", "or", "but",
-        "in", "with", "to", "for", "of", "as", "by", "from", "how", "what",
-        "where", "when", "why", "who"
-    };
-    
-    for (const auto& token : tokens) {
-        if (token.length() > 3 && stopwords.find(token) == stopwords.end()) {
-            concepts.push_back(token);
-        }
-    }
-    
-    return concepts;
+    // Simple tokenization and filtering (real implementation would use
+    // NLP/NER). Shares the tokenizer used to mine co-occurrence edges from
+    // documents, so query terms match the mined concept names.
+    return CooccurrenceBuilder::extract_terms(query, 4);
 }
 
 bool CognitiveHandler::index_document(
@@ -265,6 +464,7 @@ bool CognitiveHandler::index_document(
     const std::string& content,
     const nlohmann::json& metadata
 ) {
+    auto slot = QueryScheduler::shared().admit(QueryPriority::INGEST);
     return vector_index_->add_document(doc_id, embedding, content, metadata);
 }
 
@@ -272,6 +472,7 @@ void CognitiveHandler::batch_index_documents(
     const std::vector<std::tuple<std::string, std::vector<float>, std::string>>& documents
 ) {
     for (const auto& [doc_id, embedding, content] : documents) {
+        auto slot = QueryScheduler::shared().admit(QueryPriority::INGEST);
         vector_index_->add_document(doc_id, embedding, content);
     }
 }
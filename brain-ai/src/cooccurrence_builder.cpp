@@ -0,0 +1,383 @@
+#include "cooccurrence_builder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <tuple>
+
+namespace brain_ai {
+
+namespace {
+
+// Stopwords (also applied to query concepts via extract_terms)
+const std::unordered_set<std::string>& stopwords() {
+    static const std::unordered_set<std::string> words = {
+        "the", "is", "at", "which", "on", "a", "an", "and", "or", "but",
+        "in", "with", "to", "for", "of", "as", "by", "from", "how", "what",
+        "where", "when", "why", "who"
+    };
+    return words;
+}
+
+uint64_t pair_key(uint32_t a, uint32_t b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+} // namespace
+
+uint32_t CooccurrenceBuilder::Counts::intern(const std::string& term) {
+    auto [it, inserted] = ids.try_emplace(term, static_cast<uint32_t>(terms.size()));
+    if (inserted) {
+        terms.push_back(term);
+        term_counts.push_back(0);
+    }
+    return it->second;
+}
+
+void CooccurrenceBuilder::Counts::clear() {
+    terms.clear();
+    ids.clear();
+    term_counts.clear();
+    pair_counts.clear();
+    tokens = 0;
+    pairs = 0;
+    documents = 0;
+}
+
+CooccurrenceBuilder::CooccurrenceBuilder(SemanticNetwork& network,
+                                         const CooccurrenceConfig& config,
+                                         WorkPool& pool)
+    : network_(network), config_(config), pool_(pool) {
+    if (config_.window == 0) {
+        config_.window = 1;
+    }
+}
+
+CooccurrenceBuilder::~CooccurrenceBuilder() {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    task_cv_.wait(lock, [this] { return !task_running_; });
+}
+
+std::vector<std::string> CooccurrenceBuilder::extract_terms(const std::string& text,
+                                                            size_t min_token_length) {
+    std::vector<std::string> terms;
+    std::string token;
+    auto finish = [&] {
+        if (token.size() >= min_token_length && stopwords().count(token) == 0) {
+            terms.push_back(token);
+        }
+        token.clear();
+    };
+
+    // Words are runs of letters/digits (bytes >= 0x80 kept so UTF-8 survives)
+    for (unsigned char c : text) {
+        if (std::isalnum(c) || c >= 0x80) {
+            token += static_cast<char>(std::tolower(c));
+        } else if (!token.empty()) {
+            finish();
+        }
+    }
+    if (!token.empty()) {
+        finish();
+    }
+    return terms;
+}
+
+void CooccurrenceBuilder::count_terms(const std::vector<std::string>& terms, Counts& counts) const {
+    std::vector<uint32_t> ids;
+    ids.reserve(terms.size());
+    for (const auto& term : terms) {
+        uint32_t id = counts.intern(term);
+        ++counts.term_counts[id];
+        ids.push_back(id);
+    }
+    counts.tokens += ids.size();
+
+    // Pair each token with the next `window` tokens
+    for (size_t i = 0; i < ids.size(); ++i) {
+        size_t end = std::min(ids.size(), i + 1 + config_.window);
+        for (size_t j = i + 1; j < end; ++j) {
+            if (ids[i] != ids[j]) {
+                ++counts.pair_counts[pair_key(ids[i], ids[j])];
+                ++counts.pairs;
+            }
+        }
+    }
+    ++counts.documents;
+}
+
+void CooccurrenceBuilder::add_document(const std::string& text) {
+    // Tokenize outside the shard lock
+    std::vector<std::string> terms = extract_terms(text, config_.min_token_length);
+    {
+        Shard& shard = shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) % kShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count_terms(terms, shard.counts);
+    }
+    maybe_schedule_apply(1);
+}
+
+void CooccurrenceBuilder::add_documents(const std::vector<std::string>& texts) {
+    constexpr size_t kGrain = 16;
+    pool_.parallel_for(texts.size(), kGrain, [&](size_t begin, size_t end) {
+        Counts local;
+        for (size_t i = begin; i < end; ++i) {
+            count_terms(extract_terms(texts[i], config_.min_token_length), local);
+        }
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        merge_locked(local);
+    });
+    maybe_schedule_apply(texts.size());
+}
+
+void CooccurrenceBuilder::merge_locked(Counts& local) {
+    std::vector<uint32_t> remap(local.terms.size());
+    for (uint32_t id = 0; id < local.terms.size(); ++id) {
+        remap[id] = global_.intern(local.terms[id]);
+        global_.term_counts[remap[id]] += local.term_counts[id];
+    }
+    for (const auto& [key, count] : local.pair_counts) {
+        uint64_t global_key = pair_key(remap[key >> 32], remap[key & 0xFFFFFFFFu]);
+        global_.pair_counts[global_key] += count;
+        dirty_pairs_.insert(global_key);
+    }
+    global_.tokens += local.tokens;
+    global_.pairs += local.pairs;
+    stats_.documents += local.documents;
+    stats_.tokens += local.tokens;
+    local.clear();
+}
+
+void CooccurrenceBuilder::prune_locked(std::unordered_set<uint64_t>& applied) {
+    if (config_.max_pairs == 0 || global_.pair_counts.size() <= config_.max_pairs) {
+        return;
+    }
+
+    // Drop every pair at or below the count that frees a quarter of the
+    // budget (ties included), so pruning runs rarely
+    const size_t target = config_.max_pairs - config_.max_pairs / 4;
+    std::vector<uint64_t> counts;
+    counts.reserve(global_.pair_counts.size());
+    for (const auto& [key, count] : global_.pair_counts) {
+        counts.push_back(count);
+    }
+    size_t drop = counts.size() - target;
+    std::nth_element(counts.begin(), counts.begin() + (drop - 1), counts.end());
+    const uint64_t floor = counts[drop - 1];
+
+    size_t before = global_.pair_counts.size();
+    for (auto it = global_.pair_counts.begin(); it != global_.pair_counts.end();) {
+        if (it->second <= floor) {
+            dirty_pairs_.erase(it->first);
+            it = global_.pair_counts.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    stats_.pairs_pruned += before - global_.pair_counts.size();
+
+    // Drop terms no surviving pair references and renumber the rest, so
+    // the vocabulary stays bounded too; a dropped term counts from zero
+    // if it comes back
+    constexpr uint32_t kDropped = UINT32_MAX;
+    std::vector<uint32_t> remap(global_.terms.size(), kDropped);
+    for (const auto& [key, count] : global_.pair_counts) {
+        remap[key >> 32] = 0;
+        remap[key & 0xFFFFFFFFu] = 0;
+    }
+    Counts kept;
+    kept.tokens = global_.tokens;
+    kept.pairs = global_.pairs;
+    kept.documents = global_.documents;
+    for (uint32_t id = 0; id < global_.terms.size(); ++id) {
+        if (remap[id] == kDropped) {
+            continue;
+        }
+        remap[id] = static_cast<uint32_t>(kept.terms.size());
+        kept.ids.emplace(global_.terms[id], remap[id]);
+        kept.terms.push_back(std::move(global_.terms[id]));
+        kept.term_counts.push_back(global_.term_counts[id]);
+    }
+    stats_.terms_pruned += global_.terms.size() - kept.terms.size();
+
+    auto rekey = [&remap](uint64_t key) {
+        return pair_key(remap[key >> 32], remap[key & 0xFFFFFFFFu]);
+    };
+    kept.pair_counts.reserve(global_.pair_counts.size());
+    for (const auto& [key, count] : global_.pair_counts) {
+        kept.pair_counts.emplace(rekey(key), count);
+    }
+    // Pending keys follow the new ids; ones whose pair was pruned go
+    for (auto* keys : {&dirty_pairs_, &applied}) {
+        std::unordered_set<uint64_t> moved;
+        moved.reserve(keys->size());
+        for (uint64_t key : *keys) {
+            if (global_.pair_counts.count(key) != 0) {
+                moved.insert(rekey(key));
+            }
+        }
+        keys->swap(moved);
+    }
+    global_ = std::move(kept);
+}
+
+void CooccurrenceBuilder::merge_and_apply(bool commit_all) {
+    std::lock_guard<std::mutex> apply_lock(apply_mutex_);
+
+    std::vector<std::tuple<std::string, std::string, float>> relations;
+    std::unordered_set<uint64_t> applied;
+    {
+        // Reduce: fold every shard into the global counts
+        for (Shard& shard : shards_) {
+            Counts local;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                std::swap(local, shard.counts);
+            }
+            std::lock_guard<std::mutex> lock(merge_mutex_);
+            merge_locked(local);
+        }
+
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        if (dirty_pairs_.empty()) {
+            stats_.pairs_pending = 0;
+            return;
+        }
+        if (dirty_since_ns_.load() == 0) {
+            dirty_since_ns_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+        if (!commit_all && dirty_pairs_.size() < config_.commit_min_pairs &&
+            !commit_interval_elapsed()) {
+            // Keep collecting; bound the counts meanwhile
+            std::unordered_set<uint64_t> none;
+            prune_locked(none);
+            stats_.pairs_pending = dirty_pairs_.size();
+            return;
+        }
+        applied.swap(dirty_pairs_);
+        dirty_since_ns_.store(0);
+        stats_.pairs_pending = 0;
+        double tokens = static_cast<double>(global_.tokens);
+        double pairs = static_cast<double>(global_.pairs);
+        for (uint64_t key : applied) {
+            auto it = global_.pair_counts.find(key);
+            if (it == global_.pair_counts.end() || it->second < config_.min_pair_count) {
+                continue;   // Pruned or still rare
+            }
+            uint64_t count = it->second;
+            uint32_t x = static_cast<uint32_t>(key >> 32);
+            uint32_t y = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+            double p_xy = count / pairs;
+            double p_x = global_.term_counts[x] / tokens;
+            double p_y = global_.term_counts[y] / tokens;
+            double pmi = std::log(p_xy / (p_x * p_y));
+            double npmi = p_xy < 1.0 ? pmi / -std::log(p_xy) : 1.0;
+            if (npmi <= 0.0 || npmi < config_.min_npmi) {
+                continue;
+            }
+            float weight = static_cast<float>(std::min(npmi, 1.0));
+            relations.emplace_back(global_.terms[x], global_.terms[y], weight);
+            relations.emplace_back(global_.terms[y], global_.terms[x], weight);
+        }
+        prune_locked(applied);
+    }
+
+    // One off-lock rebuild for the whole batch; counting continues meanwhile
+    try {
+        network_.add_edges(relations);
+        network_.commit();
+    } catch (...) {
+        // Retry these pairs with the next commit
+        std::lock_guard<std::mutex> lock(merge_mutex_);
+        dirty_pairs_.insert(applied.begin(), applied.end());
+        if (dirty_since_ns_.load() == 0) {
+            dirty_since_ns_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(merge_mutex_);
+    stats_.edges_applied += relations.size();
+    ++stats_.applies;
+}
+
+bool CooccurrenceBuilder::commit_interval_elapsed() const {
+    int64_t since = dirty_since_ns_.load();
+    if (since == 0 || config_.commit_interval.count() == 0) {
+        return false;
+    }
+    auto age = std::chrono::steady_clock::now().time_since_epoch() -
+               std::chrono::steady_clock::duration(since);
+    return age >= config_.commit_interval;
+}
+
+void CooccurrenceBuilder::maybe_schedule_apply(size_t documents) {
+    if (config_.apply_every_documents == 0) {
+        return;
+    }
+    if (unapplied_documents_.fetch_add(documents) + documents < config_.apply_every_documents &&
+        !commit_interval_elapsed()) {
+        return;
+    }
+    schedule_apply(false);
+}
+
+void CooccurrenceBuilder::schedule_apply(bool force) {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    flush_requested_ |= force;
+    if (task_running_) {
+        // The running task may have swapped the shards already; a forced
+        // apply runs once more after it, otherwise the documents wait for
+        // the next cadence
+        apply_requested_ |= force;
+        return;
+    }
+    task_running_ = true;
+    unapplied_documents_.store(0);
+    pool_.submit([this] {
+        while (true) {
+            bool commit_all;
+            {
+                std::lock_guard<std::mutex> task_lock(task_mutex_);
+                commit_all = flush_requested_;
+                flush_requested_ = false;
+            }
+            try {
+                merge_and_apply(commit_all);
+            } catch (...) {
+                // Pairs stay dirty and are retried with the next apply
+            }
+            std::lock_guard<std::mutex> task_lock(task_mutex_);
+            if (!apply_requested_) {
+                task_running_ = false;
+                task_cv_.notify_all();
+                return;
+            }
+            apply_requested_ = false;
+            unapplied_documents_.store(0);
+        }
+    });
+}
+
+void CooccurrenceBuilder::flush() {
+    unapplied_documents_.store(0);
+    merge_and_apply(true);
+}
+
+void CooccurrenceBuilder::flush_async() {
+    schedule_apply(true);
+}
+
+CooccurrenceStats CooccurrenceBuilder::stats() const {
+    std::lock_guard<std::mutex> lock(merge_mutex_);
+    CooccurrenceStats stats = stats_;
+    stats.distinct_terms = global_.terms.size();
+    stats.distinct_pairs = global_.pair_counts.size();
+    return stats;
+}
+
+} // namespace brain_ai
@@ -1,4 +1,7 @@
 #include "document/document_processor.hpp"
+#include "errors/exceptions.hpp"
+#include "logging/logger.hpp"
+#include "monitoring/metrics.hpp"
 #include "utils.hpp"
 #include <sstream>
 #include <iomanip>
@@ -11,20 +14,21 @@
 #include "httplib.h"
 #include "nlohmann/json.hpp"
 
-// Logger placeholder (replace with full logging system if available)
-namespace Logger {
-    inline void info(const std::string& component, const std::string& message) {
-        std::cout << "[INFO] " << component << ": " << message << std::endl;
-    }
-    inline void warn(const std::string& component, const std::string& message) {
-        std::cout << "[WARN] " << component << ": " << message << std::endl;
-    }
-    inline void error(const std::string& component, const std::string& message) {
-        std::cerr << "[ERROR] " << component << ": " << message << std::endl;
-    }
+namespace brain_ai::document {
+
+namespace {
+
+using logging::sampling::kProgressFirstN;
+using logging::sampling::kProgressEveryM;
+using logging::sampling::kFailureFirstN;
+using logging::sampling::kFailureEveryM;
+
+const std::shared_ptr<logging::Logger>& logger() {
+    static const auto instance = GET_LOGGER(logging::logger_names::DOCUMENT);
+    return instance;
 }
 
-namespace brain_ai::document {
+} // namespace
 
 DocumentProcessor::DocumentProcessor(CognitiveHandler& cognitive_handler,
                                      const Config& config)
@@ -33,29 +37,43 @@ DocumentProcessor::DocumentProcessor(CognitiveHandler& cognitive_handler,
     
     ocr_client_ = std::make_unique<OCRClient>(config_.ocr_config);
     validator_ = std::make_unique<TextValidator>(config_.validation_config);
+    if (config_.build_cooccurrence_graph) {
+        cooccurrence_ = std::make_unique<CooccurrenceBuilder>(cognitive_.semantic_network(),
+                                                              config_.cooccurrence_config);
+    }
     
-    Logger::info("DocumentProcessor", "Initialized document processing pipeline");
+    LOG_INFO(logger(), "Initialized document processing pipeline");
 }
 
-DocumentProcessor::~DocumentProcessor() = default;
+DocumentProcessor::~DocumentProcessor() {
+    // Apply the counts of a batch that ended just before shutdown
+    if (cooccurrence_) {
+        try {
+            cooccurrence_->flush();
+        } catch (const std::exception& e) {
+            LOG_ERRORF(logger(), "Failed to apply co-occurrence edges: {}", e.what());
+        }
+    }
+}
 
 DocumentResult DocumentProcessor::process(const std::string& filepath,
-                                         const std::string& doc_id) {
+                                         const std::string& doc_id,
+                                         const RequestContext& context) {
     auto start_time = std::chrono::steady_clock::now();
     
     DocumentResult result;
     result.doc_id = doc_id.empty() ? generate_doc_id(filepath) : doc_id;
     
-    Logger::info("DocumentProcessor", "Processing document: " + filepath + 
-                " (ID: " + result.doc_id + ")");
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                      "Processing document: {} (ID: {})", filepath, result.doc_id);
     
     try {
         // Step 1: OCR extraction
-        auto ocr_result = ocr_client_->process_file(filepath);
+        auto ocr_result = ocr_client_->process_file(filepath, context);
         if (!ocr_result.success) {
             result.success = false;
             result.error_message = "OCR failed: " + ocr_result.error_message;
-            Logger::error("DocumentProcessor", result.error_message);
+            LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
             update_stats(result);
             return result;
         }
@@ -65,8 +83,8 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
         result.metadata = ocr_result.metadata;
         result.metadata["source_file"] = filepath;
         
-        Logger::info("DocumentProcessor", "OCR extracted " + 
-                    std::to_string(ocr_result.text.size()) + " chars");
+        LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                          "OCR extracted {} chars", ocr_result.text.size());
         
         // Step 2: Text validation
         auto validation_result = validator_->validate(ocr_result.text);
@@ -75,10 +93,9 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
             result.error_message = "Validation failed: low confidence";
             result.validation_confidence = validation_result.confidence;
             
-            Logger::warn("DocumentProcessor", 
-                        "Validation failed: confidence=" + 
-                        std::to_string(validation_result.confidence) +
-                        ", errors=" + std::to_string(validation_result.errors_corrected));
+            LOG_WARNF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                              "Validation failed: confidence={}, errors={}",
+                              validation_result.confidence, validation_result.errors_corrected);
             
             // Still return the text for inspection
             result.validated_text = validation_result.cleaned_text;
@@ -89,53 +106,65 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
         result.validated_text = validation_result.cleaned_text;
         result.validation_confidence = validation_result.confidence;
         
-        Logger::info("DocumentProcessor", "Text validated: confidence=" + 
-                    std::to_string(validation_result.confidence) +
-                    ", corrections=" + std::to_string(validation_result.errors_corrected));
+        LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                          "Text validated: confidence={}, corrections={}",
+                          validation_result.confidence, validation_result.errors_corrected);
+        
+        // Count concept co-occurrences (edges are applied in background batches)
+        if (cooccurrence_) {
+            cooccurrence_->add_document(result.validated_text);
+        }
         
         // Step 3: Generate embedding (if configured)
         std::vector<float> embedding;
         if (config_.auto_generate_embeddings) {
-            embedding = generate_embedding(result.validated_text);
-            Logger::info("DocumentProcessor", "Generated embedding: " + 
-                        std::to_string(embedding.size()) + " dimensions");
+            embedding = generate_embedding(result.validated_text, context);
+            LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                              "Generated embedding: {} dimensions", embedding.size());
         }
         
         // Step 4: Create episodic memory (if configured)
         if (config_.create_episodic_memory) {
             if (!create_memory(result.doc_id, result.validated_text, result.metadata)) {
-                Logger::warn("DocumentProcessor", "Failed to create episodic memory");
+                LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                                 "Failed to create episodic memory");
             } else {
-                Logger::info("DocumentProcessor", "Created episodic memory");
+                LOG_INFO_SAMPLED(logger(), kProgressFirstN, kProgressEveryM, "Created episodic memory");
             }
         }
         
         // Step 5: Index in vector store (if configured)
         if (config_.index_in_vector_store && !embedding.empty()) {
+            context.check("document_index");
             result.indexed = index_document(result.doc_id, embedding,
                                            result.validated_text, result.metadata);
             
             if (result.indexed) {
-                Logger::info("DocumentProcessor", "Indexed in vector store");
+                LOG_INFO_SAMPLED(logger(), kProgressFirstN, kProgressEveryM, "Indexed in vector store");
             } else {
-                Logger::warn("DocumentProcessor", "Failed to index in vector store");
+                LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                                 "Failed to index in vector store");
             }
         }
         
         result.success = true;
         
+    } catch (const errors::CancelledError& e) {
+        result.success = false;
+        result.error_message = e.message();
+        LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
     } catch (const std::exception& e) {
         result.success = false;
         result.error_message = "Processing exception: " + std::string(e.what());
-        Logger::error("DocumentProcessor", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
     }
     
     auto end_time = std::chrono::steady_clock::now();
     result.processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
         end_time - start_time);
     
-    Logger::info("DocumentProcessor", "Processing completed in " + 
-                std::to_string(result.processing_time.count()) + "ms");
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                      "Processing completed in {}ms", result.processing_time.count());
     
     update_stats(result);
     
@@ -144,21 +173,22 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
 
 DocumentResult DocumentProcessor::process_image(const std::vector<uint8_t>& image_data,
                                                const std::string& mime_type,
-                                               const std::string& doc_id) {
+                                               const std::string& doc_id,
+                                               const RequestContext& context) {
     auto start_time = std::chrono::steady_clock::now();
     
     DocumentResult result;
     result.doc_id = doc_id;
     
-    Logger::info("DocumentProcessor", "Processing image: " + doc_id);
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM, "Processing image: {}", doc_id);
     
     try {
         // Step 1: OCR extraction
-        auto ocr_result = ocr_client_->process_image(image_data, mime_type);
+        auto ocr_result = ocr_client_->process_image(image_data, mime_type, context);
         if (!ocr_result.success) {
             result.success = false;
             result.error_message = "OCR failed: " + ocr_result.error_message;
-            Logger::error("DocumentProcessor", result.error_message);
+            LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
             update_stats(result);
             return result;
         }
@@ -179,10 +209,14 @@ DocumentResult DocumentProcessor::process_image(const std::vector<uint8_t>& imag
             return result;
         }
         
+        if (cooccurrence_) {
+            cooccurrence_->add_document(result.validated_text);
+        }
+        
         // Step 3-5: Same as process()
         std::vector<float> embedding;
         if (config_.auto_generate_embeddings) {
-            embedding = generate_embedding(result.validated_text);
+            embedding = generate_embedding(result.validated_text, context);
         }
         
         if (config_.create_episodic_memory) {
@@ -190,16 +224,21 @@ DocumentResult DocumentProcessor::process_image(const std::vector<uint8_t>& imag
         }
         
         if (config_.index_in_vector_store && !embedding.empty()) {
+            context.check("document_index");
             result.indexed = index_document(result.doc_id, embedding,
                                            result.validated_text, result.metadata);
         }
         
         result.success = true;
         
+    } catch (const errors::CancelledError& e) {
+        result.success = false;
+        result.error_message = e.message();
+        LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
     } catch (const std::exception& e) {
         result.success = false;
         result.error_message = "Processing exception: " + std::string(e.what());
-        Logger::error("DocumentProcessor", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
     }
     
     auto end_time = std::chrono::steady_clock::now();
@@ -213,33 +252,53 @@ DocumentResult DocumentProcessor::process_image(const std::vector<uint8_t>& imag
 
 std::vector<DocumentResult> DocumentProcessor::process_batch(
     const std::vector<std::string>& filepaths,
-    ProgressCallback progress_callback) {
+    ProgressCallback progress_callback,
+    const RequestContext& context) {
     
-    Logger::info("DocumentProcessor", "Batch processing " + 
-                std::to_string(filepaths.size()) + " documents");
+    LOG_INFOF(logger(), "Batch processing {} documents", filepaths.size());
     
     std::vector<DocumentResult> results;
     results.reserve(filepaths.size());
     
     size_t current = 0;
     for (const auto& filepath : filepaths) {
+        if (context.should_stop("document_batch")) {
+            break;
+        }
         current++;
         
         if (progress_callback) {
             progress_callback(current, filepaths.size(), "Processing: " + filepath);
         }
         
-        auto result = process(filepath);
+        auto result = process(filepath, "", context);
         results.push_back(std::move(result));
     }
     
+    // Documents never started once the batch expired
+    if (results.size() < filepaths.size()) {
+        size_t skipped = filepaths.size() - results.size();
+        LOG_WARNF(logger(), "Batch stopped: {} documents not processed", skipped);
+        monitoring::MetricsRegistry::instance()
+            .get_counter(monitoring::metric_names::CANCELLED_BATCH_ITEMS)
+            .increment(static_cast<int64_t>(skipped));
+        for (size_t i = results.size(); i < filepaths.size(); ++i) {
+            DocumentResult skipped_result;
+            skipped_result.success = false;
+            skipped_result.error_message = context.cancelled() ? "Request cancelled" : "Deadline exceeded";
+            skipped_result.metadata["source_file"] = filepaths[i];
+            results.push_back(std::move(skipped_result));
+        }
+    }
+    
     // Summary
     size_t success_count = std::count_if(results.begin(), results.end(),
                                         [](const auto& r) { return r.success; });
     
-    Logger::info("DocumentProcessor", "Batch completed: " + 
-                std::to_string(success_count) + "/" + 
-                std::to_string(results.size()) + " succeeded");
+    LOG_INFOF(logger(), "Batch completed: {}/{} succeeded", success_count, results.size());
+    
+    // Summarize per-document lines sampled away during the batch
+    logger()->report_suppressed();
     
     return results;
 }
@@ -275,7 +334,7 @@ ProcessingStats DocumentProcessor::get_stats() const {
 void DocumentProcessor::reset_stats() {
     std::lock_guard<std::mutex> lock(stats_mutex_);
     stats_ = ProcessingStats{};
-    Logger::info("DocumentProcessor", "Statistics reset");
+    LOG_INFO(logger(), "Statistics reset");
 }
 
 void DocumentProcessor::update_config(const Config& config) {
@@ -284,16 +343,35 @@ void DocumentProcessor::update_config(const Config& config) {
     ocr_client_->update_config(config_.ocr_config);
     validator_->update_config(config_.validation_config);
     
-    Logger::info("DocumentProcessor", "Configuration updated");
+    // Start or stop the graph builder; a stopped one applies its counts first
+    if (config_.build_cooccurrence_graph && !cooccurrence_) {
+        cooccurrence_ = std::make_unique<CooccurrenceBuilder>(cognitive_.semantic_network(),
+                                                              config_.cooccurrence_config);
+    } else if (!config_.build_cooccurrence_graph && cooccurrence_) {
+        cooccurrence_->flush();
+        cooccurrence_.reset();
+    }
+    
+    LOG_INFO(logger(), "Configuration updated");
+}
+
+void DocumentProcessor::flush_cooccurrence_graph() {
+    if (cooccurrence_) {
+        cooccurrence_->flush_async();
+    }
+}
+
+CooccurrenceStats DocumentProcessor::get_cooccurrence_stats() const {
+    return cooccurrence_ ? cooccurrence_->stats() : CooccurrenceStats();
 }
 
 bool DocumentProcessor::check_service_health() {
     bool healthy = ocr_client_->check_health();
     
     if (healthy) {
-        Logger::info("DocumentProcessor", "OCR service is healthy");
+        LOG_INFO(logger(), "OCR service is healthy");
     } else {
-        Logger::warn("DocumentProcessor", "OCR service is unhealthy");
+        LOG_WARN(logger(), "OCR service is unhealthy");
     }
     
     return healthy;
@@ -316,11 +394,25 @@ std::string DocumentProcessor::generate_doc_id(const std::string& filepath) {
     return oss.str();
 }
 
-std::vector<float> DocumentProcessor::generate_embedding(const std::string& text) {
+std::vector<float> DocumentProcessor::generate_embedding(const std::string& text,
+                                                         const RequestContext& context) {
+    context.check("embedding");
+    
     // Try to call Python embedding service via HTTP
     try {
         httplib::Client cli("http://localhost", 5001);
         cli.set_connection_timeout(5, 0);  // 5 seconds timeout
+        if (context.has_deadline()) {
+            // Give up on the service when the request runs out of time,
+            // but never wait longer than the 5 second defaults
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(context.remaining());
+            auto timeout = std::min<std::chrono::microseconds>(remaining, std::chrono::seconds(5));
+            auto sec = static_cast<time_t>(timeout.count() / 1000000);
+            auto usec = static_cast<time_t>(timeout.count() % 1000000);
+            cli.set_connection_timeout(sec, usec);
+            cli.set_read_timeout(sec, usec);
+            cli.set_write_timeout(sec, usec);
+        }
         
         nlohmann::json request_body;
         request_body["text"] = text;
@@ -332,20 +424,26 @@ std::vector<float> DocumentProcessor::generate_embedding(const std::string& text
             
             if (response_json.contains("embedding")) {
                 auto embedding = response_json["embedding"].get<std::vector<float>>();
-                Logger::info("DocumentProcessor", "Got embedding from service");
+                LOG_INFO_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                                 "Got embedding from service");
                 return embedding;
             }
         }
         
-        Logger::warn("DocumentProcessor", "Embedding service unavailable, using fallback");
+        LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                         "Embedding service unavailable, using fallback");
         
     } catch (const std::exception& e) {
-        Logger::warn("DocumentProcessor", 
-                    std::string("Embedding service error: ") + e.what() + ", using fallback");
+        LOG_WARNF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                          "Embedding service error: {}, using fallback", e.what());
     }
     
+    // A timeout caused by the deadline is not the service being down
+    context.check("embedding");
+    
     // Fallback: generate deterministic random embedding for testing
-    Logger::warn("DocumentProcessor", "Using stub embedding generation (random)");
+    LOG_WARN_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                     "Using stub embedding generation (random)");
     
     const size_t embedding_dim = 384;  // sentence-transformers dimension
     std::vector<float> embedding(embedding_dim);
@@ -399,8 +497,8 @@ bool DocumentProcessor::create_memory(const std::string& doc_id,
         return true;
         
     } catch (const std::exception& e) {
-        Logger::error("DocumentProcessor", 
-                     "Failed to create memory: " + std::string(e.what()));
+        LOG_ERRORF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                           "Failed to create memory: {}", e.what());
         return false;
     }
 }
@@ -413,8 +511,8 @@ bool DocumentProcessor::index_document(const std::string& doc_id,
         return cognitive_.index_document(doc_id, embedding, text, metadata);
         
     } catch (const std::exception& e) {
-        Logger::error("DocumentProcessor", 
-                     "Failed to index document: " + std::string(e.what()));
+        LOG_ERRORF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                           "Failed to index document: {}", e.what());
         return false;
     }
 }
@@ -1,4 +1,7 @@
 #include "document/ocr_client.hpp"
+#include "logging/logger.hpp"
+#include "monitoring/metrics.hpp"
+#include "resilience/hedging.hpp"
 #include <fstream>
 #include <sstream>
 #include <random>
@@ -10,19 +13,7 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
-
-// Logger placeholder (replace with full logging system if available)
-namespace Logger {
-    inline void info(const std::string& component, const std::string& message) {
-        std::cout << "[INFO] " << component << ": " << message << std::endl;
-    }
-    inline void warn(const std::string& component, const std::string& message) {
-        std::cout << "[WARN] " << component << ": " << message << std::endl;
-    }
-    inline void error(const std::string& component, const std::string& message) {
-        std::cerr << "[ERROR] " << component << ": " << message << std::endl;
-    }
-}
+#include <mutex>
 
 // cpp-httplib for HTTP client (will be fetched by CMake)
 #define CPPHTTPLIB_OPENSSL_SUPPORT
@@ -31,6 +22,25 @@ namespace Logger {
 namespace brain_ai::document {
 
 namespace {
+
+using logging::sampling::kProgressFirstN;
+using logging::sampling::kProgressEveryM;
+using logging::sampling::kFailureFirstN;
+using logging::sampling::kFailureEveryM;
+
+const std::shared_ptr<logging::Logger>& logger() {
+    static const auto instance = GET_LOGGER(logging::logger_names::OCR);
+    return instance;
+}
+
+// Failed result of a request its caller gave up on
+OCRResult cancelled_result(const RequestContext& context) {
+    OCRResult result;
+    result.success = false;
+    result.error_message = context.cancelled() ? "Request cancelled" : "Deadline exceeded";
+    return result;
+}
+
 struct ParsedUrl {
     std::string scheme;
     std::string host;
@@ -175,26 +185,13 @@ void apply_timeout(ClientType& client, const OCRConfig& config) {
     apply([&](time_t sec, time_t usec) { client.set_write_timeout(sec, usec); }, write_timeout);
 }
 
-} // namespace
-
-// PIMPL implementation details
-struct OCRClient::Impl {
+// One HTTP(S) connection to a replica. httplib serializes requests on a
+// client, so concurrent (hedged) attempts each take their own.
+struct Connection {
     std::unique_ptr<httplib::Client> http_client;
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
     std::unique_ptr<httplib::SSLClient> https_client;
 #endif
-    std::string base_path;
-    std::string host;
-    int port{0};
-    std::string scheme;
-    
-    // Helper template to apply timeout to both client types
-    template<typename ClientType>
-    void configure_client(ClientType& client, const OCRConfig& config) {
-        client.set_keep_alive(true);
-        client.set_follow_location(true);
-        apply_timeout(client, config);
-    }
     
     // Unified POST method
     httplib::Result do_post(const std::string& path, const std::string& body, const std::string& content_type) {
@@ -216,8 +213,35 @@ struct OCRClient::Impl {
         return http_client->Get(path.c_str());
     }
     
-    explicit Impl(const OCRConfig& config) {
-        ParsedUrl parsed = parse_url(config.service_url);
+    // Abort an in-flight request from another thread (closes the socket)
+    void stop() {
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (https_client) {
+            https_client->stop();
+            return;
+        }
+#endif
+        http_client->stop();
+    }
+};
+
+// A validated OCR service address with its idle connections
+struct Endpoint {
+    static constexpr size_t kMaxIdleConnections = 4;
+    
+    std::string url;
+    std::string base_path;
+    std::string host;
+    int port{0};
+    std::string scheme;
+    OCRConfig config;   // Timeouts for new connections
+    
+    std::mutex pool_mutex;
+    std::vector<std::unique_ptr<Connection>> idle;
+    
+    Endpoint(const std::string& service_url, const OCRConfig& client_config)
+        : url(service_url), config(client_config) {
+        ParsedUrl parsed = parse_url(service_url);
         scheme = parsed.scheme;
         host = parsed.host;
         port = parsed.port;
@@ -240,28 +264,59 @@ struct OCRClient::Impl {
 
         base_path = sanitize_path(parsed.path);
 
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        if (scheme == "https") {
-            https_client = std::make_unique<httplib::SSLClient>(host.c_str(), port);
-            https_client->enable_server_certificate_verification(true);
-            configure_client(*https_client, config);
-        } else {
-            http_client = std::make_unique<httplib::Client>(host.c_str(), port);
-            configure_client(*http_client, config);
-        }
-#else
+#ifndef CPPHTTPLIB_OPENSSL_SUPPORT
         if (scheme == "https") {
             throw std::runtime_error("HTTPS OCR endpoints require OpenSSL support");
         }
-        http_client = std::make_unique<httplib::Client>(host.c_str(), port);
-        configure_client(*http_client, config);
 #endif
 
-        Logger::info(
-            "OCRClient",
-            "HTTP client bound to " + scheme + "://" + host + ":" + std::to_string(port) +
-                (base_path.empty() ? std::string() : base_path)
-        );
+        // First client up front, so TLS setup errors surface here
+        release(connect());
+
+        LOG_INFOF(logger(), "HTTP client bound to {}://{}:{}{}", scheme, host, port, base_path);
+    }
+    
+    // Helper template to apply timeout to both client types
+    template<typename ClientType>
+    void configure_client(ClientType& client) {
+        client.set_keep_alive(true);
+        client.set_follow_location(true);
+        apply_timeout(client, config);
+    }
+    
+    std::unique_ptr<Connection> connect() {
+        auto connection = std::make_unique<Connection>();
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+        if (scheme == "https") {
+            connection->https_client = std::make_unique<httplib::SSLClient>(host.c_str(), port);
+            connection->https_client->enable_server_certificate_verification(true);
+            configure_client(*connection->https_client);
+            return connection;
+        }
+#endif
+        connection->http_client = std::make_unique<httplib::Client>(host.c_str(), port);
+        configure_client(*connection->http_client);
+        return connection;
+    }
+    
+    // Reuse an idle (kept-alive) connection or open a new one
+    std::unique_ptr<Connection> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (!idle.empty()) {
+                auto connection = std::move(idle.back());
+                idle.pop_back();
+                return connection;
+            }
+        }
+        return connect();
+    }
+    
+    void release(std::unique_ptr<Connection> connection) {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (idle.size() < kMaxIdleConnections) {
+            idle.push_back(std::move(connection));
+        }
     }
 
     std::string resolve_endpoint(const std::string& endpoint) const {
@@ -290,6 +345,46 @@ struct OCRClient::Impl {
     }
 };
 
+resilience::HedgingConfig hedging_config(const OCRConfig& config, size_t replicas) {
+    resilience::HedgingConfig hedging;
+    hedging.max_attempts = static_cast<size_t>(std::max(config.max_retries, 1));
+    hedging.max_hedges = replicas > 1 ? static_cast<size_t>(std::max(config.max_hedges, 0)) : 0;
+    hedging.hedge_percentile = config.hedge_percentile;
+    hedging.initial_hedge_delay = config.hedge_delay;
+    hedging.backoff.base = config.retry_delay;
+    hedging.backoff.max = config.max_retry_delay;
+    // Room for every concurrent call's attempts, not one set per core
+    hedging.attempt_threads = (1 + hedging.max_hedges) *
+                              static_cast<size_t>(std::max(config.max_concurrent_requests, 1));
+    return hedging;
+}
+
+} // namespace
+
+// PIMPL implementation details
+struct OCRClient::Impl {
+    std::vector<std::unique_ptr<Endpoint>> endpoints;   // service_url first, then replicas
+    std::unique_ptr<resilience::HedgedExecutor> executor;
+    
+    explicit Impl(const OCRConfig& config) {
+        endpoints.push_back(std::make_unique<Endpoint>(config.service_url, config));
+        for (const auto& url : config.replica_urls) {
+            endpoints.push_back(std::make_unique<Endpoint>(url, config));
+        }
+        executor = std::make_unique<resilience::HedgedExecutor>(
+            hedging_config(config, endpoints.size()), endpoints.size());
+    }
+    
+    // Health and status checks go to the primary service
+    httplib::Result do_get(const std::string& path) {
+        Endpoint& primary = *endpoints.front();
+        auto connection = primary.acquire();
+        auto response = connection->do_get(path);
+        primary.release(std::move(connection));
+        return response;
+    }
+};
+
 OCRClient::OCRClient(const OCRConfig& config)
     : config_(config) {
     try {
@@ -306,9 +401,9 @@ OCRClient::OCRClient(const OCRConfig& config)
 
         config_ = local_config;
         pimpl_ = std::make_unique<Impl>(config_);
-        Logger::info("OCRClient", "Initialized with service URL: " + config_.service_url);
+        LOG_INFO(logger(), "Initialized with service URL: " + config_.service_url);
     } catch (const std::exception& e) {
-        Logger::error("OCRClient", "Failed to initialize: " + std::string(e.what()));
+        LOG_ERROR(logger(), "Failed to initialize: " + std::string(e.what()));
         throw;
     }
 }
@@ -318,8 +413,13 @@ OCRClient::~OCRClient() = default;
 OCRClient::OCRClient(OCRClient&&) noexcept = default;
 OCRClient& OCRClient::operator=(OCRClient&&) noexcept = default;
 
-OCRResult OCRClient::process_file(const std::string& filepath) {
-    Logger::info("OCRClient", "Processing file: " + filepath);
+OCRResult OCRClient::process_file(const std::string& filepath,
+                                  const RequestContext& context) {
+    if (context.should_stop("ocr")) {
+        return cancelled_result(context);
+    }
+    
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM, "Processing file: {}", filepath);
     
     // Read file into memory
     std::ifstream file(filepath, std::ios::binary | std::ios::ate);
@@ -327,7 +427,7 @@ OCRResult OCRClient::process_file(const std::string& filepath) {
         OCRResult result;
         result.success = false;
         result.error_message = "Failed to open file: " + filepath;
-        Logger::error("OCRClient", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
         return result;
     }
     
@@ -339,7 +439,7 @@ OCRResult OCRClient::process_file(const std::string& filepath) {
         OCRResult result;
         result.success = false;
         result.error_message = "Failed to read file: " + filepath;
-        Logger::error("OCRClient", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
         return result;
     }
     
@@ -354,15 +454,20 @@ OCRResult OCRClient::process_file(const std::string& filepath) {
         else if (ext == "tiff" || ext == "tif") mime_type = "image/tiff";
     }
     
-    return process_image(buffer, mime_type);
+    return process_image(buffer, mime_type, context);
 }
 
 OCRResult OCRClient::process_image(const std::vector<uint8_t>& image_data,
-                                   const std::string& mime_type) {
+                                   const std::string& mime_type,
+                                   const RequestContext& context) {
+    if (context.should_stop("ocr")) {
+        return cancelled_result(context);
+    }
+    
     auto start_time = std::chrono::steady_clock::now();
     
-    Logger::info("OCRClient", "Processing image (" + std::to_string(image_data.size()) + 
-                 " bytes, type: " + mime_type + ")");
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                      "Processing image ({} bytes, type: {})", image_data.size(), mime_type);
     
     // Create multipart form data
     std::string boundary = generate_boundary();
@@ -371,18 +476,24 @@ OCRResult OCRClient::process_image(const std::vector<uint8_t>& image_data,
     std::string content_type = "multipart/form-data; boundary=" + boundary;
     
     // Make request with retries
-    auto response = make_request("/ocr/extract", body, content_type);
+    auto response = make_request("/ocr/extract", body, content_type, context);
     
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
         end_time - start_time);
     
+    if (!response && context.expired()) {
+        OCRResult result = cancelled_result(context);
+        result.processing_time = duration;
+        return result;
+    }
+    
     if (!response) {
         OCRResult result;
         result.success = false;
         result.error_message = "Failed to get response from OCR service";
         result.processing_time = duration;
-        Logger::error("OCRClient", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
         return result;
     }
     
@@ -390,18 +501,29 @@ OCRResult OCRClient::process_image(const std::vector<uint8_t>& image_data,
     auto result = parse_response(*response);
     result.processing_time = duration;
     
-    Logger::info("OCRClient", "Processing completed in " + 
-                std::to_string(duration.count()) + "ms");
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                      "Processing completed in {}ms", duration.count());
     
     return result;
 }
 
-std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>& filepaths) {
-    Logger::info("OCRClient", "Batch processing " + std::to_string(filepaths.size()) + " files");
+std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>& filepaths,
+                                                const RequestContext& context) {
+    LOG_INFOF(logger(), "Batch processing {} files", filepaths.size());
     
     std::vector<OCRResult> results;
     results.reserve(filepaths.size());
     
+    // Files not started by the time the batch expires are skipped
+    auto process = [this, &context](const std::string& filepath) {
+        if (context.should_stop("ocr_batch")) {
+            monitoring::MetricsRegistry::instance()
+                .get_counter(monitoring::metric_names::CANCELLED_BATCH_ITEMS).increment();
+            return cancelled_result(context);
+        }
+        return process_file(filepath, context);
+    };
+    
     // Process files in parallel for better performance
     // Use thread pool with max 4 concurrent requests to avoid overwhelming the service
     const size_t max_threads = std::min(size_t(4), filepaths.size());
@@ -413,7 +535,7 @@ std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>&
         
         for (const auto& filepath : filepaths) {
             futures.push_back(std::async(std::launch::async, 
-                [this, filepath]() { return process_file(filepath); }
+                [&process, filepath]() { return process(filepath); }
             ));
         }
         
@@ -424,7 +546,7 @@ std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>&
     } else {
         // Sequential processing for single file or when parallelization disabled
         for (const auto& filepath : filepaths) {
-            results.push_back(process_file(filepath));
+            results.push_back(process(filepath));
         }
     }
     
@@ -433,8 +555,8 @@ std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>&
         if (result.success) success_count++;
     }
     
-    Logger::info("OCRClient", "Batch completed: " + std::to_string(success_count) + 
-                "/" + std::to_string(results.size()) + " succeeded");
+    LOG_INFOF(logger(), "Batch completed: {}/{} succeeded", success_count, results.size());
+    logger()->report_suppressed();
     
     return results;
 }
@@ -444,22 +566,21 @@ bool OCRClient::check_health() {
         auto response = pimpl_->do_get("/health");
         
         if (!response || response->status != 200) {
-            Logger::warn("OCRClient", "Health check failed: status " + 
-                        std::to_string(response ? response->status : 0));
+            LOG_WARNF(logger(), "Health check failed: status {}", response ? response->status : 0);
             return false;
         }
         
         // Parse response
         auto json = nlohmann::json::parse(response->body, nullptr, false);
         if (json.is_discarded()) {
-            Logger::warn("OCRClient", "Health check: invalid JSON response");
+            LOG_WARN(logger(), "Health check: invalid JSON response");
             return false;
         }
         
         return json.value("status", "") == "healthy";
         
     } catch (const std::exception& e) {
-        Logger::error("OCRClient", "Health check exception: " + std::string(e.what()));
+        LOG_ERROR(logger(), "Health check exception: " + std::string(e.what()));
         return false;
     }
 }
@@ -480,7 +601,7 @@ nlohmann::json OCRClient::get_service_status() {
         return json;
         
     } catch (const std::exception& e) {
-        Logger::error("OCRClient", "Get status exception: " + std::string(e.what()));
+        LOG_ERROR(logger(), "Get status exception: " + std::string(e.what()));
         return nlohmann::json::object();
     }
 }
@@ -496,62 +617,82 @@ void OCRClient::update_config(const OCRConfig& config) {
         }
     }
     
-    // Recreate HTTP client if URL changed
-    bool has_client = pimpl_->http_client != nullptr;
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-    has_client = has_client || (pimpl_->https_client != nullptr);
-#endif
-    if (has_client) {
-        pimpl_ = std::make_unique<Impl>(config_);
-    }
+    // Recreate the replica connections (URLs or timeouts may have changed)
+    pimpl_ = std::make_unique<Impl>(config_);
     
-    Logger::info("OCRClient", "Configuration updated");
+    LOG_INFO(logger(), "Configuration updated");
 }
 
 std::optional<std::string> OCRClient::make_request(const std::string& endpoint,
                                                    const std::string& body,
-                                                   const std::string& content_type) {
-    int attempt = 0;
-    
-    while (attempt < config_.max_retries) {
+                                                   const std::string& content_type,
+                                                   const RequestContext& context) {
+    Impl& impl = *pimpl_;
+    
+    auto send = [&](size_t target, resilience::AttemptContext& attempt)
+        -> std::optional<std::string> {
+        Endpoint& replica = *impl.endpoints[target];
+        auto connection = replica.acquire();
+        Connection* active = connection.get();
+        attempt.on_cancel([active]() { active->stop(); });
+        
+        std::optional<std::string> result;
         try {
-            const auto full_endpoint = pimpl_->resolve_endpoint(endpoint);
-            auto response = pimpl_->do_post(full_endpoint, body, content_type);
-            
-            if (!response) {
-                Logger::warn("OCRClient", "Request failed: no response (attempt " + 
-                           std::to_string(attempt + 1) + ")");
-                attempt++;
-                if (attempt < config_.max_retries) {
-                    std::this_thread::sleep_for(config_.retry_delay);
-                }
-                continue;
-            }
+            const auto full_endpoint = replica.resolve_endpoint(endpoint);
+            auto response = active->do_post(full_endpoint, body, content_type);
             
-            if (response->status != 200) {
-                Logger::warn("OCRClient", "Request failed: HTTP " + 
-                           std::to_string(response->status) + " (attempt " +
-                           std::to_string(attempt + 1) + ")");
-                attempt++;
-                if (attempt < config_.max_retries) {
-                    std::this_thread::sleep_for(config_.retry_delay);
-                }
-                continue;
+            if (attempt.cancelled()) {
+                // Lost to another attempt; not a replica failure
+            } else if (!response) {
+                LOG_WARNF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                                  "Request to {} failed: no response", replica.url);
+            } else if (response->status != 200) {
+                LOG_WARNF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                                  "Request to {} failed: HTTP {}", replica.url, response->status);
+            } else {
+                result = response->body;
             }
-            
-            return response->body;
-            
         } catch (const std::exception& e) {
-            Logger::error("OCRClient", "Request exception: " + std::string(e.what()) +
-                         " (attempt " + std::to_string(attempt + 1) + ")");
-            attempt++;
-            if (attempt < config_.max_retries) {
-                std::this_thread::sleep_for(config_.retry_delay);
-            }
+            LOG_ERRORF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                               "Request to {} exception: {}", replica.url, e.what());
         }
+        
+        // A stopped connection is not reused
+        attempt.on_cancel(nullptr);
+        if (!attempt.cancelled()) {
+            replica.release(std::move(connection));
+        }
+        return result;
+    };
+    
+    std::function<bool()> cancelled;
+    if (context.can_expire()) {
+        cancelled = [&context]() { return context.cancelled(); };
+    }
+    auto outcome = impl.executor->execute(send, context.deadline(), cancelled);
+    
+    auto& metrics = monitoring::MetricsRegistry::instance();
+    size_t primaries = outcome.attempts - outcome.hedges;   // Zero if abandoned before the first
+    size_t retries = primaries > 0 ? primaries - 1 : 0;
+    if (retries > 0) {
+        metrics.get_counter(monitoring::metric_names::OCR_RETRIES).increment(static_cast<int64_t>(retries));
+    }
+    if (outcome.hedges > 0) {
+        metrics.get_counter(monitoring::metric_names::OCR_HEDGED_REQUESTS).increment();
+    }
+    if (outcome.hedge_won) {
+        metrics.get_counter(monitoring::metric_names::OCR_HEDGE_WINS).increment();
+    }
+    if (outcome.abandoned) {
+        // The caller gave up; not a service failure
+        context.should_stop("ocr");
+    } else if (!outcome.value) {
+        metrics.get_counter(monitoring::metric_names::OCR_REQUESTS_FAILED).increment();
+        LOG_ERRORF_SAMPLED(logger(), kFailureFirstN, kFailureEveryM,
+                           "Request failed after {} attempts", outcome.attempts);
     }
     
-    return std::nullopt;
+    return outcome.value;
 }
 
 OCRResult OCRClient::parse_response(const std::string& json_str) {
@@ -583,7 +724,7 @@ OCRResult OCRClient::parse_response(const std::string& json_str) {
     } catch (const std::exception& e) {
         result.success = false;
         result.error_message = "Failed to parse response: " + std::string(e.what());
-        Logger::error("OCRClient", result.error_message);
+        LOG_ERROR_SAMPLED(logger(), kFailureFirstN, kFailureEveryM, result.error_message);
     }
     
     return result;
@@ -1,17 +1,23 @@
 #include "document/text_validator.hpp"
+#include "logging/logger.hpp"
 #include <algorithm>
 #include <cctype>
 #include <sstream>
 #include <iostream>
 
-// Logger placeholder (replace with full logging system if available)
-namespace Logger {
-    inline void info(const std::string& component, const std::string& message) {
-        std::cout << "[INFO] " << component << ": " << message << std::endl;
-    }
+namespace brain_ai::document {
+
+namespace {
+
+using logging::sampling::kProgressFirstN;
+using logging::sampling::kProgressEveryM;
+
+const std::shared_ptr<logging::Logger>& logger() {
+    static const auto instance = GET_LOGGER(logging::logger_names::VALIDATOR);
+    return instance;
 }
 
-namespace brain_ai::document {
+} // namespace
 
 // Common OCR artifacts to remove
 const std::unordered_set<std::string> TextValidator::ocr_artifacts_ = {
@@ -43,7 +49,7 @@ const std::vector<std::pair<std::regex, std::string>> TextValidator::substitutio
 
 TextValidator::TextValidator(const ValidationConfig& config)
     : config_(config) {
-    Logger::info("TextValidator", "Initialized with validation rules");
+    LOG_INFO(logger(), "Initialized with validation rules");
 }
 
 ValidationResult TextValidator::validate(const std::string& text) const {
@@ -97,17 +103,16 @@ ValidationResult TextValidator::validate(const std::string& text) const {
     result.warnings = warnings;
     result.is_valid = confidence >= config_.min_confidence_threshold;
     
-    Logger::info("TextValidator", 
-                "Validation complete: confidence=" + std::to_string(confidence) +
-                ", errors=" + std::to_string(errors_corrected) +
-                ", warnings=" + std::to_string(warnings.size()));
+    LOG_INFOF_SAMPLED(logger(), kProgressFirstN, kProgressEveryM,
+                      "Validation complete: confidence={}, errors={}, warnings={}",
+                      confidence, errors_corrected, warnings.size());
     
     return result;
 }
 
 void TextValidator::update_config(const ValidationConfig& config) {
     config_ = config;
-    Logger::info("TextValidator", "Configuration updated");
+    LOG_INFO(logger(), "Configuration updated");
 }
 
 std::string TextValidator::remove_artifacts(const std::string& text) const {
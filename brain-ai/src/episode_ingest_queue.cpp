@@ -0,0 +1,184 @@
+#include "episode_ingest_queue.hpp"
+#include "monitoring/metrics.hpp"
+#include <memory>
+#include <unordered_map>
+
+namespace brain_ai {
+
+EpisodeIngestQueue::EpisodeIngestQueue(SessionEpisodicStore& store,
+                                       const EpisodeIngestConfig& config)
+    : store_(store), config_(config), head_(&stub_), tail_(&stub_) {
+    if (config_.max_batch == 0) {
+        config_.max_batch = 1;
+    }
+    worker_ = std::thread(&EpisodeIngestQueue::worker_loop, this);
+}
+
+EpisodeIngestQueue::~EpisodeIngestQueue() {
+    running_.store(false);
+    wake_worker();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void EpisodeIngestQueue::push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+EpisodeIngestQueue::Node* EpisodeIngestQueue::pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+
+    if (tail != head_.load(std::memory_order_acquire)) {
+        return nullptr;  // A producer is between exchange and link; retry later
+    }
+
+    // Last element: re-insert the stub so tail can be detached
+    push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void EpisodeIngestQueue::wake_worker() {
+    // Pairs with the idle check in worker_loop: either the worker sees the
+    // new backlog before sleeping, or we see it idle and notify under the lock
+    if (worker_idle_.load() || !running_.load()) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+void EpisodeIngestQueue::enqueue(const std::string& session_id,
+                                 const std::string& query,
+                                 const std::string& response,
+                                 const std::vector<float>& query_embedding,
+                                 const std::unordered_map<std::string, std::string>& metadata) {
+    // Backpressure: wait (rather than reorder or drop) when far behind
+    if (backlog() >= config_.max_queued) {
+        wake_worker();
+        std::unique_lock<std::mutex> lock(progress_mutex_);
+        progress_cv_.wait(lock, [this] {
+            return backlog() < config_.max_queued || !running_.load();
+        });
+    }
+
+    auto node = std::make_unique<Node>();
+    node->session_id = session_id;
+    node->episode.emplace(query, response, query_embedding,
+                          Episode::current_timestamp_ms(), metadata);
+
+    enqueued_.fetch_add(1);
+    push(node.release());
+    wake_worker();
+}
+
+size_t EpisodeIngestQueue::drain_once() {
+    // Group by session, preserving enqueue order within each session
+    std::vector<std::pair<std::string, std::vector<Episode>>> groups;
+    std::unordered_map<std::string, size_t> group_index;
+    size_t drained = 0;
+
+    while (drained < config_.max_batch) {
+        Node* node = pop();
+        if (node == nullptr) {
+            break;
+        }
+        std::unique_ptr<Node> owned(node);
+
+        auto [it, inserted] = group_index.try_emplace(owned->session_id, groups.size());
+        if (inserted) {
+            groups.emplace_back(owned->session_id, std::vector<Episode>());
+        }
+        groups[it->second].second.push_back(std::move(*owned->episode));
+        ++drained;
+    }
+
+    if (drained == 0) {
+        return 0;
+    }
+
+    // A failed group is dropped and counted; the rest still go in, and
+    // applied_ advances regardless so flush() cannot hang on it
+    size_t failed = 0;
+    for (auto& [session_id, episodes] : groups) {
+        size_t count = episodes.size();
+        try {
+            store_.add_episodes(session_id, std::move(episodes));
+        } catch (...) {
+            failed += count;
+        }
+    }
+    if (failed > 0) {
+        failed_.fetch_add(failed, std::memory_order_relaxed);
+        monitoring::MetricsRegistry::instance()
+            .get_counter(monitoring::metric_names::EPISODES_DROPPED)
+            .increment(static_cast<int64_t>(failed));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(progress_mutex_);
+        applied_.fetch_add(drained, std::memory_order_release);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    progress_cv_.notify_all();
+    return drained;
+}
+
+void EpisodeIngestQueue::flush() {
+    size_t target = enqueued_.load(std::memory_order_acquire);
+    wake_worker();
+
+    std::unique_lock<std::mutex> lock(progress_mutex_);
+    progress_cv_.wait(lock, [this, target] {
+        return applied_.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void EpisodeIngestQueue::worker_loop() {
+    while (true) {
+        if (drain_once() > 0) {
+            continue;
+        }
+
+        if (!running_.load()) {
+            // Final drain: producers are done, so everything is linked
+            if (backlog() == 0) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        worker_idle_.store(true);
+        if (enqueued_.load() == applied_.load() && running_.load()) {
+            wake_cv_.wait(lock);
+        }
+        worker_idle_.store(false);
+    }
+
+    progress_cv_.notify_all();
+}
+
+} // namespace brain_ai
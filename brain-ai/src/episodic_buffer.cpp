@@ -1,5 +1,7 @@
 #include "episodic_buffer.hpp"
+#include "quantization.hpp"
 #include "utils.hpp"
+#include "monitoring/perf_counters.hpp"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -23,9 +25,150 @@ uint64_t Episode::current_timestamp_ms() {
     ).count();
 }
 
+size_t Episode::memory_usage_bytes() const {
+    size_t bytes = sizeof(Episode) + query.size() + response.size() +
+                   query_embedding.size() * sizeof(float) +
+                   quantized_embedding.size() * sizeof(int8_t) +
+                   rescore_embedding.size() * sizeof(uint16_t);
+    for (const auto& [key, value] : metadata) {
+        bytes += key.size() + value.size();
+    }
+    return bytes;
+}
+
+size_t Episode::embedding_dim() const {
+    return is_quantized() ? quantized_embedding.size() : query_embedding.size();
+}
+
+std::vector<float> Episode::embedding() const {
+    if (!is_quantized()) {
+        return query_embedding;
+    }
+    
+    std::vector<float> result(quantized_embedding.size());
+    if (rescore_embedding.size() == result.size()) {
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = bf16_to_float(rescore_embedding[i]);
+        }
+    } else {
+        dequantize_int8(quantized_embedding.data(), result.size(),
+                        quantization_scale, result.data());
+    }
+    return result;
+}
+
+void Episode::quantize(bool keep_rescore_copy) {
+    if (query_embedding.empty()) {
+        return;
+    }
+    
+    quantized_embedding.resize(query_embedding.size());
+    quantization_scale = quantize_int8(query_embedding.data(), query_embedding.size(),
+                                       quantized_embedding.data());
+    quantized_norm = std::sqrt(static_cast<float>(
+        dot_product_int8(quantized_embedding.data(), quantized_embedding.data(),
+                         quantized_embedding.size())));
+    
+    if (keep_rescore_copy) {
+        rescore_embedding.resize(query_embedding.size());
+        for (size_t i = 0; i < query_embedding.size(); ++i) {
+            rescore_embedding[i] = float_to_bf16(query_embedding[i]);
+        }
+    }
+    
+    query_embedding.clear();
+    query_embedding.shrink_to_fit();
+}
+
+namespace {
+
+// Copy handed to callers: always carries an fp32 query_embedding
+Episode materialize(const Episode& episode) {
+    if (!episode.is_quantized()) {
+        return episode;
+    }
+    Episode copy(episode.query, episode.response, episode.embedding(),
+                 episode.timestamp_ms, episode.metadata);
+    return copy;
+}
+
+// Hardware counter stage of retrieve_similar (metrics perf_<stage>_<event>)
+monitoring::PerfStage kRetrieveStage("episodic_retrieve");
+
+} // namespace
+
 // EpisodicBuffer implementation
-EpisodicBuffer::EpisodicBuffer(size_t capacity) 
-    : max_capacity_(capacity) {}
+EpisodicBuffer::EpisodicBuffer(size_t capacity,
+                               const ConsolidationConfig& consolidation,
+                               const EmbeddingStorageConfig& storage) 
+    : max_capacity_(capacity), consolidation_(consolidation), storage_(storage),
+      snapshot_(std::make_shared<Snapshot>()) {}
+
+EpisodicBuffer::Block::~Block() {
+    for (size_t i = 0; i < constructed_; ++i) {
+        std::launder(reinterpret_cast<Episode*>(&slots[i]))->~Episode();
+    }
+}
+
+void EpisodicBuffer::Block::put(size_t index, Episode&& episode) {
+    size_t bytes = episode.memory_usage_bytes();
+    if (index < constructed_) {
+        // Left behind by a writer that failed before publishing
+        Episode& slot = *std::launder(reinterpret_cast<Episode*>(&slots[index]));
+        bytes_ -= slot.memory_usage_bytes();
+        slot = std::move(episode);
+        bytes_ += bytes;
+        return;
+    }
+    new (&slots[index]) Episode(std::move(episode));
+    constructed_ = index + 1;
+    bytes_ += bytes;
+}
+
+const Episode& EpisodicBuffer::Snapshot::at(size_t index) const {
+    size_t slot = head + index;
+    return (*blocks[slot / kBlockSize])[slot % kBlockSize];
+}
+
+template <typename Fn>
+void EpisodicBuffer::Snapshot::for_each(Fn&& fn) const {
+    size_t slot = head;
+    size_t end = head + count;
+    while (slot < end) {
+        const Block& block = *blocks[slot / kBlockSize];
+        size_t block_end = std::min(end, (slot / kBlockSize + 1) * kBlockSize);
+        for (; slot < block_end; ++slot) {
+            fn(block[slot % kBlockSize]);
+        }
+    }
+}
+
+std::shared_ptr<const EpisodicBuffer::Snapshot> EpisodicBuffer::load_snapshot() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+void EpisodicBuffer::publish(std::shared_ptr<const Snapshot> snapshot) {
+    std::atomic_store_explicit(&snapshot_, std::move(snapshot), std::memory_order_release);
+}
+
+size_t EpisodicBuffer::drop_front(Snapshot& snapshot, size_t n) {
+    n = std::min(n, snapshot.count);
+    snapshot.head += n;
+    snapshot.count -= n;
+    
+    // Release fully evicted blocks (freed once no reader holds them)
+    size_t dead_blocks = std::min(snapshot.head / kBlockSize, snapshot.blocks.size());
+    if (snapshot.count == 0) {
+        dead_blocks = snapshot.blocks.size();
+    }
+    size_t released_bytes = 0;
+    for (size_t i = 0; i < dead_blocks; ++i) {
+        released_bytes += snapshot.blocks[i]->bytes();
+    }
+    snapshot.blocks.erase(snapshot.blocks.begin(), snapshot.blocks.begin() + dead_blocks);
+    snapshot.head = snapshot.count == 0 ? 0 : snapshot.head - dead_blocks * kBlockSize;
+    return released_bytes;
+}
 
 void EpisodicBuffer::add_episode(
     const std::string& query,
@@ -33,27 +176,87 @@ void EpisodicBuffer::add_episode(
     const std::vector<float>& query_embedding,
     const std::unordered_map<std::string, std::string>& metadata
 ) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Create episode
+    // Create (and quantize) the episode before taking the lock
     Episode episode(query, response, query_embedding, 
                     Episode::current_timestamp_ms(), metadata);
+    if (storage_.precision == EmbeddingPrecision::Int8) {
+        episode.quantize(storage_.rescore_candidates > 0);
+    }
+    
+    std::vector<Episode> batch;
+    batch.push_back(std::move(episode));
+    append(std::move(batch));
+}
+
+void EpisodicBuffer::add_episodes(std::vector<Episode> episodes) {
+    if (storage_.precision == EmbeddingPrecision::Int8) {
+        for (auto& episode : episodes) {
+            episode.quantize(storage_.rescore_candidates > 0);
+        }
+    }
+    append(std::move(episodes));
+}
+
+void EpisodicBuffer::append(std::vector<Episode>&& episodes) {
+    if (episodes.empty()) {
+        return;
+    }
     
-    // Add to buffer
-    buffer_.push_back(std::move(episode));
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    // Evict oldest if full
-    if (buffer_.size() > max_capacity_) {
-        buffer_.pop_front();
+    auto next = std::make_shared<Snapshot>(*load_snapshot());
+    
+    // Append into slots no published snapshot can see yet
+    for (auto& episode : episodes) {
+        size_t slot = next->head + next->count;
+        if (slot == next->blocks.size() * kBlockSize) {
+            next->blocks.push_back(std::make_shared<Block>());
+        }
+        memory_bytes_.fetch_add(episode.memory_usage_bytes(), std::memory_order_relaxed);
+        next->blocks.back()->put(slot % kBlockSize, std::move(episode));
+        ++next->count;
+    }
+    
+    // Evict oldest if full (queued for consolidation when enabled).
+    // Readers may still hold the slots, so they are copied, never moved,
+    // and stay charged until their block is released.
+    if (next->count > max_capacity_) {
+        size_t overflow = next->count - max_capacity_;
+        if (consolidation_.enabled) {
+            for (size_t i = 0; i < overflow; ++i) {
+                Episode copy(next->at(i));
+                memory_bytes_.fetch_add(copy.memory_usage_bytes(), std::memory_order_relaxed);
+                queue_for_consolidation(std::move(copy));
+            }
+        }
+        memory_bytes_.fetch_sub(drop_front(*next, overflow), std::memory_order_relaxed);
+    }
+    
+    publish(std::move(next));
+}
+
+void EpisodicBuffer::queue_for_consolidation(Episode&& episode) {
+    pending_.push_back(std::move(episode));
+    
+    // Bound the backlog if consolidation falls behind
+    while (pending_.size() > std::max<size_t>(consolidation_.max_pending, 1)) {
+        memory_bytes_.fetch_sub(pending_.front().memory_usage_bytes(),
+                                std::memory_order_relaxed);
+        pending_.pop_front();
     }
 }
 
 std::vector<Episode> EpisodicBuffer::retrieve_similar(
     const std::vector<float>& query_embedding,
     size_t top_k,
-    float similarity_threshold
+    float similarity_threshold,
+    const RequestContext& context
 ) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    monitoring::PerfScope perf_scope(kRetrieveStage);
+    context.check("episodic");
+    
+    // Lock-free: scan the currently published snapshot
+    auto snapshot = load_snapshot();
     
     // Compute similarity + temporal decay for each episode
     struct ScoredEpisode {
@@ -62,14 +265,45 @@ std::vector<Episode> EpisodicBuffer::retrieve_similar(
     };
     
     std::vector<ScoredEpisode> scored_episodes;
-    scored_episodes.reserve(buffer_.size());
+    scored_episodes.reserve(snapshot->count);
     
     uint64_t current_time = Episode::current_timestamp_ms();
     
-    for (const auto& episode : buffer_) {
+    // Int8 storage: quantize the query once and score with the integer kernel
+    bool rescore = storage_.precision == EmbeddingPrecision::Int8 &&
+                   storage_.rescore_candidates > 0;
+    float candidate_threshold = rescore ? similarity_threshold - storage_.rescore_margin
+                                        : similarity_threshold;
+    std::vector<int8_t> query_codes;
+    float query_code_norm = 0.0f;
+    if (storage_.precision == EmbeddingPrecision::Int8) {
+        query_codes.resize(query_embedding.size());
+        quantize_int8(query_embedding.data(), query_embedding.size(), query_codes.data());
+        query_code_norm = std::sqrt(static_cast<float>(
+            dot_product_int8(query_codes.data(), query_codes.data(), query_codes.size())));
+    }
+    
+    size_t scanned = 0;
+    snapshot->for_each([&](const Episode& episode) {
+        if (++scanned % kCancelCheckEpisodes == 0) {
+            context.check("episodic");
+        }
+        
         // Cosine similarity
-        float similarity = cosine_similarity(query_embedding, 
-                                             episode.query_embedding);
+        float similarity = 0.0f;
+        if (episode.is_quantized()) {
+            if (episode.quantized_embedding.size() != query_codes.size()) {
+                throw std::invalid_argument("Vectors must have same dimension");
+            }
+            float denom = query_code_norm * episode.quantized_norm;
+            similarity = denom > 0.0f
+                ? static_cast<float>(dot_product_int8(query_codes.data(),
+                                                      episode.quantized_embedding.data(),
+                                                      query_codes.size())) / denom
+                : 0.0f;
+        } else {
+            similarity = cosine_similarity(query_embedding, episode.query_embedding);
+        }
         
         // Temporal decay
         float decay = compute_temporal_decay(episode.timestamp_ms, 
@@ -79,9 +313,53 @@ std::vector<Episode> EpisodicBuffer::retrieve_similar(
         float score = similarity * decay;
         
         // Filter by threshold
-        if (score >= similarity_threshold) {
+        if (score >= candidate_threshold) {
             scored_episodes.push_back({&episode, score});
         }
+    });
+    
+    // Re-score the best int8 candidates in fp32 from the bfloat16 side store
+    if (rescore && !scored_episodes.empty()) {
+        size_t candidates = std::min(scored_episodes.size(),
+                                     std::max(top_k, storage_.rescore_candidates));
+        std::partial_sort(scored_episodes.begin(), scored_episodes.begin() + candidates,
+            scored_episodes.end(),
+            [](const ScoredEpisode& a, const ScoredEpisode& b) {
+                return a.score > b.score;
+            });
+        scored_episodes.resize(candidates);
+        
+        std::vector<float> exact(query_embedding.size());
+        for (auto& scored : scored_episodes) {
+            const Episode& episode = *scored.episode;
+            if (episode.rescore_embedding.size() != exact.size()) {
+                continue;
+            }
+            for (size_t i = 0; i < exact.size(); ++i) {
+                exact[i] = bf16_to_float(episode.rescore_embedding[i]);
+            }
+            scored.score = cosine_similarity(query_embedding, exact) *
+                           compute_temporal_decay(episode.timestamp_ms, current_time);
+        }
+        scored_episodes.erase(
+            std::remove_if(scored_episodes.begin(), scored_episodes.end(),
+                [similarity_threshold](const ScoredEpisode& scored) {
+                    return scored.score < similarity_threshold;
+                }),
+            scored_episodes.end());
+    }
+    
+    // Consolidated centroids compete with raw episodes
+    for (const auto& centroid : *snapshot->centroids) {
+        float similarity = cosine_similarity(query_embedding,
+                                             centroid.episode.query_embedding);
+        float decay = compute_temporal_decay(centroid.episode.timestamp_ms,
+                                             current_time);
+        float score = similarity * decay;
+        
+        if (score >= similarity_threshold) {
+            scored_episodes.push_back({&centroid.episode, score});
+        }
     }
     
     // Sort by score (descending)
@@ -95,38 +373,326 @@ std::vector<Episode> EpisodicBuffer::retrieve_similar(
     results.reserve(std::min(top_k, scored_episodes.size()));
     
     for (size_t i = 0; i < std::min(top_k, scored_episodes.size()); ++i) {
-        results.push_back(*scored_episodes[i].episode);
+        results.push_back(materialize(*scored_episodes[i].episode));
     }
     
     return results;
 }
 
 std::vector<Episode> EpisodicBuffer::get_recent(size_t count) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto snapshot = load_snapshot();
     
     std::vector<Episode> results;
-    results.reserve(std::min(count, buffer_.size()));
+    results.reserve(std::min(count, snapshot->count));
     
     // Take from end (most recent)
-    auto start = buffer_.size() > count ? buffer_.end() - count : buffer_.begin();
-    results.insert(results.end(), start, buffer_.end());
+    size_t start = snapshot->count > count ? snapshot->count - count : 0;
+    for (size_t i = start; i < snapshot->count; ++i) {
+        results.push_back(materialize(snapshot->at(i)));
+    }
     
     return results;
 }
 
 void EpisodicBuffer::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
-    buffer_.clear();
+    pending_.clear();
+    consolidated_total_ = 0;
+    ++epoch_;
+    memory_bytes_.store(0, std::memory_order_relaxed);
+    publish(std::make_shared<Snapshot>());
 }
 
-size_t EpisodicBuffer::size() const {
+size_t EpisodicBuffer::consolidate() {
+    if (!consolidation_.enabled) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> pass_lock(consolidate_mutex_);
+    
+    std::vector<Episode> batch;
+    std::vector<Centroid> centroids;
+    uint64_t epoch = 0;
+    
+    // Take the batch and a snapshot of the centroids
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto current = load_snapshot();
+        
+        size_t aged = 0;
+        if (consolidation_.min_age_ms > 0) {
+            uint64_t now = Episode::current_timestamp_ms();
+            uint64_t cutoff = now > consolidation_.min_age_ms ? now - consolidation_.min_age_ms : 0;
+            while (aged < current->count && current->at(aged).timestamp_ms < cutoff) {
+                ++aged;
+            }
+        }
+        
+        if (pending_.size() + aged < std::max<size_t>(consolidation_.min_batch, 1)) {
+            return 0;
+        }
+        
+        batch.reserve(pending_.size() + aged);
+        size_t taken_bytes = 0;
+        for (auto& episode : pending_) {
+            taken_bytes += episode.memory_usage_bytes();
+            batch.push_back(std::move(episode));
+        }
+        pending_.clear();
+        
+        // Aged ring entries are copied out; readers may still hold them
+        if (aged > 0) {
+            auto next = std::make_shared<Snapshot>(*current);
+            for (size_t i = 0; i < aged; ++i) {
+                batch.push_back(current->at(i));
+            }
+            taken_bytes += drop_front(*next, aged);
+            publish(std::move(next));
+        }
+        memory_bytes_.fetch_sub(taken_bytes, std::memory_order_relaxed);
+        
+        centroids = *current->centroids;
+        epoch = epoch_;
+    }
+    
+    // Clustering works on fp32 vectors
+    for (auto& episode : batch) {
+        if (episode.is_quantized()) {
+            episode.query_embedding = episode.embedding();
+        }
+    }
+    
+    size_t folded = fold_batch(batch, centroids);
+    for (auto& centroid : centroids) {
+        refresh_centroid_metadata(centroid);
+    }
+    
+    // Publish the new centroids
     std::lock_guard<std::mutex> lock(mutex_);
-    return buffer_.size();
+    if (epoch != epoch_) {
+        return 0;  // Cleared or reloaded meanwhile
+    }
+    auto next = std::make_shared<Snapshot>(*load_snapshot());
+    size_t old_bytes = 0, new_bytes = 0;
+    for (const auto& centroid : *next->centroids) {
+        old_bytes += centroid.episode.memory_usage_bytes();
+    }
+    for (const auto& centroid : centroids) {
+        new_bytes += centroid.episode.memory_usage_bytes();
+    }
+    next->centroids = std::make_shared<const std::vector<Centroid>>(std::move(centroids));
+    memory_bytes_.fetch_add(new_bytes, std::memory_order_relaxed);
+    memory_bytes_.fetch_sub(old_bytes, std::memory_order_relaxed);
+    publish(std::move(next));
+    consolidated_total_ += folded;
+    return folded;
 }
 
-bool EpisodicBuffer::is_full() const {
+size_t EpisodicBuffer::fold_batch(const std::vector<Episode>& batch,
+                                  std::vector<Centroid>& centroids) const {
+    size_t dim = centroids.empty() ? 0 : centroids.front().episode.query_embedding.size();
+    
+    // Unit-length copies of the batch embeddings
+    std::vector<const Episode*> members;
+    std::vector<std::vector<float>> points;
+    for (const auto& episode : batch) {
+        if (episode.query_embedding.empty()) {
+            continue;
+        }
+        if (dim == 0) {
+            dim = episode.query_embedding.size();
+        }
+        if (episode.query_embedding.size() != dim) {
+            continue;  // Mismatched dimension cannot join the clustering
+        }
+        members.push_back(&episode);
+        points.push_back(normalize_vector(episode.query_embedding));
+    }
+    if (points.empty()) {
+        return 0;
+    }
+    
+    // Cluster state: statistics before this batch plus current unit center
+    struct Cluster {
+        std::vector<float> base_sum;
+        size_t base_count = 0;
+        std::vector<float> center;
+    };
+    
+    std::vector<Cluster> clusters;
+    clusters.reserve(std::max(centroids.size(), consolidation_.max_centroids));
+    for (const auto& centroid : centroids) {
+        Cluster cluster;
+        cluster.base_sum = centroid.episode.query_embedding;
+        for (float& v : cluster.base_sum) {
+            v *= static_cast<float>(centroid.count);
+        }
+        cluster.base_count = centroid.count;
+        cluster.center = normalize_vector(centroid.episode.query_embedding);
+        clusters.push_back(std::move(cluster));
+    }
+    
+    auto nearest = [&](const std::vector<float>& point, float& best_sim) {
+        size_t best = 0;
+        best_sim = -2.0f;
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            float sim = dot_product(point.data(), clusters[c].center.data(), dim);
+            if (sim > best_sim) {
+                best_sim = sim;
+                best = c;
+            }
+        }
+        return best;
+    };
+    
+    // Seed new clusters for points far from every existing center
+    size_t max_clusters = std::max<size_t>(consolidation_.max_centroids, 1);
+    std::vector<int> seeded_from(clusters.size(), -1);
+    for (size_t p = 0; p < points.size(); ++p) {
+        float best_sim = -2.0f;
+        if (!clusters.empty()) {
+            nearest(points[p], best_sim);
+        }
+        if (clusters.empty() ||
+            (clusters.size() < max_clusters && best_sim < consolidation_.merge_threshold)) {
+            Cluster cluster;
+            cluster.base_sum.assign(dim, 0.0f);
+            cluster.center = points[p];
+            clusters.push_back(std::move(cluster));
+            seeded_from.push_back(static_cast<int>(p));
+        }
+    }
+    
+    // Lloyd refinement over the batch, warm-started from the existing centers
+    std::vector<size_t> assignment(points.size(), 0);
+    std::vector<std::vector<float>> batch_sum(clusters.size(), std::vector<float>(dim));
+    std::vector<size_t> batch_count(clusters.size());
+    size_t iterations = std::max<size_t>(consolidation_.refine_iterations, 1);
+    
+    for (size_t iter = 0; iter < iterations; ++iter) {
+        for (auto& sum : batch_sum) {
+            std::fill(sum.begin(), sum.end(), 0.0f);
+        }
+        std::fill(batch_count.begin(), batch_count.end(), 0);
+        
+        for (size_t p = 0; p < points.size(); ++p) {
+            float sim = 0.0f;
+            size_t c = nearest(points[p], sim);
+            assignment[p] = c;
+            ++batch_count[c];
+            for (size_t d = 0; d < dim; ++d) {
+                batch_sum[c][d] += points[p][d];
+            }
+        }
+        
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            if (clusters[c].base_count + batch_count[c] == 0) {
+                continue;  // Empty seed keeps its position
+            }
+            std::vector<float> total(dim);
+            for (size_t d = 0; d < dim; ++d) {
+                total[d] = clusters[c].base_sum[d] + batch_sum[c][d];
+            }
+            clusters[c].center = normalize_vector(total);
+        }
+    }
+    
+    // Write back means, counts and representatives
+    std::vector<Centroid> result;
+    result.reserve(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        size_t total_count = clusters[c].base_count + batch_count[c];
+        if (total_count == 0) {
+            continue;
+        }
+        
+        std::vector<float> mean(dim);
+        for (size_t d = 0; d < dim; ++d) {
+            mean[d] = (clusters[c].base_sum[d] + batch_sum[c][d]) / static_cast<float>(total_count);
+        }
+        
+        Centroid centroid = c < centroids.size()
+            ? std::move(centroids[c])
+            : Centroid{Episode(members[seeded_from[c]]->query,
+                               members[seeded_from[c]]->response,
+                               {}, members[seeded_from[c]]->timestamp_ms),
+                      0, -1.0f, {}};
+        centroid.episode.query_embedding = std::move(mean);
+        centroid.count = total_count;
+        
+        for (size_t p = 0; p < points.size(); ++p) {
+            if (assignment[p] != c) {
+                continue;
+            }
+            const Episode& member = *members[p];
+            float score = dot_product(points[p].data(), clusters[c].center.data(), dim);
+            if (score > centroid.representative_score) {
+                centroid.representative_score = score;
+                centroid.episode.query = member.query;
+                centroid.episode.response = member.response;
+            }
+            centroid.episode.timestamp_ms = std::max(centroid.episode.timestamp_ms,
+                                                     member.timestamp_ms);
+            if (centroid.samples.size() < consolidation_.summary_samples) {
+                centroid.samples.push_back(member.query);
+            }
+        }
+        result.push_back(std::move(centroid));
+    }
+    
+    centroids = std::move(result);
+    return points.size();
+}
+
+void EpisodicBuffer::refresh_centroid_metadata(Centroid& centroid) {
+    std::string summary;
+    for (const auto& sample : centroid.samples) {
+        if (!summary.empty()) {
+            summary += " | ";
+        }
+        summary += sample;
+    }
+    
+    centroid.episode.metadata[kConsolidatedKey] = "true";
+    centroid.episode.metadata[kEpisodeCountKey] = std::to_string(centroid.count);
+    centroid.episode.metadata[kSummaryKey] = std::move(summary);
+}
+
+std::vector<Episode> EpisodicBuffer::get_centroids() const {
+    auto snapshot = load_snapshot();
+    
+    std::vector<Episode> results;
+    results.reserve(snapshot->centroids->size());
+    for (const auto& centroid : *snapshot->centroids) {
+        results.push_back(centroid.episode);
+    }
+    return results;
+}
+
+size_t EpisodicBuffer::centroid_count() const {
+    return load_snapshot()->centroids->size();
+}
+
+size_t EpisodicBuffer::pending_count() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return buffer_.size() >= max_capacity_;
+    return pending_.size();
+}
+
+size_t EpisodicBuffer::consolidated_episodes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consolidated_total_;
+}
+
+size_t EpisodicBuffer::size() const {
+    return load_snapshot()->count;
+}
+
+bool EpisodicBuffer::is_full() const {
+    return load_snapshot()->count >= max_capacity_;
+}
+
+size_t EpisodicBuffer::memory_usage_bytes() const {
+    return memory_bytes_.load(std::memory_order_relaxed);
 }
 
 float EpisodicBuffer::compute_temporal_decay(
@@ -140,7 +706,7 @@ float EpisodicBuffer::compute_temporal_decay(
 
 // Simple persistence (CSV format for simplicity)
 void EpisodicBuffer::save_to_file(const std::string& filepath) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto snapshot = load_snapshot();
     
     std::ofstream ofs(filepath);
     if (!ofs.is_open()) {
@@ -151,12 +717,12 @@ void EpisodicBuffer::save_to_file(const std::string& filepath) const {
     ofs << "query,response,timestamp_ms,embedding_dim\n";
     
     // Write episodes
-    for (const auto& episode : buffer_) {
+    snapshot->for_each([&ofs](const Episode& episode) {
         ofs << episode.query << "," 
             << episode.response << ","
             << episode.timestamp_ms << ","
-            << episode.query_embedding.size() << "\n";
-    }
+            << episode.embedding_dim() << "\n";
+    });
 }
 
 void EpisodicBuffer::load_from_file(const std::string& filepath) {
@@ -167,7 +733,12 @@ void EpisodicBuffer::load_from_file(const std::string& filepath) {
         throw std::runtime_error("Failed to open file for reading: " + filepath);
     }
     
-    buffer_.clear();
+    pending_.clear();
+    consolidated_total_ = 0;
+    ++epoch_;
+    
+    auto next = std::make_shared<Snapshot>();
+    size_t loaded_bytes = 0;
     
     // Skip header
     std::string line;
@@ -189,8 +760,21 @@ void EpisodicBuffer::load_from_file(const std::string& filepath) {
         // Create dummy embedding (real implementation would save/load embeddings)
         std::vector<float> embedding(dim, 0.0f);
         
-        buffer_.emplace_back(query, response, embedding, timestamp);
+        Episode episode(query, response, embedding, timestamp);
+        if (storage_.precision == EmbeddingPrecision::Int8) {
+            episode.quantize(storage_.rescore_candidates > 0);
+        }
+        loaded_bytes += episode.memory_usage_bytes();
+        
+        if (next->count == next->blocks.size() * kBlockSize) {
+            next->blocks.push_back(std::make_shared<Block>());
+        }
+        next->blocks.back()->put(next->count % kBlockSize, std::move(episode));
+        ++next->count;
     }
+    
+    memory_bytes_.store(loaded_bytes, std::memory_order_relaxed);
+    publish(std::move(next));
 }
 
 } // namespace brain_ai
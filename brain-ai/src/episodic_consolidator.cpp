@@ -0,0 +1,85 @@
+#include "episodic_consolidator.hpp"
+#include <algorithm>
+
+namespace brain_ai {
+
+EpisodicConsolidator::EpisodicConsolidator(std::chrono::milliseconds interval)
+    : interval_(interval) {}
+
+EpisodicConsolidator::~EpisodicConsolidator() {
+    stop();
+}
+
+void EpisodicConsolidator::watch(const std::shared_ptr<EpisodicBuffer>& buffer) {
+    if (!buffer || !buffer->consolidation_config().enabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.push_back(buffer);
+}
+
+void EpisodicConsolidator::start() {
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true)) {
+        return;  // Already running
+    }
+    worker_ = std::thread(&EpisodicConsolidator::worker_loop, this);
+}
+
+void EpisodicConsolidator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wake_cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+size_t EpisodicConsolidator::run_once() {
+    // Snapshot live buffers and prune expired ones
+    std::vector<std::shared_ptr<EpisodicBuffer>> live;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::remove_if(buffers_.begin(), buffers_.end(),
+            [&live](const std::weak_ptr<EpisodicBuffer>& weak) {
+                auto buffer = weak.lock();
+                if (!buffer) {
+                    return true;
+                }
+                live.push_back(std::move(buffer));
+                return false;
+            });
+        buffers_.erase(it, buffers_.end());
+    }
+
+    size_t consolidated = 0;
+    for (const auto& buffer : live) {
+        consolidated += buffer->consolidate();
+    }
+    total_consolidated_.fetch_add(consolidated);
+    return consolidated;
+}
+
+size_t EpisodicConsolidator::watched_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.size();
+}
+
+void EpisodicConsolidator::worker_loop() {
+    while (running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_for(lock, interval_, [this] { return !running_.load(); });
+        }
+        if (!running_.load()) {
+            break;
+        }
+        run_once();
+    }
+}
+
+} // namespace brain_ai
@@ -1,4 +1,6 @@
 #include "grpc/brain_ai_service.hpp"
+#include "monitoring/memory_pressure.hpp"
+#include "monitoring/metrics.hpp"
 #include <iostream>
 
 namespace brain_ai::grpc_service {
@@ -13,6 +15,12 @@ BrainAIServiceImpl::BrainAIServiceImpl(const ServiceConfig& config)
     doc_processor_ = std::make_unique<document::DocumentProcessor>(
         *cognitive_, config_.document_config);
     
+    QueryScheduler::shared().reconfigure(config_.scheduler);
+    
+    if (config_.enable_rate_limit) {
+        rate_limiter_ = std::make_unique<resilience::RateLimiter>(config_.rate_limit);
+    }
+    
     std::cout << "[BrainAIService] Initialized with address: " 
               << config_.server_address << std::endl;
 }
@@ -66,6 +74,9 @@ bool BrainAIServiceImpl::start() {
             return false;
         }
         
+        // Shrink caches under memory pressure instead of getting OOM-killed
+        monitoring::MemoryPressureMonitor::instance().start();
+        
         running_.store(true);
         std::cout << "[BrainAIService] ✅ Server listening on " 
                   << config_.server_address << std::endl;
@@ -115,6 +126,35 @@ void BrainAIServiceImpl::wait() {
     std::cout << "[BrainAIService] Server wait completed" << std::endl;
 }
 
+bool BrainAIServiceImpl::admit_request(const std::string& client_key, double cost) {
+    if (!rate_limiter_ || rate_limiter_->try_acquire(client_key, cost)) {
+        return true;
+    }
+    stats_.rate_limited.fetch_add(1);
+    monitoring::MetricsRegistry::instance()
+        .get_counter(monitoring::metric_names::REQUESTS_RATE_LIMITED).increment();
+    return false;
+}
+
+QueryPriority BrainAIServiceImpl::to_query_priority(int proto_priority) {
+    switch (proto_priority) {
+        case 1: return QueryPriority::BULK;
+        case 2: return QueryPriority::INGEST;
+        default: return QueryPriority::INTERACTIVE;
+    }
+}
+
+RequestContext BrainAIServiceImpl::make_request_context(std::chrono::milliseconds client_timeout) const {
+    auto timeout = config_.default_request_timeout;
+    if (client_timeout.count() > 0 && (timeout.count() <= 0 || client_timeout < timeout)) {
+        timeout = client_timeout;
+    }
+    if (timeout.count() <= 0) {
+        return RequestContext::cancellable();
+    }
+    return RequestContext::with_timeout(timeout);
+}
+
 void BrainAIServiceImpl::update_query_stats(bool success) {
     stats_.total_queries.fetch_add(1);
     if (success) {
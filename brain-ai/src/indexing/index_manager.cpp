@@ -1,4 +1,9 @@
 #include "indexing/index_manager.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/metrics.hpp"
+#include "monitoring/slow_query_log.hpp"
+#include "query_scheduler.hpp"
+#include "work_pool.hpp"
 #include <algorithm>
 #include <execution>
 #include <fstream>
@@ -36,25 +41,36 @@ bool IndexManager::add_document(const std::string& doc_id,
                                const std::vector<float>& embedding,
                                const std::string& content,
                                const nlohmann::json& metadata) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Create full metadata
-    auto full_metadata = create_metadata(doc_id, content, metadata);
-    
-    // Add to index
-    if (!index_->add_document(doc_id, embedding, content, full_metadata)) {
-        return false;
+    auto slot = QueryScheduler::shared().admit(QueryPriority::INGEST);
+    std::shared_ptr<CooccurrenceBuilder> cooccurrence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Create full metadata
+        auto full_metadata = create_metadata(doc_id, content, metadata);
+        
+        // Add to index
+        if (!index_->add_document(doc_id, embedding, content, full_metadata)) {
+            return false;
+        }
+        
+        // Store metadata
+        documents_[doc_id] = full_metadata;
+        
+        // Update stats
+        update_stats();
+        
+        // Auto-save if needed
+        if (should_auto_save()) {
+            save_unlocked();
+        }
+        
+        cooccurrence = cooccurrence_;
     }
     
-    // Store metadata
-    documents_[doc_id] = full_metadata;
-    
-    // Update stats
-    update_stats();
-    
-    // Auto-save if needed
-    if (should_auto_save()) {
-        save();
+    // Count co-occurrences without holding the index lock
+    if (cooccurrence) {
+        cooccurrence->add_document(content);
     }
     
     return true;
@@ -63,7 +79,8 @@ bool IndexManager::add_document(const std::string& doc_id,
 BatchResult IndexManager::add_batch(const std::vector<std::string>& doc_ids,
                                    const std::vector<std::vector<float>>& embeddings,
                                    const std::vector<std::string>& contents,
-                                   const std::vector<nlohmann::json>& metadatas) {
+                                   const std::vector<nlohmann::json>& metadatas,
+                                   const RequestContext& context) {
     auto start = std::chrono::steady_clock::now();
     BatchResult result;
     result.total = doc_ids.size();
@@ -81,50 +98,97 @@ BatchResult IndexManager::add_batch(const std::vector<std::string>& doc_ids,
         return result;
     }
     
-    // Process in parallel batches
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    for (size_t i = 0; i < doc_ids.size(); ++i) {
+    // Ingest in chunks of batch_size, each under its own scheduler slot and
+    // index lock, so queries interleave with a large batch. Chunks left
+    // when the request expires are dropped.
+    std::vector<std::string> added_contents;
+    size_t chunk = std::max<size_t>(config_.batch_size, 1);
+    size_t stopped_at = doc_ids.size();
+    for (size_t begin = 0; begin < doc_ids.size(); begin += chunk) {
+        size_t end = std::min(doc_ids.size(), begin + chunk);
+        QueryScheduler::Slot slot;
         try {
-            auto metadata = has_metadata ? metadatas[i] : nlohmann::json{};
-            auto full_metadata = create_metadata(doc_ids[i], contents[i], metadata);
-            
-            if (index_->add_document(doc_ids[i], embeddings[i], contents[i], full_metadata)) {
-                documents_[doc_ids[i]] = full_metadata;
-                result.successful++;
-            } else {
+            context.check("index_batch");
+            slot = QueryScheduler::shared().admit(QueryPriority::INGEST, context);
+        } catch (const errors::CancelledError&) {
+            stopped_at = begin;
+            break;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                auto metadata = has_metadata ? metadatas[i] : nlohmann::json{};
+                auto full_metadata = create_metadata(doc_ids[i], contents[i], metadata);
+                
+                if (index_->add_document(doc_ids[i], embeddings[i], contents[i], full_metadata)) {
+                    documents_[doc_ids[i]] = full_metadata;
+                    result.successful++;
+                    if (cooccurrence_) {
+                        added_contents.push_back(contents[i]);
+                    }
+                } else {
+                    result.failed++;
+                    result.error_messages.push_back("Failed to add document: " + doc_ids[i]);
+                }
+            } catch (const std::exception& e) {
                 result.failed++;
-                result.error_messages.push_back("Failed to add document: " + doc_ids[i]);
+                result.error_messages.push_back("Exception for " + doc_ids[i] + ": " + e.what());
             }
-        } catch (const std::exception& e) {
-            result.failed++;
-            result.error_messages.push_back("Exception for " + doc_ids[i] + ": " + e.what());
         }
     }
     
-    // Update stats
-    update_stats();
+    if (stopped_at < doc_ids.size()) {
+        result.cancelled = doc_ids.size() - stopped_at;
+        result.error_messages.push_back("Cancelled after " + std::to_string(stopped_at) +
+                                        " of " + std::to_string(doc_ids.size()) + " documents");
+        monitoring::MetricsRegistry::instance()
+            .get_counter(monitoring::metric_names::CANCELLED_BATCH_ITEMS)
+            .increment(static_cast<int64_t>(result.cancelled));
+    }
+    
+    std::shared_ptr<CooccurrenceBuilder> cooccurrence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Update stats
+        update_stats();
+        
+        // Auto-save if needed
+        if (should_auto_save()) {
+            save_unlocked();
+        }
+        
+        cooccurrence = cooccurrence_;
+    }
+    
+    // Count co-occurrences of the batch in parallel, outside the index lock
+    if (cooccurrence && !added_contents.empty()) {
+        auto slot = QueryScheduler::shared().admit(QueryPriority::INGEST);
+        cooccurrence->add_documents(added_contents);
+    }
     
     // Calculate time
     auto end = std::chrono::steady_clock::now();
     result.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     
-    // Auto-save if needed
-    if (should_auto_save()) {
-        save();
-    }
-    
     return result;
 }
 
 std::vector<vector_search::SearchResult> IndexManager::search(
     const std::vector<float>& query_embedding,
     size_t top_k,
-    float similarity_threshold) {
+    float similarity_threshold,
+    const RequestContext& context) {
     
+    monitoring::SlowQueryTimer timer;
     std::lock_guard<std::mutex> lock(mutex_);
+    timer.lap(monitoring::SearchStage::LOCK_WAIT);
     
-    auto results = index_->search(query_embedding, top_k);
+    vector_search::SearchCost cost;
+    auto results = index_->search(query_embedding, top_k, &cost, context);
+    size_t candidates = results.size();
+    timer.lap(monitoring::SearchStage::HNSW);
     
     // Filter by similarity threshold
     if (similarity_threshold > 0.0f) {
@@ -136,6 +200,9 @@ std::vector<vector_search::SearchResult> IndexManager::search(
             results.end()
         );
     }
+    timer.lap(monitoring::SearchStage::FILTER);
+    
+    record_if_slow(timer, query_embedding, top_k, candidates, results.size(), &cost);
     
     return results;
 }
@@ -144,17 +211,53 @@ std::vector<std::vector<vector_search::SearchResult>> IndexManager::search_batch
     const std::vector<std::vector<float>>& query_embeddings,
     size_t top_k) {
     
-    std::vector<std::vector<vector_search::SearchResult>> results;
-    results.reserve(query_embeddings.size());
-    
-    // Process each query
-    for (const auto& query : query_embeddings) {
-        results.push_back(search(query, top_k));
+    monitoring::SlowQueryTimer timer;
+    std::lock_guard<std::mutex> lock(mutex_);
+    timer.lap(monitoring::SearchStage::LOCK_WAIT);
+    
+    // One index call for the whole batch, spread over the shared pool
+    WorkPool* pool = config_.num_threads > 1 ? &WorkPool::shared() : nullptr;
+    auto results = index_->search_batch(query_embeddings, top_k, nullptr, pool);
+    timer.lap(monitoring::SearchStage::HNSW);
+    
+    // Every query waited for the whole batch; graph work is not attributed
+    // to individual queries
+    for (size_t i = 0; i < results.size(); ++i) {
+        record_if_slow(timer, query_embeddings[i], top_k, results[i].size(),
+                       results[i].size(), nullptr);
     }
     
     return results;
 }
 
+void IndexManager::record_if_slow(const monitoring::SlowQueryTimer& timer,
+                                  const std::vector<float>& query_embedding,
+                                  size_t top_k,
+                                  size_t candidates,
+                                  size_t returned,
+                                  const vector_search::SearchCost* cost) const {
+    auto& slow_log = monitoring::SlowQueryLog::instance();
+    uint32_t total_us = timer.elapsed_us();
+    if (!slow_log.is_slow(total_us)) {
+        return;
+    }
+    
+    monitoring::SlowQueryRecord record;
+    record.source = monitoring::SlowQuerySource::INDEX_SEARCH;
+    record.fingerprint = monitoring::fingerprint_embedding(query_embedding);
+    record.total_us = total_us;
+    timer.fill(record);
+    record.set_result_count(monitoring::SearchResultCount::CANDIDATES, candidates);
+    record.set_result_count(monitoring::SearchResultCount::RETURNED, returned);
+    record.top_k = static_cast<uint32_t>(top_k);
+    if (cost) {
+        record.ef_search = static_cast<uint32_t>(cost->ef_search);
+        record.hops = cost->hops;
+        record.distance_computations = cost->distance_computations;
+    }
+    slow_log.record(record);
+}
+
 bool IndexManager::delete_document(const std::string& doc_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -394,6 +497,11 @@ IndexStats IndexManager::get_stats() const {
     return stats_;
 }
 
+void IndexManager::set_cooccurrence_builder(std::shared_ptr<CooccurrenceBuilder> builder) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cooccurrence_ = std::move(builder);
+}
+
 void IndexManager::set_ef_search(size_t ef_search) {
     std::lock_guard<std::mutex> lock(mutex_);
     config_.ef_search = ef_search;
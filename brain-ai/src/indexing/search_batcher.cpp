@@ -0,0 +1,268 @@
+#include "indexing/search_batcher.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace brain_ai::indexing {
+
+namespace {
+
+// Caps one idle period's weight in the arrival estimate, so a burst after
+// a quiet spell starts batching within a few requests
+constexpr double kMaxGapLingers = 4.0;
+
+} // namespace
+
+SearchBatcher::SearchBatcher(IndexManager& manager, const SearchBatcherConfig& config)
+    : manager_(manager),
+      config_(config),
+      last_arrival_(Clock::now()) {
+    config_.max_batch = std::max<size_t>(config_.max_batch, 1);
+    config_.arrival_smoothing = std::clamp(config_.arrival_smoothing, 0.01, 1.0);
+
+    // Start out assuming low traffic (no linger)
+    gap_ewma_us_ = kMaxGapLingers * static_cast<double>(config_.max_linger.count());
+
+    dispatcher_ = std::thread([this]() { dispatch_loop(); });
+}
+
+SearchBatcher::~SearchBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    dispatcher_.join();
+}
+
+std::future<std::vector<vector_search::SearchResult>> SearchBatcher::submit(
+    std::vector<float> query_embedding,
+    size_t top_k,
+    float similarity_threshold,
+    QueryPriority priority,
+    const RequestContext& context) {
+
+    Request request;
+    auto future = request.promise.get_future();
+
+    // A bad query would fail the whole batch, so reject it here
+    size_t dim = manager_.get_config().embedding_dim;
+    if (query_embedding.size() != dim) {
+        request.promise.set_exception(std::make_exception_ptr(std::invalid_argument(
+            "Query dimension mismatch: expected " + std::to_string(dim) +
+            ", got " + std::to_string(query_embedding.size()))));
+        return future;
+    }
+
+    request.query = std::move(query_embedding);
+    request.top_k = top_k;
+    request.similarity_threshold = similarity_threshold;
+    request.priority = priority;
+    request.context = context;
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            request.promise.set_exception(std::make_exception_ptr(
+                std::runtime_error("SearchBatcher is shutting down")));
+            return future;
+        }
+
+        // Update the arrival gap estimate
+        auto now = Clock::now();
+        double gap_us = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - last_arrival_).count());
+        gap_us = std::min(gap_us, kMaxGapLingers * static_cast<double>(config_.max_linger.count()));
+        gap_ewma_us_ += config_.arrival_smoothing * (gap_us - gap_ewma_us_);
+        last_arrival_ = now;
+
+        request.arrival = now;
+        queue_.push_back(std::move(request));
+
+        // The dispatcher waits for the first request or a full batch
+        wake = queue_.size() == 1 || queue_.size() >= config_.max_batch;
+    }
+    if (wake) {
+        cv_.notify_one();
+    }
+    return future;
+}
+
+std::vector<vector_search::SearchResult> SearchBatcher::search(
+    std::vector<float> query_embedding,
+    size_t top_k,
+    float similarity_threshold,
+    QueryPriority priority,
+    const RequestContext& context) {
+    auto future = submit(std::move(query_embedding), top_k, similarity_threshold, priority, context);
+
+    // The dispatcher only checks the context when the batch runs, so a
+    // caller that gives up while queued or lingering stops waiting here
+    if (context.can_expire()) {
+        while (future.wait_for(QueryScheduler::kExpiryPoll) != std::future_status::ready) {
+            context.check("search");
+        }
+    }
+    return future.get();
+}
+
+std::chrono::microseconds SearchBatcher::current_linger() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return linger_for(1);
+}
+
+SearchBatcherStats SearchBatcher::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::chrono::microseconds SearchBatcher::linger_for(size_t queued) const {
+    if (queued >= config_.max_batch) {
+        return std::chrono::microseconds(0);
+    }
+
+    // Lingering only pays off if another request is expected within the cap
+    double max_linger_us = static_cast<double>(config_.max_linger.count());
+    if (gap_ewma_us_ >= max_linger_us) {
+        return std::chrono::microseconds(0);
+    }
+
+    // Long enough to fill the batch at the current arrival rate
+    double fill_us = gap_ewma_us_ * static_cast<double>(config_.max_batch - queued);
+    return std::chrono::microseconds(static_cast<int64_t>(std::min(fill_us, max_linger_us)));
+}
+
+void SearchBatcher::dispatch_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;   // Stopping and drained
+        }
+
+        // Give the batch a chance to fill, counted from the oldest request
+        if (!stopping_ && queue_.size() < config_.max_batch) {
+            auto deadline = queue_.front().arrival + linger_for(queue_.size());
+            cv_.wait_until(lock, deadline, [this]() {
+                return stopping_ || queue_.size() >= config_.max_batch;
+            });
+        }
+
+        size_t count = std::min(queue_.size(), config_.max_batch);
+        std::vector<Request> batch;
+        batch.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }
+
+        stats_.requests += count;
+        stats_.batches++;
+        stats_.largest_batch = std::max(stats_.largest_batch, count);
+
+        lock.unlock();
+        execute(batch);
+        lock.lock();
+    }
+}
+
+void SearchBatcher::execute(std::vector<Request>& batch) {
+    // Fail requests that expired, so they neither wait for a slot nor
+    // get searched
+    auto drop_expired = [&batch]() {
+        auto live = std::remove_if(batch.begin(), batch.end(), [](Request& request) {
+            try {
+                request.context.check("search");
+                return false;
+            } catch (...) {
+                request.promise.set_exception(std::current_exception());
+                return true;
+            }
+        });
+        batch.erase(live, batch.end());
+    };
+    drop_expired();
+    if (batch.empty()) {
+        return;
+    }
+
+    // One slot for the whole batch, in its most urgent lane. The batch
+    // stops waiting once its last deadline passes; a request without a
+    // deadline keeps it waiting.
+    QueryPriority priority = batch.front().priority;
+    auto latest = RequestContext::Clock::time_point::min();
+    for (const auto& request : batch) {
+        priority = std::min(priority, request.priority);
+        latest = std::max(latest, request.context.deadline());
+    }
+    RequestContext batch_context;
+    if (latest != RequestContext::Clock::time_point::max()) {
+        batch_context = RequestContext::derived(latest);
+    }
+
+    QueryScheduler::Slot slot;
+    try {
+        slot = QueryScheduler::shared().admit(priority, batch_context);
+    } catch (const errors::CancelledError&) {
+        drop_expired();   // Every request is past its deadline by now
+        for (auto& request : batch) {
+            request.promise.set_exception(std::current_exception());
+        }
+        return;
+    }
+
+    // Drop requests that expired while waiting for the slot
+    drop_expired();
+    if (batch.empty()) {
+        return;
+    }
+
+    std::vector<std::vector<float>> queries;
+    queries.reserve(batch.size());
+    size_t max_k = 0;
+    for (auto& request : batch) {
+        queries.push_back(std::move(request.query));
+        max_k = std::max(max_k, request.top_k);
+    }
+
+    std::vector<std::vector<vector_search::SearchResult>> results;
+    try {
+        results = manager_.search_batch(queries, max_k);
+    } catch (...) {
+        for (auto& request : batch) {
+            request.promise.set_exception(std::current_exception());
+        }
+        return;
+    }
+    slot.release();
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto& list = results[i];
+        float threshold = batch[i].similarity_threshold;
+        if (threshold > 0.0f) {
+            list.erase(
+                std::remove_if(list.begin(), list.end(),
+                    [threshold](const auto& r) {
+                        return r.similarity < threshold;
+                    }),
+                list.end()
+            );
+        }
+        if (list.size() > batch[i].top_k) {
+            list.erase(list.begin() + static_cast<std::ptrdiff_t>(batch[i].top_k), list.end());
+        }
+        batch[i].promise.set_value(std::move(list));
+    }
+
+    auto& metrics = monitoring::MetricsRegistry::instance();
+    metrics.get_counter(monitoring::metric_names::SEARCH_BATCHES).increment();
+    metrics.get_counter(monitoring::metric_names::SEARCH_BATCHED_REQUESTS).increment(
+        static_cast<int64_t>(batch.size()));
+    metrics.get_histogram(monitoring::metric_names::SEARCH_BATCH_SIZE)
+        .observe(static_cast<double>(batch.size()));
+}
+
+} // namespace brain_ai::indexing
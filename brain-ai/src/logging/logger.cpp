@@ -1,4 +1,5 @@
 #include "logging/logger.hpp"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -12,8 +13,9 @@ namespace logging {
 // Helper Functions
 // ============================================================================
 
-std::string get_timestamp() {
-    auto now = std::chrono::system_clock::now();
+namespace {
+
+std::string format_timestamp(std::chrono::system_clock::time_point now) {
     auto now_time_t = std::chrono::system_clock::to_time_t(now);
     auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -28,10 +30,29 @@ std::string get_timestamp() {
     return oss.str();
 }
 
+} // namespace
+
+std::string get_timestamp() {
+    return format_timestamp(std::chrono::system_clock::now());
+}
+
 // ============================================================================
 // LogMessage Implementation
 // ============================================================================
 
+void LogMessage::resolve() {
+    if (!formatter) {
+        return;
+    }
+    try {
+        message = formatter();
+    } catch (const std::exception& e) {
+        message = std::string("<log format error: ") + e.what() + ">";
+    }
+    formatter = nullptr;
+    timestamp = format_timestamp(time);
+}
+
 std::string LogMessage::format() const {
     std::ostringstream oss;
     
@@ -57,8 +78,13 @@ std::string LogMessage::format() const {
 // ============================================================================
 
 void ConsoleSink::write(const LogMessage& msg) {
+    // Routine lines wait for flush(); warnings and errors go out at once
+    // (stderr is unbuffered)
     std::ostream& out = (msg.level >= LogLevel::ERROR) ? std::cerr : std::cout;
-    out << msg.format() << std::endl;
+    out << msg.format() << '\n';
+    if (msg.level == LogLevel::WARN) {
+        out.flush();
+    }
 }
 
 void ConsoleSink::flush() {
@@ -66,6 +92,90 @@ void ConsoleSink::flush() {
     std::cerr.flush();
 }
 
+// ============================================================================
+// AsyncSink Implementation
+// ============================================================================
+
+AsyncSink::AsyncSink(std::shared_ptr<LogSink> target, size_t max_queue)
+    : target_(std::move(target))
+    , max_queue_(std::max<size_t>(max_queue, 1)) {
+    writer_ = std::thread(&AsyncSink::writer_loop, this);
+}
+
+AsyncSink::~AsyncSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    target_->flush();
+}
+
+void AsyncSink::write(const LogMessage& msg) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= max_queue_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue_.push_back(msg);
+    }
+    work_cv_.notify_one();
+}
+
+void AsyncSink::flush() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+    target_->flush();
+}
+
+void AsyncSink::writer_loop() {
+    std::deque<LogMessage> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            break;   // Stopping and drained
+        }
+        batch.swap(queue_);
+        busy_ = true;
+        lock.unlock();
+        
+        // Formatting and I/O happen here, off the logging threads
+        for (auto& msg : batch) {
+            msg.resolve();
+            target_->write(msg);
+        }
+        batch.clear();
+        
+        size_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reported_dropped_) {
+            LogMessage summary;
+            summary.level = LogLevel::WARN;
+            summary.timestamp = get_timestamp();
+            summary.logger_name = "logging";
+            summary.message = "Async log queue full, dropped " +
+                              std::to_string(dropped - reported_dropped_) + " messages";
+            summary.line = 0;
+            target_->write(summary);
+            reported_dropped_ = dropped;
+        }
+        
+        lock.lock();
+        busy_ = false;
+        if (queue_.empty()) {
+            idle_cv_.notify_all();
+        }
+    }
+    busy_ = false;
+    idle_cv_.notify_all();
+}
+
 // ============================================================================
 // FileSink Implementation
 // ============================================================================
@@ -159,6 +269,41 @@ void FileSink::rotate_if_needed() {
     current_size_ = 0;
 }
 
+// ============================================================================
+// LogSite Implementation
+// ============================================================================
+
+bool LogSite::admit(uint64_t& suppressed) {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    // First hit after the window elapsed starts a new one
+    uint64_t start = window_start_ms_.load(std::memory_order_relaxed);
+    if (window_ms_ != 0 && now - start >= window_ms_ &&
+        window_start_ms_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        hits_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t hit = hits_.fetch_add(1, std::memory_order_relaxed);
+    bool keep = hit < first_n_ ||
+                (every_m_ != 0 && (hit - first_n_ + 1) % every_m_ == 0);
+    if (!keep) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = pending_.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+std::string with_suppressed(const std::string& message, uint64_t suppressed) {
+    if (suppressed == 0) {
+        return message;
+    }
+    return message + " (" + std::to_string(suppressed) + " similar suppressed)";
+}
+
 // ============================================================================
 // Logger Implementation
 // ============================================================================
@@ -197,6 +342,31 @@ void Logger::log(LogLevel level, const std::string& message,
     }
 }
 
+void Logger::log_deferred(LogLevel level, std::function<std::string()> formatter,
+                          const char* file, int line, const char* func) {
+    if (!should_log(level)) {
+        return;
+    }
+    
+    LogMessage msg;
+    msg.level = level;
+    msg.time = std::chrono::system_clock::now();
+    msg.logger_name = name_;
+    msg.formatter = std::move(formatter);
+    msg.file = file ? file : "";
+    msg.line = line;
+    msg.function = func ? func : "";
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& sink : sinks_) {
+        // Synchronous sinks need the text now; async ones format later
+        if (msg.formatter && !sink->defers_formatting()) {
+            msg.resolve();
+        }
+        sink->write(msg);
+    }
+}
+
 void Logger::trace(const std::string& message, const char* file, int line, const char* func) {
     log(LogLevel::TRACE, message, file, line, func);
 }
@@ -221,7 +391,39 @@ void Logger::fatal(const std::string& message, const char* file, int line, const
     log(LogLevel::FATAL, message, file, line, func);
 }
 
+bool Logger::admit(LogSite& site, uint64_t& suppressed) {
+    if (site.owner_.load(std::memory_order_acquire) == nullptr) {
+        Logger* expected = nullptr;
+        if (site.owner_.compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sites_.push_back(&site);
+        }
+    }
+    return site.admit(suppressed);
+}
+
+void Logger::report_suppressed() {
+    std::vector<std::pair<LogSite*, uint64_t>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (LogSite* site : sites_) {
+            uint64_t count = site->pending_.exchange(0, std::memory_order_relaxed);
+            if (count > 0) {
+                pending.emplace_back(site, count);
+            }
+        }
+    }
+
+    for (const auto& [site, count] : pending) {
+        log(site->level(),
+            "Suppressed " + std::to_string(count) + " messages",
+            site->file(), site->line(), "");
+    }
+}
+
 void Logger::flush() {
+    report_suppressed();
+    
     std::lock_guard<std::mutex> lock(mutex_);
     for (auto& sink : sinks_) {
         sink->flush();
@@ -232,7 +434,23 @@ void Logger::flush() {
 // LoggerRegistry Implementation
 // ============================================================================
 
-LoggerRegistry::LoggerRegistry() {}
+LoggerRegistry::LoggerRegistry()
+    : global_sinks_{std::make_shared<ConsoleSink>()} {
+    // Loggers print to the console until initialize_logging() or
+    // set_global_sinks() installs something else
+    start_flusher();
+}
+
+LoggerRegistry::~LoggerRegistry() {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        flusher_stop_ = true;
+    }
+    flush_cv_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+}
 
 LoggerRegistry& LoggerRegistry::instance() {
     static LoggerRegistry registry;
@@ -247,8 +465,12 @@ std::shared_ptr<Logger> LoggerRegistry::get_logger(const std::string& name) {
         return it->second;
     }
     
-    // Create new logger
+    // Create new logger with the global configuration
     auto logger = std::make_shared<Logger>(name);
+    logger->set_level(global_level_);
+    for (const auto& sink : global_sinks_) {
+        logger->add_sink(sink);
+    }
     loggers_[name] = logger;
     
     return logger;
@@ -256,6 +478,7 @@ std::shared_ptr<Logger> LoggerRegistry::get_logger(const std::string& name) {
 
 void LoggerRegistry::set_global_level(LogLevel level) {
     std::lock_guard<std::mutex> lock(mutex_);
+    global_level_ = level;
     
     for (auto& [_, logger] : loggers_) {
         logger->set_level(level);
@@ -263,10 +486,33 @@ void LoggerRegistry::set_global_level(LogLevel level) {
 }
 
 void LoggerRegistry::add_global_sink(std::shared_ptr<LogSink> sink) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    for (auto& [_, logger] : loggers_) {
-        logger->add_sink(sink);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        global_sinks_.push_back(sink);
+        
+        for (auto& [_, logger] : loggers_) {
+            logger->add_sink(sink);
+        }
+    }
+    start_flusher();
+}
+
+void LoggerRegistry::set_global_sinks(std::vector<std::shared_ptr<LogSink>> sinks) {
+    bool has_sinks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        global_sinks_ = std::move(sinks);
+        has_sinks = !global_sinks_.empty();
+        
+        for (auto& [_, logger] : loggers_) {
+            logger->clear_sinks();
+            for (const auto& sink : global_sinks_) {
+                logger->add_sink(sink);
+            }
+        }
+    }
+    if (has_sinks) {
+        start_flusher();
     }
 }
 
@@ -278,27 +524,69 @@ void LoggerRegistry::flush_all() {
     }
 }
 
+void LoggerRegistry::set_flush_interval(std::chrono::milliseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        flush_interval_ = std::max(interval, std::chrono::milliseconds(0));
+    }
+    flush_cv_.notify_all();
+}
+
+void LoggerRegistry::start_flusher() {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    if (!flusher_.joinable() && !flusher_stop_) {
+        flusher_ = std::thread(&LoggerRegistry::flusher_loop, this);
+    }
+}
+
+void LoggerRegistry::flusher_loop() {
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    while (!flusher_stop_) {
+        if (flush_interval_.count() == 0) {
+            flush_cv_.wait(lock);
+            continue;
+        }
+        auto interval = flush_interval_;
+        if (flush_cv_.wait_for(lock, interval, [&] {
+                return flusher_stop_ || flush_interval_ != interval;
+            })) {
+            continue;   // Stopping, or the interval changed
+        }
+        
+        // Buffered console lines and suppressed-count summaries go out here
+        lock.unlock();
+        flush_all();
+        lock.lock();
+    }
+}
+
 // ============================================================================
 // Initialization Function
 // ============================================================================
 
-void initialize_logging(LogLevel level, const std::string& log_file) {
+void initialize_logging(LogLevel level, const std::string& log_file, bool async) {
     auto& registry = LoggerRegistry::instance();
     
-    // Add console sink
-    auto console_sink = std::make_shared<ConsoleSink>();
-    registry.add_global_sink(console_sink);
+    // Console sink (replaces any installed sinks)
+    std::vector<std::shared_ptr<LogSink>> sinks{std::make_shared<ConsoleSink>()};
     
     // Add file sink if specified
     if (!log_file.empty()) {
         try {
-            auto file_sink = std::make_shared<FileSink>(log_file);
-            registry.add_global_sink(file_sink);
+            sinks.push_back(std::make_shared<FileSink>(log_file));
         } catch (const std::exception& e) {
             std::cerr << "Failed to create file sink: " << e.what() << std::endl;
         }
     }
     
+    // One writer thread per sink, so a slow file does not hold up the console
+    if (async) {
+        for (auto& sink : sinks) {
+            sink = std::make_shared<AsyncSink>(sink);
+        }
+    }
+    registry.set_global_sinks(std::move(sinks));
+    
     // Set global log level
     registry.set_global_level(level);
 }
@@ -0,0 +1,79 @@
+#include "mapped_file.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace brain_ai {
+
+MappedFile::MappedFile(const std::string& path) : path_(path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file for mapping: " + path +
+                                 " (" + std::strerror(errno) + ")");
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + path + " (" + std::strerror(err) + ")");
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        opened_empty_ = true;   // mmap rejects zero-length mappings
+        return;
+    }
+
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    int err = errno;
+    ::close(fd);   // The mapping keeps the file referenced
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap file: " + path + " (" + std::strerror(err) + ")");
+    }
+    data_ = static_cast<const char*>(addr);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      opened_empty_(std::exchange(other.opened_empty_, false)),
+      path_(std::move(other.path_)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        opened_empty_ = std::exchange(other.opened_empty_, false);
+        path_ = std::move(other.path_);
+    }
+    return *this;
+}
+
+void MappedFile::advise_sequential() const {
+    if (data_ != nullptr) {
+        ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::release() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    opened_empty_ = false;
+}
+
+} // namespace brain_ai
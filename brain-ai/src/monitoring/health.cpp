@@ -1,5 +1,8 @@
 #include "monitoring/health.hpp"
+#include "monitoring/memory_pressure.hpp"
 #include "monitoring/metrics.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
@@ -64,6 +67,8 @@ std::string HealthCheckResult::to_json() const {
     oss << "  \"status\": \"" << health_status_to_string(status) << "\",\n";
     oss << "  \"message\": \"" << json_escape(message) << "\",\n";
     oss << "  \"check_duration_ms\": " << check_duration_ms << ",\n";
+    oss << "  \"age_ms\": " << age_ms << ",\n";
+    oss << "  \"stale\": " << (stale ? "true" : "false") << ",\n";
     oss << "  \"timestamp\": \"" << ts.str() << "\"";
     if (!details.empty()) {
         oss << ",\n  \"details\": {\n";
@@ -83,46 +88,157 @@ std::string HealthCheckResult::to_json() const {
 // HealthCheck Implementation
 // ============================================================================
 
+namespace {
+
+// Checks run on the shared pool; RunSlot keeps each check to one queued
+// or running task, so a hung check holds at most one worker
+template <typename Fn>
+bool submit_check(Fn fn) {
+    try {
+        WorkPool::shared().submit(std::move(fn));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+HealthCheckResult cancelled_result(const std::string& name) {
+    return create_health_result(name, HealthStatus::UNKNOWN, "Health check cancelled");
+}
+
+HealthCheckResult timed_out_result(const std::string& name, int timeout_ms) {
+    return create_health_result(name, HealthStatus::UNHEALTHY,
+                                "Health check timed out after " +
+                                std::to_string(timeout_ms) + "ms");
+}
+
+} // namespace
+
+bool HealthCheck::RunSlot::try_start() {
+    bool idle_now = false;
+    return in_flight.compare_exchange_strong(idle_now, true, std::memory_order_acq_rel);
+}
+
+void HealthCheck::RunSlot::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_flight.store(false, std::memory_order_release);
+        cancelled.store(false, std::memory_order_release);   // Ends an abandoned cancel
+    }
+    idle.notify_all();
+}
+
+bool HealthCheck::cancel_and_wait(std::chrono::milliseconds limit) {
+    std::unique_lock<std::mutex> lock(run_->mutex);
+    run_->cancelled.store(true, std::memory_order_release);
+    bool idle = run_->idle.wait_for(lock, limit, [this] {
+        return !run_->in_flight.load(std::memory_order_acquire);
+    });
+    if (idle) {
+        run_->cancelled.store(false, std::memory_order_release);
+    }
+    return idle;
+}
+
 HealthCheckResult HealthCheck::execute() {
     auto start = std::chrono::steady_clock::now();
     
+    // A slow run is not a failure: report what it last found instead
+    if (!run_->try_start()) {
+        return get_last_result();
+    }
+    
     HealthCheckResult result;
     result.component_name = name_;
     result.timestamp = std::chrono::system_clock::now();
     
+    // The task owns everything it touches, so a run that times out can
+    // finish after this call (or this HealthCheck) is gone
+    auto promise = std::make_shared<std::promise<HealthCheckResult>>();
+    auto future = promise->get_future();
+    bool started = submit_check([check_func = check_func_, promise, run = run_, name = name_]() {
+        HealthCheckResult value;
+        std::exception_ptr error;
+        if (run->cancelled.load(std::memory_order_acquire)) {
+            value = cancelled_result(name);
+        } else {
+            try {
+                value = check_func();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        run->finish();
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(value));
+        }
+    });
+    if (!started) {
+        run_->finish();
+        result.status = HealthStatus::UNHEALTHY;
+        result.message = "Health check could not be scheduled";
+        return record(std::move(result), start);
+    }
+    
     try {
-        // Execute with timeout
-        auto future = std::async(std::launch::async, check_func_);
-        
         if (future.wait_for(std::chrono::milliseconds(timeout_ms_)) == 
             std::future_status::timeout) {
-            result.status = HealthStatus::UNHEALTHY;
-            result.message = "Health check timed out after " + 
-                           std::to_string(timeout_ms_) + "ms";
+            result = timed_out_result(name_, timeout_ms_);
         } else {
             result = future.get();
         }
     } catch (const std::exception& e) {
         result.status = HealthStatus::UNHEALTHY;
         result.message = "Health check failed: " + std::string(e.what());
+    } catch (...) {
+        result.status = HealthStatus::UNHEALTHY;
+        result.message = "Health check failed: unknown exception";
+    }
+    
+    return record(std::move(result), start);
+}
+
+HealthCheckResult HealthCheck::probe() {
+    auto start = std::chrono::steady_clock::now();
+    
+    HealthCheckResult result;
+    result.component_name = name_;
+    
+    try {
+        result = check_func_();
+    } catch (const std::exception& e) {
+        result.status = HealthStatus::UNHEALTHY;
+        result.message = "Health check failed: " + std::string(e.what());
+    } catch (...) {
+        result.status = HealthStatus::UNHEALTHY;
+        result.message = "Health check failed: unknown exception";
     }
     
+    return record(std::move(result), start);
+}
+
+HealthCheckResult HealthCheck::record(HealthCheckResult result,
+                                      std::chrono::steady_clock::time_point start) {
     auto end = std::chrono::steady_clock::now();
     result.check_duration_ms = 
         std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     
     // Update cached result
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        last_result_ = result;
-        
-        if (result.status == HealthStatus::UNHEALTHY) {
-            consecutive_failures_++;
-        } else {
-            consecutive_failures_ = 0;
-        }
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_result_ = result;
+    
+    if (result.status == HealthStatus::UNHEALTHY) {
+        consecutive_failures_++;
+    } else {
+        consecutive_failures_ = 0;
     }
     
+    std::atomic_store_explicit(&cached_,
+                               std::shared_ptr<const HealthCheckResult>(
+                                   std::make_shared<HealthCheckResult>(result)),
+                               std::memory_order_release);
     return result;
 }
 
@@ -136,6 +252,7 @@ std::string SystemHealth::to_json() const {
     oss << "{\n";
     oss << "  \"overall_status\": \"" << health_status_to_string(overall_status) << "\",\n";
     oss << "  \"timestamp\": \"" << std::chrono::system_clock::to_time_t(timestamp) << "\",\n";
+    oss << "  \"from_cache\": " << (from_cache ? "true" : "false") << ",\n";
     oss << "  \"components\": [\n";
     
     for (size_t i = 0; i < component_results.size(); ++i) {
@@ -161,7 +278,7 @@ void SystemHealth::compute_overall_status() {
     for (const auto& result : component_results) {
         if (result.status == HealthStatus::UNHEALTHY) {
             has_unhealthy = true;
-        } else if (result.status == HealthStatus::DEGRADED) {
+        } else if (result.status == HealthStatus::DEGRADED || result.stale) {
             has_degraded = true;
         }
     }
@@ -184,28 +301,60 @@ HealthCheckRegistry& HealthCheckRegistry::instance() {
     return registry;
 }
 
+HealthCheckRegistry::~HealthCheckRegistry() {
+    stop_prober();
+    drain_checks();   // On-demand runs as well
+}
+
+void HealthCheckRegistry::drain_checks() {
+    std::vector<std::shared_ptr<HealthCheck>> checks;
+    int max_timeout_ms = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [_, check] : checks_) {
+            checks.push_back(check);
+            max_timeout_ms = std::max(max_timeout_ms, check->timeout_ms());
+        }
+    }
+    
+    // One shared deadline: a hung check is abandoned (its task owns what
+    // it touches) instead of holding up shutdown
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(max_timeout_ms);
+    for (auto& check : checks) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        check->cancel_and_wait(std::max(left, std::chrono::milliseconds(0)));
+    }
+}
+
 void HealthCheckRegistry::register_check(const std::string& name,
                                         HealthCheckFunction check_func,
-                                        int timeout_ms) {
+                                        int timeout_ms,
+                                        int interval_ms) {
     std::lock_guard<std::mutex> lock(mutex_);
-    checks_[name] = std::make_unique<HealthCheck>(name, check_func, timeout_ms);
+    checks_[name] = std::make_shared<HealthCheck>(name, check_func, timeout_ms, interval_ms);
+    prober_cv_.notify_all();   // New checks are due immediately
 }
 
 SystemHealth HealthCheckRegistry::check_all() {
-    std::vector<std::unique_ptr<HealthCheck>*> checks_to_run;
+    std::vector<std::shared_ptr<HealthCheck>> checks_to_run;
     
     {
         std::lock_guard<std::mutex> lock(mutex_);
+        if (prober_active_) {
+            return cached_health();
+        }
         for (auto& [_, check] : checks_) {
-            checks_to_run.push_back(&check);
+            checks_to_run.push_back(check);
         }
     }
     
     SystemHealth health;
     health.timestamp = std::chrono::system_clock::now();
     
-    for (auto* check_ptr : checks_to_run) {
-        health.component_results.push_back((*check_ptr)->execute());
+    for (auto& check : checks_to_run) {
+        health.component_results.push_back(check->execute());
     }
     
     health.compute_overall_status();
@@ -213,16 +362,145 @@ SystemHealth HealthCheckRegistry::check_all() {
     return health;
 }
 
-HealthCheckResult HealthCheckRegistry::check_one(const std::string& name) {
+SystemHealth HealthCheckRegistry::cached_health() const {
+    SystemHealth health;
+    health.timestamp = std::chrono::system_clock::now();
+    health.from_cache = true;
+    health.component_results.reserve(checks_.size());
+    
+    for (const auto& [name, check] : checks_) {
+        auto cached = check->cached_result();
+        HealthCheckResult result = cached
+            ? *cached
+            : create_health_result(name, HealthStatus::UNKNOWN, "Awaiting first probe");
+        
+        // Before the first result, age counts from the prober's start
+        auto since = cached ? result.timestamp : prober_started_;
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            health.timestamp - since);
+        result.age_ms = std::max<int64_t>(0, age.count());
+        result.stale = age > interval_of(*check) + std::chrono::milliseconds(check->timeout_ms());
+        
+        health.component_results.push_back(std::move(result));
+    }
+    
+    health.compute_overall_status();
+    return health;
+}
+
+std::chrono::milliseconds HealthCheckRegistry::interval_of(const HealthCheck& check) const {
+    return check.interval_ms() > 0 ? std::chrono::milliseconds(check.interval_ms())
+                                   : default_interval_;
+}
+
+void HealthCheckRegistry::start_prober(std::chrono::milliseconds default_interval) {
+    std::lock_guard<std::mutex> control(control_mutex_);
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = checks_.find(name);
-    if (it == checks_.end()) {
-        return create_health_result(name, HealthStatus::UNKNOWN, 
-                                    "Health check not found");
+    default_interval_ = std::max(default_interval, std::chrono::milliseconds(1));
+    if (prober_active_) {
+        prober_cv_.notify_all();
+        return;
     }
     
-    return it->second->execute();
+    prober_active_ = true;
+    prober_stop_ = false;
+    prober_started_ = std::chrono::system_clock::now();
+    for (auto& [_, check] : checks_) {
+        check->next_probe_ = std::chrono::steady_clock::time_point();
+    }
+    prober_ = std::thread(&HealthCheckRegistry::prober_loop, this);
+}
+
+void HealthCheckRegistry::stop_prober() {
+    std::lock_guard<std::mutex> control(control_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prober_active_) {
+            return;
+        }
+        prober_active_ = false;
+        prober_stop_ = true;
+    }
+    prober_cv_.notify_all();
+    prober_.join();
+    drain_checks();
+}
+
+bool HealthCheckRegistry::prober_running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return prober_active_;
+}
+
+void HealthCheckRegistry::prober_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (!prober_stop_) {
+        auto now = std::chrono::steady_clock::now();
+        auto next_wake = now + default_interval_;
+        
+        for (auto& [_, check] : checks_) {
+            auto timeout = std::chrono::milliseconds(check->timeout_ms());
+            
+            // Give up waiting on an overrunning probe: record the timeout,
+            // dated from the probe's start, and leave the task to finish
+            if (check->probe_done_) {
+                if (check->probe_done_->load(std::memory_order_acquire)) {
+                    check->probe_done_.reset();
+                } else if (now >= check->probe_started_ + timeout) {
+                    auto result = timed_out_result(check->name(), check->timeout_ms());
+                    result.timestamp = check->probe_started_wall_;
+                    check->record(std::move(result), check->probe_started_);
+                    check->probe_done_.reset();
+                }
+            }
+            
+            if (check->next_probe_ <= now) {
+                if (check->run_->try_start()) {
+                    auto done = std::make_shared<std::atomic<bool>>(false);
+                    bool started = submit_check([check = check, done]() {
+                        if (!check->run_->cancelled.load(std::memory_order_acquire)) {
+                            check->probe();
+                        }
+                        done->store(true, std::memory_order_release);
+                        check->run_->finish();
+                    });
+                    if (started) {
+                        check->probe_started_ = now;
+                        check->probe_started_wall_ = std::chrono::system_clock::now();
+                        check->probe_done_ = std::move(done);
+                    } else {
+                        check->run_->finish();
+                    }
+                }
+                // A run still in flight is left alone; its result ages
+                // until it is reported stale
+                check->next_probe_ = now + interval_of(*check);
+            }
+            next_wake = std::min(next_wake, check->next_probe_);
+            if (check->probe_done_) {
+                next_wake = std::min(next_wake, check->probe_started_ + timeout);
+            }
+        }
+        
+        prober_cv_.wait_until(lock, next_wake);
+    }
+}
+
+HealthCheckResult HealthCheckRegistry::check_one(const std::string& name) {
+    std::shared_ptr<HealthCheck> check;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = checks_.find(name);
+        if (it == checks_.end()) {
+            return create_health_result(name, HealthStatus::UNKNOWN, 
+                                        "Health check not found");
+        }
+        check = it->second;
+    }
+    
+    // Run outside the lock so the prober and cached check_all() never wait on it
+    return check->execute();
 }
 
 std::vector<std::string> HealthCheckRegistry::get_check_names() const {
@@ -352,6 +630,35 @@ HealthCheckResult check_memory_health() {
         result.status = HealthStatus::HEALTHY;
         result.message = "Memory usage normal: " + std::to_string(static_cast<int>(usage_percent)) + "%";
     }
+
+    // Process / cgroup view, as seen by the pressure monitor
+    auto& monitor = MemoryPressureMonitor::instance();
+    MemorySample sample = read_memory_sample(monitor.config());
+    MemoryPressureLevel pressure = monitor.running()
+        ? monitor.level()
+        : classify_memory_pressure(sample, monitor.config());
+
+    result.details["rss_mb"] = std::to_string(sample.rss_bytes / (1024 * 1024));
+    if (sample.cgroup_available) {
+        result.details["cgroup_current_mb"] =
+            std::to_string(sample.cgroup_current_bytes / (1024 * 1024));
+        result.details["cgroup_max_mb"] = sample.cgroup_max_bytes > 0
+            ? std::to_string(sample.cgroup_max_bytes / (1024 * 1024)) : "max";
+    }
+    if (sample.psi_available) {
+        std::ostringstream psi;
+        psi << std::fixed << std::setprecision(2) << sample.psi_some_avg10;
+        result.details["psi_some_avg10"] = psi.str();
+    }
+    result.details["pressure_level"] = memory_pressure_level_to_string(pressure);
+
+    if (pressure == MemoryPressureLevel::CRITICAL) {
+        result.status = HealthStatus::UNHEALTHY;
+        result.message = "Memory pressure critical, caches shrunk";
+    } else if (pressure == MemoryPressureLevel::HIGH && result.status == HealthStatus::HEALTHY) {
+        result.status = HealthStatus::DEGRADED;
+        result.message = "Memory pressure high, caches shrunk";
+    }
     
     return result;
 }
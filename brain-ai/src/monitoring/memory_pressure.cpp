@@ -0,0 +1,393 @@
+#include "monitoring/memory_pressure.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace brain_ai {
+namespace monitoring {
+
+namespace detail {
+
+struct MemoryPressureListeners {
+    std::mutex mutex;
+    std::map<uint64_t, MemoryPressureMonitor::Listener> listeners;
+    uint64_t next_id = 1;
+};
+
+} // namespace detail
+
+namespace {
+
+size_t page_size() {
+#ifdef __linux__
+    long size = ::sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#else
+    return 4096;
+#endif
+}
+
+bool read_file(const std::string& path, std::string& contents) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// memory.current / memory.max style file: a byte count or "max"
+bool read_bytes_file(const std::string& path, size_t& bytes) {
+    std::string contents;
+    if (!read_file(path, contents)) {
+        return false;
+    }
+    std::istringstream in(contents);
+    std::string token;
+    if (!(in >> token)) {
+        return false;
+    }
+    if (token == "max") {
+        bytes = 0;
+        return true;
+    }
+    try {
+        bytes = static_cast<size_t>(std::stoull(token));
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+// Directory of this process's cgroup v2 node ("0::<path>" line), or ""
+std::string cgroup_v2_dir(const MemoryPressureConfig& config) {
+    std::ifstream file(config.proc_root + "/self/cgroup");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            std::string path = line.substr(3);
+            return path == "/" ? config.cgroup_root : config.cgroup_root + path;
+        }
+    }
+    return "";
+}
+
+// PSI file: "some avg10=1.23 avg60=... total=..." / "full avg10=..."
+bool parse_psi(const std::string& contents, double& some_avg10, double& full_avg10) {
+    bool found = false;
+    std::istringstream in(contents);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        std::string avg10;
+        if (!(fields >> kind >> avg10) || avg10.compare(0, 6, "avg10=") != 0) {
+            continue;
+        }
+        double value = 0.0;
+        try {
+            value = std::stod(avg10.substr(6));
+        } catch (...) {
+            continue;
+        }
+        if (kind == "some") {
+            some_avg10 = value;
+            found = true;
+        } else if (kind == "full") {
+            full_avg10 = value;
+        }
+    }
+    return found;
+}
+
+void read_meminfo(const MemoryPressureConfig& config, MemorySample& sample) {
+    std::ifstream file(config.proc_root + "/meminfo");
+    std::string line;
+    bool have_total = false;
+    bool have_available = false;
+    while (std::getline(file, line) && !(have_total && have_available)) {
+        std::istringstream fields(line);
+        std::string key;
+        size_t kb = 0;
+        if (!(fields >> key >> kb)) {
+            continue;
+        }
+        if (key == "MemTotal:") {
+            sample.system_total_bytes = kb * 1024;
+            have_total = true;
+        } else if (key == "MemAvailable:") {
+            sample.system_available_bytes = kb * 1024;
+            have_available = true;
+        }
+    }
+    sample.system_available = have_total && have_available;
+}
+
+} // namespace
+
+// ============================================================================
+// Levels and Samples
+// ============================================================================
+
+const char* memory_pressure_level_to_string(MemoryPressureLevel level) {
+    switch (level) {
+        case MemoryPressureLevel::NORMAL: return "NORMAL";
+        case MemoryPressureLevel::MODERATE: return "MODERATE";
+        case MemoryPressureLevel::HIGH: return "HIGH";
+        case MemoryPressureLevel::CRITICAL: return "CRITICAL";
+        default: return "UNKNOWN";
+    }
+}
+
+double memory_pressure_budget_factor(MemoryPressureLevel level) {
+    switch (level) {
+        case MemoryPressureLevel::MODERATE: return 0.5;
+        case MemoryPressureLevel::HIGH: return 0.25;
+        case MemoryPressureLevel::CRITICAL: return 0.1;
+        default: return 1.0;
+    }
+}
+
+double MemorySample::usage_ratio() const {
+    if (cgroup_available && cgroup_max_bytes > 0) {
+        return static_cast<double>(cgroup_current_bytes) / cgroup_max_bytes;
+    }
+    if (rss_limit_bytes > 0) {
+        return static_cast<double>(rss_bytes) / rss_limit_bytes;
+    }
+    return 0.0;
+}
+
+MemorySample read_memory_sample(const MemoryPressureConfig& config) {
+    MemorySample sample;
+    sample.rss_limit_bytes = config.rss_limit_bytes;
+
+    std::string statm;
+    if (read_file(config.proc_root + "/self/statm", statm)) {
+        std::istringstream fields(statm);
+        size_t total_pages = 0;
+        size_t resident_pages = 0;
+        if (fields >> total_pages >> resident_pages) {
+            sample.rss_bytes = resident_pages * page_size();
+        }
+    }
+
+    read_meminfo(config, sample);
+
+    std::string cgroup_dir = cgroup_v2_dir(config);
+    if (!cgroup_dir.empty() &&
+        read_bytes_file(cgroup_dir + "/memory.current", sample.cgroup_current_bytes)) {
+        sample.cgroup_available = true;
+        if (!read_bytes_file(cgroup_dir + "/memory.max", sample.cgroup_max_bytes)) {
+            sample.cgroup_max_bytes = 0;
+        }
+    }
+
+    // Prefer the cgroup's own stall figures over the system-wide ones
+    std::string psi;
+    if ((!cgroup_dir.empty() && read_file(cgroup_dir + "/memory.pressure", psi) &&
+         parse_psi(psi, sample.psi_some_avg10, sample.psi_full_avg10)) ||
+        (read_file(config.proc_root + "/pressure/memory", psi) &&
+         parse_psi(psi, sample.psi_some_avg10, sample.psi_full_avg10))) {
+        sample.psi_available = true;
+    }
+
+    return sample;
+}
+
+MemoryPressureLevel classify_memory_pressure(const MemorySample& sample,
+                                             const MemoryPressureConfig& config,
+                                             MemoryPressureLevel current) {
+    auto threshold = [&](double value, MemoryPressureLevel level) {
+        return level <= current ? value * (1.0 - config.hysteresis) : value;
+    };
+
+    MemoryPressureLevel level = MemoryPressureLevel::NORMAL;
+    double ratio = sample.usage_ratio();
+    if (ratio > 0.0) {
+        if (ratio >= threshold(config.critical_ratio, MemoryPressureLevel::CRITICAL)) {
+            level = MemoryPressureLevel::CRITICAL;
+        } else if (ratio >= threshold(config.high_ratio, MemoryPressureLevel::HIGH)) {
+            level = MemoryPressureLevel::HIGH;
+        } else if (ratio >= threshold(config.moderate_ratio, MemoryPressureLevel::MODERATE)) {
+            level = MemoryPressureLevel::MODERATE;
+        }
+    }
+
+    if (sample.psi_available) {
+        MemoryPressureLevel stall = MemoryPressureLevel::NORMAL;
+        if (sample.psi_full_avg10 >=
+            threshold(config.critical_psi_full, MemoryPressureLevel::CRITICAL)) {
+            stall = MemoryPressureLevel::CRITICAL;
+        } else if (sample.psi_some_avg10 >=
+                   threshold(config.high_psi_some, MemoryPressureLevel::HIGH)) {
+            stall = MemoryPressureLevel::HIGH;
+        } else if (sample.psi_some_avg10 >=
+                   threshold(config.moderate_psi_some, MemoryPressureLevel::MODERATE)) {
+            stall = MemoryPressureLevel::MODERATE;
+        }
+        level = std::max(level, stall);
+    }
+
+    return level;
+}
+
+// ============================================================================
+// MemoryPressureSubscription Implementation
+// ============================================================================
+
+MemoryPressureSubscription::MemoryPressureSubscription(MemoryPressureSubscription&& other) noexcept
+    : listeners_(std::move(other.listeners_)), id_(other.id_) {
+    other.id_ = 0;
+}
+
+MemoryPressureSubscription& MemoryPressureSubscription::operator=(
+    MemoryPressureSubscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        listeners_ = std::move(other.listeners_);
+        id_ = other.id_;
+        other.id_ = 0;
+    }
+    return *this;
+}
+
+void MemoryPressureSubscription::reset() {
+    if (!listeners_) {
+        return;
+    }
+    {
+        // Waits for a notification in progress, so the listener never
+        // runs after this returns
+        std::lock_guard<std::mutex> lock(listeners_->mutex);
+        listeners_->listeners.erase(id_);
+    }
+    listeners_.reset();
+    id_ = 0;
+}
+
+// ============================================================================
+// MemoryPressureMonitor Implementation
+// ============================================================================
+
+MemoryPressureMonitor::MemoryPressureMonitor(const MemoryPressureConfig& config)
+    : config_(config),
+      listeners_(std::make_shared<detail::MemoryPressureListeners>()) {}
+
+MemoryPressureMonitor::~MemoryPressureMonitor() {
+    stop();
+}
+
+MemoryPressureMonitor& MemoryPressureMonitor::instance() {
+    static MemoryPressureMonitor monitor;
+    return monitor;
+}
+
+MemoryPressureSubscription MemoryPressureMonitor::subscribe(Listener listener) {
+    MemoryPressureSubscription subscription;
+    std::lock_guard<std::mutex> lock(listeners_->mutex);
+
+    MemoryPressureLevel current = level();
+    if (current != MemoryPressureLevel::NORMAL) {
+        listener(current);
+    }
+
+    subscription.id_ = listeners_->next_id++;
+    subscription.listeners_ = listeners_;
+    listeners_->listeners.emplace(subscription.id_, std::move(listener));
+    return subscription;
+}
+
+void MemoryPressureMonitor::publish(MemoryPressureLevel level) {
+    // Held across the exchange so listeners see changes in order
+    std::lock_guard<std::mutex> lock(listeners_->mutex);
+    int previous = level_.exchange(static_cast<int>(level), std::memory_order_acq_rel);
+    if (previous == static_cast<int>(level)) {
+        return;
+    }
+
+    auto& registry = MetricsRegistry::instance();
+    registry.get_gauge(metric_names::MEMORY_PRESSURE_LEVEL).set(static_cast<double>(level));
+    registry.get_counter(metric_names::MEMORY_PRESSURE_CHANGES).increment();
+
+    for (auto& [id, listener] : listeners_->listeners) {
+        try {
+            listener(level);
+        } catch (...) {
+            // A failing listener must not stop the others from shrinking
+        }
+    }
+}
+
+MemoryPressureLevel MemoryPressureMonitor::poll() {
+    MemorySample sample = read_memory_sample(config_);
+    {
+        std::lock_guard<std::mutex> lock(sample_mutex_);
+        last_sample_ = sample;
+    }
+
+    auto& registry = MetricsRegistry::instance();
+    registry.get_gauge(metric_names::MEMORY_RSS_BYTES).set(static_cast<double>(sample.rss_bytes));
+    registry.get_gauge(metric_names::MEMORY_USAGE_RATIO).set(sample.usage_ratio());
+    registry.get_gauge(metric_names::MEMORY_PSI_SOME_AVG10).set(sample.psi_some_avg10);
+
+    MemoryPressureLevel next = classify_memory_pressure(sample, config_, level());
+    publish(next);
+    return next;
+}
+
+MemorySample MemoryPressureMonitor::last_sample() const {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    return last_sample_;
+}
+
+void MemoryPressureMonitor::start() {
+    std::lock_guard<std::mutex> control(control_mutex_);
+    if (poller_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(poller_mutex_);
+        poller_stop_ = false;
+    }
+    poller_ = std::thread(&MemoryPressureMonitor::poller_loop, this);
+}
+
+void MemoryPressureMonitor::stop() {
+    std::lock_guard<std::mutex> control(control_mutex_);
+    if (!poller_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(poller_mutex_);
+        poller_stop_ = true;
+    }
+    poller_cv_.notify_all();
+    poller_.join();
+}
+
+bool MemoryPressureMonitor::running() const {
+    std::lock_guard<std::mutex> control(control_mutex_);
+    return poller_.joinable();
+}
+
+void MemoryPressureMonitor::poller_loop() {
+    std::unique_lock<std::mutex> lock(poller_mutex_);
+    while (!poller_stop_) {
+        lock.unlock();
+        poll();
+        lock.lock();
+        poller_cv_.wait_for(lock, config_.poll_interval, [this] { return poller_stop_; });
+    }
+}
+
+} // namespace monitoring
+} // namespace brain_ai
@@ -0,0 +1,250 @@
+#include "monitoring/perf_counters.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace brain_ai {
+namespace monitoring {
+
+namespace {
+
+bool env_enabled() {
+    const char* value = std::getenv("BRAIN_AI_PERF_COUNTERS");
+    return value != nullptr && value[0] != '\0' && std::strcmp(value, "0") != 0;
+}
+
+#ifdef __linux__
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_read_miss(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by PerfEvent
+const EventSpec kEventSpecs[kNumPerfEvents] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+// ============================================================================
+// Per-thread Event Group
+// ============================================================================
+
+class ThreadGroup {
+public:
+    ThreadGroup() {
+        int first_error = 0;
+        for (size_t event = 0; event < kNumPerfEvents; ++event) {
+            int fd = open_event(kEventSpecs[event], leader_fd_);
+            if (fd < 0) {
+                if (first_error == 0) {
+                    first_error = errno;
+                }
+                continue;   // Unsupported on this CPU; the rest still count
+            }
+            if (leader_fd_ < 0) {
+                leader_fd_ = fd;
+            }
+            fds_[num_open_] = fd;
+            slot_event_[num_open_] = event;
+            ++num_open_;
+        }
+
+        if (leader_fd_ < 0) {
+            reason_ = std::strerror(first_error != 0 ? first_error : ENOSYS);
+            MetricsRegistry::instance()
+                .get_counter(metric_names::PERF_COUNTERS_UNAVAILABLE)
+                .increment();
+        }
+    }
+
+    ~ThreadGroup() {
+        for (size_t slot = 0; slot < num_open_; ++slot) {
+            ::close(fds_[slot]);
+        }
+    }
+
+    ThreadGroup(const ThreadGroup&) = delete;
+    ThreadGroup& operator=(const ThreadGroup&) = delete;
+
+    bool available() const { return leader_fd_ >= 0; }
+    const std::string& reason() const { return reason_; }
+
+    bool read(PerfReading& reading) const {
+        if (leader_fd_ < 0) {
+            return false;
+        }
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, values[nr]
+        uint64_t buffer[3 + kNumPerfEvents];
+        ssize_t bytes = ::read(leader_fd_, buffer, sizeof(buffer));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+            return false;
+        }
+
+        uint64_t count = buffer[0];
+        uint64_t time_enabled = buffer[1];
+        uint64_t time_running = buffer[2];
+        if (count > num_open_ || time_running == 0) {
+            return false;   // Group never got onto the PMU
+        }
+
+        reading.valid_mask = 0;
+        for (size_t slot = 0; slot < count; ++slot) {
+            uint64_t value = buffer[3 + slot];
+            if (time_running < time_enabled) {
+                // Multiplexed: extrapolate to the full enabled time
+                value = static_cast<uint64_t>(
+                    static_cast<double>(value) * time_enabled / time_running);
+            }
+            reading.values[slot_event_[slot]] = value;
+            reading.valid_mask |= 1u << slot_event_[slot];
+        }
+        return true;
+    }
+
+private:
+    int leader_fd_ = -1;
+    int fds_[kNumPerfEvents] = {};
+    size_t slot_event_[kNumPerfEvents] = {};
+    size_t num_open_ = 0;
+    std::string reason_;
+
+    static int open_event(const EventSpec& spec, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = spec.type;
+        attr.config = spec.config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Calling thread on any CPU
+        long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+        return static_cast<int>(fd);
+    }
+};
+
+ThreadGroup& thread_group() {
+    thread_local ThreadGroup group;
+    return group;
+}
+
+#endif // __linux__
+
+} // namespace
+
+// ============================================================================
+// PerfCounters Implementation
+// ============================================================================
+
+std::atomic<bool> PerfCounters::enabled_{env_enabled()};
+
+const char* perf_event_name(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES: return "cycles";
+        case PerfEvent::INSTRUCTIONS: return "instructions";
+        case PerfEvent::LLC_MISSES: return "llc_misses";
+        case PerfEvent::DTLB_MISSES: return "dtlb_misses";
+        case PerfEvent::BRANCH_MISSES: return "branch_misses";
+        default: return "unknown";
+    }
+}
+
+#ifdef __linux__
+
+bool PerfCounters::available() {
+    return thread_group().available();
+}
+
+std::string PerfCounters::unavailable_reason() {
+    return thread_group().reason();
+}
+
+bool PerfCounters::read(PerfReading& reading) {
+    return thread_group().read(reading);
+}
+
+#else
+
+bool PerfCounters::available() {
+    return false;
+}
+
+std::string PerfCounters::unavailable_reason() {
+    return "perf_event_open is only supported on Linux";
+}
+
+bool PerfCounters::read(PerfReading& /*reading*/) {
+    return false;
+}
+
+#endif // __linux__
+
+// ============================================================================
+// PerfStage / PerfScope Implementation
+// ============================================================================
+
+void PerfStage::record(const PerfReading& delta) {
+    std::call_once(metrics_once_, [this] {
+        auto& registry = MetricsRegistry::instance();
+        std::string prefix = std::string(metric_names::PERF_PREFIX) + name_ + "_";
+        samples_ = &registry.get_counter(prefix + "samples");
+        for (size_t event = 0; event < kNumPerfEvents; ++event) {
+            counters_[event] = &registry.get_counter(
+                prefix + perf_event_name(static_cast<PerfEvent>(event)));
+        }
+    });
+
+    samples_->increment();
+    for (size_t event = 0; event < kNumPerfEvents; ++event) {
+        if ((delta.valid_mask >> event) & 1u) {
+            counters_[event]->increment(static_cast<int64_t>(delta.values[event]));
+        }
+    }
+}
+
+void PerfScope::begin(PerfStage& stage) {
+    if (PerfCounters::read(start_)) {
+        stage_ = &stage;
+    }
+}
+
+void PerfScope::end() {
+    PerfStage* stage = stage_;
+    stage_ = nullptr;
+
+    PerfReading now;
+    if (!PerfCounters::read(now)) {
+        return;
+    }
+
+    PerfReading delta;
+    delta.valid_mask = start_.valid_mask & now.valid_mask;
+    for (size_t event = 0; event < kNumPerfEvents; ++event) {
+        // Scaled values can step backwards slightly; clamp at zero
+        bool counted = ((delta.valid_mask >> event) & 1u) &&
+                       now.values[event] > start_.values[event];
+        delta.values[event] = counted ? now.values[event] - start_.values[event] : 0;
+    }
+    stage->record(delta);
+}
+
+} // namespace monitoring
+} // namespace brain_ai
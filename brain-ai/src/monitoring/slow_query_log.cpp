@@ -0,0 +1,242 @@
+#include "monitoring/slow_query_log.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+namespace brain_ai {
+namespace monitoring {
+
+static_assert(std::is_trivially_copyable<SlowQueryRecord>::value,
+              "SlowQueryRecord is copied through the ring word by word");
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+void fnv_mix(uint64_t& state, unsigned char byte) {
+    state ^= byte;
+    state *= kFnvPrime;
+}
+
+const char* const kQueryStageNames[kSlowQueryStages] = {
+    "vector", "episodic", "semantic", "fusion", "hallucination", "explanation"
+};
+const char* const kQueryResultNames[kSlowQueryResultCounts] = {
+    "vector", "episodic", "semantic", "fused"
+};
+const char* const kSearchStageNames[kSlowQueryStages] = {
+    "lock_wait", "hnsw", "filter", "", "", ""
+};
+const char* const kSearchResultNames[kSlowQueryResultCounts] = {
+    "candidates", "returned", "", ""
+};
+
+uint64_t wall_clock_ms() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// ============================================================================
+// Record Helpers
+// ============================================================================
+
+uint64_t fingerprint_text(const std::string& text) {
+    uint64_t state = kFnvOffset;
+    bool pending_space = false;
+    bool started = false;
+    for (unsigned char ch : text) {
+        if (std::isspace(ch)) {
+            pending_space = started;
+            continue;
+        }
+        if (pending_space) {
+            fnv_mix(state, ' ');
+            pending_space = false;
+        }
+        fnv_mix(state, static_cast<unsigned char>(std::tolower(ch)));
+        started = true;
+    }
+    return state;
+}
+
+uint64_t fingerprint_embedding(const std::vector<float>& embedding) {
+    uint64_t state = kFnvOffset;
+    for (float value : embedding) {
+        unsigned char bytes[sizeof(float)];
+        std::memcpy(bytes, &value, sizeof(float));
+        for (unsigned char byte : bytes) {
+            fnv_mix(state, byte);
+        }
+    }
+    return state;
+}
+
+const char* slow_query_stage_name(SlowQuerySource source, size_t stage) {
+    if (stage >= kSlowQueryStages) {
+        return "";
+    }
+    return source == SlowQuerySource::PROCESS_QUERY ? kQueryStageNames[stage]
+                                                    : kSearchStageNames[stage];
+}
+
+const char* slow_query_result_name(SlowQuerySource source, size_t index) {
+    if (index >= kSlowQueryResultCounts) {
+        return "";
+    }
+    return source == SlowQuerySource::PROCESS_QUERY ? kQueryResultNames[index]
+                                                    : kSearchResultNames[index];
+}
+
+std::string format_slow_query(const SlowQueryRecord& record) {
+    char fingerprint[17];
+    std::snprintf(fingerprint, sizeof(fingerprint), "%016llx",
+                  static_cast<unsigned long long>(record.fingerprint));
+
+    std::ostringstream line;
+    line << "seq=" << record.sequence
+         << " ts=" << record.timestamp_ms
+         << " src=" << (record.source == SlowQuerySource::PROCESS_QUERY ? "query" : "search")
+         << " fp=" << fingerprint
+         << " total_us=" << record.total_us;
+
+    line << " stages=";
+    for (size_t stage = 0; stage < kSlowQueryStages; ++stage) {
+        const char* name = slow_query_stage_name(record.source, stage);
+        if (*name == '\0') {
+            break;
+        }
+        line << (stage > 0 ? "," : "") << name << ":" << record.stage_us[stage];
+    }
+
+    line << " results=";
+    for (size_t index = 0; index < kSlowQueryResultCounts; ++index) {
+        const char* name = slow_query_result_name(record.source, index);
+        if (*name == '\0') {
+            break;
+        }
+        line << (index > 0 ? "," : "") << name << ":" << record.result_counts[index];
+    }
+
+    line << " k=" << record.top_k
+         << " ef=" << record.ef_search
+         << " hops=" << record.hops
+         << " dists=" << record.distance_computations;
+    return line.str();
+}
+
+// ============================================================================
+// SlowQueryLog Implementation
+// ============================================================================
+
+SlowQueryLog::SlowQueryLog(size_t capacity, uint32_t threshold_us)
+    : capacity_(std::max<size_t>(capacity, 1)),
+      slots_(new Slot[capacity_]),
+      threshold_us_(threshold_us) {}
+
+SlowQueryLog& SlowQueryLog::instance() {
+    static SlowQueryLog log;
+    return log;
+}
+
+void SlowQueryLog::record(SlowQueryRecord record) {
+    uint64_t ticket = next_ticket_.fetch_add(1, std::memory_order_relaxed);
+    record.sequence = ticket;
+    record.timestamp_ms = wall_clock_ms();
+    MetricsRegistry::instance().get_counter(metric_names::SLOW_QUERIES).increment();
+
+    Slot& slot = slots_[ticket % capacity_];
+    uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) != 0 ||
+        !slot.sequence.compare_exchange_strong(sequence, sequence + 1,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+        // Lapped a slot still being written
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // A writer holding ticket t can reach the slot after the one holding
+    // t + capacity; keep the newer record
+    if (slot.ticket.load(std::memory_order_relaxed) > ticket + 1) {
+        slot.sequence.store(sequence, std::memory_order_release);   // Contents unchanged
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot.ticket.store(ticket + 1, std::memory_order_relaxed);
+
+    uint64_t words[kRecordWords] = {};
+    std::memcpy(words, &record, sizeof(record));
+    for (size_t i = 0; i < kRecordWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+std::vector<SlowQueryRecord> SlowQueryLog::snapshot() const {
+    std::vector<SlowQueryRecord> records;
+    records.reserve(capacity_);
+    uint64_t cleared_before = cleared_before_.load(std::memory_order_relaxed);
+
+    uint64_t words[kRecordWords];
+    for (size_t index = 0; index < capacity_; ++index) {
+        const Slot& slot = slots_[index];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0 || (before & 1) != 0) {
+            continue;
+        }
+        for (size_t i = 0; i < kRecordWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            continue;   // Rewritten while copying
+        }
+
+        SlowQueryRecord record;
+        std::memcpy(&record, words, sizeof(record));
+        if (record.sequence >= cleared_before) {
+            records.push_back(record);
+        }
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](const SlowQueryRecord& a, const SlowQueryRecord& b) {
+                  return a.sequence < b.sequence;
+              });
+    return records;
+}
+
+std::string SlowQueryLog::dump() const {
+    std::string out;
+    for (const auto& record : snapshot()) {
+        out += format_slow_query(record);
+        out += '\n';
+    }
+    return out;
+}
+
+bool SlowQueryLog::dump_to_file(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << dump();
+    return static_cast<bool>(file.flush());
+}
+
+void SlowQueryLog::clear() {
+    cleared_before_.store(next_ticket_.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+}
+
+} // namespace monitoring
+} // namespace brain_ai
@@ -0,0 +1,107 @@
+#include "quantization.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace brain_ai {
+
+float quantize_int8(const float* src, size_t n, int8_t* codes) {
+    float max_abs = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        max_abs = std::max(max_abs, std::fabs(src[i]));
+    }
+    
+    if (max_abs == 0.0f || !std::isfinite(max_abs)) {
+        std::fill(codes, codes + n, int8_t(0));
+        return 0.0f;
+    }
+    
+    float scale = max_abs / 127.0f;
+    float inv_scale = 1.0f / scale;
+    for (size_t i = 0; i < n; ++i) {
+        float q = std::nearbyint(src[i] * inv_scale);
+        codes[i] = static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+    }
+    return scale;
+}
+
+void dequantize_int8(const int8_t* codes, size_t n, float scale, float* dst) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(codes[i]) * scale;
+    }
+}
+
+#if defined(__AVX2__)
+namespace {
+
+// Signed x signed products via the unsigned x signed instructions:
+// a.b == |a| . (sign(a) * b). Codes are in [-127, 127], so |a| fits u8
+// and the pairwise i16 sums of maddubs cannot saturate.
+inline __m256i dot_block(__m256i acc, __m256i va, __m256i vb) {
+    __m256i abs_a = _mm256_sign_epi8(va, va);
+    __m256i signed_b = _mm256_sign_epi8(vb, va);
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+    return _mm256_dpbusd_epi32(acc, abs_a, signed_b);
+#elif defined(__AVXVNNI__)
+    return _mm256_dpbusd_avx_epi32(acc, abs_a, signed_b);
+#else
+    __m256i pairs = _mm256_maddubs_epi16(abs_a, signed_b);
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, _mm256_set1_epi16(1)));
+#endif
+}
+
+inline int32_t horizontal_sum(__m256i v) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+} // namespace
+#endif
+
+int32_t dot_product_int8(const int8_t* a, const int8_t* b, size_t n) {
+    size_t i = 0;
+    int32_t result = 0;
+    
+#if defined(__AVX2__)
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    for (; i + 64 <= n; i += 64) {
+        acc0 = dot_block(acc0,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        acc1 = dot_block(acc1,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)));
+    }
+    for (; i + 32 <= n; i += 32) {
+        acc0 = dot_block(acc0,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    }
+    result = horizontal_sum(_mm256_add_epi32(acc0, acc1));
+#endif
+    
+    for (; i < n; ++i) {
+        result += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return result;
+}
+
+const char* int8_kernel_name() {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+    return "avx512-vnni";
+#elif defined(__AVXVNNI__)
+    return "avx-vnni";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace brain_ai
@@ -0,0 +1,246 @@
+#include "query_scheduler.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace brain_ai {
+
+namespace {
+
+// Slots held by this thread (nested admissions pass straight through)
+thread_local size_t t_held_slots = 0;
+
+constexpr std::string_view kWaitMetrics[kQueryPriorityCount] = {
+    monitoring::metric_names::SCHEDULER_INTERACTIVE_WAIT_US,
+    monitoring::metric_names::SCHEDULER_BULK_WAIT_US,
+    monitoring::metric_names::SCHEDULER_INGEST_WAIT_US,
+};
+
+size_t index_of(QueryPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+} // namespace
+
+const char* query_priority_name(QueryPriority priority) {
+    switch (priority) {
+        case QueryPriority::INTERACTIVE: return "interactive";
+        case QueryPriority::BULK: return "bulk";
+        case QueryPriority::INGEST: return "ingest";
+    }
+    return "unknown";
+}
+
+QueryScheduler::Slot& QueryScheduler::Slot::operator=(Slot&& other) noexcept {
+    if (this != &other) {
+        release();
+        scheduler_ = std::exchange(other.scheduler_, nullptr);
+        priority_ = other.priority_;
+        enqueued_ = other.enqueued_;
+    }
+    return *this;
+}
+
+void QueryScheduler::Slot::release() {
+    if (scheduler_) {
+        std::exchange(scheduler_, nullptr)->release_slot(priority_, enqueued_);
+    }
+}
+
+QueryScheduler::QueryScheduler(const QuerySchedulerConfig& config)
+    : last_interactive_(Clock::now()),
+      last_adjust_(Clock::now()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    apply_config_locked(config);
+}
+
+QueryScheduler::~QueryScheduler() = default;
+
+QueryScheduler& QueryScheduler::shared() {
+    static QueryScheduler scheduler;
+    return scheduler;
+}
+
+void QueryScheduler::apply_config_locked(const QuerySchedulerConfig& config) {
+    config_ = config;
+    capacity_ = config_.max_concurrency;
+    if (capacity_ == 0) {
+        capacity_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const size_t defaults[kQueryPriorityCount] = {
+        capacity_,
+        std::max<size_t>(1, capacity_ / 2),
+        std::max<size_t>(1, capacity_ / 4),
+    };
+    for (size_t i = 0; i < kQueryPriorityCount; ++i) {
+        auto& lane_config = config_.lanes[i];
+        lane_config.weight = std::max<uint32_t>(lane_config.weight, 1);
+        size_t limit = lane_config.max_concurrency > 0 ? lane_config.max_concurrency : defaults[i];
+        lanes_[i].limit = std::min(limit, capacity_);
+        lanes_[i].stride = 1.0 / static_cast<double>(lane_config.weight);
+    }
+
+    // Throttling restarts from the configured ingest limit
+    ingest_max_ = lanes_[index_of(QueryPriority::INGEST)].limit;
+    monitoring::MetricsRegistry::instance()
+        .get_gauge(monitoring::metric_names::SCHEDULER_INGEST_LIMIT)
+        .set(static_cast<double>(ingest_max_));
+}
+
+void QueryScheduler::reconfigure(const QuerySchedulerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    apply_config_locked(config);
+    dispatch_locked();
+}
+
+QuerySchedulerConfig QueryScheduler::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+size_t QueryScheduler::lane_limit(QueryPriority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lanes_[index_of(priority)].limit;
+}
+
+QueryScheduler::Slot QueryScheduler::admit(QueryPriority priority, const RequestContext& context) {
+    if (t_held_slots > 0) {
+        return Slot();   // Already inside admitted work
+    }
+    context.check("scheduler");
+
+    auto enqueued = Clock::now();
+    Waiter waiter;
+    double wait_us;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Lane& lane = lanes_[index_of(priority)];
+        if (lane.queue.empty()) {
+            lane.pass = std::max(lane.pass, virtual_time_);   // Rejoin without banked credit
+        }
+        lane.queue.push_back(&waiter);
+        dispatch_locked();
+        auto granted = [&waiter]() { return waiter.granted; };
+        if (!context.can_expire()) {
+            waiter.cv.wait(lock, granted);
+        } else {
+            // Wake at the deadline, and every kExpiryPoll to notice cancel()
+            while (!waiter.granted) {
+                auto wake = std::min(context.deadline(), Clock::now() + kExpiryPoll);
+                waiter.cv.wait_until(lock, wake, granted);
+                if (!waiter.granted && context.expired()) {
+                    lane.queue.erase(std::find(lane.queue.begin(), lane.queue.end(), &waiter));
+                    lock.unlock();
+                    context.check("scheduler");
+                }
+            }
+        }
+
+        wait_us = std::chrono::duration<double, std::micro>(Clock::now() - enqueued).count();
+        lane.total_wait_us += wait_us;
+    }
+    monitoring::MetricsRegistry::instance()
+        .get_histogram(kWaitMetrics[index_of(priority)]).observe(wait_us);
+
+    ++t_held_slots;
+    return Slot(this, priority, enqueued);
+}
+
+void QueryScheduler::dispatch_locked() {
+    while (running_ < capacity_) {
+        Lane* next = nullptr;
+        for (auto& lane : lanes_) {
+            if (lane.queue.empty() || lane.running >= lane.limit) {
+                continue;
+            }
+            // Ties go to the higher-priority lane (earlier in the array)
+            if (!next || lane.pass < next->pass) {
+                next = &lane;
+            }
+        }
+        if (!next) {
+            return;
+        }
+
+        Waiter* waiter = next->queue.front();
+        next->queue.pop_front();
+        virtual_time_ = next->pass;
+        next->pass += next->stride;
+        next->running++;
+        next->admitted++;
+        running_++;
+
+        waiter->granted = true;
+        waiter->cv.notify_one();
+    }
+}
+
+void QueryScheduler::release_slot(QueryPriority priority, Clock::time_point enqueued) {
+    --t_held_slots;
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    lanes_[index_of(priority)].running--;
+    running_--;
+
+    if (priority == QueryPriority::INTERACTIVE) {
+        double latency_us = std::chrono::duration<double, std::micro>(now - enqueued).count();
+        interactive_latency_us_ += config_.latency_smoothing * (latency_us - interactive_latency_us_);
+        last_interactive_ = now;
+    }
+    adjust_ingest_locked(now);
+    dispatch_locked();
+}
+
+void QueryScheduler::adjust_ingest_locked(Clock::time_point now) {
+    if (config_.interactive_latency_target.count() <= 0 ||
+        now - last_adjust_ < config_.throttle_interval) {
+        return;
+    }
+    last_adjust_ = now;
+
+    // Stale samples stop counting once interactive traffic goes quiet
+    double target_us = static_cast<double>(config_.interactive_latency_target.count());
+    bool active = now - last_interactive_ < 10 * config_.throttle_interval;
+    double latency_us = active ? interactive_latency_us_ : 0.0;
+
+    Lane& ingest = lanes_[index_of(QueryPriority::INGEST)];
+    size_t limit = ingest.limit;
+    if (latency_us > target_us) {
+        limit = std::max<size_t>(1, limit / 2);
+        if (limit < ingest.limit) {
+            throttle_events_++;
+            monitoring::MetricsRegistry::instance()
+                .get_counter(monitoring::metric_names::SCHEDULER_INGEST_THROTTLED).increment();
+        }
+    } else if (latency_us < target_us / 2) {
+        limit = std::min(ingest_max_, limit + 1);
+    }
+
+    if (limit != ingest.limit) {
+        ingest.limit = limit;
+        monitoring::MetricsRegistry::instance()
+            .get_gauge(monitoring::metric_names::SCHEDULER_INGEST_LIMIT)
+            .set(static_cast<double>(limit));
+    }
+}
+
+QuerySchedulerStats QueryScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QuerySchedulerStats stats;
+    for (size_t i = 0; i < kQueryPriorityCount; ++i) {
+        const Lane& lane = lanes_[i];
+        auto& out = stats.lanes[i];
+        out.admitted = lane.admitted;
+        out.queued = lane.queue.size();
+        out.running = lane.running;
+        out.limit = lane.limit;
+        out.total_wait_us = lane.total_wait_us;
+    }
+    stats.interactive_latency_us = interactive_latency_us_;
+    stats.throttle_events = throttle_events_;
+    return stats;
+}
+
+} // namespace brain_ai
@@ -0,0 +1,77 @@
+#include "request_context.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/metrics.hpp"
+#include <string>
+
+namespace brain_ai {
+
+RequestContext RequestContext::with_timeout(Clock::duration timeout) {
+    auto now = Clock::now();
+    if (timeout >= Clock::time_point::max() - now) {
+        return cancellable();   // Too far out to represent
+    }
+    return with_deadline(now + timeout);
+}
+
+RequestContext RequestContext::with_deadline(Clock::time_point deadline) {
+    auto state = std::make_shared<State>();
+    state->deadline = deadline;
+    return RequestContext(std::move(state));
+}
+
+RequestContext RequestContext::cancellable() {
+    return RequestContext(std::make_shared<State>());
+}
+
+RequestContext RequestContext::derived(Clock::time_point deadline) {
+    auto state = std::make_shared<State>();
+    state->deadline = deadline;
+    state->reported.store(true, std::memory_order_relaxed);
+    return RequestContext(std::move(state));
+}
+
+void RequestContext::cancel() const {
+    if (state_) {
+        state_->cancelled.store(true, std::memory_order_release);
+    }
+}
+
+RequestContext::Clock::duration RequestContext::remaining() const {
+    if (!has_deadline()) {
+        return Clock::duration::max();
+    }
+    if (cancelled()) {
+        return Clock::duration::zero();
+    }
+    auto now = Clock::now();
+    return now < state_->deadline ? state_->deadline - now : Clock::duration::zero();
+}
+
+bool RequestContext::deadline_exceeded() const {
+    return !cancelled() && has_deadline() && Clock::now() >= state_->deadline;
+}
+
+bool RequestContext::should_stop(const char* stage) const {
+    if (!expired()) {
+        return false;
+    }
+
+    // Counted once per request, at the stage that gave up first
+    if (!state_->reported.exchange(true, std::memory_order_acq_rel)) {
+        auto& metrics = monitoring::MetricsRegistry::instance();
+        metrics.get_counter(monitoring::metric_names::REQUESTS_CANCELLED).increment();
+        if (deadline_exceeded()) {
+            metrics.get_counter(monitoring::metric_names::REQUESTS_DEADLINE_EXCEEDED).increment();
+        }
+        metrics.get_counter(std::string(monitoring::metric_names::CANCELLED_PREFIX) + stage).increment();
+    }
+    return true;
+}
+
+void RequestContext::check(const char* stage) const {
+    if (should_stop(stage)) {
+        throw errors::CancelledError(stage, deadline_exceeded());
+    }
+}
+
+} // namespace brain_ai
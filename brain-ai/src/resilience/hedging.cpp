@@ -0,0 +1,406 @@
+#include "resilience/hedging.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+
+namespace brain_ai {
+namespace resilience {
+
+// ============================================================================
+// Backoff
+// ============================================================================
+
+std::chrono::milliseconds backoff_delay(const BackoffPolicy& policy, size_t retry,
+                                        std::mt19937_64& rng) {
+    double base = static_cast<double>(std::max<int64_t>(policy.base.count(), 0));
+    double max = static_cast<double>(std::max<int64_t>(policy.max.count(), 0));
+    double ceiling = std::min(max, base * std::pow(std::max(policy.multiplier, 1.0),
+                                                   static_cast<double>(retry)));
+    if (ceiling <= 0.0) {
+        return std::chrono::milliseconds(0);
+    }
+    std::uniform_real_distribution<double> jitter(0.0, ceiling);
+    return std::chrono::milliseconds(static_cast<int64_t>(jitter(rng)));
+}
+
+// ============================================================================
+// LatencyTracker Implementation
+// ============================================================================
+
+LatencyTracker::LatencyTracker(size_t window)
+    : window_(std::max<size_t>(window, 1)) {
+    samples_.reserve(window_);
+}
+
+void LatencyTracker::record(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_.size() < window_) {
+        samples_.push_back(latency);
+    } else {
+        samples_[next_] = latency;
+    }
+    next_ = (next_ + 1) % window_;
+}
+
+std::optional<std::chrono::microseconds> LatencyTracker::percentile(double p,
+                                                                     size_t min_samples) const {
+    std::vector<std::chrono::microseconds> samples;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (samples_.empty() || samples_.size() < min_samples) {
+            return std::nullopt;
+        }
+        samples = samples_;
+    }
+
+    p = std::clamp(p, 0.0, 1.0);
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+    size_t index = rank == 0 ? 0 : rank - 1;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+size_t LatencyTracker::count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_.size();
+}
+
+// ============================================================================
+// AttemptContext Implementation
+// ============================================================================
+
+void AttemptContext::on_cancel(std::function<void()> canceller) {
+    // Cancellers run under the lock, so clearing one waits out a running
+    // cancellation before the attempt releases what it refers to
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cancelled_.load(std::memory_order_acquire)) {
+        if (canceller) {
+            canceller();
+        }
+        return;
+    }
+    canceller_ = std::move(canceller);
+}
+
+void AttemptContext::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cancelled_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (canceller_) {
+        canceller_();
+        canceller_ = nullptr;
+    }
+}
+
+// ============================================================================
+// HedgedExecutor Implementation
+// ============================================================================
+
+// One thread running callbacks at their due times
+class HedgedExecutor::Timer {
+public:
+    Timer() : thread_(&Timer::loop, this) {}
+    ~Timer() { stop(); }
+
+    void schedule(Clock::time_point when, std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            queue_.push(Entry{when, sequence_++, std::move(callback)});
+        }
+        cv_.notify_one();
+    }
+
+    // Runs pending callbacks early; later schedule() calls are ignored
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        while (!queue_.empty()) {
+            auto callback = std::move(const_cast<Entry&>(queue_.top()).callback);
+            queue_.pop();
+            callback();
+        }
+    }
+
+private:
+    struct Entry {
+        Clock::time_point when;
+        uint64_t sequence;
+        std::function<void()> callback;
+
+        bool operator>(const Entry& other) const {
+            return when != other.when ? when > other.when : sequence > other.sequence;
+        }
+    };
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (queue_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            auto when = queue_.top().when;
+            if (Clock::now() < when) {
+                cv_.wait_until(lock, when);
+                continue;
+            }
+            auto callback = std::move(const_cast<Entry&>(queue_.top()).callback);
+            queue_.pop();
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue_;
+    uint64_t sequence_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// State of one execute_async() call, shared by its attempts and timers
+struct HedgedExecutor::Request {
+    Attempt attempt;
+    Clock::time_point deadline;
+    std::function<bool()> cancelled;
+    std::promise<HedgedResult> promise;
+
+    std::mutex mutex;
+    HedgedResult result;
+    std::vector<std::shared_ptr<AttemptContext>> contexts;
+    size_t in_flight = 0;
+    size_t failed = 0;
+    size_t failures_seen = 0;
+    size_t primaries = 0;
+    size_t target = 0;
+    bool hedge = false;                  // Whether the value came from a hedge
+    bool decided = false;
+    bool completed = false;              // Promise set
+    Clock::time_point hedge_at;
+    std::optional<Clock::time_point> retry_at;
+    std::optional<Clock::time_point> armed;   // Earliest pending timer
+};
+
+HedgedExecutor::HedgedExecutor(const HedgingConfig& config, size_t targets)
+    : config_(config)
+    , targets_(targets)
+    , rng_(std::random_device{}()) {
+    if (targets_ == 0) {
+        throw std::invalid_argument("HedgedExecutor needs at least one target");
+    }
+    config_.max_attempts = std::max<size_t>(config_.max_attempts, 1);
+
+    // Attempts block in I/O, so the pool may exceed the core count
+    size_t threads = config_.attempt_threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency()) * (1 + config_.max_hedges);
+    }
+    timer_ = std::make_unique<Timer>();
+    pool_ = std::make_unique<WorkPool>(std::max<size_t>(threads, 1 + config_.max_hedges));
+}
+
+HedgedExecutor::~HedgedExecutor() {
+    // Pending requests give up: waiting ones through the timer's final
+    // callbacks, running ones as their attempts return
+    stopping_.store(true, std::memory_order_release);
+    timer_->stop();
+    pool_.reset();
+}
+
+std::chrono::microseconds HedgedExecutor::hedge_delay() const {
+    auto observed = latencies_.percentile(config_.hedge_percentile, config_.min_samples);
+    std::chrono::microseconds delay = observed ? *observed : config_.initial_hedge_delay;
+    return std::max<std::chrono::microseconds>(delay, config_.min_hedge_delay);
+}
+
+std::chrono::milliseconds HedgedExecutor::next_backoff(size_t retry) {
+    std::lock_guard<std::mutex> lock(rng_mutex_);
+    return backoff_delay(config_.backoff, retry, rng_);
+}
+
+std::future<HedgedResult> HedgedExecutor::execute_async(Attempt attempt, Clock::time_point deadline,
+                                                        std::function<bool()> cancelled) {
+    auto request = std::make_shared<Request>();
+    request->attempt = std::move(attempt);
+    request->deadline = deadline;
+    request->cancelled = std::move(cancelled);
+    auto future = request->promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(request->mutex);
+        request->target = next_target_.fetch_add(1, std::memory_order_relaxed) % targets_;
+        if (Clock::now() < deadline && !(request->cancelled && request->cancelled())) {
+            launch(request, request->target, false);
+            request->hedge_at = Clock::now() + hedge_delay();
+        }
+    }
+    advance(request);
+    return future;
+}
+
+HedgedResult HedgedExecutor::execute(const Attempt& attempt, Clock::time_point deadline,
+                                     const std::function<bool()>& cancelled) {
+    return execute_async(attempt, deadline, cancelled).get();
+}
+
+// Called with request->mutex held
+void HedgedExecutor::launch(const std::shared_ptr<Request>& request, size_t target, bool hedge) {
+    auto context = std::make_shared<AttemptContext>();
+    request->contexts.push_back(context);
+    ++request->in_flight;
+    ++request->result.attempts;
+    if (hedge) {
+        ++request->result.hedges;
+    } else {
+        ++request->primaries;
+    }
+
+    pool_->submit([this, request, context, target, hedge]() {
+        auto start = Clock::now();
+        std::optional<std::string> value;
+        try {
+            value = request->attempt(target, *context);
+        } catch (...) {
+            value.reset();
+        }
+        latencies_.record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start));
+        finish_attempt(request, target, hedge, std::move(value));
+    });
+}
+
+void HedgedExecutor::finish_attempt(const std::shared_ptr<Request>& request, size_t target, bool hedge,
+                                    std::optional<std::string> value) {
+    {
+        std::lock_guard<std::mutex> lock(request->mutex);
+        --request->in_flight;
+        if (value && !request->result.value) {
+            request->result.value = std::move(value);
+            request->target = target;
+            request->hedge = hedge;
+        } else if (!value) {
+            ++request->failed;
+        }
+    }
+    advance(request);
+}
+
+void HedgedExecutor::advance(const std::shared_ptr<Request>& request) {
+    std::vector<std::shared_ptr<AttemptContext>> to_cancel;
+    bool complete = false;
+    std::optional<Clock::time_point> arm;
+    {
+        std::lock_guard<std::mutex> lock(request->mutex);
+        if (request->completed) {
+            return;
+        }
+
+        const size_t max_in_flight = 1 + config_.max_hedges;
+        const bool hedging = config_.max_hedges > 0 && targets_ > 1 && config_.hedge_percentile > 0.0;
+        auto& result = request->result;
+
+        while (!request->decided) {
+            auto now = Clock::now();
+            if (result.value) {
+                request->decided = true;
+                break;
+            }
+            if (now >= request->deadline || (request->cancelled && request->cancelled()) ||
+                stopping_.load(std::memory_order_acquire)) {
+                result.abandoned = true;
+                request->decided = true;
+                break;
+            }
+
+            // A failure schedules a retry even while a hedge is still running,
+            // so the backoff overlaps the remaining attempt
+            if (request->failed > request->failures_seen) {
+                request->failures_seen = request->failed;
+                if (!request->retry_at && request->primaries < config_.max_attempts) {
+                    request->retry_at = now + next_backoff(request->primaries - 1);
+                }
+            }
+            if (!request->retry_at && request->in_flight == 0) {
+                request->decided = true;   // Out of attempts
+                break;
+            }
+
+            if (request->retry_at && now >= *request->retry_at && request->in_flight < max_in_flight) {
+                request->retry_at.reset();
+                request->target = (request->target + 1) % targets_;
+                launch(request, request->target, false);
+                request->hedge_at = now + hedge_delay();
+                continue;
+            }
+
+            bool can_hedge = hedging && result.hedges < config_.max_hedges &&
+                             request->in_flight > 0 && request->in_flight < max_in_flight;
+            if (can_hedge && now >= request->hedge_at) {
+                request->target = (request->target + 1) % targets_;
+                launch(request, request->target, true);
+                request->hedge_at = now + hedge_delay();
+                continue;
+            }
+
+            // Nothing due: arm the timer for the next event (attempt
+            // completions advance the request on their own)
+            std::optional<Clock::time_point> wake;
+            if (request->retry_at && request->in_flight < max_in_flight) {
+                wake = *request->retry_at;
+            }
+            if (can_hedge) {
+                wake = wake ? std::min(*wake, request->hedge_at) : request->hedge_at;
+            }
+            Clock::time_point give_up_check = request->cancelled ? now + kCancelPoll : request->deadline;
+            if (give_up_check < Clock::time_point::max()) {
+                give_up_check = std::min(give_up_check, request->deadline);
+                wake = wake ? std::min(*wake, give_up_check) : give_up_check;
+            }
+            if (wake && !(request->armed && *request->armed <= *wake && *request->armed > now)) {
+                request->armed = *wake;
+                arm = *wake;
+            }
+            break;
+        }
+
+        if (request->decided) {
+            // Abort the losers; the request completes once all have returned
+            to_cancel.swap(request->contexts);
+            if (request->in_flight == 0) {
+                request->completed = true;
+                result.target = request->target;
+                result.hedge_won = result.value.has_value() && request->hedge;
+                complete = true;
+            }
+        }
+    }
+
+    for (auto& context : to_cancel) {
+        context->cancel();
+    }
+    if (arm) {
+        timer_->schedule(*arm, [this, request]() { advance(request); });
+    }
+    if (complete) {
+        request->promise.set_value(std::move(request->result));
+    }
+}
+
+} // namespace resilience
+} // namespace brain_ai
@@ -0,0 +1,176 @@
+#include "resilience/rate_limiter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace brain_ai {
+namespace resilience {
+
+namespace {
+
+// Bucket word: [tag:16][theoretical arrival time in us:48]
+constexpr unsigned kTimeBits = 48;
+constexpr uint64_t kTimeMask = (uint64_t{1} << kTimeBits) - 1;
+
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+uint64_t tag_of(uint64_t key_hash) {
+    uint64_t tag = key_hash >> kTimeBits;
+    return tag == 0 ? 1 : tag;   // A zero word marks an unused bucket
+}
+
+} // namespace
+
+// ============================================================================
+// RateLimiter Implementation
+// ============================================================================
+
+RateLimiter::RateLimiter(const RateLimiterConfig& config)
+    : config_(config)
+    , epoch_(std::chrono::steady_clock::now()) {
+    if (!(config_.rate_per_second > 0.0)) {
+        throw std::invalid_argument("RateLimiter rate_per_second must be positive");
+    }
+    if (!(config_.burst > 0.0)) {
+        throw std::invalid_argument("RateLimiter burst must be positive");
+    }
+
+    shard_count_ = round_up_pow2(std::max<size_t>(config_.shards, 1));
+    buckets_per_shard_ = round_up_pow2(std::max<size_t>(config_.buckets_per_shard, 1));
+    config_.max_probes = std::clamp<size_t>(config_.max_probes, 1, buckets_per_shard_);
+    shard_bits_ = 0;
+    while ((size_t{1} << shard_bits_) < shard_count_) {
+        ++shard_bits_;
+    }
+
+    interval_us_ = 1e6 / config_.rate_per_second;
+    // Arrival times must fit the bucket word for years of uptime
+    if (config_.burst * interval_us_ > static_cast<double>(kTimeMask >> 2)) {
+        throw std::invalid_argument("RateLimiter burst takes too long to refill");
+    }
+    tolerance_us_ = static_cast<uint64_t>(std::llround(config_.burst * interval_us_));
+
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+    for (size_t i = 0; i < shard_count_; ++i) {
+        shards_[i].buckets = std::make_unique<Bucket[]>(buckets_per_shard_);
+    }
+}
+
+uint64_t RateLimiter::hash_key(std::string_view key) {
+    // FNV-1a, then a splitmix64 finalizer so the tag bits are well mixed
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char ch : key) {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+uint64_t RateLimiter::now_us() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch_).count());
+}
+
+RateLimitDecision RateLimiter::acquire_hashed(uint64_t key_hash, double cost) {
+    Shard& shard = shards_[key_hash & (shard_count_ - 1)];
+    const size_t mask = buckets_per_shard_ - 1;
+    const size_t home = static_cast<size_t>(key_hash >> shard_bits_) & mask;
+    const uint64_t key_tag = tag_of(key_hash);
+    const uint64_t charge = cost > 0.0
+        ? static_cast<uint64_t>(std::llround(cost * interval_us_)) : 0;
+
+    RateLimitDecision decision;
+    while (true) {
+        const uint64_t now = now_us();
+
+        // The key's own bucket, else the first slot it may claim: unused,
+        // or full again (a full bucket holds no state worth keeping)
+        Bucket* target = nullptr;
+        Bucket* claimable = nullptr;
+        for (size_t probe = 0; probe < config_.max_probes; ++probe) {
+            Bucket& bucket = shard.buckets[(home + probe) & mask];
+            uint64_t word = bucket.state.load(std::memory_order_relaxed);
+            if ((word >> kTimeBits) == key_tag) {
+                target = &bucket;
+                break;
+            }
+            if (!claimable && (word & kTimeMask) <= now) {
+                claimable = &bucket;
+            }
+        }
+        if (!target) {
+            target = claimable;
+        }
+
+        // Keys that find no slot share the shard's overflow bucket
+        uint64_t tag = key_tag;
+        if (!target) {
+            target = &shard.overflow;
+            tag = 1;
+        }
+
+        uint64_t word = target->state.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t tat;
+            if ((word >> kTimeBits) == tag) {
+                tat = std::max(word & kTimeMask, now);
+            } else if ((word & kTimeMask) <= now) {
+                tat = now;   // Claiming a free slot starts a full bucket
+            } else {
+                break;       // Another key claimed the slot first; look again
+            }
+
+            uint64_t next_tat = tat + charge;
+            if (next_tat - now > tolerance_us_) {
+                target->rejected.fetch_add(1, std::memory_order_relaxed);
+                decision.allowed = false;
+                decision.remaining = static_cast<double>(tolerance_us_ - (tat - now)) / interval_us_;
+                decision.retry_after = std::chrono::microseconds(next_tat - now - tolerance_us_);
+                return decision;
+            }
+
+            uint64_t desired = (tag << kTimeBits) | (next_tat & kTimeMask);
+            if (target->state.compare_exchange_weak(word, desired,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+                target->allowed.fetch_add(1, std::memory_order_relaxed);
+                decision.allowed = true;
+                decision.remaining = static_cast<double>(tolerance_us_ - (next_tat - now)) / interval_us_;
+                return decision;
+            }
+        }
+    }
+}
+
+RateLimiterStats RateLimiter::stats() const {
+    RateLimiterStats stats;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        const Shard& shard = shards_[i];
+        for (size_t b = 0; b < buckets_per_shard_; ++b) {
+            stats.allowed += shard.buckets[b].allowed.load(std::memory_order_relaxed);
+            stats.rejected += shard.buckets[b].rejected.load(std::memory_order_relaxed);
+        }
+
+        // Every request charged to the overflow bucket is an overflow
+        uint64_t allowed = shard.overflow.allowed.load(std::memory_order_relaxed);
+        uint64_t rejected = shard.overflow.rejected.load(std::memory_order_relaxed);
+        stats.allowed += allowed;
+        stats.rejected += rejected;
+        stats.overflows += allowed + rejected;
+    }
+    return stats;
+}
+
+} // namespace resilience
+} // namespace brain_ai
@@ -0,0 +1,547 @@
+#include "semantic_activation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace brain_ai {
+
+namespace {
+
+// Pull (bottom-up) when the frontier's out-edges exceed this share of all edges
+constexpr uint64_t kPullEdgeDivisor = 4;
+
+// Chunk sizes for the parallel levels (frontier entries / nodes)
+constexpr size_t kPushGrain = 256;
+constexpr size_t kPullGrain = 2048;
+
+void atomic_max(std::atomic<float>& target, float value) {
+    float current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Continue a BFS from `frontier` (level `hop`) with dense per-node state
+// on the pool. `activations` holds every node visited so far.
+ActivationList parallel_bfs_levels(const SemanticGraph& graph,
+                                   const std::unordered_map<uint32_t, float>& activations,
+                                   std::vector<std::pair<uint32_t, float>> frontier,
+                                   size_t hop,
+                                   const ActivationConfig& config,
+                                   WorkPool& pool,
+                                   const RequestContext& context) {
+    const uint32_t num_nodes = graph.num_nodes();
+    const uint32_t* targets = graph.targets();
+    const float* weights = graph.weights();
+    const float decay = config.decay_factor;
+    const float threshold = config.activation_threshold;
+    
+    std::vector<std::atomic<float>> activation(num_nodes);
+    std::vector<std::atomic<uint8_t>> visited(num_nodes);
+    std::vector<uint32_t> visited_nodes;
+    visited_nodes.reserve(activations.size());
+    for (const auto& [id, value] : activations) {
+        activation[id].store(value, std::memory_order_relaxed);
+        visited[id].store(1, std::memory_order_relaxed);
+        visited_nodes.push_back(id);
+    }
+    
+    std::vector<float> frontier_value;   // Pull only: activation * decay, NaN outside frontier
+    std::vector<std::vector<uint32_t>> discovered;
+    
+    for (; hop < config.max_hops && !frontier.empty(); ++hop) {
+        context.check("semantic");
+        
+        uint64_t frontier_edges = 0;
+        for (const auto& entry : frontier) {
+            frontier_edges += graph.degree(entry.first);
+        }
+        
+        if (frontier_edges > graph.num_edges() / kPullEdgeDivisor) {
+            // Bottom-up: each node takes the max over its frontier parents,
+            // so every node is written by one chunk only
+            const auto& reverse = graph.reverse_edges();
+            if (frontier_value.empty()) {
+                frontier_value.assign(num_nodes, std::numeric_limits<float>::quiet_NaN());
+            }
+            for (const auto& [id, value] : frontier) {
+                frontier_value[id] = value * decay;
+            }
+            
+            discovered.assign((num_nodes + kPullGrain - 1) / kPullGrain, {});
+            pool.parallel_for(num_nodes, kPullGrain, [&](size_t begin, size_t end) {
+                auto& out = discovered[begin / kPullGrain];
+                for (size_t v = begin; v < end; ++v) {
+                    float best = 0.0f;
+                    bool reached = false;
+                    for (uint64_t e = reverse.offsets[v]; e < reverse.offsets[v + 1]; ++e) {
+                        float candidate = frontier_value[reverse.sources[e]] * reverse.weights[e];
+                        if (candidate >= threshold && (!reached || candidate > best)) {
+                            best = candidate;
+                            reached = true;
+                        }
+                    }
+                    if (!reached) {
+                        continue;
+                    }
+                    if (visited[v].load(std::memory_order_relaxed) == 0) {
+                        visited[v].store(1, std::memory_order_relaxed);
+                        activation[v].store(best, std::memory_order_relaxed);
+                        out.push_back(static_cast<uint32_t>(v));
+                    } else if (best > activation[v].load(std::memory_order_relaxed)) {
+                        activation[v].store(best, std::memory_order_relaxed);
+                    }
+                }
+            });
+            
+            for (const auto& entry : frontier) {
+                frontier_value[entry.first] = std::numeric_limits<float>::quiet_NaN();
+            }
+        } else {
+            // Top-down: push from frontier chunks; the first thread to claim
+            // a node adds it to the next level
+            discovered.assign((frontier.size() + kPushGrain - 1) / kPushGrain, {});
+            pool.parallel_for(frontier.size(), kPushGrain, [&](size_t begin, size_t end) {
+                auto& out = discovered[begin / kPushGrain];
+                for (size_t i = begin; i < end; ++i) {
+                    uint32_t current = frontier[i].first;
+                    float value = frontier[i].second * decay;
+                    for (uint64_t e = graph.edge_begin(current); e < graph.edge_end(current); ++e) {
+                        float candidate = value * weights[e];
+                        if (candidate < threshold) {
+                            continue;
+                        }
+                        uint32_t target = targets[e];
+                        if (visited[target].load(std::memory_order_relaxed) == 0 &&
+                            visited[target].exchange(1, std::memory_order_relaxed) == 0) {
+                            out.push_back(target);
+                        }
+                        atomic_max(activation[target], candidate);
+                    }
+                }
+            });
+        }
+        
+        // parallel_for has joined, so relaxed values are final for this level
+        frontier.clear();
+        for (const auto& chunk : discovered) {
+            for (uint32_t id : chunk) {
+                frontier.push_back({id, activation[id].load(std::memory_order_relaxed)});
+                visited_nodes.push_back(id);
+            }
+        }
+    }
+    
+    ActivationList result;
+    result.reserve(visited_nodes.size());
+    for (uint32_t id : visited_nodes) {
+        result.emplace_back(id, activation[id].load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+// Sequential levels until the frontier is large enough to hand off to a
+// pool (explicit pool, else the shared one when it has several threads)
+ActivationList bfs_levels(const SemanticGraph& graph,
+                          const std::vector<uint32_t>& sources,
+                          const ActivationConfig& config,
+                          WorkPool* pool,
+                          const RequestContext& context) {
+    // Activation map (a node is visited once it has an activation)
+    std::unordered_map<uint32_t, float> activations;
+    
+    // Current level: (node, activation to propagate)
+    std::vector<std::pair<uint32_t, float>> frontier;
+    std::vector<uint32_t> discovered;
+    
+    for (uint32_t id : sources) {
+        if (activations.emplace(id, 1.0f).second) {
+            frontier.push_back({id, 1.0f});
+        }
+    }
+    
+    const uint32_t* targets = graph.targets();
+    const float* weights = graph.weights();
+    
+    for (size_t hop = 0; hop < config.max_hops && !frontier.empty(); ++hop) {
+        context.check("semantic");
+        if (config.parallel_frontier_threshold > 0 &&
+            frontier.size() >= config.parallel_frontier_threshold) {
+            WorkPool& workers = pool ? *pool : WorkPool::shared();
+            if (pool || workers.size() > 1) {
+                return parallel_bfs_levels(graph, activations, std::move(frontier),
+                                           hop, config, workers, context);
+            }
+        }
+        
+        discovered.clear();
+        for (const auto& [current, activation] : frontier) {
+            for (uint64_t e = graph.edge_begin(current); e < graph.edge_end(current); ++e) {
+                float new_activation = activation * config.decay_factor * weights[e];
+                if (new_activation < config.activation_threshold) {
+                    continue;
+                }
+                
+                // Keep the strongest path; expand next level on first visit
+                auto [it, inserted] = activations.try_emplace(targets[e], new_activation);
+                if (inserted) {
+                    discovered.push_back(targets[e]);
+                } else {
+                    it->second = std::max(it->second, new_activation);
+                }
+            }
+        }
+        
+        frontier.clear();
+        for (uint32_t id : discovered) {
+            frontier.push_back({id, activations[id]});
+        }
+    }
+    
+    return ActivationList(activations.begin(), activations.end());
+}
+
+} // namespace
+
+ActivationList bfs_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             const RequestContext& context) {
+    return bfs_levels(graph, sources, config, nullptr, context);
+}
+
+ActivationList bfs_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             WorkPool& pool) {
+    return bfs_levels(graph, sources, config, &pool, RequestContext());
+}
+
+ActivationList ppr_activation(const SemanticGraph& graph,
+                             const std::vector<uint32_t>& sources,
+                             const ActivationConfig& config,
+                             const RequestContext& context) {
+    struct PushState {
+        float estimate = 0.0f;
+        float residual = 0.0f;
+        bool queued = false;
+    };
+    
+    std::unordered_map<uint32_t, PushState> state;
+    std::deque<uint32_t> work;
+    const uint32_t* targets = graph.targets();
+    const float* weights = graph.weights();
+    const float alpha = config.ppr_alpha;
+    const float epsilon = config.ppr_epsilon;
+    
+    auto push_threshold = [&](uint32_t id) {
+        return epsilon * static_cast<float>(std::max<uint32_t>(graph.degree(id), 1));
+    };
+    
+    // Restart mass is split evenly over distinct sources
+    for (uint32_t id : sources) {
+        state.try_emplace(id);
+    }
+    if (state.empty()) {
+        return {};
+    }
+    float share = 1.0f / static_cast<float>(state.size());
+    for (auto& [id, node] : state) {
+        node.residual = share;
+        node.queued = true;
+        work.push_back(id);
+    }
+    
+    size_t pushes = 0;
+    while (!work.empty()) {
+        if (++pushes % kCancelCheckPushes == 0) {
+            context.check("semantic");
+        }
+        
+        uint32_t u = work.front();
+        work.pop_front();
+        
+        PushState& node = state[u];
+        node.queued = false;
+        float residual = node.residual;
+        node.residual = 0.0f;
+        
+        float out_weight = 0.0f;
+        for (uint64_t e = graph.edge_begin(u); e < graph.edge_end(u); ++e) {
+            out_weight += std::max(weights[e], 0.0f);
+        }
+        if (out_weight <= 0.0f) {
+            node.estimate += residual;  // Dangling: absorb
+            continue;
+        }
+        
+        node.estimate += alpha * residual;
+        float spread = (1.0f - alpha) * residual / out_weight;
+        for (uint64_t e = graph.edge_begin(u); e < graph.edge_end(u); ++e) {
+            if (weights[e] <= 0.0f) {
+                continue;
+            }
+            // References into unordered_map stay valid across inserts
+            PushState& neighbor = state[targets[e]];
+            neighbor.residual += spread * weights[e];
+            if (!neighbor.queued && neighbor.residual >= push_threshold(targets[e])) {
+                neighbor.queued = true;
+                work.push_back(targets[e]);
+            }
+        }
+    }
+    
+    float max_estimate = 0.0f;
+    for (const auto& [id, node] : state) {
+        max_estimate = std::max(max_estimate, node.estimate);
+    }
+    
+    ActivationList activations;
+    if (max_estimate <= 0.0f) {
+        return activations;
+    }
+    for (const auto& [id, node] : state) {
+        float activation = node.estimate / max_estimate;
+        if (activation >= config.activation_threshold) {
+            activations.emplace_back(id, activation);
+        }
+    }
+    return activations;
+}
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+// Activations are stored in blocks of 8 lanes (one AVX register); a node
+// only gets blocks for the lane groups that actually reach it
+constexpr size_t kLaneBlock = 8;
+constexpr size_t kMaxLaneBlocks = kMaxActivationBatch / kLaneBlock;
+
+// Per-thread scratch for batched BFS, reused across calls so a batch
+// costs O(touched nodes) instead of O(graph) in allocation and zeroing
+struct BatchWorkspace {
+    std::vector<uint32_t> slot_of;        // Node -> slot (kNone when untouched)
+    std::vector<uint32_t> slot_node;
+    std::vector<uint64_t> visited;        // Queries that reached the slot
+    std::vector<uint64_t> reached;        // Queries first reaching it this level
+    std::vector<uint32_t> slot_blocks;    // Slot -> lane block per group (or kNone)
+    std::vector<float> blocks;            // kLaneBlock activations per block
+    std::vector<uint32_t> reached_slots;
+    std::vector<uint32_t> frontier_slots;
+    std::vector<uint64_t> frontier_masks;
+    std::vector<float> frontier_values;   // kLaneBlock lanes per active group
+    
+    void clear() {
+        for (uint32_t node : slot_node) {
+            slot_of[node] = kNone;
+        }
+        slot_node.clear();
+        visited.clear();
+        reached.clear();
+        slot_blocks.clear();
+        blocks.clear();
+        reached_slots.clear();
+        frontier_slots.clear();
+        frontier_masks.clear();
+        frontier_values.clear();
+    }
+};
+
+BatchWorkspace& batch_workspace() {
+    thread_local BatchWorkspace workspace;
+    return workspace;
+}
+
+} // namespace
+
+std::vector<ActivationList> batch_bfs_activation(const SemanticGraph& graph,
+                                                const std::vector<std::vector<uint32_t>>& batch_sources,
+                                                const ActivationConfig& config) {
+    const size_t batch = batch_sources.size();
+    if (batch > kMaxActivationBatch) {
+        throw std::invalid_argument("Activation batch exceeds " +
+                                    std::to_string(kMaxActivationBatch) + " queries");
+    }
+    
+    const float decay = config.decay_factor;
+    const float threshold = config.activation_threshold;
+    const uint32_t* targets = graph.targets();
+    const float* weights = graph.weights();
+    
+    BatchWorkspace& ws = batch_workspace();
+    if (ws.slot_of.size() < graph.num_nodes()) {
+        ws.slot_of.resize(graph.num_nodes(), kNone);
+    }
+    
+    auto slot_for = [&ws](uint32_t node) {
+        uint32_t& slot = ws.slot_of[node];
+        if (slot == kNone) {
+            slot = static_cast<uint32_t>(ws.slot_node.size());
+            ws.slot_node.push_back(node);
+            ws.visited.push_back(0);
+            ws.reached.push_back(0);
+            ws.slot_blocks.resize(ws.slot_blocks.size() + kMaxLaneBlocks, kNone);
+        }
+        return slot;
+    };
+    auto block_for = [&ws](uint32_t slot, size_t group) {
+        uint32_t& block = ws.slot_blocks[slot * kMaxLaneBlocks + group];
+        if (block == kNone) {
+            block = static_cast<uint32_t>(ws.blocks.size() / kLaneBlock);
+            ws.blocks.resize(ws.blocks.size() + kLaneBlock, 0.0f);
+        }
+        return ws.blocks.data() + static_cast<size_t>(block) * kLaneBlock;
+    };
+    auto mark_reached = [&ws](uint32_t slot, uint64_t bits) {
+        if (ws.reached[slot] == 0) {
+            ws.reached_slots.push_back(slot);
+        }
+        ws.reached[slot] |= bits;
+    };
+    
+    for (size_t q = 0; q < batch; ++q) {
+        uint64_t bit = uint64_t{1} << q;
+        for (uint32_t id : batch_sources[q]) {
+            uint32_t slot = slot_for(id);
+            if ((ws.reached[slot] & bit) == 0) {
+                mark_reached(slot, bit);
+                block_for(slot, q / kLaneBlock)[q % kLaneBlock] = 1.0f;
+            }
+        }
+    }
+    
+    for (size_t hop = 0;; ++hop) {
+        // Snapshot the new frontier: activation * decay for each lane group
+        // the node is active in (NaN outside the mask, so those lanes never
+        // pass the threshold)
+        ws.frontier_slots.clear();
+        ws.frontier_masks.clear();
+        ws.frontier_values.clear();
+        for (uint32_t slot : ws.reached_slots) {
+            uint64_t mask = ws.reached[slot];
+            ws.visited[slot] |= mask;
+            ws.reached[slot] = 0;
+            ws.frontier_slots.push_back(slot);
+            ws.frontier_masks.push_back(mask);
+            for (size_t group = 0; group < kMaxLaneBlocks; ++group) {
+                unsigned bits = (mask >> (group * kLaneBlock)) & 0xFF;
+                if (bits == 0) {
+                    continue;
+                }
+                const float* activation = ws.blocks.data() +
+                    static_cast<size_t>(ws.slot_blocks[slot * kMaxLaneBlocks + group]) * kLaneBlock;
+                for (size_t l = 0; l < kLaneBlock; ++l) {
+                    ws.frontier_values.push_back((bits >> l) & 1
+                        ? activation[l] * decay
+                        : std::numeric_limits<float>::quiet_NaN());
+                }
+            }
+        }
+        ws.reached_slots.clear();
+        if (hop >= config.max_hops || ws.frontier_slots.empty()) {
+            break;
+        }
+        
+        const float* values = ws.frontier_values.data();
+        for (size_t i = 0; i < ws.frontier_slots.size(); ++i) {
+            uint32_t current = ws.slot_node[ws.frontier_slots[i]];
+            uint64_t mask = ws.frontier_masks[i];
+            
+            // Lane groups active at this node
+            unsigned groups = 0;
+            for (size_t group = 0; group < kMaxLaneBlocks; ++group) {
+                groups |= static_cast<unsigned>(((mask >> (group * kLaneBlock)) & 0xFF) != 0) << group;
+            }
+            
+            for (uint64_t e = graph.edge_begin(current); e < graph.edge_end(current); ++e) {
+                float weight = weights[e];
+                uint32_t slot = slot_for(targets[e]);
+                const float* lane_values = values;
+                
+                for (unsigned active = groups; active; active &= active - 1) {
+                    size_t group = __builtin_ctz(active);
+                    
+                    // Relax 8 queries at once (vectorized by the compiler)
+                    float candidate[kLaneBlock];
+                    unsigned pass = 0;
+                    for (size_t l = 0; l < kLaneBlock; ++l) {
+                        candidate[l] = lane_values[l] * weight;
+                        pass |= static_cast<unsigned>(candidate[l] >= threshold) << l;
+                    }
+                    lane_values += kLaneBlock;
+                    if (pass == 0) {
+                        continue;
+                    }
+                    
+                    float* activation = block_for(slot, group);
+                    for (size_t l = 0; l < kLaneBlock; ++l) {
+                        bool better = ((pass >> l) & 1) && candidate[l] > activation[l];
+                        activation[l] = better ? candidate[l] : activation[l];
+                    }
+                    
+                    // Queries reaching this node for the first time
+                    uint64_t fresh = (static_cast<uint64_t>(pass) << (group * kLaneBlock)) &
+                                     ~ws.visited[slot];
+                    if (fresh) {
+                        mark_reached(slot, fresh);
+                    }
+                }
+            }
+            values += kLaneBlock * __builtin_popcount(groups);
+        }
+    }
+    
+    std::vector<ActivationList> results(batch);
+    for (uint32_t slot = 0; slot < ws.slot_node.size(); ++slot) {
+        for (uint64_t mask = ws.visited[slot]; mask; mask &= mask - 1) {
+            int q = __builtin_ctzll(mask);
+            uint32_t block = ws.slot_blocks[slot * kMaxLaneBlocks + q / kLaneBlock];
+            results[q].emplace_back(ws.slot_node[slot], ws.blocks[block * kLaneBlock + q % kLaneBlock]);
+        }
+    }
+    ws.clear();
+    return results;
+}
+
+std::vector<ActivationList> compute_activation_batch(const SemanticGraph& graph,
+                                                    const std::vector<std::vector<uint32_t>>& batch_sources,
+                                                    const ActivationConfig& config) {
+    std::vector<ActivationList> results;
+    results.reserve(batch_sources.size());
+    
+    if (config.mode != ActivationMode::BFS) {
+        for (const auto& sources : batch_sources) {
+            results.push_back(compute_activation(graph, sources, config));
+        }
+        return results;
+    }
+    
+    for (size_t begin = 0; begin < batch_sources.size(); begin += kMaxActivationBatch) {
+        size_t end = std::min(begin + kMaxActivationBatch, batch_sources.size());
+        std::vector<std::vector<uint32_t>> chunk(batch_sources.begin() + begin,
+                                                 batch_sources.begin() + end);
+        for (auto& activations : batch_bfs_activation(graph, chunk, config)) {
+            results.push_back(std::move(activations));
+        }
+    }
+    return results;
+}
+
+ActivationList compute_activation(const SemanticGraph& graph,
+                                 const std::vector<uint32_t>& sources,
+                                 const ActivationConfig& config,
+                                 const RequestContext& context) {
+    switch (config.mode) {
+        case ActivationMode::PersonalizedPageRank:
+            return ppr_activation(graph, sources, config, context);
+        default:
+            return bfs_activation(graph, sources, config, context);
+    }
+}
+
+} // namespace brain_ai
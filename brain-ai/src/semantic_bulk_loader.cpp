@@ -0,0 +1,374 @@
+#include "semantic_bulk_loader.hpp"
+#include "mapped_file.hpp"
+#include "errors/exceptions.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace brain_ai {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Run fn(0..n-1) on n threads (the caller runs index 0). Every started
+// thread is joined before returning or throwing; the first exception
+// thrown by fn (or by starting a thread) is rethrown here.
+template <typename Fn>
+void run_parallel(size_t n, Fn&& fn) {
+    std::vector<std::exception_ptr> errors(n);
+    auto run = [&fn, &errors](size_t t) {
+        try {
+            fn(t);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    try {
+        workers.reserve(n > 0 ? n - 1 : 0);
+        for (size_t t = 1; t < n; ++t) {
+            workers.emplace_back(run, t);
+        }
+    } catch (...) {
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        throw;
+    }
+    run(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+MappedFile map_input(const std::string& path) {
+    try {
+        return MappedFile(path);
+    } catch (const std::exception& e) {
+        throw errors::SemanticNetworkError(e.what());
+    }
+}
+
+std::string_view trim(std::string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r')) {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+std::string_view unquote(std::string_view field) {
+    if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+        field = field.substr(1, field.size() - 2);
+    }
+    return field;
+}
+
+// Split off the next field up to separator (the remainder stays in line)
+std::string_view next_field(std::string_view& line, char separator) {
+    size_t pos = line.find(separator);
+    std::string_view field = line.substr(0, pos);
+    line = pos == std::string_view::npos ? std::string_view() : line.substr(pos + 1);
+    return unquote(trim(field));
+}
+
+// Parse state of one text chunk; names are views into the mapping
+struct TextChunk {
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::vector<std::string_view> names;
+    std::vector<EdgeRecord> edges;         // Local ids until remapped
+    size_t skipped = 0;
+    
+    uint32_t intern(std::string_view name) {
+        auto [it, inserted] = ids.try_emplace(name, static_cast<uint32_t>(names.size()));
+        if (inserted) {
+            names.push_back(name);
+        }
+        return it->second;
+    }
+};
+
+void parse_text_chunk(const char* begin, const char* end, char separator,
+                      float default_weight, bool skip_first_line, TextChunk& chunk) {
+    const char* cursor = begin;
+    bool first = true;
+    while (cursor < end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* line_end = newline ? newline : end;
+        std::string_view line(cursor, line_end - cursor);
+        cursor = newline ? newline + 1 : end;
+        
+        if (first) {
+            first = false;
+            if (skip_first_line) {
+                continue;
+            }
+        }
+        
+        line = trim(line);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        
+        std::string_view source = next_field(line, separator);
+        std::string_view target = next_field(line, separator);
+        std::string_view weight_field = next_field(line, separator);
+        if (source.empty() || target.empty()) {
+            ++chunk.skipped;
+            continue;
+        }
+        
+        float weight = default_weight;
+        if (!weight_field.empty()) {
+            const char* last = weight_field.data() + weight_field.size();
+            auto [ptr, ec] = std::from_chars(weight_field.data(), last, weight);
+            if (ec != std::errc() || ptr != last) {
+                ++chunk.skipped;
+                continue;
+            }
+        }
+        
+        uint32_t source_id = chunk.intern(source);
+        uint32_t target_id = chunk.intern(target);
+        chunk.edges.push_back({source_id, target_id, weight});
+    }
+}
+
+// Split [0, size) into n ranges that end just after a newline
+std::vector<size_t> chunk_boundaries(const char* data, size_t size, size_t n) {
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < n; ++i) {
+        size_t pos = std::max(bounds.back(), size * i / n);
+        const void* newline = pos < size ? std::memchr(data + pos, '\n', size - pos) : nullptr;
+        pos = newline ? static_cast<const char*>(newline) - data + 1 : size;
+        bounds.push_back(pos);
+    }
+    bounds.push_back(size);
+    return bounds;
+}
+
+} // namespace
+
+SemanticBulkLoader::SemanticBulkLoader(BulkLoadOptions options)
+    : options_(std::move(options)) {}
+
+EdgeListFormat SemanticBulkLoader::detect_format(const std::string& path) {
+    auto ends_with = [&path](const char* suffix) {
+        size_t len = std::strlen(suffix);
+        return path.size() >= len && path.compare(path.size() - len, len, suffix) == 0;
+    };
+    if (ends_with(".csv")) {
+        return EdgeListFormat::CSV;
+    }
+    if (ends_with(".bin")) {
+        return EdgeListFormat::Binary;
+    }
+    return EdgeListFormat::TSV;
+}
+
+size_t SemanticBulkLoader::resolve_threads(size_t bytes) const {
+    size_t threads = options_.num_threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Keep at least 1 MiB per chunk so small files stay single-threaded
+    constexpr size_t kMinChunkBytes = 1 << 20;
+    return std::max<size_t>(1, std::min(threads, bytes / kMinChunkBytes));
+}
+
+std::shared_ptr<const SemanticGraph> SemanticBulkLoader::load(const std::string& path) {
+    stats_ = BulkLoadStats{};
+    auto start = Clock::now();
+    
+    EdgeListFormat format = options_.format;
+    if (format == EdgeListFormat::Auto) {
+        format = detect_format(path);
+    }
+    
+    std::shared_ptr<const SemanticGraph> graph;
+    switch (format) {
+        case EdgeListFormat::CSV:
+            graph = load_text(path, ',');
+            break;
+        case EdgeListFormat::Binary:
+            graph = load_binary(path);
+            break;
+        default:
+            graph = load_text(path, '\t');
+            break;
+    }
+    
+    stats_.nodes = graph->num_nodes();
+    stats_.edges = graph->num_edges();
+    stats_.total_seconds = seconds_since(start);
+    if (stats_.total_seconds > 0.0) {
+        stats_.edges_per_sec = stats_.records / stats_.total_seconds;
+    }
+    return graph;
+}
+
+std::shared_ptr<const SemanticGraph> SemanticBulkLoader::load_text(
+    const std::string& path,
+    char separator
+) {
+    auto parse_start = Clock::now();
+    MappedFile file = map_input(path);
+    file.advise_sequential();
+    
+    size_t threads = resolve_threads(file.size());
+    auto bounds = chunk_boundaries(file.data(), file.size(), threads);
+    std::vector<TextChunk> chunks(threads);
+    
+    run_parallel(threads, [&](size_t t) {
+        parse_text_chunk(file.data() + bounds[t], file.data() + bounds[t + 1], separator,
+                         options_.default_weight, options_.skip_header && t == 0, chunks[t]);
+    });
+    
+    // Merge local name tables in chunk order, so ids follow first appearance
+    std::unordered_map<std::string_view, uint32_t> global_ids;
+    size_t local_names = 0;
+    for (const auto& chunk : chunks) {
+        local_names += chunk.names.size();
+    }
+    global_ids.reserve(local_names);
+    
+    std::vector<std::string> names;
+    std::vector<std::vector<uint32_t>> remap(threads);
+    std::vector<size_t> edge_offsets(threads + 1, 0);
+    for (size_t t = 0; t < threads; ++t) {
+        remap[t].reserve(chunks[t].names.size());
+        for (std::string_view name : chunks[t].names) {
+            auto [it, inserted] = global_ids.try_emplace(name, static_cast<uint32_t>(names.size()));
+            if (inserted) {
+                names.emplace_back(name);
+            }
+            remap[t].push_back(it->second);
+        }
+        edge_offsets[t + 1] = edge_offsets[t] + chunks[t].edges.size();
+        stats_.skipped += chunks[t].skipped;
+    }
+    
+    std::vector<EdgeRecord> edges(edge_offsets[threads]);
+    run_parallel(threads, [&](size_t t) {
+        EdgeRecord* out = edges.data() + edge_offsets[t];
+        for (const auto& edge : chunks[t].edges) {
+            *out++ = {remap[t][edge.source], remap[t][edge.target], edge.weight};
+        }
+        chunks[t] = TextChunk{};
+    });
+    
+    stats_.records = edges.size();
+    stats_.threads = threads;
+    stats_.parse_seconds = seconds_since(parse_start);
+    
+    auto build_start = Clock::now();
+    auto graph = SemanticGraph::build(std::move(names), std::move(edges));
+    stats_.build_seconds = seconds_since(build_start);
+    return graph;
+}
+
+std::shared_ptr<const SemanticGraph> SemanticBulkLoader::load_binary(const std::string& path) {
+    static_assert(sizeof(EdgeRecord) == 12, "EdgeRecord must match the packed record layout");
+    
+    auto parse_start = Clock::now();
+    MappedFile file = map_input(path);
+    file.advise_sequential();
+    if (file.size() % sizeof(EdgeRecord) != 0) {
+        throw errors::SemanticNetworkError("Binary edge list size is not a multiple of " +
+                                           std::to_string(sizeof(EdgeRecord)) + " bytes: " + path);
+    }
+    
+    size_t num_records = file.size() / sizeof(EdgeRecord);
+    size_t threads = resolve_threads(file.size());
+    std::vector<EdgeRecord> edges(num_records);
+    std::vector<uint32_t> max_ids(threads, 0);
+    
+    run_parallel(threads, [&](size_t t) {
+        size_t begin = num_records * t / threads;
+        size_t end = num_records * (t + 1) / threads;
+        if (begin == end) {
+            return;
+        }
+        std::memcpy(edges.data() + begin, file.data() + begin * sizeof(EdgeRecord),
+                    (end - begin) * sizeof(EdgeRecord));
+        uint32_t max_id = 0;
+        for (size_t i = begin; i < end; ++i) {
+            max_id = std::max({max_id, edges[i].source, edges[i].target});
+        }
+        max_ids[t] = max_id;
+    });
+    
+    size_t num_nodes = 0;
+    if (num_records > 0) {
+        num_nodes = static_cast<size_t>(*std::max_element(max_ids.begin(), max_ids.end())) + 1;
+    }
+    
+    // Names are bounded by their file; without one, only the id bound
+    // stops a corrupt record from allocating billions of default names
+    std::vector<std::string> names;
+    if (!options_.names_path.empty()) {
+        MappedFile names_file = map_input(options_.names_path);
+        std::string_view remaining(names_file.data(), names_file.size());
+        while (!remaining.empty()) {
+            size_t pos = remaining.find('\n');
+            std::string_view line = remaining.substr(0, pos);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            names.emplace_back(line);
+            remaining = pos == std::string_view::npos ? std::string_view() : remaining.substr(pos + 1);
+        }
+    }
+    
+    size_t max_nodes = options_.max_nodes;
+    if (max_nodes == 0) {
+        max_nodes = options_.names_path.empty() ? 2 * num_records : names.size();
+    }
+    if (num_nodes > max_nodes) {
+        throw errors::SemanticNetworkError("Binary edge list " + path + " references id " +
+                                           std::to_string(num_nodes - 1) + " but at most " +
+                                           std::to_string(max_nodes) + " nodes are allowed");
+    }
+    
+    if (!options_.names_path.empty()) {
+        if (names.size() < num_nodes) {
+            throw errors::SemanticNetworkError("Names file " + options_.names_path + " has " +
+                                               std::to_string(names.size()) + " entries but edges reference id " +
+                                               std::to_string(num_nodes - 1));
+        }
+    } else {
+        names.reserve(num_nodes);
+        for (size_t id = 0; id < num_nodes; ++id) {
+            names.push_back(std::to_string(id));
+        }
+    }
+    
+    stats_.records = edges.size();
+    stats_.threads = threads;
+    stats_.parse_seconds = seconds_since(parse_start);
+    
+    auto build_start = Clock::now();
+    auto graph = SemanticGraph::build(std::move(names), std::move(edges));
+    stats_.build_seconds = seconds_since(build_start);
+    return graph;
+}
+
+} // namespace brain_ai
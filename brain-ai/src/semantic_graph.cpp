@@ -0,0 +1,456 @@
+#include "semantic_graph.hpp"
+#include "mapped_file.hpp"
+#include "errors/exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <unistd.h>
+
+namespace brain_ai {
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'B', 'A', 'I', 'S', 'N', 'E', 'T', '\0'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint64_t kSectionAlignment = 64;
+
+enum Section {
+    kOffsets,
+    kTargets,
+    kWeights,
+    kStringOffsets,
+    kStringData,
+    kHashSlots,
+    kHasEmbedding,
+    kEmbeddings,
+    kNumSections
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_nodes;
+    uint32_t embedding_dim;
+    uint64_t num_edges;
+    uint64_t string_bytes;
+    uint64_t hash_slots;
+    uint64_t file_size;
+    uint64_t section_offset[kNumSections];
+    uint64_t section_bytes[kNumSections];
+};
+
+uint64_t align_up(uint64_t offset) {
+    return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+template <typename T>
+const T* section_ptr(const MappedFile& file, const SnapshotHeader& header, Section section) {
+    return reinterpret_cast<const T*>(file.data() + header.section_offset[section]);
+}
+
+} // namespace
+
+uint64_t SemanticGraph::hash_name(std::string_view name) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::shared_ptr<const SemanticGraph> SemanticGraph::empty() {
+    return build({}, {});
+}
+
+std::vector<uint32_t> SemanticGraph::build_hash_index(
+    const std::vector<char>& string_data,
+    const std::vector<uint64_t>& string_offsets
+) {
+    size_t num_nodes = string_offsets.size() - 1;
+    size_t slots = 2;
+    while (slots < num_nodes * 2) {
+        slots <<= 1;
+    }
+    
+    std::vector<uint32_t> index(slots, 0);
+    uint64_t mask = slots - 1;
+    for (size_t id = 0; id < num_nodes; ++id) {
+        std::string_view name(string_data.data() + string_offsets[id],
+                              string_offsets[id + 1] - string_offsets[id]);
+        uint64_t slot = hash_name(name) & mask;
+        while (index[slot] != 0) {
+            uint32_t other = index[slot] - 1;
+            std::string_view existing(string_data.data() + string_offsets[other],
+                                      string_offsets[other + 1] - string_offsets[other]);
+            if (existing == name) {
+                throw errors::InvalidGraphStructureError("duplicate concept '" +
+                                                         std::string(name) + "'");
+            }
+            slot = (slot + 1) & mask;
+        }
+        index[slot] = static_cast<uint32_t>(id + 1);
+    }
+    return index;
+}
+
+std::shared_ptr<const SemanticGraph> SemanticGraph::build(
+    std::vector<std::string> names,
+    std::vector<EdgeRecord> edges,
+    std::vector<std::vector<float>> embeddings
+) {
+    if (names.size() >= kInvalidId) {
+        throw errors::InvalidGraphStructureError("too many concepts");
+    }
+    const size_t num_nodes = names.size();
+    auto storage = std::make_shared<Storage>();
+    
+    // Counting sort by source (stable, so input order survives per source)
+    storage->offsets.assign(num_nodes + 1, 0);
+    for (const auto& edge : edges) {
+        if (edge.source >= num_nodes || edge.target >= num_nodes) {
+            throw errors::InvalidGraphStructureError("edge references unknown concept id");
+        }
+        ++storage->offsets[edge.source + 1];
+    }
+    std::partial_sum(storage->offsets.begin(), storage->offsets.end(), storage->offsets.begin());
+    
+    std::vector<uint32_t> sorted_targets(edges.size());
+    std::vector<float> sorted_weights(edges.size());
+    {
+        std::vector<uint64_t> cursor(storage->offsets.begin(), storage->offsets.end() - 1);
+        for (const auto& edge : edges) {
+            uint64_t pos = cursor[edge.source]++;
+            sorted_targets[pos] = edge.target;
+            sorted_weights[pos] = edge.weight;
+        }
+    }
+    edges.clear();
+    edges.shrink_to_fit();
+    
+    // Sort each row by target and drop duplicates (last weight wins)
+    storage->targets.reserve(sorted_targets.size());
+    storage->weights.reserve(sorted_weights.size());
+    std::vector<uint32_t> order;
+    uint64_t row_begin = 0;
+    for (size_t u = 0; u < num_nodes; ++u) {
+        uint64_t row_end = storage->offsets[u + 1];
+        storage->offsets[u] = storage->targets.size();
+        
+        bool strictly_sorted = true;
+        for (uint64_t i = row_begin + 1; i < row_end && strictly_sorted; ++i) {
+            strictly_sorted = sorted_targets[i - 1] < sorted_targets[i];
+        }
+        
+        if (strictly_sorted) {
+            storage->targets.insert(storage->targets.end(),
+                                    sorted_targets.begin() + row_begin,
+                                    sorted_targets.begin() + row_end);
+            storage->weights.insert(storage->weights.end(),
+                                    sorted_weights.begin() + row_begin,
+                                    sorted_weights.begin() + row_end);
+        } else {
+            order.resize(row_end - row_begin);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return sorted_targets[row_begin + a] < sorted_targets[row_begin + b];
+            });
+            for (size_t i = 0; i < order.size(); ++i) {
+                uint64_t pos = row_begin + order[i];
+                bool last_of_run = i + 1 == order.size() ||
+                    sorted_targets[row_begin + order[i + 1]] != sorted_targets[pos];
+                if (last_of_run) {
+                    storage->targets.push_back(sorted_targets[pos]);
+                    storage->weights.push_back(sorted_weights[pos]);
+                }
+            }
+        }
+        row_begin = row_end;
+    }
+    storage->offsets[num_nodes] = storage->targets.size();
+    
+    // String table
+    storage->string_offsets.reserve(num_nodes + 1);
+    size_t total_chars = 0;
+    for (const auto& name : names) {
+        total_chars += name.size();
+    }
+    storage->string_data.reserve(total_chars);
+    for (const auto& name : names) {
+        storage->string_offsets.push_back(storage->string_data.size());
+        storage->string_data.insert(storage->string_data.end(), name.begin(), name.end());
+    }
+    storage->string_offsets.push_back(storage->string_data.size());
+    names.clear();
+    storage->hash_slots = build_hash_index(storage->string_data, storage->string_offsets);
+    
+    // Embedding block
+    uint32_t dim = 0;
+    for (const auto& embedding : embeddings) {
+        if (!embedding.empty()) {
+            dim = static_cast<uint32_t>(embedding.size());
+            break;
+        }
+    }
+    if (dim > 0) {
+        storage->embeddings.assign(num_nodes * static_cast<size_t>(dim), 0.0f);
+        storage->has_embedding.assign(num_nodes, 0);
+        for (size_t u = 0; u < std::min(num_nodes, embeddings.size()); ++u) {
+            if (embeddings[u].empty()) {
+                continue;
+            }
+            if (embeddings[u].size() != dim) {
+                throw errors::InvalidGraphStructureError("embedding dimension mismatch");
+            }
+            std::copy(embeddings[u].begin(), embeddings[u].end(),
+                      storage->embeddings.begin() + u * dim);
+            storage->has_embedding[u] = 1;
+        }
+    }
+    
+    std::shared_ptr<SemanticGraph> graph(new SemanticGraph());
+    graph->num_nodes_ = static_cast<uint32_t>(num_nodes);
+    graph->num_edges_ = storage->targets.size();
+    graph->embedding_dim_ = dim;
+    graph->attach(std::move(storage));
+    return graph;
+}
+
+void SemanticGraph::attach(std::shared_ptr<Storage> storage) {
+    offsets_ = storage->offsets.data();
+    targets_ = storage->targets.data();
+    weights_ = storage->weights.data();
+    string_data_ = storage->string_data.data();
+    string_offsets_ = storage->string_offsets.data();
+    hash_slots_ = storage->hash_slots.data();
+    hash_mask_ = storage->hash_slots.size() - 1;
+    embeddings_ = storage->embeddings.empty() ? nullptr : storage->embeddings.data();
+    has_embedding_ = storage->has_embedding.empty() ? nullptr : storage->has_embedding.data();
+    backing_ = std::move(storage);
+}
+
+uint32_t SemanticGraph::find(std::string_view name) const {
+    uint64_t slot = hash_name(name) & hash_mask_;
+    while (hash_slots_[slot] != 0) {
+        uint32_t id = hash_slots_[slot] - 1;
+        if (this->name(id) == name) {
+            return id;
+        }
+        slot = (slot + 1) & hash_mask_;
+    }
+    return kInvalidId;
+}
+
+std::string_view SemanticGraph::name(uint32_t id) const {
+    return std::string_view(string_data_ + string_offsets_[id],
+                            string_offsets_[id + 1] - string_offsets_[id]);
+}
+
+const SemanticGraph::ReverseEdges& SemanticGraph::reverse_edges() const {
+    std::call_once(reverse_once_, [this] {
+        auto reverse = std::make_unique<ReverseEdges>();
+        reverse->offsets.assign(static_cast<size_t>(num_nodes_) + 1, 0);
+        reverse->sources.resize(num_edges_);
+        reverse->weights.resize(num_edges_);
+        
+        // Counting sort by target; scanning sources in order keeps rows sorted
+        for (uint64_t e = 0; e < num_edges_; ++e) {
+            ++reverse->offsets[targets_[e] + 1];
+        }
+        std::partial_sum(reverse->offsets.begin(), reverse->offsets.end(), reverse->offsets.begin());
+        std::vector<uint64_t> cursor(reverse->offsets.begin(), reverse->offsets.end() - 1);
+        for (uint32_t u = 0; u < num_nodes_; ++u) {
+            for (uint64_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                uint64_t slot = cursor[targets_[e]]++;
+                reverse->sources[slot] = u;
+                reverse->weights[slot] = weights_[e];
+            }
+        }
+        reverse_ = std::move(reverse);
+    });
+    return *reverse_;
+}
+
+const float* SemanticGraph::embedding(uint32_t id) const {
+    if (embedding_dim_ == 0 || !has_embedding_[id]) {
+        return nullptr;
+    }
+    return embeddings_ + static_cast<size_t>(id) * embedding_dim_;
+}
+
+void SemanticGraph::save_to_file(const std::string& path) const {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.byte_order = kByteOrderMark;
+    header.num_nodes = num_nodes_;
+    header.embedding_dim = embedding_dim_;
+    header.num_edges = num_edges_;
+    header.string_bytes = string_offsets_[num_nodes_];
+    header.hash_slots = hash_mask_ + 1;
+    
+    const void* sections[kNumSections] = {
+        offsets_, targets_, weights_, string_offsets_, string_data_, hash_slots_,
+        has_embedding_, embeddings_
+    };
+    header.section_bytes[kOffsets] = (num_nodes_ + 1ull) * sizeof(uint64_t);
+    header.section_bytes[kTargets] = num_edges_ * sizeof(uint32_t);
+    header.section_bytes[kWeights] = num_edges_ * sizeof(float);
+    header.section_bytes[kStringOffsets] = (num_nodes_ + 1ull) * sizeof(uint64_t);
+    header.section_bytes[kStringData] = header.string_bytes;
+    header.section_bytes[kHashSlots] = header.hash_slots * sizeof(uint32_t);
+    header.section_bytes[kHasEmbedding] = embedding_dim_ > 0 ? num_nodes_ : 0;
+    header.section_bytes[kEmbeddings] =
+        static_cast<uint64_t>(num_nodes_) * embedding_dim_ * sizeof(float);
+    
+    uint64_t offset = align_up(sizeof(SnapshotHeader));
+    for (int i = 0; i < kNumSections; ++i) {
+        header.section_offset[i] = offset;
+        offset = align_up(offset + header.section_bytes[i]);
+    }
+    header.file_size = offset;
+    
+    // Write beside the target and rename, so readers never see a partial
+    // file; the name is unique per process and call so concurrent saves to
+    // one path never share a temp file
+    static std::atomic<uint64_t> save_counter{0};
+    std::string tmp_path = path + ".tmp." + std::to_string(::getpid()) + "." +
+                           std::to_string(save_counter.fetch_add(1));
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            throw errors::SemanticNetworkError("Failed to open file for writing: " + tmp_path);
+        }
+        static const char padding[kSectionAlignment] = {};
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t written = sizeof(header);
+        for (int i = 0; i < kNumSections; ++i) {
+            ofs.write(padding, header.section_offset[i] - written);
+            if (header.section_bytes[i] > 0) {
+                ofs.write(static_cast<const char*>(sections[i]), header.section_bytes[i]);
+            }
+            written = header.section_offset[i] + header.section_bytes[i];
+        }
+        ofs.write(padding, header.file_size - written);
+        ofs.flush();
+        if (!ofs) {
+            std::remove(tmp_path.c_str());
+            throw errors::SemanticNetworkError("Failed to write semantic graph snapshot: " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw errors::SemanticNetworkError("Failed to replace semantic graph snapshot: " + path);
+    }
+}
+
+std::shared_ptr<const SemanticGraph> SemanticGraph::load_from_file(const std::string& path) {
+    auto file = std::make_shared<MappedFile>();
+    try {
+        *file = MappedFile(path);
+    } catch (const std::exception& e) {
+        throw errors::SemanticNetworkError(e.what());
+    }
+    
+    auto fail = [&path](const std::string& reason) {
+        return errors::SemanticNetworkError("Invalid semantic graph snapshot " + path + ": " + reason);
+    };
+    
+    SnapshotHeader header;
+    if (file->size() < sizeof(header)) {
+        throw fail("file too small");
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+        throw fail("bad magic");
+    }
+    if (header.version != kSnapshotVersion) {
+        throw fail("unsupported version " + std::to_string(header.version));
+    }
+    if (header.byte_order != kByteOrderMark) {
+        throw fail("written with a different byte order");
+    }
+    if (header.file_size != file->size()) {
+        throw fail("truncated");
+    }
+    
+    // Bound the counts by the file size first, so the byte sizes below
+    // cannot overflow (n * embedding_dim itself fits in 64 bits)
+    const uint64_t n = header.num_nodes;
+    if (header.num_edges > file->size() / sizeof(uint32_t) ||
+        header.hash_slots > file->size() / sizeof(uint32_t) ||
+        n * header.embedding_dim > file->size() / sizeof(float)) {
+        throw fail("section sizes exceed the file");
+    }
+    const uint64_t expected[kNumSections] = {
+        (n + 1) * sizeof(uint64_t),
+        header.num_edges * sizeof(uint32_t),
+        header.num_edges * sizeof(float),
+        (n + 1) * sizeof(uint64_t),
+        header.string_bytes,
+        header.hash_slots * sizeof(uint32_t),
+        header.embedding_dim > 0 ? n : 0,
+        n * header.embedding_dim * sizeof(float)
+    };
+    for (int i = 0; i < kNumSections; ++i) {
+        if (header.section_bytes[i] != expected[i] ||
+            header.section_offset[i] % kSectionAlignment != 0 ||
+            header.section_offset[i] > file->size() ||
+            header.section_bytes[i] > file->size() - header.section_offset[i]) {
+            throw fail("section " + std::to_string(i) + " out of bounds");
+        }
+    }
+    
+    // Structural checks, so traversal can trust the arrays
+    if (header.hash_slots <= n || (header.hash_slots & (header.hash_slots - 1)) != 0) {
+        throw fail("bad name index size");
+    }
+    const uint64_t* offsets = section_ptr<uint64_t>(*file, header, kOffsets);
+    const uint64_t* string_offsets = section_ptr<uint64_t>(*file, header, kStringOffsets);
+    if (offsets[0] != 0 || offsets[n] != header.num_edges ||
+        string_offsets[0] != 0 || string_offsets[n] != header.string_bytes) {
+        throw fail("bad offsets");
+    }
+    for (uint64_t u = 0; u < n; ++u) {
+        if (offsets[u] > offsets[u + 1] || string_offsets[u] > string_offsets[u + 1]) {
+            throw fail("offsets not monotonic");
+        }
+    }
+    const uint32_t* targets = section_ptr<uint32_t>(*file, header, kTargets);
+    for (uint64_t e = 0; e < header.num_edges; ++e) {
+        if (targets[e] >= n) {
+            throw fail("edge target out of range");
+        }
+    }
+    const uint32_t* hash_slots = section_ptr<uint32_t>(*file, header, kHashSlots);
+    for (uint64_t slot = 0; slot < header.hash_slots; ++slot) {
+        if (hash_slots[slot] > n) {
+            throw fail("name index out of range");
+        }
+    }
+    
+    std::shared_ptr<SemanticGraph> graph(new SemanticGraph());
+    graph->num_nodes_ = header.num_nodes;
+    graph->num_edges_ = header.num_edges;
+    graph->embedding_dim_ = header.embedding_dim;
+    graph->hash_mask_ = header.hash_slots - 1;
+    graph->offsets_ = offsets;
+    graph->targets_ = targets;
+    graph->weights_ = section_ptr<float>(*file, header, kWeights);
+    graph->string_data_ = section_ptr<char>(*file, header, kStringData);
+    graph->string_offsets_ = string_offsets;
+    graph->hash_slots_ = hash_slots;
+    if (header.embedding_dim > 0) {
+        graph->has_embedding_ = section_ptr<uint8_t>(*file, header, kHasEmbedding);
+        graph->embeddings_ = section_ptr<float>(*file, header, kEmbeddings);
+    }
+    graph->mapped_ = true;
+    graph->backing_ = std::move(file);
+    return graph;
+}
+
+} // namespace brain_ai
@@ -1,17 +1,209 @@
 #include "semantic_network.hpp"
 #include "utils.hpp"
+#include "work_pool.hpp"
 #include <algorithm>
 #include <cmath>
-#include <unordered_set>
+#include <stdexcept>
 
 namespace brain_ai {
 
+namespace {
+
+// Sort by activation (descending, ties by id) and resolve names
+std::vector<std::pair<std::string, float>> rank_activations(const SemanticGraph& graph,
+                                                            ActivationList& ranked) {
+    std::sort(ranked.begin(), ranked.end(),
+        [](const auto& a, const auto& b) {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        });
+    
+    std::vector<std::pair<std::string, float>> results;
+    results.reserve(ranked.size());
+    for (const auto& [id, activation] : ranked) {
+        results.emplace_back(std::string(graph.name(id)), activation);
+    }
+    return results;
+}
+
+// Copy of old (ids unchanged) with appended nodes and edges. Existing
+// edges come first so the new weights override them.
+std::shared_ptr<const SemanticGraph> merge_graph(const SemanticGraph& old,
+                                                 const std::vector<std::string>& new_names,
+                                                 const std::vector<std::vector<float>>& new_embeddings,
+                                                 const std::vector<EdgeRecord>& new_edges,
+                                                 uint32_t embedding_dim) {
+    uint32_t old_nodes = old.num_nodes();
+    
+    std::vector<std::string> names;
+    names.reserve(old_nodes + new_names.size());
+    for (uint32_t id = 0; id < old_nodes; ++id) {
+        names.emplace_back(old.name(id));
+    }
+    names.insert(names.end(), new_names.begin(), new_names.end());
+    
+    std::vector<EdgeRecord> edges;
+    edges.reserve(old.num_edges() + new_edges.size());
+    for (uint32_t id = 0; id < old_nodes; ++id) {
+        for (uint64_t e = old.edge_begin(id); e < old.edge_end(id); ++e) {
+            edges.push_back({id, old.targets()[e], old.weights()[e]});
+        }
+    }
+    edges.insert(edges.end(), new_edges.begin(), new_edges.end());
+    
+    std::vector<std::vector<float>> embeddings;
+    if (embedding_dim > 0) {
+        embeddings.resize(names.size());
+        for (uint32_t id = 0; id < old_nodes; ++id) {
+            if (const float* emb = old.embedding(id)) {
+                embeddings[id].assign(emb, emb + old.embedding_dim());
+            }
+        }
+        for (size_t i = 0; i < new_embeddings.size(); ++i) {
+            embeddings[old_nodes + i] = new_embeddings[i];
+        }
+    }
+    
+    return SemanticGraph::build(std::move(names), std::move(edges), std::move(embeddings));
+}
+
+} // namespace
+
+uint32_t SemanticNetwork::find_locked(const std::string& concept) const {
+    uint32_t id = graph_->find(concept);
+    if (id != SemanticGraph::kInvalidId) {
+        return id;
+    }
+    auto it = new_ids_.find(concept);
+    return it != new_ids_.end() ? it->second : SemanticGraph::kInvalidId;
+}
+
+uint32_t SemanticNetwork::intern_locked(const std::string& concept) {
+    uint32_t id = find_locked(concept);
+    if (id == SemanticGraph::kInvalidId) {
+        id = graph_->num_nodes() + compiling_nodes_ + static_cast<uint32_t>(new_names_.size());
+        new_ids_.emplace(concept, id);
+        new_names_.push_back(concept);
+        new_embeddings_.emplace_back();
+    }
+    return id;
+}
+
+size_t SemanticNetwork::pending_locked() const {
+    return new_names_.size() + pending_edges_.size();
+}
+
+SemanticNetwork::~SemanticNetwork() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    closing_ = true;
+    commit_done_.wait(lock, [this] { return !commit_scheduled_; });
+}
+
+void SemanticNetwork::maybe_schedule_commit_locked() {
+    if (commit_threshold_ == 0 || commit_scheduled_ || closing_ ||
+        pending_locked() < commit_threshold_) {
+        return;
+    }
+    commit_scheduled_ = true;
+    WorkPool::shared().submit([this] { background_commit(); });
+}
+
+void SemanticNetwork::background_commit() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closing_ || commit_threshold_ == 0 || pending_locked() < commit_threshold_) {
+                commit_scheduled_ = false;
+                commit_done_.notify_all();
+                return;
+            }
+        }
+        try {
+            std::lock_guard<std::mutex> rebuild_lock(rebuild_mutex_);
+            compile();
+        } catch (...) {
+            // The edits stay pending for the next commit
+            std::lock_guard<std::mutex> lock(mutex_);
+            commit_scheduled_ = false;
+            commit_done_.notify_all();
+            return;
+        }
+    }
+}
+
+void SemanticNetwork::compile() const {
+    // Take the pending edits; their names stay in new_ids_ (and their ids
+    // reserved) so concurrent edits keep resolving them until the swap
+    std::shared_ptr<const SemanticGraph> base;
+    std::vector<std::string> names;
+    std::vector<std::vector<float>> embeddings;
+    std::vector<EdgeRecord> edges;
+    uint32_t embedding_dim;
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (new_names_.empty() && pending_edges_.empty()) {
+            graph_version_ = version_;   // No rebuild in flight under rebuild_mutex_
+            return;
+        }
+        base = graph_;
+        names.swap(new_names_);
+        embeddings.swap(new_embeddings_);
+        edges.swap(pending_edges_);
+        compiling_nodes_ = static_cast<uint32_t>(names.size());
+        embedding_dim = embedding_dim_;
+        version = version_;
+    }
+    
+    std::shared_ptr<const SemanticGraph> merged;
+    try {
+        merged = merge_graph(*base, names, embeddings, edges, embedding_dim);
+    } catch (...) {
+        // Put the edits back ahead of any made meanwhile
+        std::lock_guard<std::mutex> lock(mutex_);
+        new_names_.insert(new_names_.begin(), names.begin(), names.end());
+        new_embeddings_.insert(new_embeddings_.begin(), embeddings.begin(), embeddings.end());
+        pending_edges_.insert(pending_edges_.begin(), edges.begin(), edges.end());
+        compiling_nodes_ = 0;
+        throw;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    graph_ = std::move(merged);
+    graph_version_ = version;
+    for (const auto& name : names) {
+        new_ids_.erase(name);
+    }
+    compiling_nodes_ = 0;
+}
+
+void SemanticNetwork::clear_activations_locked() {
+    for (uint32_t id : touched_) {
+        activations_[id] = 0.0f;
+    }
+    touched_.clear();
+}
+
 void SemanticNetwork::add_node(const std::string& concept,
                                 const std::vector<float>& embedding) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (nodes_.find(concept) == nodes_.end()) {
-        nodes_.emplace(concept, SemanticNode(concept, embedding));
+    if (find_locked(concept) != SemanticGraph::kInvalidId) {
+        return;
     }
+    
+    if (!embedding.empty()) {
+        if (embedding_dim_ == 0) {
+            embedding_dim_ = static_cast<uint32_t>(embedding.size());
+        } else if (embedding.size() != embedding_dim_) {
+            throw std::invalid_argument("Concept embedding dimension mismatch: expected " +
+                                        std::to_string(embedding_dim_) + ", got " +
+                                        std::to_string(embedding.size()));
+        }
+    }
+    
+    intern_locked(concept);
+    new_embeddings_.back() = embedding;
+    ++version_;
+    maybe_schedule_commit_locked();
 }
 
 void SemanticNetwork::add_edge(const std::string& source,
@@ -20,15 +212,44 @@ void SemanticNetwork::add_edge(const std::string& source,
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Ensure nodes exist
-    if (nodes_.find(source) == nodes_.end()) {
-        nodes_.emplace(source, SemanticNode(source));
+    uint32_t source_id = intern_locked(source);
+    uint32_t target_id = intern_locked(target);
+    
+    // Add edge (merged into the CSR on the next commit)
+    pending_edges_.push_back({source_id, target_id, weight});
+    ++version_;
+    maybe_schedule_commit_locked();
+}
+
+void SemanticNetwork::add_edges(
+    const std::vector<std::tuple<std::string, std::string, float>>& relations) {
+    if (relations.empty()) {
+        return;
     }
-    if (nodes_.find(target) == nodes_.end()) {
-        nodes_.emplace(target, SemanticNode(target));
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_edges_.reserve(pending_edges_.size() + relations.size());
+    for (const auto& [source, target, weight] : relations) {
+        uint32_t source_id = intern_locked(source);
+        pending_edges_.push_back({source_id, intern_locked(target), weight});
     }
-    
-    // Add edge
-    nodes_[source].edges[target] = weight;
+    ++version_;
+    maybe_schedule_commit_locked();
+}
+
+void SemanticNetwork::commit() {
+    std::lock_guard<std::mutex> rebuild_lock(rebuild_mutex_);
+    compile();
+}
+
+void SemanticNetwork::set_commit_threshold(size_t edits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commit_threshold_ = edits;
+    maybe_schedule_commit_locked();
+}
+
+size_t SemanticNetwork::pending_edits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_locked();
 }
 
 std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
@@ -37,95 +258,119 @@ std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
     float decay_factor,
     float activation_threshold
 ) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Reset activations
-    for (auto& [concept, node] : nodes_) {
-        node.activation_level = 0.0f;
+    ActivationConfig config;
+    config.max_hops = max_hops;
+    config.decay_factor = decay_factor;
+    config.activation_threshold = activation_threshold;
+    return spread_activation(source_concepts, config);
+}
+
+std::shared_ptr<const SemanticGraph> SemanticNetwork::snapshot(uint64_t& version) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (graph_version_ == version_) {
+            version = graph_version_;
+            return graph_;
+        }
     }
     
-    // Activation map
-    std::unordered_map<std::string, float> activations;
-    
-    // BFS queue: (concept, hop_count, activation_level)
-    std::queue<std::tuple<std::string, size_t, float>> frontier;
+    // Merge the edits made so far (after any rebuild already in flight)
+    std::lock_guard<std::mutex> rebuild_lock(rebuild_mutex_);
+    compile();
+    std::lock_guard<std::mutex> lock(mutex_);
+    version = graph_version_;
+    return graph_;
+}
+
+std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
+    const std::vector<std::string>& source_concepts,
+    const ActivationConfig& config,
+    const RequestContext& context
+) {
+    context.check("semantic");
     
-    // Visited set to avoid cycles
-    std::unordered_set<std::string> visited;
+    uint64_t version;
+    std::shared_ptr<const SemanticGraph> graph = snapshot(version);
     
-    // Initialize with source concepts
+    std::vector<uint32_t> sources;
+    sources.reserve(source_concepts.size());
     for (const auto& concept : source_concepts) {
-        if (nodes_.find(concept) != nodes_.end()) {
-            frontier.push({concept, 0, 1.0f});
-            activations[concept] = 1.0f;
-            visited.insert(concept);
+        uint32_t id = graph->find(concept);
+        if (id != SemanticGraph::kInvalidId) {
+            sources.push_back(id);
         }
     }
     
-    // BFS with spreading activation
-    while (!frontier.empty()) {
-        auto [current, hops, activation] = frontier.front();
-        frontier.pop();
-        
-        // Stop if max hops reached
-        if (hops >= max_hops) {
-            continue;
-        }
-        
-        // Get current node
-        auto it = nodes_.find(current);
-        if (it == nodes_.end()) {
-            continue;
-        }
-        
-        const SemanticNode& node = it->second;
-        
-        // Spread activation to neighbors
-        for (const auto& [neighbor, edge_weight] : node.edges) {
-            // Compute decayed activation
-            float new_activation = activation * decay_factor * edge_weight;
-            
-            // Skip if below threshold
-            if (new_activation < activation_threshold) {
-                continue;
-            }
-            
-            // Update activation (accumulate if already activated)
-            if (activations.find(neighbor) != activations.end()) {
-                activations[neighbor] = std::max(activations[neighbor], new_activation);
-            } else {
-                activations[neighbor] = new_activation;
-            }
-            
-            // Add to frontier if not visited at this level
-            if (visited.find(neighbor) == visited.end()) {
-                frontier.push({neighbor, hops + 1, new_activation});
-                visited.insert(neighbor);
-            }
-        }
+    // Reuse a result computed on this graph version, if any. Sources are
+    // traversed in key order so the result does not depend on query order.
+    ActivationCacheKey key = ActivationCache::make_key(std::move(sources), config);
+    std::shared_ptr<const ActivationCache::Entry> entry = cache_.find(version, key);
+    if (!entry) {
+        auto computed = std::make_shared<ActivationCache::Entry>();
+        computed->activations = compute_activation(*graph, key.sources, config, context);
+        computed->ranked = rank_activations(*graph, computed->activations);
+        entry = computed;
+        cache_.insert(version, std::move(key), entry);
     }
     
     // Update node activation levels
-    for (auto& [concept, activation] : activations) {
-        if (nodes_.find(concept) != nodes_.end()) {
-            nodes_[concept].activation_level = activation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clear_activations_locked();
+        if (activations_.size() < graph->num_nodes()) {
+            activations_.resize(graph->num_nodes(), 0.0f);
+        }
+        for (const auto& [id, activation] : entry->activations) {
+            activations_[id] = activation;
+            touched_.push_back(id);
         }
     }
     
-    // Convert to sorted vector
-    std::vector<std::pair<std::string, float>> results;
-    results.reserve(activations.size());
+    return entry->ranked;
+}
+
+std::vector<std::vector<std::pair<std::string, float>>> SemanticNetwork::spread_activation_batch(
+    const std::vector<std::vector<std::string>>& batch_concepts,
+    const ActivationConfig& config
+) const {
+    uint64_t version;
+    std::shared_ptr<const SemanticGraph> graph = snapshot(version);
     
-    for (const auto& [concept, activation] : activations) {
-        results.push_back({concept, activation});
+    // Serve cached queries; batch the rest
+    std::vector<std::vector<std::pair<std::string, float>>> results(batch_concepts.size());
+    std::vector<ActivationCacheKey> miss_keys;
+    std::vector<size_t> miss_index;
+    for (size_t q = 0; q < batch_concepts.size(); ++q) {
+        std::vector<uint32_t> sources;
+        for (const auto& concept : batch_concepts[q]) {
+            uint32_t id = graph->find(concept);
+            if (id != SemanticGraph::kInvalidId) {
+                sources.push_back(id);
+            }
+        }
+        ActivationCacheKey key = ActivationCache::make_key(std::move(sources), config);
+        if (auto entry = cache_.find(version, key)) {
+            results[q] = entry->ranked;
+        } else {
+            miss_keys.push_back(std::move(key));
+            miss_index.push_back(q);
+        }
     }
     
-    // Sort by activation level (descending)
-    std::sort(results.begin(), results.end(),
-        [](const auto& a, const auto& b) {
-            return a.second > b.second;
-        });
+    std::vector<std::vector<uint32_t>> batch_sources;
+    batch_sources.reserve(miss_keys.size());
+    for (const auto& key : miss_keys) {
+        batch_sources.push_back(key.sources);
+    }
     
+    auto computed = compute_activation_batch(*graph, batch_sources, config);
+    for (size_t i = 0; i < computed.size(); ++i) {
+        auto entry = std::make_shared<ActivationCache::Entry>();
+        entry->activations = std::move(computed[i]);
+        entry->ranked = rank_activations(*graph, entry->activations);
+        results[miss_index[i]] = entry->ranked;
+        cache_.insert(version, std::move(miss_keys[i]), std::move(entry));
+    }
     return results;
 }
 
@@ -134,27 +379,41 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
     size_t top_k,
     float threshold
 ) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<const SemanticGraph> graph = this->graph();
+    
+    uint32_t dim = graph->embedding_dim();
+    if (dim == 0) {
+        return {};
+    }
+    if (query_embedding.size() != dim) {
+        throw std::invalid_argument("Vectors must have same dimension");
+    }
     
     struct ScoredConcept {
-        std::string concept;
+        uint32_t id;
         float similarity;
     };
     
     std::vector<ScoredConcept> scored_concepts;
+    float query_norm = std::sqrt(dot_product(query_embedding.data(), query_embedding.data(), dim));
     
-    for (const auto& [concept, node] : nodes_) {
+    for (uint32_t id = 0; id < graph->num_nodes(); ++id) {
         // Skip nodes without embeddings
-        if (node.embedding.empty()) {
+        const float* embedding = graph->embedding(id);
+        if (embedding == nullptr) {
             continue;
         }
         
         // Compute similarity
-        float similarity = cosine_similarity(query_embedding, node.embedding);
+        float norm = std::sqrt(dot_product(embedding, embedding, dim));
+        float similarity = 0.0f;
+        if (query_norm > 0.0f && norm > 0.0f) {
+            similarity = dot_product(query_embedding.data(), embedding, dim) / (query_norm * norm);
+        }
         
         // Filter by threshold
         if (similarity >= threshold) {
-            scored_concepts.push_back({concept, similarity});
+            scored_concepts.push_back({id, similarity});
         }
     }
     
@@ -169,7 +428,7 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
     results.reserve(std::min(top_k, scored_concepts.size()));
     
     for (size_t i = 0; i < std::min(top_k, scored_concepts.size()); ++i) {
-        results.push_back(scored_concepts[i].concept);
+        results.emplace_back(graph->name(scored_concepts[i].id));
     }
     
     return results;
@@ -178,44 +437,119 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
 void SemanticNetwork::decay_activations(float decay_rate) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    for (auto& [concept, node] : nodes_) {
-        node.activation_level *= decay_rate;
+    for (uint32_t id : touched_) {
+        activations_[id] *= decay_rate;
     }
 }
 
 void SemanticNetwork::reset_activations() {
     std::lock_guard<std::mutex> lock(mutex_);
-    
-    for (auto& [concept, node] : nodes_) {
-        node.activation_level = 0.0f;
-    }
+    clear_activations_locked();
 }
 
 size_t SemanticNetwork::num_nodes() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return nodes_.size();
+    return graph()->num_nodes();
 }
 
 size_t SemanticNetwork::num_edges() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    return graph()->num_edges();  // Duplicate edges collapse on merge
+}
+
+std::optional<std::shared_ptr<const SemanticNode>> SemanticNetwork::get_node(
+    const std::string& concept) const {
+    std::shared_ptr<const SemanticGraph> graph = this->graph();
     
-    size_t count = 0;
-    for (const auto& [concept, node] : nodes_) {
-        count += node.edges.size();
+    uint32_t id = graph->find(concept);
+    if (id == SemanticGraph::kInvalidId) {
+        return std::nullopt;
     }
     
-    return count;
+    auto node = std::make_shared<SemanticNode>(concept);
+    if (const float* embedding = graph->embedding(id)) {
+        node->embedding.assign(embedding, embedding + graph->embedding_dim());
+    }
+    for (uint64_t e = graph->edge_begin(id); e < graph->edge_end(id); ++e) {
+        node->edges[std::string(graph->name(graph->targets()[e]))] = graph->weights()[e];
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        node->activation_level = id < activations_.size() ? activations_[id] : 0.0f;
+    }
+    return std::shared_ptr<const SemanticNode>(std::move(node));
 }
 
-std::optional<const SemanticNode*> SemanticNetwork::get_node(const std::string& concept) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+BulkLoadStats SemanticNetwork::load_edge_list(const std::string& path,
+                                              const BulkLoadOptions& options) {
+    SemanticBulkLoader loader(options);
+    std::shared_ptr<const SemanticGraph> loaded = loader.load(path);
     
-    auto it = nodes_.find(concept);
-    if (it != nodes_.end()) {
-        return &(it->second);
+    std::lock_guard<std::mutex> rebuild_lock(rebuild_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++version_;
+        if (graph_->num_nodes() == 0 && new_names_.empty()) {
+            graph_ = std::move(loaded);
+            graph_version_ = version_;
+            embedding_dim_ = graph_->embedding_dim();
+            clear_activations_locked();
+            return loader.stats();
+        }
+        
+        std::vector<uint32_t> remap(loaded->num_nodes());
+        for (uint32_t id = 0; id < loaded->num_nodes(); ++id) {
+            remap[id] = intern_locked(std::string(loaded->name(id)));
+        }
+        pending_edges_.reserve(pending_edges_.size() + loaded->num_edges());
+        for (uint32_t id = 0; id < loaded->num_nodes(); ++id) {
+            for (uint64_t e = loaded->edge_begin(id); e < loaded->edge_end(id); ++e) {
+                pending_edges_.push_back({remap[id], remap[loaded->targets()[e]], loaded->weights()[e]});
+            }
+        }
     }
+    compile();
+    return loader.stats();
+}
+
+void SemanticNetwork::save_to_file(const std::string& filepath) const {
+    graph()->save_to_file(filepath);
+}
+
+void SemanticNetwork::load_from_file(const std::string& filepath) {
+    std::shared_ptr<const SemanticGraph> loaded = SemanticGraph::load_from_file(filepath);
     
-    return std::nullopt;
+    std::lock_guard<std::mutex> rebuild_lock(rebuild_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    graph_ = std::move(loaded);
+    graph_version_ = version_;
+    new_names_.clear();
+    new_embeddings_.clear();
+    new_ids_.clear();
+    pending_edges_.clear();
+    embedding_dim_ = graph_->embedding_dim();
+    clear_activations_locked();
+    activations_.clear();
+}
+
+uint64_t SemanticNetwork::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+void SemanticNetwork::set_activation_cache_bytes(size_t max_bytes) {
+    cache_.set_max_bytes(max_bytes);
+    if (max_bytes == 0) {
+        cache_.clear();
+    }
+}
+
+ActivationCacheStats SemanticNetwork::activation_cache_stats() const {
+    return cache_.stats();
+}
+
+std::shared_ptr<const SemanticGraph> SemanticNetwork::graph() const {
+    uint64_t version;
+    return snapshot(version);
 }
 
 } // namespace brain_ai
@@ -0,0 +1,295 @@
+#include "session_episodic_store.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace brain_ai {
+
+SessionEpisodicStore::SessionEpisodicStore(const SessionStoreConfig& config)
+    : config_(config),
+      default_buffer_(std::make_shared<EpisodicBuffer>(config.session_capacity,
+                                                       config.consolidation,
+                                                       config.embedding_storage)),
+      budget_bytes_(config.memory_budget_bytes) {
+    if (config_.num_shards == 0) {
+        config_.num_shards = 1;
+    }
+    shards_.reserve(config_.num_shards);
+    for (size_t i = 0; i < config_.num_shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+
+    if (config_.consolidation.enabled) {
+        consolidator_ = std::make_unique<EpisodicConsolidator>(config_.consolidation_interval);
+        consolidator_->watch(default_buffer_);
+        consolidator_->start();
+    }
+
+    pressure_subscription_ = monitoring::MemoryPressureMonitor::instance().subscribe(
+        [this](monitoring::MemoryPressureLevel level) { on_memory_pressure(level); });
+}
+
+SessionEpisodicStore::~SessionEpisodicStore() {
+    pressure_subscription_.reset();
+    if (consolidator_) {
+        consolidator_->stop();
+    }
+}
+
+SessionEpisodicStore::Shard& SessionEpisodicStore::shard_for(const std::string& session_id) const {
+    return *shards_[std::hash<std::string>{}(session_id) % shards_.size()];
+}
+
+std::shared_ptr<EpisodicBuffer> SessionEpisodicStore::acquire(const std::string& session_id,
+                                                              bool create) {
+    if (session_id.empty()) {
+        return default_buffer_;
+    }
+
+    Shard& shard = shard_for(session_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.sessions.find(session_id);
+    if (it == shard.sessions.end()) {
+        if (!create) {
+            return nullptr;
+        }
+        shard.lru.push_front(session_id);
+        SessionEntry entry;
+        entry.buffer = std::make_shared<EpisodicBuffer>(config_.session_capacity,
+                                                        config_.consolidation,
+                                                        config_.embedding_storage);
+        entry.lru_pos = shard.lru.begin();
+        if (consolidator_) {
+            consolidator_->watch(entry.buffer);
+        }
+        it = shard.sessions.emplace(session_id, std::move(entry)).first;
+    } else {
+        // Move to most-recently-used position
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+    }
+
+    it->second.last_access = access_clock_.fetch_add(1, std::memory_order_relaxed) + 1;
+    return it->second.buffer;
+}
+
+void SessionEpisodicStore::account(const std::string& session_id,
+                                   const std::shared_ptr<EpisodicBuffer>& buffer) {
+    if (session_id.empty()) {
+        return;  // Default session is measured directly, see memory_usage_bytes()
+    }
+
+    size_t now_bytes = buffer->memory_usage_bytes();
+
+    Shard& shard = shard_for(session_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.sessions.find(session_id);
+    if (it == shard.sessions.end() || it->second.buffer != buffer) {
+        return;  // Session was evicted concurrently; nothing to account
+    }
+
+    total_bytes_.fetch_add(static_cast<int64_t>(now_bytes) -
+                           static_cast<int64_t>(it->second.accounted_bytes),
+                           std::memory_order_relaxed);
+    it->second.accounted_bytes = now_bytes;
+}
+
+void SessionEpisodicStore::enforce_budget(const std::string& keep_session_id) {
+    size_t budget = budget_bytes_.load(std::memory_order_relaxed);
+    if (budget == 0) {
+        return;
+    }
+    size_t usage = session_bytes();
+    if (usage <= budget) {
+        return;
+    }
+    size_t excess = usage - budget;
+
+    // One pass over the shards: each contributes LRU-tail sessions until
+    // they alone would cover the excess, so the global LRU victims are
+    // always among the candidates
+    struct Candidate {
+        uint64_t last_access;
+        size_t shard;
+        std::string session_id;
+    };
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex);
+        size_t gathered = 0;
+        for (auto it = shards_[i]->lru.rbegin(); it != shards_[i]->lru.rend() && gathered < excess; ++it) {
+            if (*it == keep_session_id) {
+                continue;
+            }
+            const SessionEntry& entry = shards_[i]->sessions.at(*it);
+            candidates.push_back({entry.last_access, i, *it});
+            gathered += std::max<size_t>(entry.accounted_bytes, 1);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.last_access < b.last_access; });
+
+    for (const auto& victim : candidates) {
+        if (session_bytes() <= budget) {
+            return;
+        }
+        Shard& shard = *shards_[victim.shard];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(victim.session_id);
+        if (it == shard.sessions.end() || it->second.last_access != victim.last_access) {
+            continue;  // Touched or removed meanwhile; it is no longer LRU
+        }
+
+        total_bytes_.fetch_sub(static_cast<int64_t>(it->second.accounted_bytes),
+                               std::memory_order_relaxed);
+        shard.lru.erase(it->second.lru_pos);
+        shard.sessions.erase(it);
+        evicted_sessions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Still over only if candidates were touched concurrently; the next
+    // write evicts again
+}
+
+void SessionEpisodicStore::on_memory_pressure(monitoring::MemoryPressureLevel level) {
+    size_t budget = config_.memory_budget_bytes;
+    if (level == monitoring::MemoryPressureLevel::NORMAL) {
+        pressure_base_bytes_ = 0;
+    } else {
+        if (budget == 0 && pressure_base_bytes_ == 0) {
+            pressure_base_bytes_ = std::max<size_t>(session_bytes(), 1);
+        }
+        size_t base = budget != 0 ? budget : pressure_base_bytes_;
+        budget = std::max<size_t>(
+            1, static_cast<size_t>(base * monitoring::memory_pressure_budget_factor(level)));
+    }
+    budget_bytes_.store(budget, std::memory_order_relaxed);
+    enforce_budget(std::string());
+}
+
+void SessionEpisodicStore::add_episode(
+    const std::string& session_id,
+    const std::string& query,
+    const std::string& response,
+    const std::vector<float>& query_embedding,
+    const std::unordered_map<std::string, std::string>& metadata
+) {
+    auto buffer = acquire(session_id, true);
+    buffer->add_episode(query, response, query_embedding, metadata);
+    account(session_id, buffer);
+    enforce_budget(session_id);
+}
+
+void SessionEpisodicStore::add_episodes(const std::string& session_id,
+                                        std::vector<Episode> episodes) {
+    if (episodes.empty()) {
+        return;
+    }
+    auto buffer = acquire(session_id, true);
+    buffer->add_episodes(std::move(episodes));
+    account(session_id, buffer);
+    enforce_budget(session_id);
+}
+
+std::vector<Episode> SessionEpisodicStore::retrieve_similar(
+    const std::string& session_id,
+    const std::vector<float>& query_embedding,
+    size_t top_k,
+    float similarity_threshold,
+    const RequestContext& context
+) {
+    auto buffer = acquire(session_id, false);
+    if (!buffer) {
+        return {};
+    }
+    return buffer->retrieve_similar(query_embedding, top_k, similarity_threshold, context);
+}
+
+std::vector<Episode> SessionEpisodicStore::get_recent(const std::string& session_id,
+                                                      size_t count) {
+    auto buffer = acquire(session_id, false);
+    if (!buffer) {
+        return {};
+    }
+    return buffer->get_recent(count);
+}
+
+std::shared_ptr<EpisodicBuffer> SessionEpisodicStore::find_session(
+    const std::string& session_id) const {
+    if (session_id.empty()) {
+        return default_buffer_;
+    }
+
+    Shard& shard = shard_for(session_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(session_id);
+    return it != shard.sessions.end() ? it->second.buffer : nullptr;
+}
+
+void SessionEpisodicStore::clear_session(const std::string& session_id) {
+    if (session_id.empty()) {
+        default_buffer_->clear();
+        return;
+    }
+
+    Shard& shard = shard_for(session_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(session_id);
+    if (it == shard.sessions.end()) {
+        return;
+    }
+
+    total_bytes_.fetch_sub(static_cast<int64_t>(it->second.accounted_bytes),
+                           std::memory_order_relaxed);
+    shard.lru.erase(it->second.lru_pos);
+    shard.sessions.erase(it);
+}
+
+void SessionEpisodicStore::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& [_, entry] : shard->sessions) {
+            total_bytes_.fetch_sub(static_cast<int64_t>(entry.accounted_bytes),
+                                   std::memory_order_relaxed);
+        }
+        shard->sessions.clear();
+        shard->lru.clear();
+    }
+    clear_session("");
+}
+
+size_t SessionEpisodicStore::size() const {
+    size_t total = default_buffer_->size();
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& [_, entry] : shard->sessions) {
+            total += entry.buffer->size();
+        }
+    }
+    return total;
+}
+
+size_t SessionEpisodicStore::session_size(const std::string& session_id) const {
+    auto buffer = find_session(session_id);
+    return buffer ? buffer->size() : 0;
+}
+
+size_t SessionEpisodicStore::session_count() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->sessions.size();
+    }
+    return count;
+}
+
+size_t SessionEpisodicStore::session_bytes() const {
+    int64_t bytes = total_bytes_.load(std::memory_order_relaxed);
+    return bytes > 0 ? static_cast<size_t>(bytes) : 0;
+}
+
+size_t SessionEpisodicStore::memory_usage_bytes() const {
+    return session_bytes() + default_buffer_->memory_usage_bytes();
+}
+
+} // namespace brain_ai
@@ -1,4 +1,7 @@
 #include "vector_search/hnsw_index.hpp"
+#include "monitoring/perf_counters.hpp"
+#include "errors/exceptions.hpp"
+#include "work_pool.hpp"
 #include <fstream>
 #include <cmath>
 #include <algorithm>
@@ -7,6 +10,69 @@
 namespace brain_ai {
 namespace vector_search {
 
+namespace {
+
+// Hardware counter stages (metrics perf_<stage>_<event>)
+monitoring::PerfStage kAddStage("hnsw_add");
+monitoring::PerfStage kSearchStage("hnsw_search");
+
+// Base-layer expansions between deadline checks of a cancellable search
+constexpr size_t kCancelCheckHops = 64;
+
+/**
+ * Beam search of searchKnn (ef candidates, best k kept) that gives up
+ * once the request expires
+ * 
+ * hnswlib asks should_stop_search once per expanded node, so the context
+ * is polled there every kCancelCheckHops hops. Stopping early lets
+ * hnswlib release its visited list as usual; the caller raises the
+ * cancellation after the search returns.
+ */
+class DeadlineStopCondition : public hnswlib::BaseSearchStopCondition<float> {
+public:
+    DeadlineStopCondition(size_t ef, size_t k, const RequestContext& context)
+        : ef_(ef), k_(k), context_(context) {}
+    
+    void add_point_to_result(hnswlib::labeltype, const void*, float) override { ++size_; }
+    void remove_point_from_result(hnswlib::labeltype, const void*, float) override { --size_; }
+    
+    bool should_stop_search(float candidate_dist, float lower_bound) override {
+        if (candidate_dist > lower_bound && size_ == ef_) {
+            return true;
+        }
+        if (++hops_ % kCancelCheckHops == 0 && context_.expired()) {
+            expired_ = true;
+            return true;
+        }
+        return false;
+    }
+    
+    bool should_consider_candidate(float candidate_dist, float lower_bound) override {
+        return size_ < ef_ || lower_bound > candidate_dist;
+    }
+    
+    bool should_remove_extra() override { return size_ > ef_; }
+    
+    // Candidates arrive sorted by distance
+    void filter_results(std::vector<std::pair<float, hnswlib::labeltype>>& candidates) override {
+        if (candidates.size() > k_) {
+            candidates.resize(k_);
+        }
+    }
+    
+    bool expired() const { return expired_; }
+    
+private:
+    size_t ef_;
+    size_t k_;
+    const RequestContext& context_;
+    size_t size_ = 0;
+    size_t hops_ = 0;
+    bool expired_ = false;
+};
+
+} // namespace
+
 // ============================================================================
 // HNSWIndex Implementation
 // ============================================================================
@@ -87,17 +153,21 @@ void HNSWIndex::initialize_index() {
 }
 
 void HNSWIndex::normalize_vector(std::vector<float>& vec) const {
+    normalize_vector(vec.data(), vec.size());
+}
+
+void HNSWIndex::normalize_vector(float* vec, size_t size) const {
     // Compute L2 norm
     float norm = 0.0f;
-    for (float val : vec) {
-        norm += val * val;
+    for (size_t i = 0; i < size; ++i) {
+        norm += vec[i] * vec[i];
     }
     norm = std::sqrt(norm);
     
     // Normalize
     if (norm > 1e-10f) {
-        for (float& val : vec) {
-            val /= norm;
+        for (size_t i = 0; i < size; ++i) {
+            vec[i] /= norm;
         }
     }
 }
@@ -115,6 +185,7 @@ bool HNSWIndex::add_document(const std::string& doc_id,
                             const std::string& content,
                             const nlohmann::json& metadata) {
     std::lock_guard<std::mutex> lock(mutex_);
+    monitoring::PerfScope perf_scope(kAddStage);
     
     // Check if document already exists
     if (documents_.find(doc_id) != documents_.end()) {
@@ -152,8 +223,11 @@ bool HNSWIndex::add_document(const std::string& doc_id,
 }
 
 std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
-                                           size_t top_k) {
+                                           size_t top_k,
+                                           SearchCost* cost,
+                                           const RequestContext& context) {
     std::lock_guard<std::mutex> lock(mutex_);
+    monitoring::PerfScope perf_scope(kSearchStage);
     
     // Validate query dimension
     if (query.size() != dim_) {
@@ -176,10 +250,103 @@ std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
     // Limit top_k to available documents
     size_t actual_k = std::min(top_k, static_cast<size_t>(next_internal_id_));
     
-    // Search HNSWlib index
-    auto result = index_->searchKnn(normalized_query.data(), actual_k);
+    // Search HNSWlib index (the mutex serializes searches, so the metric
+    // deltas belong to this query)
+    long hops_before = index_->metric_hops.load(std::memory_order_relaxed);
+    long distances_before = index_->metric_distance_computations.load(std::memory_order_relaxed);
+    std::priority_queue<std::pair<float, hnswlib::labeltype>> result;
+    if (!context.can_expire()) {
+        result = index_->searchKnn(normalized_query.data(), actual_k);
+    } else {
+        context.check("vector_search");
+        DeadlineStopCondition stop(std::max(ef_search_, actual_k), actual_k, context);
+        auto closest = index_->searchStopConditionClosest(normalized_query.data(), stop);
+        if (stop.expired()) {
+            context.check("vector_search");   // Throws
+        }
+        // hnswlib 0.8 reports internal ids here, not labels
+        for (auto& [distance, id] : closest) {
+            result.emplace(distance, index_->getExternalLabel(static_cast<hnswlib::tableint>(id)));
+        }
+    }
+    if (cost) {
+        cost->hops = static_cast<size_t>(
+            index_->metric_hops.load(std::memory_order_relaxed) - hops_before);
+        cost->distance_computations = static_cast<size_t>(
+            index_->metric_distance_computations.load(std::memory_order_relaxed) - distances_before);
+        cost->ef_search = std::max(ef_search_, actual_k);
+    }
+    
+    return to_search_results(std::move(result));
+}
+
+std::vector<std::vector<SearchResult>> HNSWIndex::search_batch(
+    const std::vector<std::vector<float>>& queries,
+    size_t top_k,
+    SearchCost* cost,
+    WorkPool* pool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    monitoring::PerfScope perf_scope(kSearchStage);
+    
+    // Validate every query before doing any work
+    for (const auto& query : queries) {
+        if (query.size() != dim_) {
+            throw std::invalid_argument("Query dimension mismatch: expected " + 
+                                       std::to_string(dim_) + ", got " + 
+                                       std::to_string(query.size()));
+        }
+    }
+    
+    std::vector<std::vector<SearchResult>> batch_results(queries.size());
+    if (queries.empty() || next_internal_id_ == 0) {
+        return batch_results;
+    }
+    
+    // One pass normalizes the whole batch into a contiguous buffer, so the
+    // searches read their queries from adjacent cache lines
+    std::vector<float> normalized(queries.size() * dim_);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        float* row = normalized.data() + i * dim_;
+        std::copy(queries[i].begin(), queries[i].end(), row);
+        if (space_type_ == "ip") {
+            normalize_vector(row, dim_);
+        }
+    }
+    
+    size_t actual_k = std::min(top_k, static_cast<size_t>(next_internal_id_));
+    
+    // searchKnn only reads the graph, and the mutex keeps writers out, so
+    // the queries can run side by side. Metric deltas cover the batch.
+    long hops_before = index_->metric_hops.load(std::memory_order_relaxed);
+    long distances_before = index_->metric_distance_computations.load(std::memory_order_relaxed);
+    auto search_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i + 1 < end) {
+                __builtin_prefetch(normalized.data() + (i + 1) * dim_);
+            }
+            batch_results[i] = to_search_results(
+                index_->searchKnn(normalized.data() + i * dim_, actual_k));
+        }
+    };
+    if (pool && pool->size() > 1 && queries.size() > 1) {
+        size_t grain = (queries.size() + pool->size() - 1) / pool->size();
+        pool->parallel_for(queries.size(), grain, search_range);
+    } else {
+        search_range(0, queries.size());
+    }
+    if (cost) {
+        cost->hops = static_cast<size_t>(
+            index_->metric_hops.load(std::memory_order_relaxed) - hops_before);
+        cost->distance_computations = static_cast<size_t>(
+            index_->metric_distance_computations.load(std::memory_order_relaxed) - distances_before);
+        cost->ef_search = std::max(ef_search_, actual_k);
+    }
     
-    // Convert results
+    return batch_results;
+}
+
+std::vector<SearchResult> HNSWIndex::to_search_results(
+    std::priority_queue<std::pair<float, hnswlib::labeltype>> result) const {
     std::vector<SearchResult> search_results;
     search_results.reserve(result.size());
     
@@ -195,13 +362,16 @@ std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
         // Get document metadata
         auto doc_id_it = internal_id_to_doc_id_.find(internal_id);
         if (doc_id_it != internal_id_to_doc_id_.end()) {
-            const auto& doc = documents_[doc_id_it->second];
-            search_results.emplace_back(
-                doc.doc_id,
-                doc.content,
-                similarity,
-                doc.metadata
-            );
+            auto doc_it = documents_.find(doc_id_it->second);
+            if (doc_it != documents_.end()) {
+                const auto& doc = doc_it->second;
+                search_results.emplace_back(
+                    doc.doc_id,
+                    doc.content,
+                    similarity,
+                    doc.metadata
+                );
+            }
         }
         
         result.pop();
@@ -0,0 +1,123 @@
+#include "work_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace brain_ai {
+
+WorkPool::WorkPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back(&WorkPool::worker_loop, this);
+    }
+}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void WorkPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void WorkPool::parallel_for(size_t count, size_t grain,
+                            const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || workers_.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // Shared with helper tasks, which may start after the loop is done;
+    // they only touch body while unclaimed chunks remain
+    struct Job {
+        const std::function<void(size_t, size_t)>* body;
+        size_t count;
+        size_t grain;
+        size_t chunks;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        void run() {
+            size_t completed = 0;
+            for (size_t chunk; (chunk = next.fetch_add(1)) < chunks; ++completed) {
+                size_t begin = chunk * grain;
+                try {
+                    (*body)(begin, std::min(begin + grain, count));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            if (completed > 0 && done.fetch_add(completed) + completed == chunks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    };
+
+    auto job = std::make_shared<Job>();
+    job->body = &body;
+    job->count = count;
+    job->grain = grain;
+    job->chunks = chunks;
+
+    size_t helpers = std::min(workers_.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([job] { job->run(); });
+    }
+    job->run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&] { return job->done.load() == chunks; });
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+WorkPool& WorkPool::shared() {
+    static WorkPool pool;
+    return pool;
+}
+
+} // namespace brain_ai
@@ -1,4 +1,6 @@
 #include "cognitive_handler.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/slow_query_log.hpp"
 #include <cassert>
 #include <iostream>
 
@@ -103,5 +105,144 @@ void test_cognitive_handler() {
         // With all features disabled, should only use vector search
     }
     
+    // Test episodic memory is partitioned by session
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        
+        handler.add_episode("alice query", "alice response", emb, {}, "alice");
+        handler.add_episode("bob query", "bob response", emb, {}, "bob");
+        
+        assert(handler.episodic_session_count() == 2 && "Should have 2 sessions");
+        assert(handler.episodic_buffer_size() == 2 && "Should have 2 episodes");
+        assert(handler.episodic_buffer().size() == 0 && "Default session untouched");
+        
+        auto alice = handler.episodic_store().retrieve_similar("alice", emb, 5, 0.5f);
+        assert(alice.size() == 1 && alice[0].query == "alice query" &&
+               "Session should only see its own episodes");
+    }
+    
+    // Test asynchronous episode recording
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        handler.add_episode_async("q1", "r1", emb, {}, "alice");
+        handler.add_episode_async("q2", "r2", emb, {}, "alice");
+        handler.flush_episodes();
+        
+        assert(handler.episode_queue_backlog() == 0 && "Queue drained after flush");
+        auto recent = handler.episodic_store().get_recent("alice", 10);
+        assert(recent.size() == 2 && recent[1].query == "q2" && "Episodes recorded in order");
+    }
+    
+    // Test slow queries are captured with their stage breakdown
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        handler.index_document("doc", {1.0f, 0.0f, 0.0f, 0.0f}, "indexed content");
+        
+        auto& slow_log = monitoring::SlowQueryLog::instance();
+        uint32_t saved_threshold = slow_log.threshold_us();
+        slow_log.clear();
+        slow_log.set_threshold_us(1);   // Everything counts as slow
+        
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        handler.process_query("Slow   Query", emb);
+        handler.process_query("slow query", emb);
+        slow_log.set_threshold_us(saved_threshold);
+        
+        auto records = slow_log.snapshot();
+        assert(records.size() == 2 && "Both queries recorded");
+        const auto& first = records[0];
+        const auto& second = records[1];
+        assert(first.source == monitoring::SlowQuerySource::PROCESS_QUERY);
+        assert(first.fingerprint == second.fingerprint && "Case and spacing folded");
+        assert(first.result_counts[static_cast<size_t>(monitoring::QueryResultCount::VECTOR)] == 1);
+        assert(first.top_k == 10 && first.ef_search >= 10);
+        
+        uint64_t stage_sum = 0;
+        for (uint32_t us : first.stage_us) {
+            stage_sum += us;
+        }
+        assert(stage_sum <= first.total_us && "Stages partition the total");
+        slow_log.clear();
+    }
+    
+    // Test query fingerprints tell apart everything that shapes the response
+    {
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        QueryConfig config;
+        auto base = QueryFingerprint::make("query", emb, config, "alice");
+        auto same = QueryFingerprint::make("query", emb, config, "alice");
+        assert(base == same && base.hash == same.hash);
+        
+        assert(!(base == QueryFingerprint::make("query", emb, config, "bob")));
+        assert(!(base == QueryFingerprint::make("other", emb, config, "alice")));
+        std::vector<float> nudged = {1.0f, 0.0f, 0.0f, 1e-7f};
+        assert(!(base == QueryFingerprint::make("query", nudged, config, "alice")));
+        QueryConfig top5;
+        top5.top_k_results = 5;
+        assert(!(base == QueryFingerprint::make("query", emb, top5, "alice")));
+        QueryConfig ppr;
+        ppr.semantic_activation.mode = ActivationMode::PersonalizedPageRank;
+        assert(!(base == QueryFingerprint::make("query", emb, ppr, "alice")));
+        QueryConfig bulk;
+        bulk.priority = QueryPriority::BULK;
+        assert(!(base == QueryFingerprint::make("query", emb, bulk, "alice")));
+        
+        // Parallelism does not change the response
+        QueryConfig parallel;
+        parallel.semantic_activation.parallel_frontier_threshold = 1;
+        assert(base == QueryFingerprint::make("query", emb, parallel, "alice"));
+    }
+        
+    // Test coalesced and direct queries answer the same
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        handler.index_document("doc1", {1.0f, 0.0f, 0.0f, 0.0f}, "Test document 1");
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        
+        auto shared = handler.process_query_shared("test query", emb);
+        handler.set_query_coalescing(false);
+        auto direct = handler.process_query("test query", emb);
+        handler.set_query_coalescing(true);
+        
+        assert(shared->response == direct.response);
+        assert(shared->results.size() == direct.results.size());
+        assert(handler.query_coalescing_stats().executions == 1 && "Direct run bypassed");
+    }
+    
+    // Test an expired context stops the query; a live one changes nothing
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        handler.index_document("doc1", {1.0f, 0.0f, 0.0f, 0.0f}, "Test document 1");
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        
+        auto context = RequestContext::cancellable();
+        context.cancel();
+        bool cancelled = false;
+        try {
+            handler.process_query("test query", emb, QueryConfig(), "", context);
+        } catch (const errors::CancelledError& e) {
+            cancelled = !e.deadline_exceeded();
+        }
+        assert(cancelled && "Cancelled query throws");
+        
+        bool expired = false;
+        try {
+            handler.process_query("test query", emb, QueryConfig(), "",
+                                  RequestContext::with_timeout(std::chrono::milliseconds(0)));
+        } catch (const errors::CancelledError& e) {
+            expired = e.deadline_exceeded();
+        }
+        assert(expired && "Past-deadline query throws");
+        
+        auto live = handler.process_query("test query", emb, QueryConfig(), "",
+                                          RequestContext::with_timeout(std::chrono::seconds(30)));
+        auto plain = handler.process_query("test query", emb);
+        assert(live.response == plain.response && live.results.size() == plain.results.size());
+    }
+    
     std::cout << "All cognitive handler tests passed!\n";
 }
@@ -0,0 +1,219 @@
+#include "cooccurrence_builder.hpp"
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+using namespace brain_ai;
+
+void test_cooccurrence_builder() {
+    // Test term extraction matches query concept filtering
+    {
+        auto terms = CooccurrenceBuilder::extract_terms("The Neural-network, from which LEARNING grows!", 4);
+        assert(terms.size() == 4);
+        assert(terms[0] == "neural" && terms[1] == "network");
+        assert(terms[2] == "learning" && terms[3] == "grows");
+    }
+    
+    // Test PMI-weighted edges for frequently co-occurring terms
+    {
+        SemanticNetwork network;
+        CooccurrenceConfig config;
+        config.apply_every_documents = 0;   // Apply on flush only
+        CooccurrenceBuilder builder(network, config);
+        
+        for (int i = 0; i < 20; ++i) {
+            builder.add_document("neural network training");
+            builder.add_document("garden flowers bloom");
+        }
+        builder.add_document("neural flowers");   // Seen once: below min_pair_count
+        assert(network.num_nodes() == 0 && "Nothing applied before flush");
+        builder.flush();
+        
+        auto node = network.get_node("neural");
+        assert(node.has_value());
+        const auto& edges = (*node)->edges;
+        assert(edges.count("network") == 1 && edges.count("training") == 1);
+        assert(edges.count("flowers") == 0 && "Rare pair filtered");
+        float weight = edges.at("network");
+        assert(weight > 0.0f && weight <= 1.0f && "NPMI weight in (0, 1]");
+        
+        auto back = network.get_node("network");
+        assert(back.has_value() && (*back)->edges.at("neural") == weight && "Edges are symmetric");
+        
+        auto activated = network.spread_activation({"neural"}, 2, 0.9f, 0.05f);
+        bool found = false;
+        for (const auto& [concept, activation] : activated) {
+            found |= concept == "network";
+        }
+        assert(found && "Mined edges feed spreading activation");
+        
+        auto stats = builder.stats();
+        assert(stats.documents == 41 && stats.applies == 1);
+        assert(stats.edges_applied == 12 && "Three pairs per topic, both directions");
+    }
+    
+    // Test parallel batch counting matches per-document counting
+    {
+        std::vector<std::string> texts;
+        for (int i = 0; i < 200; ++i) {
+            texts.push_back("alpha beta gamma delta term" + std::to_string(i % 7) + " epsilon");
+        }
+        
+        SemanticNetwork sequential_network;
+        CooccurrenceConfig config;
+        config.apply_every_documents = 0;
+        CooccurrenceBuilder sequential(sequential_network, config);
+        for (const auto& text : texts) {
+            sequential.add_document(text);
+        }
+        sequential.flush();
+        
+        SemanticNetwork parallel_network;
+        WorkPool pool(3);
+        CooccurrenceBuilder parallel(parallel_network, config, pool);
+        parallel.add_documents(texts);
+        parallel.flush();
+        
+        auto a = sequential.stats();
+        auto b = parallel.stats();
+        assert(a.documents == b.documents && a.tokens == b.tokens);
+        assert(a.distinct_pairs == b.distinct_pairs && a.edges_applied == b.edges_applied);
+        assert(sequential_network.num_edges() == parallel_network.num_edges());
+        assert((*sequential_network.get_node("alpha"))->edges ==
+               (*parallel_network.get_node("alpha"))->edges && "Same weights");
+    }
+    
+    // Test background applies during concurrent ingestion and queries
+    {
+        SemanticNetwork network;
+        WorkPool pool(2);
+        CooccurrenceConfig config;
+        config.apply_every_documents = 16;
+        CooccurrenceBuilder builder(network, config, pool);
+        
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&builder, t] {
+                for (int i = 0; i < 100; ++i) {
+                    builder.add_document("shared concept topic" + std::to_string(t) +
+                                         " detail" + std::to_string(i % 5));
+                }
+            });
+        }
+        for (int i = 0; i < 50; ++i) {
+            network.spread_activation({"shared"}, 2, 0.7f, 0.01f);
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        builder.flush();
+        
+        auto stats = builder.stats();
+        assert(stats.documents == 400 && "All documents counted");
+        assert(stats.applies >= 1);
+        auto node = network.get_node("shared");
+        assert(node.has_value() && (*node)->edges.count("concept") == 1);
+    }
+    
+    // Test asynchronous flush applies on the pool
+    {
+        SemanticNetwork network;
+        WorkPool pool(1);
+        CooccurrenceConfig config;
+        config.apply_every_documents = 0;
+        {
+            CooccurrenceBuilder builder(network, config, pool);
+            for (int i = 0; i < 5; ++i) {
+                builder.add_document("async flush edges");
+            }
+            builder.flush_async();
+        }   // Destructor waits for the task
+        auto node = network.get_node("async");
+        assert(node.has_value() && (*node)->edges.count("flush") == 1);
+    }
+    
+    // Test low-count pairs are pruned beyond max_pairs
+    {
+        SemanticNetwork network;
+        CooccurrenceConfig config;
+        config.apply_every_documents = 0;
+        config.max_pairs = 8;
+        CooccurrenceBuilder builder(network, config);
+        
+        for (int i = 0; i < 10; ++i) {
+            builder.add_document("frequent pairing");
+        }
+        for (int i = 0; i < 20; ++i) {
+            builder.add_document("rare" + std::to_string(i) + " once" + std::to_string(i));
+        }
+        builder.flush();
+        
+        auto stats = builder.stats();
+        assert(stats.distinct_pairs <= config.max_pairs && "Pair counts bounded");
+        assert(stats.pairs_pruned >= 13);
+        auto node = network.get_node("frequent");
+        assert(node.has_value() && (*node)->edges.count("pairing") == 1 && "Frequent pair kept");
+        assert(stats.terms_pruned >= 26 && "Terms of pruned pairs dropped");
+        assert(stats.distinct_terms <= 2 * config.max_pairs && "Vocabulary bounded");
+        
+        // Surviving terms were renumbered; new pairs still land on them
+        for (int i = 0; i < 10; ++i) {
+            builder.add_document("frequent newcomer");
+        }
+        builder.flush();
+        node = network.get_node("newcomer");
+        assert(node.has_value() && (*node)->edges.count("frequent") == 1 && "Renumbered term paired");
+    }
+    
+    // Test applies buffer edges and commit them in bounded batches
+    {
+        SemanticNetwork network;
+        WorkPool pool(1);
+        auto wait_for_pool = [&pool] {   // Single worker: runs after queued applies
+            std::promise<void> done;
+            pool.submit([&done] { done.set_value(); });
+            done.get_future().wait();
+        };
+        CooccurrenceConfig config;
+        config.apply_every_documents = 4;
+        config.commit_min_pairs = 1000;
+        config.commit_interval = std::chrono::milliseconds(0);
+        CooccurrenceBuilder builder(network, config, pool);
+        
+        for (int i = 0; i < 8; ++i) {
+            builder.add_document("alpha beta gamma");
+            wait_for_pool();
+        }
+        auto stats = builder.stats();
+        assert(stats.applies == 0 && stats.pairs_pending == 3 && "Below the size bound");
+        assert(network.num_edges() == 0 && network.pending_edits() == 0 && "Graph untouched");
+        
+        builder.flush();
+        stats = builder.stats();
+        assert(stats.applies == 1 && stats.pairs_pending == 0 && network.num_edges() == 6);
+    }
+    
+    // Test the commit interval bounds how long edges stay buffered
+    {
+        SemanticNetwork network;
+        WorkPool pool(1);
+        CooccurrenceConfig config;
+        config.apply_every_documents = 4;
+        config.commit_min_pairs = 1000;
+        config.commit_interval = std::chrono::milliseconds(1);
+        {
+            CooccurrenceBuilder builder(network, config, pool);
+            for (int i = 0; i < 4; ++i) {
+                builder.add_document("delta epsilon");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            builder.add_document("delta epsilon");   // Buffer is now old enough
+        }   // Destructor waits for the task
+        assert(network.num_edges() == 2 && "Committed once the interval passed");
+    }
+    
+    std::cout << "All co-occurrence builder tests passed!\n";
+}
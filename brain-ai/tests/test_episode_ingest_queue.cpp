@@ -0,0 +1,72 @@
+#include "episode_ingest_queue.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+using namespace brain_ai;
+
+void test_episode_ingest_queue() {
+    // Test flush makes queued episodes visible
+    {
+        SessionEpisodicStore store(SessionStoreConfig(100));
+        EpisodeIngestQueue queue(store);
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+        
+        for (int i = 0; i < 50; ++i) {
+            queue.enqueue("s1", "q" + std::to_string(i), "r", emb);
+        }
+        queue.flush();
+        
+        assert(queue.applied() == 50 && "All episodes applied after flush");
+        assert(queue.backlog() == 0 && "Nothing left queued");
+        assert(store.session_size("s1") == 50 && "Episodes visible in store");
+    }
+    
+    // Test per-session ordering with concurrent producers
+    {
+        SessionEpisodicStore store(SessionStoreConfig(1000));
+        EpisodeIngestConfig config;
+        config.max_batch = 7;   // Force many small batches
+        EpisodeIngestQueue queue(store, config);
+        
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back([&queue, t]() {
+                std::vector<float> emb = {1.0f, static_cast<float>(t), 0.0f};
+                std::string session = "session_" + std::to_string(t);
+                for (int i = 0; i < 200; ++i) {
+                    queue.enqueue(session, std::to_string(i), "r", emb);
+                }
+            });
+        }
+        for (auto& th : producers) th.join();
+        queue.flush();
+        
+        for (int t = 0; t < 4; ++t) {
+            auto episodes = store.get_recent("session_" + std::to_string(t), 1000);
+            assert(episodes.size() == 200 && "Every episode recorded");
+            for (size_t i = 0; i < episodes.size(); ++i) {
+                assert(episodes[i].query == std::to_string(i) && "Session order preserved");
+            }
+        }
+        assert(queue.batches() > 1 && "Work should be batched");
+    }
+    
+    // Test backpressure and drain on destruction
+    {
+        SessionEpisodicStore store(SessionStoreConfig(100));
+        {
+            EpisodeIngestConfig config;
+            config.max_queued = 4;
+            EpisodeIngestQueue queue(store, config);
+            std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+            for (int i = 0; i < 40; ++i) {
+                queue.enqueue("", "q", "r", emb);
+                assert(queue.backlog() <= 5 && "Backlog bounded");
+            }
+        }
+        assert(store.default_buffer().size() == 40 && "Destructor drains the queue");
+    }
+    
+    std::cout << "All episode ingest queue tests passed!\n";
+}
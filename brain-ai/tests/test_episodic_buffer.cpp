@@ -1,6 +1,11 @@
 #include "episodic_buffer.hpp"
+#include "episodic_consolidator.hpp"
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 using namespace brain_ai;
 
@@ -40,6 +45,28 @@ void test_episodic_buffer() {
         assert(all[0].query != "q1" && "Oldest episode should be evicted");
     }
     
+    // Evicted slots stay charged until their block is released
+    {
+        EpisodicBuffer buffer(4);
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+        
+        const size_t block_size = 64;  // Slots per storage block
+        buffer.add_episode("q", "r", emb);
+        size_t per_episode = buffer.memory_usage_bytes();
+        for (size_t i = 1; i < block_size; ++i) {
+            buffer.add_episode("q", "r", emb);
+        }
+        assert(buffer.memory_usage_bytes() == block_size * per_episode &&
+               "Evicted slots in a live block are still charged");
+        
+        // Fill the next block far enough to evict all of the first
+        for (size_t i = 0; i < 4; ++i) {
+            buffer.add_episode("q", "r", emb);
+        }
+        assert(buffer.memory_usage_bytes() == 4 * per_episode &&
+               "Released block is no longer charged");
+    }
+    
     // Test get_recent
     {
         EpisodicBuffer buffer(10);
@@ -65,5 +92,171 @@ void test_episodic_buffer() {
         assert(buffer.size() == 0 && "Buffer should be empty after clear");
     }
     
+    // Test consolidation of evicted episodes into centroids
+    {
+        ConsolidationConfig config;
+        config.enabled = true;
+        config.max_centroids = 2;
+        config.min_batch = 4;
+        EpisodicBuffer buffer(2, config);
+        
+        std::vector<float> topic_a = {1.0f, 0.0f, 0.0f};
+        std::vector<float> topic_b = {0.0f, 1.0f, 0.0f};
+        for (int i = 0; i < 4; ++i) {
+            buffer.add_episode("a" + std::to_string(i), "ra", topic_a);
+            buffer.add_episode("b" + std::to_string(i), "rb", topic_b);
+        }
+        
+        assert(buffer.size() == 2 && "Ring should stay bounded");
+        assert(buffer.pending_count() == 6 && "Evicted episodes should be queued");
+        size_t folded = buffer.consolidate();
+        assert(folded == 6 && "All pending episodes should be folded");
+        assert(buffer.pending_count() == 0 && "Queue should be drained");
+        assert(buffer.centroid_count() == 2 && "One centroid per topic");
+        assert(buffer.consolidated_episodes() == 6 && "Consolidated count tracked");
+        
+        for (const auto& centroid : buffer.get_centroids()) {
+            assert(centroid.metadata.at(EpisodicBuffer::kEpisodeCountKey) == "3" &&
+                   "Each centroid should cover 3 episodes");
+            assert(!centroid.metadata.at(EpisodicBuffer::kSummaryKey).empty() &&
+                   "Centroid should carry a summary");
+        }
+        
+        // Centroid is retrievable alongside raw episodes
+        auto similar = buffer.retrieve_similar(topic_a, 5, 0.5f);
+        bool found_centroid = false;
+        for (const auto& ep : similar) {
+            found_centroid |= ep.metadata.count(EpisodicBuffer::kConsolidatedKey) > 0;
+            assert(ep.query[0] == 'a' && "Only topic A should match");
+        }
+        assert(found_centroid && "Centroid should be retrieved");
+        
+        buffer.clear();
+        assert(buffer.centroid_count() == 0 && "Clear should drop centroids");
+    }
+    
+    // Test centroid count stays bounded
+    {
+        ConsolidationConfig config;
+        config.enabled = true;
+        config.max_centroids = 4;
+        config.min_batch = 1;
+        EpisodicBuffer buffer(1, config);
+        
+        for (int i = 0; i < 64; ++i) {
+            std::vector<float> emb(8, 0.0f);
+            emb[i % 8] = 1.0f;
+            emb[(i * 3) % 8] += 0.5f;
+            buffer.add_episode("q" + std::to_string(i), "r", emb);
+            if (i % 8 == 7) {
+                buffer.consolidate();
+            }
+        }
+        buffer.consolidate();
+        
+        assert(buffer.centroid_count() <= 4 && "Centroids bounded by max_centroids");
+        assert(buffer.consolidated_episodes() == 63 && "All evicted episodes consolidated");
+    }
+    
+    // Test background consolidator
+    {
+        ConsolidationConfig config;
+        config.enabled = true;
+        config.min_batch = 1;
+        auto buffer = std::make_shared<EpisodicBuffer>(1, config);
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+        buffer->add_episode("q1", "r1", emb);
+        buffer->add_episode("q2", "r2", emb);
+        
+        EpisodicConsolidator consolidator(std::chrono::milliseconds(10));
+        consolidator.watch(buffer);
+        size_t consolidated = consolidator.run_once();
+        assert(consolidated == 1 && "Pending episode consolidated");
+        
+        buffer.reset();
+        consolidator.run_once();
+        assert(consolidator.watched_count() == 0 && "Expired buffers pruned");
+    }
+    
+    // Test int8 embedding storage
+    {
+        EmbeddingStorageConfig storage;
+        storage.precision = EmbeddingPrecision::Int8;
+        EpisodicBuffer fp32_buffer(10);
+        EpisodicBuffer int8_buffer(10, ConsolidationConfig(), storage);
+        
+        std::vector<float> emb1(64, 0.1f);
+        std::vector<float> emb2(64, 0.1f);
+        emb1[0] = 1.0f;
+        emb2[1] = 1.0f;
+        for (auto* buffer : {&fp32_buffer, &int8_buffer}) {
+            buffer->add_episode("q1", "r1", emb1);
+            buffer->add_episode("q2", "r2", emb2);
+        }
+        
+        assert(int8_buffer.memory_usage_bytes() < fp32_buffer.memory_usage_bytes() &&
+               "Int8 storage should be smaller");
+        
+        auto similar = int8_buffer.retrieve_similar(emb1, 1, 0.5f);
+        assert(similar.size() == 1 && similar[0].query == "q1" && "Int8 ranking should match");
+        assert(similar[0].query_embedding.size() == 64 && "Results carry an fp32 embedding");
+        assert(std::fabs(similar[0].query_embedding[0] - 1.0f) < 0.01f && "Dequantized value close");
+        
+        auto recent = int8_buffer.get_recent(1);
+        assert(recent[0].query_embedding.size() == 64 && "Recent episodes materialized too");
+    }
+    
+    // Test int8 storage with fp32 re-scoring
+    {
+        EmbeddingStorageConfig storage;
+        storage.precision = EmbeddingPrecision::Int8;
+        storage.rescore_candidates = 4;
+        EpisodicBuffer buffer(10, ConsolidationConfig(), storage);
+        
+        std::vector<float> emb = {0.3f, -0.7f, 0.2f, 0.9f};
+        buffer.add_episode("q1", "r1", emb);
+        buffer.add_episode("q2", "r2", {-0.3f, 0.7f, -0.2f, -0.9f});
+        
+        auto similar = buffer.retrieve_similar(emb, 5, 0.9f);
+        assert(similar.size() == 1 && similar[0].query == "q1" && "Re-scored hit should remain");
+        assert(std::fabs(similar[0].query_embedding[1] + 0.7f) < 0.01f &&
+               "Results come from the bfloat16 side store");
+    }
+    
+    // Test readers run concurrently with a writer
+    {
+        EpisodicBuffer buffer(100);
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+        
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&]() {
+                std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+                while (!done.load()) {
+                    auto similar = buffer.retrieve_similar(emb, 5, 0.0f);
+                    auto recent = buffer.get_recent(10);
+                    assert(similar.size() <= 5 && recent.size() <= 10 && "Bounded results");
+                    for (const auto& ep : recent) {
+                        assert(ep.query.size() > 1 && ep.query[0] == 'q' && "Consistent episode");
+                    }
+                    assert(buffer.size() <= 100 && "Size never exceeds capacity");
+                    reads.fetch_add(1);
+                }
+            });
+        }
+        
+        std::vector<float> emb = {1.0f, 0.5f, 0.0f};
+        for (int i = 0; i < 2000; ++i) {
+            buffer.add_episode("q" + std::to_string(i), "r", emb);
+        }
+        done = true;
+        for (auto& th : readers) th.join();
+        
+        assert(buffer.size() == 100 && "Writer should fill the ring");
+        assert(buffer.get_recent(1)[0].query == "q1999" && "Latest episode visible");
+        assert(buffer.get_recent(100)[0].query == "q1900" && "Oldest live episode correct");
+    }
+    
     std::cout << "All episodic buffer tests passed!\n";
 }
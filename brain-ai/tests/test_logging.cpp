@@ -0,0 +1,388 @@
+#include "logging/logger.hpp"
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace brain_ai::logging;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+// Collects messages instead of printing them
+class CaptureSink : public LogSink {
+public:
+    void write(const LogMessage& msg) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back(msg.message);
+    }
+    void flush() override {}
+
+    std::vector<std::string> messages() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> messages_;
+};
+
+void test_sampled_first_n_then_every_m() {
+    auto logger = std::make_shared<Logger>("test.sampled");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+
+    for (int i = 0; i < 100; ++i) {
+        LOG_INFO_SAMPLED(logger, 3, 10, "hit " + std::to_string(i));
+    }
+
+    // Hits 0-2, then every 10th after them (12, 22, ..., 92)
+    auto messages = sink->messages();
+    EXPECT_EQ(messages.size(), 12u);
+    EXPECT_EQ(messages[2], "hit 2");
+    EXPECT_EQ(messages[3], "hit 12 (9 similar suppressed)");
+    EXPECT_EQ(messages[11], "hit 92 (9 similar suppressed)");
+
+    // Hits 93-99 are reported in a summary
+    logger->report_suppressed();
+    messages = sink->messages();
+    EXPECT_EQ(messages.size(), 13u);
+    EXPECT_EQ(messages.back(), "Suppressed 7 messages");
+
+    logger->report_suppressed();
+    EXPECT_EQ(sink->messages().size(), 13u);   // Nothing pending
+}
+
+void test_sampled_message_not_built_when_dropped() {
+    auto logger = std::make_shared<Logger>("test.lazy");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+
+    int built = 0;
+    auto build = [&built]() {
+        ++built;
+        return std::string("expensive");
+    };
+
+    // Rate limit only: one line per window
+    for (int i = 0; i < 50; ++i) {
+        LOG_WARN_SAMPLED(logger, 1, 0, build());
+    }
+    EXPECT_EQ(built, 1);
+    EXPECT_EQ(sink->messages().size(), 1u);
+
+    // Disabled levels do not count as hits
+    logger->set_level(LogLevel::ERROR);
+    for (int i = 0; i < 50; ++i) {
+        LOG_INFO_SAMPLED(logger, 1, 0, build());
+    }
+    EXPECT_EQ(built, 1);
+}
+
+void test_log_site_window() {
+    LogSite site(LogLevel::INFO, __FILE__, __LINE__, 2, 0, 20);
+
+    uint64_t suppressed = 0;
+    int admitted = 0;
+    for (int i = 0; i < 5; ++i) {
+        admitted += site.admit(suppressed) ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 2);
+    EXPECT_EQ(site.pending_suppressed(), 3u);
+
+    // A new window admits again and carries the previous window's count
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(site.admit(suppressed));
+    EXPECT_EQ(suppressed, 3u);
+    EXPECT_EQ(site.pending_suppressed(), 0u);
+    EXPECT_EQ(site.total_suppressed(), 3u);
+}
+
+void test_sampled_concurrent() {
+    auto logger = std::make_shared<Logger>("test.concurrent");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&logger]() {
+            for (int i = 0; i < 2500; ++i) {
+                LOG_INFO_SAMPLED(logger, 10, 100, "concurrent");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger->report_suppressed();
+
+    // Every hit is either written or counted in a suppressed total
+    uint64_t accounted = 0;
+    for (const auto& message : sink->messages()) {
+        auto open = message.find('(');
+        if (message.rfind("Suppressed ", 0) == 0) {
+            accounted += std::stoull(message.substr(11));
+        } else {
+            accounted += 1;
+            if (open != std::string::npos) {
+                accounted += std::stoull(message.substr(open + 1));
+            }
+        }
+    }
+    EXPECT_EQ(accounted, 10000u);
+}
+
+void test_disabled_level_skips_message() {
+    auto logger = std::make_shared<Logger>("test.disabled");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+    logger->set_level(LogLevel::WARN);
+
+    int built = 0;
+    auto build = [&built]() {
+        ++built;
+        return std::string("expensive");
+    };
+
+    LOG_DEBUG(logger, build());
+    LOG_INFO(logger, build());
+    EXPECT_EQ(built, 0);
+
+    LOG_WARN(logger, build());
+    EXPECT_EQ(built, 1);
+    EXPECT_EQ(sink->messages().size(), 1u);
+}
+
+void test_compiled_out_levels() {
+    static_assert(log_level_compiled_in(LogLevel::FATAL), "FATAL is never compiled out");
+
+    auto logger = std::make_shared<Logger>("test.compiled");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+    logger->set_level(LogLevel::TRACE);
+
+    int built = 0;
+    LOG_TRACEF(logger, "trace {}", ++built);
+    LOG_DEBUG(logger, std::to_string(++built));
+
+    // Compiled-out call sites never run, even when the runtime level allows them
+    size_t expected = 0;
+    if (log_level_compiled_in(LogLevel::TRACE)) ++expected;
+    if (log_level_compiled_in(LogLevel::DEBUG)) ++expected;
+    EXPECT_EQ(static_cast<size_t>(built), expected);
+    EXPECT_EQ(sink->messages().size(), expected);
+}
+
+void test_deferred_formatting() {
+    auto logger = std::make_shared<Logger>("test.format");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+
+    std::string name = "index";
+    LOG_INFOF(logger, "loaded {} with {} nodes in {} ms", name, 42, 1.5);
+    LOG_INFOF(logger, "no arguments");
+    LOG_INFOF(logger, "missing {} and {}", "one");
+    LOG_INFOF(logger, "literal {", 7);
+
+    auto messages = sink->messages();
+    EXPECT_EQ(messages.size(), 4u);
+    EXPECT_EQ(messages[0], "loaded index with 42 nodes in 1.5 ms");
+    EXPECT_EQ(messages[1], "no arguments");
+    EXPECT_EQ(messages[2], "missing one and {}");
+    EXPECT_EQ(messages[3], "literal {");
+
+    // Disabled levels never capture the arguments
+    logger->set_level(LogLevel::ERROR);
+    int captured = 0;
+    LOG_WARNF(logger, "{}", ++captured);
+    EXPECT_EQ(captured, 0);
+}
+
+void test_sampled_deferred_formatting() {
+    auto logger = std::make_shared<Logger>("test.sampled_format");
+    auto sink = std::make_shared<CaptureSink>();
+    logger->add_sink(sink);
+
+    // Dropped hits never capture their arguments
+    int captured = 0;
+    for (int i = 0; i < 25; ++i) {
+        LOG_INFOF_SAMPLED(logger, 2, 10, "hit {} of {}", i, ++captured);
+    }
+
+    // Hits 0-1, then 11 and 21
+    auto messages = sink->messages();
+    EXPECT_EQ(captured, 4);
+    EXPECT_EQ(messages.size(), 4u);
+    EXPECT_EQ(messages[1], "hit 1 of 2");
+    EXPECT_EQ(messages[2], "hit 11 of 3 (9 similar suppressed)");
+    EXPECT_EQ(messages[3], "hit 21 of 4 (9 similar suppressed)");
+}
+
+void test_async_sink_formats_on_writer() {
+    auto logger = std::make_shared<Logger>("test.async");
+    auto capture = std::make_shared<CaptureSink>();
+    auto async = std::make_shared<AsyncSink>(capture);
+    logger->add_sink(async);
+
+    // Arguments are copied, so changing them afterwards does not matter
+    std::string value = "before";
+    for (int i = 0; i < 100; ++i) {
+        LOG_INFOF(logger, "line {} {}", i, value);
+    }
+    value = "after";
+    LOG_INFO(logger, "plain");
+    logger->flush();
+
+    auto messages = capture->messages();
+    EXPECT_EQ(messages.size(), 101u);
+    EXPECT_EQ(messages[0], "line 0 before");
+    EXPECT_EQ(messages[99], "line 99 before");
+    EXPECT_EQ(messages[100], "plain");
+    EXPECT_EQ(async->dropped(), 0u);
+}
+
+void test_async_sink_drops_when_full() {
+    // Blocks the writer thread until released
+    class SlowSink : public CaptureSink {
+    public:
+        void write(const LogMessage& msg) override {
+            std::unique_lock<std::mutex> lock(gate_mutex_);
+            gate_cv_.wait(lock, [this] { return open_; });
+            lock.unlock();
+            CaptureSink::write(msg);
+        }
+        void open() {
+            std::lock_guard<std::mutex> lock(gate_mutex_);
+            open_ = true;
+            gate_cv_.notify_all();
+        }
+    private:
+        std::mutex gate_mutex_;
+        std::condition_variable gate_cv_;
+        bool open_ = false;
+    };
+
+    auto slow = std::make_shared<SlowSink>();
+    auto async = std::make_shared<AsyncSink>(slow, 4);
+    auto logger = std::make_shared<Logger>("test.async.full");
+    logger->add_sink(async);
+
+    for (int i = 0; i < 50; ++i) {
+        LOG_INFOF(logger, "burst {}", i);
+    }
+    slow->open();
+    logger->flush();
+
+    // Everything that was not dropped is written, plus one summary line
+    auto messages = slow->messages();
+    EXPECT_TRUE(async->dropped() > 0);
+    EXPECT_EQ(messages.size(), 50 - async->dropped() + 1);
+    size_t summaries = 0;
+    for (const auto& message : messages) {
+        summaries += message.find("dropped") != std::string::npos ? 1 : 0;
+    }
+    EXPECT_EQ(summaries, 1u);
+}
+
+void test_registry_defaults_to_console() {
+    // Must run before any test replaces the global sinks
+    std::ostringstream captured;
+    auto* original = std::cout.rdbuf(captured.rdbuf());
+    auto logger = LoggerRegistry::instance().get_logger("test.registry.default");
+    LOG_INFO(logger, "default output");
+    logger->flush();
+    std::cout.rdbuf(original);
+
+    EXPECT_TRUE(captured.str().find("default output") != std::string::npos);
+}
+
+void test_registry_applies_global_sinks() {
+    auto& registry = LoggerRegistry::instance();
+    auto sink = std::make_shared<CaptureSink>();
+    registry.set_global_sinks({sink});
+
+    // Loggers created after configuration still get the sinks
+    auto logger = registry.get_logger("test.registry.late");
+    LOG_INFO(logger, "configured");
+    EXPECT_EQ(sink->messages().size(), 1u);
+
+    registry.set_global_sinks({std::make_shared<ConsoleSink>()});
+    LOG_INFO(logger, "to console");
+    EXPECT_EQ(sink->messages().size(), 1u);
+}
+
+void test_registry_flushes_on_timer() {
+    auto& registry = LoggerRegistry::instance();
+    auto sink = std::make_shared<CaptureSink>();
+    registry.set_flush_interval(std::chrono::milliseconds(20));
+    registry.set_global_sinks({sink});
+
+    auto logger = registry.get_logger("test.registry.timer");
+    for (int i = 0; i < 10; ++i) {
+        LOG_INFO_SAMPLED(logger, 1, 0, "hit");
+    }
+    EXPECT_EQ(sink->messages().size(), 1u);
+
+    // The periodic flush reports the pending count without a flush() call
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sink->messages().size() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto messages = sink->messages();
+    registry.set_global_sinks({std::make_shared<ConsoleSink>()});
+    registry.set_flush_interval(LoggerRegistry::kDefaultFlushInterval);
+    EXPECT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages.back(), "Suppressed 9 messages");
+}
+
+int main() {
+    std::cout << "Running Logging Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Registry defaults to console", test_registry_defaults_to_console);
+    run_test("Sampled logging first N then 1 in M", test_sampled_first_n_then_every_m);
+    run_test("Sampled message not built when dropped", test_sampled_message_not_built_when_dropped);
+    run_test("Log site window", test_log_site_window);
+    run_test("Sampled logging concurrent", test_sampled_concurrent);
+    run_test("Disabled level skips message", test_disabled_level_skips_message);
+    run_test("Compiled-out levels", test_compiled_out_levels);
+    run_test("Deferred formatting", test_deferred_formatting);
+    run_test("Sampled deferred formatting", test_sampled_deferred_formatting);
+    run_test("Async sink formats on writer", test_async_sink_formats_on_writer);
+    run_test("Async sink drops when full", test_async_sink_drops_when_full);
+    run_test("Registry applies global sinks", test_registry_applies_global_sinks);
+    run_test("Registry flushes on timer", test_registry_flushes_on_timer);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Logging Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
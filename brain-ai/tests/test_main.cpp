@@ -89,8 +89,17 @@ void print_summary() {
 
 // Forward declarations of test functions
 void test_utils();
+void test_quantization();
 void test_episodic_buffer();
+void test_session_episodic_store();
+void test_episode_ingest_queue();
 void test_semantic_network();
+void test_semantic_graph();
+void test_work_pool();
+void test_single_flight();
+void test_query_scheduler();
+void test_request_context();
+void test_cooccurrence_builder();
 void test_hallucination_detector();
 void test_hybrid_fusion();
 void test_explanation_engine();
@@ -101,8 +110,17 @@ int main() {
     std::cout << std::string(60, '=') << "\n\n";
     
     simple_test::run_test("Utils Tests", test_utils);
+    simple_test::run_test("Quantization Tests", test_quantization);
     simple_test::run_test("Episodic Buffer Tests", test_episodic_buffer);
+    simple_test::run_test("Session Episodic Store Tests", test_session_episodic_store);
+    simple_test::run_test("Episode Ingest Queue Tests", test_episode_ingest_queue);
     simple_test::run_test("Semantic Network Tests", test_semantic_network);
+    simple_test::run_test("Semantic Graph Tests", test_semantic_graph);
+    simple_test::run_test("Work Pool Tests", test_work_pool);
+    simple_test::run_test("Single Flight Tests", test_single_flight);
+    simple_test::run_test("Query Scheduler Tests", test_query_scheduler);
+    simple_test::run_test("Request Context Tests", test_request_context);
+    simple_test::run_test("Co-occurrence Builder Tests", test_cooccurrence_builder);
     simple_test::run_test("Hallucination Detector Tests", test_hallucination_detector);
     simple_test::run_test("Hybrid Fusion Tests", test_hybrid_fusion);
     simple_test::run_test("Explanation Engine Tests", test_explanation_engine);
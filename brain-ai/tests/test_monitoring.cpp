@@ -1,5 +1,13 @@
 #include "monitoring/metrics.hpp"
 #include "monitoring/health.hpp"
+#include "monitoring/memory_pressure.hpp"
+#include "monitoring/perf_counters.hpp"
+#include "monitoring/slow_query_log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <thread>
 #include <chrono>
 #include <iostream>
@@ -312,6 +320,487 @@ void test_predefined_health_checks() {
     EXPECT_TRUE(!thread_result.details.empty());
 }
 
+void test_perf_counters_disabled() {
+    static PerfStage stage("test_perf_disabled");
+    auto& registry = MetricsRegistry::instance();
+    
+    PerfCounters::set_enabled(false);
+    {
+        PerfScope scope(stage);
+    }
+    
+    // Metrics are only registered once a sample is recorded
+    auto names = registry.get_counter_names();
+    EXPECT_TRUE(std::find(names.begin(), names.end(),
+                          "perf_test_perf_disabled_samples") == names.end());
+}
+
+void test_perf_counters_scope() {
+    static PerfStage stage("test_perf_scope");
+    auto& registry = MetricsRegistry::instance();
+    
+    PerfCounters::set_enabled(true);
+    volatile uint64_t sink = 0;
+    {
+        PerfScope scope(stage);
+        for (uint64_t i = 0; i < 100000; ++i) {
+            sink = sink + i * i;
+        }
+    }
+    PerfCounters::set_enabled(false);
+    
+    if (!PerfCounters::available()) {
+        // Not permitted here: nothing recorded, failure counted
+        std::cout << "(unavailable: " << PerfCounters::unavailable_reason() << ") ";
+        EXPECT_TRUE(!PerfCounters::unavailable_reason().empty());
+        EXPECT_TRUE(registry.get_counter("perf_counters_unavailable").value() >= 1);
+        auto names = registry.get_counter_names();
+        EXPECT_TRUE(std::find(names.begin(), names.end(),
+                              "perf_test_perf_scope_samples") == names.end());
+        return;
+    }
+    
+    EXPECT_EQ(registry.get_counter("perf_test_perf_scope_samples").value(), 1);
+    PerfReading reading;
+    EXPECT_TRUE(PerfCounters::read(reading));
+    if (reading.valid(PerfEvent::INSTRUCTIONS)) {
+        EXPECT_TRUE(registry.get_counter("perf_test_perf_scope_instructions").value() >= 100000);
+    }
+    
+    // stop() ends the scope once
+    {
+        PerfCounters::set_enabled(true);
+        PerfScope scope(stage);
+        scope.stop();
+        scope.stop();
+        PerfCounters::set_enabled(false);
+    }
+    EXPECT_EQ(registry.get_counter("perf_test_perf_scope_samples").value(), 2);
+}
+
+void test_slow_query_log_ring() {
+    SlowQueryLog log(4, 1000);
+    
+    EXPECT_TRUE(!log.is_slow(999));
+    EXPECT_TRUE(log.is_slow(1000));
+    
+    for (uint32_t i = 0; i < 6; ++i) {
+        SlowQueryRecord record;
+        record.total_us = 1000 + i;
+        log.record(record);
+    }
+    
+    // Only the newest `capacity` records survive, oldest first
+    auto records = log.snapshot();
+    EXPECT_EQ(records.size(), 4u);
+    EXPECT_EQ(records.front().total_us, 1002u);
+    EXPECT_EQ(records.back().total_us, 1005u);
+    EXPECT_EQ(log.recorded(), 6u);
+    
+    log.clear();
+    EXPECT_TRUE(log.snapshot().empty());
+    
+    log.set_threshold_us(0);
+    EXPECT_TRUE(!log.is_slow(1000000));
+}
+
+void test_slow_query_log_dump() {
+    SlowQueryLog log(8, 1);
+    
+    SlowQueryRecord record;
+    record.source = SlowQuerySource::INDEX_SEARCH;
+    record.fingerprint = 0xabcdef;
+    record.total_us = 2500;
+    record.stage_us[static_cast<size_t>(SearchStage::HNSW)] = 2000;
+    record.set_result_count(SearchResultCount::CANDIDATES, 10);
+    record.set_result_count(SearchResultCount::RETURNED, 3);
+    record.top_k = 10;
+    record.ef_search = 50;
+    record.hops = 4;
+    record.distance_computations = 64;
+    log.record(record);
+    
+    std::string dump = log.dump();
+    EXPECT_TRUE(dump.find("src=search fp=0000000000abcdef total_us=2500") != std::string::npos);
+    EXPECT_TRUE(dump.find("stages=lock_wait:0,hnsw:2000,filter:0 ") != std::string::npos);
+    EXPECT_TRUE(dump.find("results=candidates:10,returned:3 k=10 ef=50 hops=4 dists=64") !=
+                std::string::npos);
+    
+    std::string path = "/tmp/brain_ai_slow_queries_test.log";
+    EXPECT_TRUE(log.dump_to_file(path));
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    EXPECT_EQ(line + "\n", dump);
+    std::remove(path.c_str());
+    
+    EXPECT_EQ(fingerprint_text("  What is  HNSW?"), fingerprint_text("what is hnsw?"));
+    EXPECT_TRUE(fingerprint_text("what is hnsw") != fingerprint_text("whatis hnsw"));
+}
+
+void test_slow_query_log_concurrent() {
+    SlowQueryLog log(64, 1);
+    
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&log, t]() {
+            for (uint32_t i = 0; i < 5000; ++i) {
+                SlowQueryRecord record;
+                record.total_us = t;
+                record.top_k = i;
+                record.ef_search = i;   // Readers check top_k == ef_search
+                log.record(record);
+            }
+        });
+    }
+    
+    size_t torn = 0;
+    for (int i = 0; i < 50; ++i) {
+        for (const auto& record : log.snapshot()) {
+            if (record.top_k != record.ef_search) {
+                ++torn;
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(log.recorded(), 20000u);
+    EXPECT_EQ(log.snapshot().size(), 64u);
+}
+
+void test_health_check_timeout_does_not_block() {
+    HealthCheck check("slow_check", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return create_health_result("slow_check", HealthStatus::HEALTHY, "OK");
+    }, 20);
+    
+    auto start = std::chrono::steady_clock::now();
+    auto result = check.execute();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    EXPECT_TRUE(result.status == HealthStatus::UNHEALTHY);
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(250));
+    
+    // The overrunning run is not duplicated, and waiting on it is not
+    // recorded as another failure
+    auto again = check.execute();
+    EXPECT_TRUE(again.message.find("timed out") != std::string::npos);
+    EXPECT_EQ(check.consecutive_failures(), 1);
+    
+    while (check.in_flight()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(check.execute().status == HealthStatus::UNHEALTHY);   // Times out again
+    while (check.in_flight()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void test_health_check_unknown_exception() {
+    HealthCheck check("throwing_check", []() -> HealthCheckResult {
+        throw 42;
+    }, 1000);
+    
+    auto result = check.execute();
+    EXPECT_TRUE(result.status == HealthStatus::UNHEALTHY);
+    EXPECT_TRUE(!check.in_flight());
+    
+    result = check.probe();
+    EXPECT_TRUE(result.status == HealthStatus::UNHEALTHY);
+    EXPECT_EQ(check.consecutive_failures(), 2);
+}
+
+void test_health_prober_cache() {
+    auto& registry = HealthCheckRegistry::instance();
+    auto runs = std::make_shared<std::atomic<int>>(0);
+    
+    registry.register_check("prober_fast", [runs]() {
+        (*runs)++;
+        return create_health_result("prober_fast", HealthStatus::HEALTHY, "OK");
+    }, 1000, 20);
+    registry.register_check("prober_hung", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        return create_health_result("prober_hung", HealthStatus::HEALTHY, "OK");
+    }, 10, 10);
+    
+    registry.start_prober(std::chrono::milliseconds(50));
+    EXPECT_TRUE(registry.prober_running());
+    
+    auto find = [](const SystemHealth& health, const std::string& name) {
+        for (const auto& result : health.component_results) {
+            if (result.component_name == name) {
+                return result;
+            }
+        }
+        return HealthCheckResult();
+    };
+    
+    // Served from cache without running the checks
+    auto health = registry.check_all();
+    EXPECT_TRUE(health.from_cache);
+    
+    // The hung check has no result within interval + timeout: stale
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    health = registry.check_all();
+    auto hung = find(health, "prober_hung");
+    EXPECT_TRUE(hung.stale);
+    EXPECT_TRUE(hung.status == HealthStatus::UNHEALTHY);
+    EXPECT_TRUE(hung.message.find("timed out") != std::string::npos);
+    EXPECT_TRUE(hung.age_ms >= 20);
+    EXPECT_TRUE(health.overall_status != HealthStatus::HEALTHY);
+    
+    // Once the hung run finishes the fast check is probed repeatedly
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (runs->load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(runs->load() >= 3);
+    
+    health = registry.check_all();
+    auto fast = find(health, "prober_fast");
+    EXPECT_TRUE(fast.status == HealthStatus::HEALTHY);
+    EXPECT_TRUE(!fast.stale);
+    
+    // Cached responses never wait on a check
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        registry.check_all();
+    }
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+    
+    registry.stop_prober();
+    EXPECT_TRUE(!registry.prober_running());
+    registry.unregister_check("prober_fast");
+    registry.unregister_check("prober_hung");
+}
+
+void test_health_check_cancel_and_wait() {
+    std::atomic<int> runs{0};
+    HealthCheck check("cancelled_check", [&runs]() {
+        runs++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return create_health_result("cancelled_check", HealthStatus::HEALTHY, "OK");
+    }, 10);
+    
+    EXPECT_TRUE(check.execute().status == HealthStatus::UNHEALTHY);   // Timed out, still running
+    EXPECT_TRUE(check.in_flight());
+    EXPECT_TRUE(check.cancel_and_wait(std::chrono::seconds(5)));
+    EXPECT_TRUE(!check.in_flight() && runs.load() == 1);
+    
+    // Runs are accepted again once the wait is over
+    EXPECT_TRUE(check.cancel_and_wait(std::chrono::seconds(5)));
+    EXPECT_TRUE(check.execute().status == HealthStatus::UNHEALTHY);
+    EXPECT_TRUE(check.cancel_and_wait(std::chrono::seconds(5)));
+    EXPECT_EQ(runs.load(), 2);
+    
+    // A run outlasting the limit is abandoned, not waited for
+    EXPECT_TRUE(check.execute().status == HealthStatus::UNHEALTHY);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(!check.cancel_and_wait(std::chrono::milliseconds(10)));
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(90));
+    EXPECT_TRUE(check.in_flight());
+    
+    // It clears the cancellation when it finishes, so later runs proceed
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (check.in_flight() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(check.execute().message.find("timed out") != std::string::npos);
+    EXPECT_TRUE(check.cancel_and_wait(std::chrono::seconds(5)));
+    EXPECT_EQ(runs.load(), 4);
+}
+
+void test_health_registry_drain_is_bounded() {
+    auto& registry = HealthCheckRegistry::instance();
+    auto release = std::make_shared<std::atomic<bool>>(false);
+    registry.register_check("drain_hung", [release]() {
+        while (!release->load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return create_health_result("drain_hung", HealthStatus::HEALTHY, "OK");
+    }, 20, 10);
+    
+    registry.start_prober(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));   // Probe is running
+    
+    // The hung probe holds stop_prober() up for at most its timeout
+    auto start = std::chrono::steady_clock::now();
+    registry.stop_prober();
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+    
+    release->store(true);
+    registry.unregister_check("drain_hung");
+}
+
+namespace {
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    file << contents;
+}
+
+// Fake /proc and cgroup v2 tree for read_memory_sample
+MemoryPressureConfig fake_memory_tree(const std::string& root) {
+    std::filesystem::create_directories(root + "/proc/self");
+    std::filesystem::create_directories(root + "/proc/pressure");
+    std::filesystem::create_directories(root + "/cgroup/app.slice");
+    
+    write_file(root + "/proc/self/statm", "5000 1000 200 10 0 900 0\n");
+    write_file(root + "/proc/self/cgroup", "0::/app.slice\n");
+    write_file(root + "/proc/meminfo",
+               "MemTotal:        1000000 kB\nMemFree:  100000 kB\nMemAvailable:  500000 kB\n");
+    write_file(root + "/proc/pressure/memory",
+               "some avg10=1.00 avg60=0.50 avg300=0.10 total=100\n"
+               "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+    write_file(root + "/cgroup/app.slice/memory.current", "800\n");
+    write_file(root + "/cgroup/app.slice/memory.max", "1000\n");
+    
+    MemoryPressureConfig config;
+    config.proc_root = root + "/proc";
+    config.cgroup_root = root + "/cgroup";
+    return config;
+}
+
+} // namespace
+
+void test_memory_sample_reading() {
+    std::string root = "/tmp/brain_ai_memory_pressure_test";
+    auto config = fake_memory_tree(root);
+    
+    auto sample = read_memory_sample(config);
+    EXPECT_TRUE(sample.rss_bytes >= 1000u * 4096u);
+    EXPECT_TRUE(sample.cgroup_available);
+    EXPECT_EQ(sample.cgroup_current_bytes, 800u);
+    EXPECT_EQ(sample.cgroup_max_bytes, 1000u);
+    EXPECT_TRUE(sample.system_available);
+    EXPECT_EQ(sample.system_total_bytes, 1000000u * 1024u);
+    EXPECT_NEAR(sample.usage_ratio(), 0.8, 1e-9);   // cgroup limit wins
+    
+    // No cgroup memory.pressure: falls back to the system-wide PSI file
+    EXPECT_TRUE(sample.psi_available);
+    EXPECT_NEAR(sample.psi_some_avg10, 1.0, 1e-9);
+    
+    write_file(root + "/cgroup/app.slice/memory.pressure",
+               "some avg10=42.50 avg60=0.00 avg300=0.00 total=0\n"
+               "full avg10=3.25 avg60=0.00 avg300=0.00 total=0\n");
+    write_file(root + "/cgroup/app.slice/memory.max", "max\n");
+    sample = read_memory_sample(config);
+    EXPECT_NEAR(sample.psi_some_avg10, 42.5, 1e-9);
+    EXPECT_NEAR(sample.psi_full_avg10, 3.25, 1e-9);
+    EXPECT_EQ(sample.cgroup_max_bytes, 0u);
+    EXPECT_TRUE(sample.usage_ratio() == 0.0);   // Unlimited, no RSS budget: no signal
+    
+    // Unlimited cgroup: RSS against the configured budget
+    config.rss_limit_bytes = sample.rss_bytes * 2;
+    sample = read_memory_sample(config);
+    EXPECT_TRUE(sample.usage_ratio() > 0.0 && sample.usage_ratio() <= 1.0);
+    
+    // Missing files leave fields unavailable instead of failing
+    config.proc_root = root + "/missing";
+    config.cgroup_root = root + "/missing";
+    sample = read_memory_sample(config);
+    EXPECT_TRUE(!sample.cgroup_available && !sample.psi_available && !sample.system_available);
+    EXPECT_TRUE(sample.usage_ratio() == 0.0);
+    
+    std::filesystem::remove_all(root);
+}
+
+void test_memory_pressure_classification() {
+    MemoryPressureConfig config;
+    MemorySample sample;
+    sample.cgroup_available = true;
+    sample.cgroup_max_bytes = 1000;
+    
+    sample.cgroup_current_bytes = 500;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::NORMAL);
+    sample.cgroup_current_bytes = 800;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::MODERATE);
+    sample.cgroup_current_bytes = 900;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::HIGH);
+    sample.cgroup_current_bytes = 960;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::CRITICAL);
+    
+    // Hysteresis: 0.80 stays HIGH once there, drops when clearly below
+    sample.cgroup_current_bytes = 800;
+    EXPECT_TRUE(classify_memory_pressure(sample, config, MemoryPressureLevel::HIGH) ==
+                MemoryPressureLevel::HIGH);
+    sample.cgroup_current_bytes = 700;
+    EXPECT_TRUE(classify_memory_pressure(sample, config, MemoryPressureLevel::HIGH) ==
+                MemoryPressureLevel::MODERATE);
+    
+    // Stalls raise the level even with headroom
+    sample.cgroup_current_bytes = 100;
+    sample.psi_available = true;
+    sample.psi_some_avg10 = 35.0;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::HIGH);
+    sample.psi_full_avg10 = 25.0;
+    EXPECT_TRUE(classify_memory_pressure(sample, config) == MemoryPressureLevel::CRITICAL);
+}
+
+void test_memory_pressure_listeners() {
+    auto monitor = std::make_unique<MemoryPressureMonitor>();
+    std::vector<MemoryPressureLevel> seen;
+    
+    auto subscription = monitor->subscribe([&seen](MemoryPressureLevel level) {
+        seen.push_back(level);
+    });
+    EXPECT_TRUE(subscription.active());
+    EXPECT_TRUE(seen.empty());   // NORMAL is not announced
+    
+    monitor->publish(MemoryPressureLevel::HIGH);
+    monitor->publish(MemoryPressureLevel::HIGH);   // Unchanged: no call
+    monitor->publish(MemoryPressureLevel::NORMAL);
+    EXPECT_EQ(seen.size(), 2u);
+    EXPECT_TRUE(seen[0] == MemoryPressureLevel::HIGH);
+    EXPECT_TRUE(seen[1] == MemoryPressureLevel::NORMAL);
+    
+    // Late subscribers hear the current level right away
+    monitor->publish(MemoryPressureLevel::MODERATE);
+    MemoryPressureLevel late = MemoryPressureLevel::NORMAL;
+    auto late_subscription = monitor->subscribe([&late](MemoryPressureLevel level) {
+        late = level;
+    });
+    EXPECT_TRUE(late == MemoryPressureLevel::MODERATE);
+    
+    subscription.reset();
+    EXPECT_TRUE(!subscription.active());
+    monitor->publish(MemoryPressureLevel::CRITICAL);
+    EXPECT_EQ(seen.size(), 3u);   // Unsubscribed before CRITICAL
+    EXPECT_TRUE(late == MemoryPressureLevel::CRITICAL);
+    
+    // Background polling against a fake tree under pressure
+    std::string root = "/tmp/brain_ai_memory_pressure_poll";
+    auto config = fake_memory_tree(root);
+    config.poll_interval = std::chrono::milliseconds(10);
+    write_file(root + "/cgroup/app.slice/memory.current", "990\n");
+    
+    MemoryPressureMonitor polled(config);
+    std::atomic<int> level{0};
+    auto polled_subscription = polled.subscribe([&level](MemoryPressureLevel value) {
+        level = static_cast<int>(value);
+    });
+    polled.start();
+    EXPECT_TRUE(polled.running());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (level.load() != static_cast<int>(MemoryPressureLevel::CRITICAL) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(polled.level() == MemoryPressureLevel::CRITICAL);
+    EXPECT_EQ(polled.last_sample().cgroup_current_bytes, 990u);
+    polled.stop();
+    EXPECT_TRUE(!polled.running());
+    
+    // Subscriptions may outlive their monitor
+    monitor.reset();
+    late_subscription.reset();
+    
+    std::filesystem::remove_all(root);
+}
+
 int main() {
     std::cout << "Running Monitoring Tests...\n";
     std::cout << "============================================================\n\n";
@@ -344,6 +833,25 @@ int main() {
     run_test("System health aggregation (unhealthy)", test_system_health_unhealthy);
     run_test("Health check registry", test_health_registry);
     run_test("Predefined health checks", test_predefined_health_checks);
+    run_test("Health check timeout does not block", test_health_check_timeout_does_not_block);
+    run_test("Health check unknown exception", test_health_check_unknown_exception);
+    run_test("Health prober cache", test_health_prober_cache);
+    run_test("Health check cancel and wait", test_health_check_cancel_and_wait);
+    run_test("Health registry drain is bounded", test_health_registry_drain_is_bounded);
+    
+    // Hardware counter tests
+    run_test("Perf counters disabled", test_perf_counters_disabled);
+    run_test("Perf counters scope", test_perf_counters_scope);
+    
+    // Slow-query log tests
+    run_test("Slow query log ring", test_slow_query_log_ring);
+    run_test("Slow query log dump", test_slow_query_log_dump);
+    run_test("Slow query log concurrent writers", test_slow_query_log_concurrent);
+    
+    // Memory pressure tests
+    run_test("Memory sample reading", test_memory_sample_reading);
+    run_test("Memory pressure classification", test_memory_pressure_classification);
+    run_test("Memory pressure listeners", test_memory_pressure_listeners);
     
     std::cout << "\n============================================================\n";
     std::cout << "Monitoring Tests Complete\n";
@@ -0,0 +1,65 @@
+#include "quantization.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace brain_ai;
+
+void test_quantization() {
+    // Test quantize/dequantize round trip
+    {
+        std::vector<float> v = {0.5f, -1.0f, 0.25f, 0.0f, 0.75f};
+        std::vector<int8_t> codes(v.size());
+        float scale = quantize_int8(v.data(), v.size(), codes.data());
+        
+        assert(std::fabs(scale - 1.0f / 127.0f) < 1e-6f && "Scale should map max |x| to 127");
+        assert(codes[1] == -127 && "Max magnitude should use full range");
+        
+        std::vector<float> back(v.size());
+        dequantize_int8(codes.data(), codes.size(), scale, back.data());
+        for (size_t i = 0; i < v.size(); ++i) {
+            assert(std::fabs(back[i] - v[i]) <= scale && "Round trip error bounded by scale");
+        }
+    }
+    
+    // Test zero vector
+    {
+        std::vector<float> v(16, 0.0f);
+        std::vector<int8_t> codes(v.size(), 1);
+        assert(quantize_int8(v.data(), v.size(), codes.data()) == 0.0f && "Zero vector has zero scale");
+        assert(codes[0] == 0 && "Zero vector has zero codes");
+    }
+    
+    // Test int8 dot product matches scalar reference (all tail lengths)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> dist(-127, 127);
+        for (size_t n : {0, 1, 31, 32, 33, 64, 100, 384, 1536}) {
+            std::vector<int8_t> a(n), b(n);
+            int32_t expected = 0;
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = static_cast<int8_t>(dist(rng));
+                b[i] = static_cast<int8_t>(dist(rng));
+                expected += static_cast<int32_t>(a[i]) * b[i];
+            }
+            assert(dot_product_int8(a.data(), b.data(), n) == expected &&
+                   "SIMD kernel must match scalar result");
+        }
+        
+        // Extremes must not saturate
+        std::vector<int8_t> hi(256, 127), lo(256, -127);
+        assert(dot_product_int8(hi.data(), hi.data(), 256) == 127 * 127 * 256 && "No saturation");
+        assert(dot_product_int8(hi.data(), lo.data(), 256) == -127 * 127 * 256 && "No saturation");
+    }
+    
+    // Test bfloat16 conversion
+    {
+        assert(bf16_to_float(float_to_bf16(1.0f)) == 1.0f && "1.0 is exact");
+        assert(bf16_to_float(float_to_bf16(-2.5f)) == -2.5f && "-2.5 is exact");
+        float x = 0.123456f;
+        assert(std::fabs(bf16_to_float(float_to_bf16(x)) - x) < 1e-3f && "bf16 keeps ~3 digits");
+    }
+    
+    std::cout << "All quantization tests passed! (kernel: " << int8_kernel_name() << ")\n";
+}
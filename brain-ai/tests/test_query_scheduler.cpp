@@ -0,0 +1,197 @@
+#include "query_scheduler.hpp"
+#include "errors/exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+size_t lane(QueryPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+QuerySchedulerConfig config_with(size_t max_concurrency) {
+    QuerySchedulerConfig config;
+    config.max_concurrency = max_concurrency;
+    config.interactive_latency_target = std::chrono::microseconds(0);   // No throttling
+    return config;
+}
+
+} // namespace
+
+void test_query_scheduler() {
+    // Test total and per-lane concurrency limits
+    {
+        auto config = config_with(3);
+        config.lanes[lane(QueryPriority::BULK)].max_concurrency = 1;
+        QueryScheduler scheduler(config);
+        
+        std::atomic<int> running{0};
+        std::atomic<int> peak{0};
+        std::atomic<int> bulk_running{0};
+        std::atomic<int> bulk_peak{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 12; ++i) {
+            auto priority = i % 2 == 0 ? QueryPriority::BULK : QueryPriority::INTERACTIVE;
+            threads.emplace_back([&, priority]() {
+                scheduler.run(priority, [&]() {
+                    int now = ++running;
+                    peak = std::max(peak.load(), now);
+                    if (priority == QueryPriority::BULK) {
+                        int bulk = ++bulk_running;
+                        bulk_peak = std::max(bulk_peak.load(), bulk);
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    if (priority == QueryPriority::BULK) {
+                        --bulk_running;
+                    }
+                    --running;
+                    return 0;
+                });
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        assert(peak.load() <= 3 && "Total slots respected");
+        assert(bulk_peak.load() == 1 && "Bulk lane limit respected");
+        auto stats = scheduler.stats();
+        assert(stats.lanes[lane(QueryPriority::BULK)].admitted == 6);
+        assert(stats.lanes[lane(QueryPriority::INTERACTIVE)].admitted == 6);
+    }
+    
+    // Test freed slots are shared by weight
+    {
+        auto config = config_with(1);
+        config.lanes[lane(QueryPriority::INTERACTIVE)].weight = 3;
+        config.lanes[lane(QueryPriority::BULK)].weight = 1;
+        QueryScheduler scheduler(config);
+        
+        std::mutex order_mutex;
+        std::string order;
+        auto holder = scheduler.admit(QueryPriority::INGEST);
+        
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            for (auto priority : {QueryPriority::INTERACTIVE, QueryPriority::BULK}) {
+                threads.emplace_back([&, priority]() {
+                    auto slot = scheduler.admit(priority);
+                    std::lock_guard<std::mutex> lock(order_mutex);
+                    order += priority == QueryPriority::INTERACTIVE ? 'I' : 'B';
+                });
+            }
+        }
+        // Everyone queued behind the held slot
+        while (true) {
+            auto stats = scheduler.stats();
+            if (stats.lanes[lane(QueryPriority::INTERACTIVE)].queued == 4 &&
+                stats.lanes[lane(QueryPriority::BULK)].queued == 4) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        holder.release();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        // Stride order: interactive advances 1/3 per slot, bulk 1
+        assert(order == "IBIIIBBB" && "Weighted fair order");
+    }
+    
+    // Test nested admissions pass through instead of deadlocking
+    {
+        QueryScheduler scheduler(config_with(1));
+        int value = scheduler.run(QueryPriority::INTERACTIVE, [&]() {
+            return scheduler.run(QueryPriority::INGEST, []() { return 7; });
+        });
+        assert(value == 7);
+        assert(scheduler.stats().lanes[lane(QueryPriority::INGEST)].admitted == 0);
+    }
+    
+    // Test ingest is throttled while interactive latency is high, then recovers
+    {
+        auto config = config_with(4);
+        config.lanes[lane(QueryPriority::INGEST)].max_concurrency = 4;
+        config.interactive_latency_target = std::chrono::microseconds(1000);
+        config.throttle_interval = std::chrono::milliseconds(1);
+        config.latency_smoothing = 1.0;
+        QueryScheduler scheduler(config);
+        assert(scheduler.lane_limit(QueryPriority::INGEST) == 4);
+        
+        for (int i = 0; i < 3; ++i) {
+            scheduler.run(QueryPriority::INTERACTIVE, []() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                return 0;
+            });
+        }
+        assert(scheduler.lane_limit(QueryPriority::INGEST) == 1 && "Halved to one");
+        assert(scheduler.stats().throttle_events == 2);
+        
+        // Interactive traffic goes quiet: the limit grows back one step at a time
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 5; ++i) {
+            scheduler.run(QueryPriority::INGEST, []() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                return 0;
+            });
+        }
+        assert(scheduler.lane_limit(QueryPriority::INGEST) == 4 && "Restored to configured");
+    }
+    
+    // Test a queued request leaves the queue when its context expires
+    {
+        QueryScheduler scheduler(config_with(1));
+        auto holder = scheduler.admit(QueryPriority::BULK);
+        
+        // Admissions wait on other threads (this one holds a slot)
+        std::atomic<bool> deadline_hit{false};
+        std::thread([&]() {
+            try {
+                scheduler.admit(QueryPriority::INTERACTIVE,
+                                RequestContext::with_timeout(std::chrono::milliseconds(5)));
+            } catch (const errors::CancelledError& e) {
+                deadline_hit = e.deadline_exceeded() && e.stage() == "scheduler";
+            }
+        }).join();
+        assert(deadline_hit.load() && "Deadline ends the wait");
+        
+        auto context = RequestContext::cancellable();
+        std::atomic<bool> cancelled{false};
+        std::thread waiter([&]() {
+            try {
+                scheduler.admit(QueryPriority::INTERACTIVE, context);
+            } catch (const errors::CancelledError& e) {
+                cancelled = !e.deadline_exceeded();
+            }
+        });
+        while (scheduler.stats().lanes[lane(QueryPriority::INTERACTIVE)].queued == 0) {
+            std::this_thread::yield();
+        }
+        context.cancel();
+        waiter.join();
+        assert(cancelled.load() && "cancel() ends the wait");
+        
+        auto stats = scheduler.stats();
+        assert(stats.lanes[lane(QueryPriority::INTERACTIVE)].queued == 0 && "No stale waiter");
+        assert(stats.lanes[lane(QueryPriority::INTERACTIVE)].admitted == 0);
+        
+        // The slot passes on as usual once released
+        holder.release();
+        int value = scheduler.run(QueryPriority::INTERACTIVE, []() { return 3; },
+                                  RequestContext::with_timeout(std::chrono::seconds(10)));
+        assert(value == 3);
+        assert(scheduler.stats().lanes[lane(QueryPriority::INTERACTIVE)].admitted == 1);
+    }
+    
+    std::cout << "All query scheduler tests passed!\n";
+}
@@ -0,0 +1,187 @@
+#include "request_context.hpp"
+#include "episodic_buffer.hpp"
+#include "errors/exceptions.hpp"
+#include "monitoring/metrics.hpp"
+#include "semantic_network.hpp"
+#include "vector_search/hnsw_index.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+int64_t counter(std::string_view name) {
+    return monitoring::MetricsRegistry::instance().get_counter(name).value();
+}
+
+// Runs fn and reports whether it threw CancelledError at stage
+template <typename Fn>
+bool cancelled_at(const std::string& stage, Fn&& fn) {
+    try {
+        fn();
+    } catch (const errors::CancelledError& e) {
+        return e.stage() == stage;
+    }
+    return false;
+}
+
+std::vector<float> random_vector(std::mt19937& rng, size_t dim) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(dim);
+    for (auto& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+} // namespace
+
+void test_request_context() {
+    // Test the default context never expires and cannot be cancelled
+    {
+        RequestContext context;
+        context.cancel();
+        assert(!context.can_expire() && !context.expired() && !context.has_deadline());
+        assert(context.remaining() == RequestContext::Clock::duration::max());
+        assert(!context.should_stop("test"));
+        context.check("test");
+    }
+    
+    // Test deadlines, cancellation and shared copies
+    {
+        auto live = RequestContext::with_timeout(std::chrono::seconds(30));
+        assert(live.has_deadline() && !live.expired());
+        assert(live.remaining() > std::chrono::seconds(29));
+        
+        auto past = RequestContext::with_timeout(std::chrono::milliseconds(0));
+        assert(past.expired() && past.remaining() == RequestContext::Clock::duration::zero());
+        
+        auto forever = RequestContext::with_timeout(RequestContext::Clock::duration::max());
+        assert(forever.can_expire() && !forever.has_deadline() && !forever.expired());
+        
+        auto context = RequestContext::cancellable();
+        auto copy = context;
+        std::thread([copy]() { copy.cancel(); }).join();
+        assert(context.cancelled() && context.expired() && "Copies share one token");
+    }
+    
+    // Test the first stage to give up is counted once per request
+    {
+        int64_t cancelled = counter(monitoring::metric_names::REQUESTS_CANCELLED);
+        int64_t deadline = counter(monitoring::metric_names::REQUESTS_DEADLINE_EXCEEDED);
+        int64_t stage = counter("cancelled_unit_stage");
+        
+        auto context = RequestContext::with_timeout(std::chrono::milliseconds(0));
+        bool threw = false;
+        try {
+            context.check("unit_stage");
+        } catch (const errors::CancelledError& e) {
+            threw = e.deadline_exceeded() && e.stage() == "unit_stage";
+        }
+        assert(threw);
+        assert(context.should_stop("later_stage") && "Still expired");
+        
+        assert(counter(monitoring::metric_names::REQUESTS_CANCELLED) == cancelled + 1);
+        assert(counter(monitoring::metric_names::REQUESTS_DEADLINE_EXCEEDED) == deadline + 1);
+        assert(counter("cancelled_unit_stage") == stage + 1);
+        assert(counter("cancelled_later_stage") == 0 && "Only the first stage counts");
+        
+        auto user = RequestContext::cancellable();
+        user.cancel();
+        bool stopped = cancelled_at("unit_stage", [&]() { user.check("unit_stage"); });
+        assert(stopped && "A cancelled context throws");
+        assert(counter(monitoring::metric_names::REQUESTS_DEADLINE_EXCEEDED) == deadline + 1 &&
+               "A cancel is not a deadline miss");
+    }
+    
+    // Test HNSW search stops on an expired context and is unchanged otherwise
+    {
+        const size_t dim = 16;
+        vector_search::HNSWIndex index(dim, 1000);
+        std::mt19937 rng(7);
+        for (int i = 0; i < 150; ++i) {
+            index.add_document("doc" + std::to_string(i), random_vector(rng, dim), "content");
+        }
+        
+        for (int q = 0; q < 20; ++q) {
+            auto query = random_vector(rng, dim);
+            auto plain = index.search(query, 10);
+            auto timed = index.search(query, 10, nullptr,
+                                      RequestContext::with_timeout(std::chrono::seconds(30)));
+            assert(plain.size() == timed.size());
+            for (size_t i = 0; i < plain.size(); ++i) {
+                assert(plain[i].doc_id == timed[i].doc_id && "Same neighbours with a deadline");
+            }
+        }
+        
+        auto query = random_vector(rng, dim);
+        auto context = RequestContext::cancellable();
+        context.cancel();
+        bool stopped = cancelled_at("vector_search", [&]() { index.search(query, 10, nullptr, context); });
+        assert(stopped && "A cancelled context stops the search");
+        
+        // Cancelled from another thread while searches run
+        auto racing = RequestContext::cancellable();
+        std::thread canceller([racing]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            racing.cancel();
+        });
+        stopped = false;
+        for (int i = 0; i < 1000000 && !stopped; ++i) {
+            stopped = cancelled_at("vector_search", [&]() { index.search(query, 10, nullptr, racing); });
+        }
+        canceller.join();
+        assert(stopped && "Searches stop once cancelled");
+    }
+    
+    // Test the episodic scan stops on an expired context
+    {
+        EpisodicBuffer buffer(4096);
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f, 0.0f};
+        for (size_t i = 0; i < 3 * EpisodicBuffer::kCancelCheckEpisodes; ++i) {
+            buffer.add_episode("q" + std::to_string(i), "r", emb);
+        }
+        
+        auto live = buffer.retrieve_similar(emb, 5, 0.5f,
+                                            RequestContext::with_timeout(std::chrono::seconds(30)));
+        assert(live.size() == 5);
+        
+        auto context = RequestContext::cancellable();
+        context.cancel();
+        bool stopped = cancelled_at("episodic", [&]() { buffer.retrieve_similar(emb, 5, 0.5f, context); });
+        assert(stopped && "A cancelled context stops the scan");
+    }
+    
+    // Test semantic activation stops on an expired context (BFS and PPR)
+    {
+        SemanticNetwork network;
+        for (int i = 0; i < 50; ++i) {
+            network.add_node("n" + std::to_string(i), {1.0f, 0.0f});
+        }
+        for (int i = 0; i + 1 < 50; ++i) {
+            network.add_edge("n" + std::to_string(i), "n" + std::to_string(i + 1), 0.9f);
+        }
+        
+        for (auto mode : {ActivationMode::BFS, ActivationMode::PersonalizedPageRank}) {
+            ActivationConfig config;
+            config.mode = mode;
+            auto plain = network.spread_activation({"n0"}, config);
+            auto timed = network.spread_activation({"n0"}, config,
+                                                   RequestContext::with_timeout(std::chrono::seconds(30)));
+            assert(plain == timed && "Same activation with a deadline");
+            
+            auto context = RequestContext::cancellable();
+            context.cancel();
+            bool stopped = cancelled_at("semantic", [&]() { network.spread_activation({"n0"}, config, context); });
+            assert(stopped && "A cancelled context stops the activation");
+        }
+    }
+    
+    std::cout << "All request context tests passed!\n";
+}
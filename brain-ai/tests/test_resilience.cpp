@@ -1,6 +1,9 @@
 #include "resilience/circuit_breaker.hpp"
+#include "resilience/hedging.hpp"
+#include "resilience/rate_limiter.hpp"
 #include <thread>
 #include <chrono>
+#include <condition_variable>
 #include <iostream>
 
 using namespace brain_ai::resilience;
@@ -313,6 +316,400 @@ void test_circuit_breaker_exception_propagation() {
     EXPECT_TRUE(caught_correct_exception);
 }
 
+// In-process stand-in for an OCR replica: answers after a fixed latency
+// (or fails), and returns early when the attempt is cancelled
+struct FakeReplica {
+    std::chrono::milliseconds latency{0};
+    bool fail = false;
+    std::string name;
+    std::atomic<int> calls{0};
+    std::atomic<int> cancelled{0};
+
+    std::optional<std::string> serve(AttemptContext& context) {
+        calls++;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool aborted = false;
+        context.on_cancel([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
+            cv.notify_all();
+        });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait_for(lock, latency, [&]() { return aborted; });
+        }
+        context.on_cancel(nullptr);
+        if (context.cancelled()) {
+            cancelled++;
+            return std::nullopt;
+        }
+        if (fail) {
+            return std::nullopt;
+        }
+        return name;
+    }
+};
+
+HedgingConfig fast_hedging() {
+    HedgingConfig config;
+    config.max_attempts = 3;
+    config.max_hedges = 1;
+    config.initial_hedge_delay = std::chrono::milliseconds(20);
+    config.min_hedge_delay = std::chrono::milliseconds(1);
+    config.backoff.base = std::chrono::milliseconds(5);
+    config.backoff.max = std::chrono::milliseconds(20);
+    return config;
+}
+
+void test_backoff_delay_bounds() {
+    BackoffPolicy policy;
+    policy.base = std::chrono::milliseconds(100);
+    policy.max = std::chrono::milliseconds(1000);
+    std::mt19937_64 rng(42);
+
+    long long max_seen = 0;
+    for (int i = 0; i < 200; ++i) {
+        auto first = backoff_delay(policy, 0, rng).count();
+        EXPECT_TRUE(first >= 0 && first <= 100);
+        auto capped = backoff_delay(policy, 20, rng).count();
+        EXPECT_TRUE(capped >= 0 && capped <= 1000);
+        max_seen = std::max<long long>(max_seen, capped);
+    }
+    // Jitter spreads retries across the whole range
+    EXPECT_TRUE(max_seen > 500);
+
+    policy.base = std::chrono::milliseconds(0);
+    EXPECT_EQ(backoff_delay(policy, 3, rng).count(), 0);
+}
+
+void test_latency_tracker_percentile() {
+    LatencyTracker tracker(100);
+    EXPECT_FALSE(tracker.percentile(0.5).has_value());
+
+    for (int i = 1; i <= 100; ++i) {
+        tracker.record(std::chrono::microseconds(i));
+    }
+    EXPECT_EQ(tracker.percentile(0.5)->count(), 50);
+    EXPECT_EQ(tracker.percentile(0.95)->count(), 95);
+    EXPECT_EQ(tracker.percentile(1.0)->count(), 100);
+    EXPECT_FALSE(tracker.percentile(0.5, 101).has_value());
+
+    // The window keeps only the newest samples
+    for (int i = 0; i < 100; ++i) {
+        tracker.record(std::chrono::microseconds(1000));
+    }
+    EXPECT_EQ(tracker.count(), 100u);
+    EXPECT_EQ(tracker.percentile(0.5)->count(), 1000);
+}
+
+void test_hedge_beats_slow_replica() {
+    FakeReplica slow;
+    slow.latency = std::chrono::milliseconds(5000);
+    slow.name = "slow";
+    FakeReplica fast;
+    fast.latency = std::chrono::milliseconds(5);
+    fast.name = "fast";
+    FakeReplica* replicas[] = {&slow, &fast};
+
+    HedgedExecutor executor(fast_hedging(), 2);
+    auto start = std::chrono::steady_clock::now();
+    auto result = executor.execute([&](size_t target, AttemptContext& context) {
+        return replicas[target]->serve(context);
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(result.value.has_value());
+    EXPECT_EQ(*result.value, std::string("fast"));
+    EXPECT_TRUE(result.hedge_won);
+    EXPECT_EQ(result.hedges, 1u);
+    EXPECT_EQ(result.target, 1u);
+    EXPECT_EQ(slow.cancelled.load(), 1);   // Loser aborted, not waited out
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(1000));
+    EXPECT_EQ(executor.latencies().count(), 2u);   // Winner and cancelled loser
+}
+
+void test_hedge_delay_follows_percentile() {
+    HedgingConfig config = fast_hedging();
+    config.min_samples = 10;
+    HedgedExecutor executor(config, 2);
+    EXPECT_TRUE(executor.hedge_delay() == std::chrono::milliseconds(20));
+
+    FakeReplica replica;
+    replica.latency = std::chrono::milliseconds(2);
+    replica.name = "ok";
+    for (int i = 0; i < 10; ++i) {
+        executor.execute([&](size_t, AttemptContext& context) { return replica.serve(context); });
+    }
+    // Now derived from observed latencies (~2 ms), not the initial delay
+    EXPECT_TRUE(executor.hedge_delay() < std::chrono::milliseconds(20));
+    EXPECT_TRUE(executor.hedge_delay() >= std::chrono::milliseconds(1));
+}
+
+void test_retry_fails_over_to_next_replica() {
+    FakeReplica broken;
+    broken.fail = true;
+    FakeReplica healthy;
+    healthy.name = "healthy";
+    FakeReplica* replicas[] = {&broken, &healthy};
+
+    HedgingConfig config = fast_hedging();
+    config.max_hedges = 0;
+    HedgedExecutor executor(config, 2);
+    auto result = executor.execute([&](size_t target, AttemptContext& context) {
+        return replicas[target]->serve(context);
+    });
+
+    EXPECT_TRUE(result.value.has_value());
+    EXPECT_EQ(*result.value, std::string("healthy"));
+    EXPECT_EQ(result.attempts, 2u);
+    EXPECT_EQ(result.hedges, 0u);
+    EXPECT_FALSE(result.hedge_won);
+}
+
+void test_gives_up_after_max_attempts() {
+    FakeReplica broken;
+    broken.fail = true;
+
+    HedgingConfig config = fast_hedging();
+    config.max_attempts = 4;
+    HedgedExecutor executor(config, 1);   // Single target: no hedging
+    auto result = executor.execute([&](size_t, AttemptContext& context) {
+        return broken.serve(context);
+    });
+
+    EXPECT_FALSE(result.value.has_value());
+    EXPECT_EQ(result.attempts, 4u);
+    EXPECT_EQ(result.hedges, 0u);
+    EXPECT_EQ(broken.calls.load(), 4);
+}
+
+void test_backoff_ends_when_hedge_succeeds() {
+    // The first replica fails after the hedge went out; the long backoff
+    // that follows must not delay the hedge's answer
+    FakeReplica failing;
+    failing.latency = std::chrono::milliseconds(50);
+    failing.fail = true;
+    FakeReplica steady;
+    steady.latency = std::chrono::milliseconds(100);
+    steady.name = "steady";
+    FakeReplica* replicas[] = {&failing, &steady};
+
+    HedgingConfig config = fast_hedging();
+    config.backoff.base = std::chrono::milliseconds(5000);
+    config.backoff.max = std::chrono::milliseconds(5000);
+    HedgedExecutor executor(config, 2);
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = executor.execute([&](size_t target, AttemptContext& context) {
+        return replicas[target]->serve(context);
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(result.value.has_value());
+    EXPECT_EQ(*result.value, std::string("steady"));
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(1000));
+}
+
+void test_execute_async_does_not_block_in_backoff() {
+    FakeReplica broken;
+    broken.fail = true;
+
+    HedgingConfig config = fast_hedging();
+    config.max_hedges = 0;
+    config.max_attempts = 2;
+    config.backoff.base = std::chrono::milliseconds(200);
+    config.backoff.max = std::chrono::milliseconds(200);
+    HedgedExecutor executor(config, 1);
+
+    // The retry waits on the executor's timer, not on the caller
+    auto start = std::chrono::steady_clock::now();
+    auto future = executor.execute_async([&](size_t, AttemptContext& context) {
+        return broken.serve(context);
+    });
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100));
+
+    auto result = future.get();
+    EXPECT_FALSE(result.value.has_value());
+    EXPECT_EQ(result.attempts, 2u);
+    EXPECT_EQ(executor.latencies().count(), 2u);   // Failed attempts too
+}
+
+void test_attempt_exception_counts_as_failure() {
+    HedgingConfig config = fast_hedging();
+    config.max_hedges = 0;
+    HedgedExecutor executor(config, 1);
+
+    std::atomic<int> calls{0};
+    auto result = executor.execute([&](size_t, AttemptContext&) -> std::optional<std::string> {
+        if (calls++ == 0) {
+            throw std::runtime_error("connection reset");
+        }
+        return std::string("recovered");
+    });
+
+    EXPECT_TRUE(result.value.has_value());
+    EXPECT_EQ(calls.load(), 2);
+}
+
+void test_deadline_abandons_request() {
+    FakeReplica slow;
+    slow.latency = std::chrono::milliseconds(5000);
+    slow.name = "slow";
+
+    HedgingConfig config = fast_hedging();
+    HedgedExecutor executor(config, 1);
+    auto start = std::chrono::steady_clock::now();
+    auto result = executor.execute([&](size_t, AttemptContext& context) {
+        return slow.serve(context);
+    }, start + std::chrono::milliseconds(30));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(result.value.has_value());
+    EXPECT_TRUE(result.abandoned);
+    EXPECT_EQ(slow.cancelled.load(), 1);   // In-flight attempt aborted
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(1000));
+
+    // Already past the deadline: nothing is launched
+    auto late = executor.execute([&](size_t, AttemptContext& context) {
+        return slow.serve(context);
+    }, std::chrono::steady_clock::now());
+    EXPECT_TRUE(late.abandoned);
+    EXPECT_EQ(late.attempts, 0u);
+}
+
+void test_cancel_predicate_abandons_request() {
+    FakeReplica slow;
+    slow.latency = std::chrono::milliseconds(5000);
+
+    HedgedExecutor executor(fast_hedging(), 2);
+    std::atomic<bool> caller_gone{false};
+    std::thread canceller([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        caller_gone = true;
+    });
+    auto result = executor.execute([&](size_t, AttemptContext& context) {
+        return slow.serve(context);
+    }, HedgedExecutor::Clock::time_point::max(), [&]() { return caller_gone.load(); });
+    canceller.join();
+
+    EXPECT_TRUE(result.abandoned);
+    EXPECT_FALSE(result.value.has_value());
+    EXPECT_EQ(slow.cancelled.load(), static_cast<int>(result.attempts));
+}
+
+// ============================================================================
+// Rate Limiter Tests
+// ============================================================================
+
+void test_rate_limiter_burst_then_reject() {
+    RateLimiterConfig config;
+    config.rate_per_second = 1.0;   // Effectively no refill during the test
+    config.burst = 5.0;
+    RateLimiter limiter(config);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(limiter.try_acquire("client-a"));
+    }
+    auto decision = limiter.acquire("client-a");
+    EXPECT_FALSE(decision.allowed);
+    EXPECT_TRUE(decision.remaining < 1.0);
+    EXPECT_TRUE(decision.retry_after > std::chrono::milliseconds(0));
+    EXPECT_TRUE(decision.retry_after <= std::chrono::milliseconds(1000));
+
+    // Other keys have their own buckets
+    EXPECT_TRUE(limiter.try_acquire("client-b"));
+
+    auto stats = limiter.stats();
+    EXPECT_EQ(stats.allowed, 6u);
+    EXPECT_EQ(stats.rejected, 1u);
+}
+
+void test_rate_limiter_refills() {
+    RateLimiterConfig config;
+    config.rate_per_second = 100.0;   // One token per 10ms
+    config.burst = 2.0;
+    RateLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.try_acquire("tenant"));
+    EXPECT_TRUE(limiter.try_acquire("tenant"));
+    EXPECT_FALSE(limiter.try_acquire("tenant"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(limiter.try_acquire("tenant"));
+
+    // Weighted requests take several tokens; one bigger than the bucket never fits
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(limiter.try_acquire("tenant", 2.0));
+    EXPECT_FALSE(limiter.try_acquire("other", 3.0));
+}
+
+void test_rate_limiter_concurrent_exact() {
+    RateLimiterConfig config;
+    config.rate_per_second = 0.001;   // No refill
+    config.burst = 1000.0;
+    config.shards = 4;
+    RateLimiter limiter(config);
+
+    // Eight threads race for the same buckets; exactly burst get through each
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                for (const char* key : {"x", "y", "z"}) {
+                    if (limiter.try_acquire(key)) {
+                        allowed++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(allowed.load(), 3000);
+    EXPECT_EQ(limiter.stats().rejected, 21000u);
+}
+
+void test_rate_limiter_reuses_full_buckets() {
+    RateLimiterConfig config;
+    config.rate_per_second = 100.0;
+    config.burst = 1.0;
+    config.shards = 1;
+    config.buckets_per_shard = 4;
+    config.max_probes = 4;
+    RateLimiter limiter(config);
+    EXPECT_EQ(limiter.capacity(), 4u);
+
+    // More keys than slots: the extra keys share one overflow bucket
+    int allowed = 0;
+    for (int i = 0; i < 16; ++i) {
+        allowed += limiter.try_acquire("key-" + std::to_string(i)) ? 1 : 0;
+    }
+    EXPECT_EQ(limiter.stats().overflows, 12u);
+    EXPECT_EQ(allowed, 5);
+
+    // Once the buckets have refilled their slots serve new keys again
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    uint64_t overflows = limiter.stats().overflows;
+    EXPECT_TRUE(limiter.try_acquire("late-key"));
+    EXPECT_FALSE(limiter.try_acquire("late-key"));
+    EXPECT_EQ(limiter.stats().overflows, overflows);
+}
+
+void test_rate_limiter_rejects_bad_config() {
+    RateLimiterConfig config;
+    config.rate_per_second = 0.0;
+    bool thrown = false;
+    try {
+        RateLimiter limiter(config);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
 int main() {
     std::cout << "Running Circuit Breaker Tests...\n";
     std::cout << "============================================================\n\n";
@@ -330,6 +727,22 @@ int main() {
     run_test("Circuit breaker predefined configs", test_circuit_breaker_predefined_configs);
     run_test("Circuit breaker JSON export", test_circuit_breaker_json_export);
     run_test("Circuit breaker exception propagation", test_circuit_breaker_exception_propagation);
+    run_test("Backoff delay bounds", test_backoff_delay_bounds);
+    run_test("Latency tracker percentile", test_latency_tracker_percentile);
+    run_test("Hedge beats slow replica", test_hedge_beats_slow_replica);
+    run_test("Hedge delay follows percentile", test_hedge_delay_follows_percentile);
+    run_test("Retry fails over to next replica", test_retry_fails_over_to_next_replica);
+    run_test("Gives up after max attempts", test_gives_up_after_max_attempts);
+    run_test("Backoff ends when hedge succeeds", test_backoff_ends_when_hedge_succeeds);
+    run_test("Execute async does not block in backoff", test_execute_async_does_not_block_in_backoff);
+    run_test("Attempt exception counts as failure", test_attempt_exception_counts_as_failure);
+    run_test("Deadline abandons request", test_deadline_abandons_request);
+    run_test("Cancel predicate abandons request", test_cancel_predicate_abandons_request);
+    run_test("Rate limiter burst then reject", test_rate_limiter_burst_then_reject);
+    run_test("Rate limiter refills", test_rate_limiter_refills);
+    run_test("Rate limiter concurrent exact", test_rate_limiter_concurrent_exact);
+    run_test("Rate limiter reuses full buckets", test_rate_limiter_reuses_full_buckets);
+    run_test("Rate limiter rejects bad config", test_rate_limiter_rejects_bad_config);
     
     std::cout << "\n============================================================\n";
     std::cout << "Resilience Tests Complete\n";
@@ -0,0 +1,294 @@
+#include "semantic_graph.hpp"
+#include "semantic_bulk_loader.hpp"
+#include "semantic_network.hpp"
+#include "errors/exceptions.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("brain_ai_test_" + name)).string();
+}
+
+void write_file(const std::string& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+}  // namespace
+
+void test_semantic_graph() {
+    // Test CSR build: rows sorted by target, duplicates keep the last weight
+    {
+        auto graph = SemanticGraph::build(
+            {"a", "b", "c"},
+            {{0, 2, 0.1f}, {0, 1, 0.2f}, {2, 0, 0.3f}, {0, 2, 0.9f}});
+
+        assert(graph->num_nodes() == 3 && "Should have 3 nodes");
+        assert(graph->num_edges() == 3 && "Duplicate edge should collapse");
+        assert(graph->degree(0) == 2 && graph->degree(1) == 0 && graph->degree(2) == 1);
+
+        uint64_t e = graph->edge_begin(0);
+        assert(graph->targets()[e] == 1 && graph->targets()[e + 1] == 2 && "Row sorted by target");
+        assert(std::fabs(graph->weights()[e + 1] - 0.9f) < 1e-6f && "Last duplicate wins");
+
+        assert(graph->find("c") == 2 && graph->name(2) == "c");
+        assert(graph->find("missing") == SemanticGraph::kInvalidId);
+        assert(graph->embedding(0) == nullptr && "No embeddings by default");
+    }
+
+    // Test invalid graphs are rejected
+    {
+        bool threw = false;
+        try {
+            SemanticGraph::build({"a"}, {{0, 5, 1.0f}});
+        } catch (const errors::InvalidGraphStructureError&) {
+            threw = true;
+        }
+        assert(threw && "Out of range edge should throw");
+
+        threw = false;
+        try {
+            SemanticGraph::build({"a", "a"}, {});
+        } catch (const errors::InvalidGraphStructureError&) {
+            threw = true;
+        }
+        assert(threw && "Duplicate names should throw");
+    }
+
+    // Test TSV load: comments, header, missing weights, malformed lines
+    {
+        std::string path = temp_path("edges.tsv");
+        write_file(path,
+                   "source\ttarget\tweight\n"
+                   "# comment\n"
+                   "cat\tanimal\t0.9\r\n"
+                   "\n"
+                   "dog\tanimal\n"
+                   "dog\tcat\tnot-a-number\n"
+                   "lonely\n"
+                   "animal\tliving thing\t0.5");
+
+        BulkLoadOptions options;
+        options.skip_header = true;
+        options.default_weight = 0.7f;
+        SemanticBulkLoader loader(options);
+        auto graph = loader.load(path);
+
+        assert(loader.stats().records == 3 && "Three valid edges");
+        assert(loader.stats().skipped == 2 && "Two malformed lines");
+        assert(graph->num_nodes() == 4 && "cat, animal, dog, living thing");
+        uint32_t dog = graph->find("dog");
+        assert(graph->degree(dog) == 1);
+        assert(std::fabs(graph->weights()[graph->edge_begin(dog)] - 0.7f) < 1e-6f &&
+               "Missing weight uses default");
+        assert(graph->find("living thing") != SemanticGraph::kInvalidId && "Spaces kept in names");
+        std::remove(path.c_str());
+    }
+
+    // Test CSV load split across several threads matches a single thread
+    {
+        std::string path = temp_path("edges.csv");
+        std::string content;
+        for (int i = 0; i < 250000; ++i) {
+            content += "n" + std::to_string(i % 5000) + ",\"n" + std::to_string((i * 7) % 5000) +
+                       "\"," + std::to_string((i % 10) / 10.0) + "\n";
+        }
+        write_file(path, content);
+
+        BulkLoadOptions single;
+        single.num_threads = 1;
+        auto expected = SemanticBulkLoader(single).load(path);
+
+        BulkLoadOptions parallel;
+        parallel.num_threads = 4;
+        SemanticBulkLoader loader(parallel);
+        auto graph = loader.load(path);
+
+        assert(loader.stats().threads == 4 && "File is large enough for 4 chunks");
+        assert(loader.stats().records == 250000);
+        assert(graph->num_nodes() == expected->num_nodes());
+        assert(graph->num_edges() == expected->num_edges());
+        for (uint32_t id = 0; id < graph->num_nodes(); ++id) {
+            assert(graph->name(id) == expected->name(id) && "Ids follow first appearance");
+            assert(graph->degree(id) == expected->degree(id));
+        }
+        std::remove(path.c_str());
+    }
+
+    // Test binary load with and without a names file
+    {
+        std::string path = temp_path("edges.bin");
+        std::string names_path = temp_path("names.txt");
+        EdgeRecord records[] = {{0, 1, 0.5f}, {1, 2, 0.25f}};
+        write_file(path, std::string(reinterpret_cast<const char*>(records), sizeof(records)));
+        write_file(names_path, "alpha\nbeta\ngamma\n");
+
+        auto numbered = SemanticBulkLoader().load(path);
+        assert(numbered->num_nodes() == 3 && numbered->find("2") == 2 && "Default names are ids");
+
+        BulkLoadOptions options;
+        options.names_path = names_path;
+        auto named = SemanticBulkLoader(options).load(path);
+        assert(named->find("beta") == 1 && named->num_edges() == 2);
+
+        // A corrupt id is rejected before any per-node allocation
+        EdgeRecord corrupt[] = {{0, 1, 0.5f}, {0xFFFFFFFFu, 2, 0.25f}};
+        write_file(path, std::string(reinterpret_cast<const char*>(corrupt), sizeof(corrupt)));
+        for (const std::string& names : {std::string(), names_path}) {
+            BulkLoadOptions bounded;
+            bounded.names_path = names;
+            bool rejected = false;
+            try {
+                SemanticBulkLoader(bounded).load(path);
+            } catch (const errors::SemanticNetworkError&) {
+                rejected = true;
+            }
+            assert(rejected && "Out of range id should throw");
+        }
+
+        write_file(path, "12345");
+        bool threw = false;
+        try {
+            SemanticBulkLoader().load(path);
+        } catch (const errors::SemanticNetworkError&) {
+            threw = true;
+        }
+        assert(threw && "Truncated binary file should throw");
+        std::remove(path.c_str());
+        std::remove(names_path.c_str());
+    }
+
+    // Test SemanticNetwork adopts and merges bulk loads
+    {
+        std::string path = temp_path("network.tsv");
+        write_file(path, "A\tB\t1.0\nB\tC\t1.0\n");
+
+        SemanticNetwork network;
+        auto stats = network.load_edge_list(path);
+        assert(stats.edges == 2 && network.num_nodes() == 3);
+
+        auto activated = network.spread_activation({"A"}, 2, 0.7f, 0.1f);
+        assert(activated.size() == 3 && activated[0].first == "A" && "Traversal over loaded graph");
+        assert((*network.get_node("C"))->activation_level > 0.4f && "Activation recorded");
+
+        network.add_edge("C", "D", 0.5f);
+        network.add_edge("A", "B", 0.2f);  // Overrides the loaded weight
+        write_file(path, "D\tA\t1.0\n");
+        network.load_edge_list(path);
+
+        assert(network.num_nodes() == 4 && network.num_edges() == 4 && "Edits merged");
+        auto node = network.get_node("A");
+        assert(node.has_value() && std::fabs((*node)->edges.at("B") - 0.2f) < 1e-6f);
+        std::remove(path.c_str());
+    }
+
+    // Test snapshot round trip through a read-only mapping
+    {
+        std::string path = temp_path("graph.snap");
+        auto graph = SemanticGraph::build(
+            {"a", "b", "c"},
+            {{0, 1, 0.5f}, {1, 2, 0.25f}, {2, 0, 1.0f}},
+            {{1.0f, 0.0f}, {}, {0.0f, 1.0f}});
+        graph->save_to_file(path);
+
+        auto loaded = SemanticGraph::load_from_file(path);
+        assert(loaded->is_mapped() && !graph->is_mapped());
+        assert(loaded->num_nodes() == 3 && loaded->num_edges() == 3);
+        assert(loaded->find("c") == 2 && loaded->name(1) == "b" && "Name index survives");
+        assert(loaded->targets()[loaded->edge_begin(1)] == 2);
+        assert(std::fabs(loaded->weights()[loaded->edge_begin(1)] - 0.25f) < 1e-6f);
+        assert(loaded->embedding_dim() == 2 && loaded->embedding(1) == nullptr);
+        assert(loaded->embedding(2)[1] == 1.0f && "Embedding block survives");
+
+        // Corrupt the version field
+        {
+            std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(8);
+            uint32_t version = SemanticGraph::kSnapshotVersion + 1;
+            f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        }
+        bool threw = false;
+        try {
+            SemanticGraph::load_from_file(path);
+        } catch (const errors::SemanticNetworkError&) {
+            threw = true;
+        }
+        assert(threw && "Unknown snapshot version should be rejected");
+        assert(loaded->find("a") == 0 && "Existing mapping unaffected by later writes");
+
+        // A header whose section sizes overflow is rejected
+        graph->save_to_file(path);
+        {
+            std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(20);   // embedding_dim
+            uint32_t dim = 0xC0000000u;
+            f.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+        }
+        threw = false;
+        try {
+            SemanticGraph::load_from_file(path);
+        } catch (const errors::SemanticNetworkError&) {
+            threw = true;
+        }
+        assert(threw && "Oversized embedding block should be rejected");
+        std::remove(path.c_str());
+    }
+
+    // Test concurrent saves to one path each publish a complete snapshot
+    {
+        std::string path = temp_path("concurrent.snap");
+        auto small = SemanticGraph::build({"a", "b"}, {{0, 1, 1.0f}});
+        auto large = SemanticGraph::build({"x", "y", "z"}, {{0, 1, 1.0f}, {1, 2, 1.0f}});
+        std::vector<std::thread> savers;
+        for (const auto& graph : {small, large}) {
+            savers.emplace_back([graph, &path] {
+                for (int i = 0; i < 50; ++i) {
+                    graph->save_to_file(path);
+                }
+            });
+        }
+        for (auto& saver : savers) {
+            saver.join();
+        }
+        auto loaded = SemanticGraph::load_from_file(path);
+        assert((loaded->num_nodes() == 2 || loaded->num_nodes() == 3) && "Whole snapshot published");
+        size_t leftovers = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+            leftovers += entry.path().filename().string().rfind("brain_ai_test_concurrent.snap.tmp", 0) == 0;
+        }
+        assert(leftovers == 0 && "Temp files renamed away");
+        std::remove(path.c_str());
+    }
+
+    // Test SemanticNetwork persistence
+    {
+        std::string path = temp_path("network.snap");
+        SemanticNetwork network;
+        network.add_node("A", {1.0f, 0.0f});
+        network.add_edge("A", "B", 0.9f);
+        network.save_to_file(path);
+
+        SemanticNetwork restored;
+        restored.add_node("stale");
+        restored.load_from_file(path);
+        assert(restored.num_nodes() == 2 && restored.num_edges() == 1 && "Load replaces graph");
+        assert(!restored.get_node("stale").has_value());
+        assert(restored.find_similar_concepts({1.0f, 0.0f}, 1, 0.5f)[0] == "A");
+
+        restored.add_edge("B", "C");  // Edits on top of a mapped graph
+        assert(restored.num_edges() == 2 && !restored.graph()->is_mapped());
+        std::remove(path.c_str());
+    }
+
+    std::cout << "All semantic graph tests passed!\n";
+}
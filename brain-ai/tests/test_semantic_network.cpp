@@ -1,6 +1,13 @@
 #include "semantic_network.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <thread>
+#include <unordered_map>
 
 using namespace brain_ai;
 
@@ -79,5 +86,277 @@ void test_semantic_network() {
         assert((*node)->activation_level == 0.0f && "Activation should be reset");
     }
     
+    // Test Personalized PageRank mode
+    {
+        SemanticNetwork network;
+        
+        // A reaches D directly (weak) and via B (strong)
+        network.add_edge("A", "B", 1.0f);
+        network.add_edge("A", "D", 0.1f);
+        network.add_edge("B", "C", 1.0f);
+        network.add_edge("C", "A", 1.0f);
+        network.add_edge("D", "E", 1.0f);
+        network.commit();
+        
+        ActivationConfig config;
+        config.mode = ActivationMode::PersonalizedPageRank;
+        config.activation_threshold = 0.0f;
+        auto activated = network.spread_activation({"A"}, config);
+        
+        assert(!activated.empty() && activated[0].first == "A" && "Source ranks first");
+        assert(activated[0].second == 1.0f && "Scores normalized to the source");
+        
+        std::unordered_map<std::string, float> scores(activated.begin(), activated.end());
+        assert(scores.count("E") && "PPR is not hop limited");
+        assert(scores["B"] > scores["D"] && "Mass follows edge weights");
+        assert((*network.get_node("B"))->activation_level == scores["B"] && "Levels recorded");
+        
+        // Looser tolerance does less work and reaches fewer nodes
+        config.ppr_epsilon = 0.2f;
+        assert(network.spread_activation({"A"}, config).size() < activated.size());
+        
+        // Unknown sources activate nothing
+        assert(network.spread_activation({"missing"}, config).empty());
+    }
+    
+    // Test BFS propagates the strongest same-level parent
+    {
+        SemanticNetwork network;
+        network.add_edge("S", "weak", 0.2f);
+        network.add_edge("S", "strong", 1.0f);
+        network.add_edge("weak", "X", 1.0f);    // Reaches X first
+        network.add_edge("strong", "X", 1.0f);
+        network.add_edge("X", "Y", 1.0f);
+        network.commit();
+        
+        auto activated = network.spread_activation({"S"}, 3, 0.5f, 0.01f);
+        std::unordered_map<std::string, float> scores(activated.begin(), activated.end());
+        assert(std::fabs(scores["X"] - 0.25f) < 1e-6f && "X keeps the strongest path");
+        assert(std::fabs(scores["Y"] - 0.125f) < 1e-6f && "Y sees X's strongest activation");
+    }
+    
+    // Test batched activation matches per-query activation
+    {
+        SemanticNetwork network;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> node(0, 199);
+        std::uniform_real_distribution<float> weight(0.3f, 1.0f);
+        for (int i = 0; i < 800; ++i) {
+            network.add_edge("n" + std::to_string(node(rng)), "n" + std::to_string(node(rng)), weight(rng));
+        }
+        network.commit();
+        
+        std::vector<std::vector<std::string>> batch;
+        for (int q = 0; q < 70; ++q) {  // More than one 64-query sweep
+            batch.push_back({"n" + std::to_string(node(rng)), "n" + std::to_string(node(rng))});
+        }
+        batch.push_back({"missing"});
+        
+        ActivationConfig config;
+        config.max_hops = 4;
+        config.activation_threshold = 0.05f;
+        auto batched = network.spread_activation_batch(batch, config);
+        assert(batched.size() == batch.size() && batched.back().empty());
+        
+        for (size_t q = 0; q < batch.size(); ++q) {
+            auto single = network.spread_activation(batch[q], config);
+            assert(single == batched[q] && "Batch must match per-query results");
+        }
+        
+        config.mode = ActivationMode::PersonalizedPageRank;
+        auto ppr = network.spread_activation_batch({batch[0]}, config);
+        assert(ppr[0] == network.spread_activation(batch[0], config) && "PPR batch per query");
+    }
+    
+    // Test parallel levels (push and pull) match the sequential BFS
+    {
+        std::mt19937 rng(11);
+        WorkPool pool(4);
+        for (uint32_t degree : {2u, 40u}) {    // Sparse: top-down, dense: bottom-up
+            const uint32_t n = 2000;
+            std::vector<std::string> names;
+            for (uint32_t i = 0; i < n; ++i) {
+                names.push_back("n" + std::to_string(i));
+            }
+            std::uniform_int_distribution<uint32_t> node(0, n - 1);
+            std::uniform_real_distribution<float> weight(0.3f, 1.0f);
+            std::vector<EdgeRecord> edges;
+            for (uint32_t i = 0; i < n * degree; ++i) {
+                edges.push_back({node(rng), node(rng), weight(rng)});
+            }
+            auto graph = SemanticGraph::build(names, edges);
+            
+            std::vector<uint32_t> sources;
+            for (int i = 0; i < 50; ++i) {
+                sources.push_back(node(rng));
+            }
+            
+            ActivationConfig config;
+            config.max_hops = 4;
+            config.activation_threshold = 0.02f;
+            config.parallel_frontier_threshold = 0;
+            auto sequential = bfs_activation(*graph, sources, config);
+            config.parallel_frontier_threshold = 1;
+            auto parallel = bfs_activation(*graph, sources, config, pool);
+            
+            std::sort(sequential.begin(), sequential.end());
+            std::sort(parallel.begin(), parallel.end());
+            assert(sequential.size() > 100 && "Traversal reaches a large neighbourhood");
+            assert(sequential == parallel && "Parallel levels match sequential BFS");
+        }
+    }
+    
+    // Test activation cache hits, invalidation and memory bound
+    {
+        SemanticNetwork network;
+        network.add_edge("A", "B", 0.9f);
+        network.add_edge("B", "C", 0.9f);
+        network.add_edge("D", "C", 0.5f);
+        network.commit();
+        
+        auto& hits_metric = monitoring::MetricsRegistry::instance().get_counter(
+            monitoring::metric_names::SEMANTIC_CACHE_HITS);
+        int64_t hits_before = hits_metric.value();
+        
+        auto first = network.spread_activation({"A", "D"});
+        auto second = network.spread_activation({"D", "A", "A"});   // Same source set
+        assert(first == second && "Cached result returned");
+        auto stats = network.activation_cache_stats();
+        assert(stats.hits == 1 && stats.misses == 1 && stats.entries == 1);
+        assert(hits_metric.value() == hits_before + 1 && "Hits reported to MetricsRegistry");
+        assert((*network.get_node("B"))->activation_level > 0.0f && "Hit updates activation levels");
+        
+        network.spread_activation({"A", "D"}, 2, 0.7f, 0.1f);         // Different hops: miss
+        assert(network.activation_cache_stats().misses == 2);
+        
+        uint64_t version = network.version();
+        network.add_edge("C", "E", 1.0f);
+        assert(network.version() > version && "Edits bump the graph version");
+        network.commit();
+        auto after = network.spread_activation({"A", "D"});
+        stats = network.activation_cache_stats();
+        assert(stats.invalidations == 1 && stats.misses == 3 && "Edit invalidates cached results");
+        bool reaches_e = false;
+        for (const auto& [concept, activation] : after) {
+            reaches_e |= concept == "E";
+        }
+        assert(reaches_e && "Result recomputed on the new graph");
+        
+        // Memory bound: tiny budget evicts, zero disables
+        network.set_activation_cache_bytes(1024);
+        network.spread_activation({"A"});
+        network.spread_activation({"B"});
+        network.spread_activation({"C"});
+        stats = network.activation_cache_stats();
+        assert(stats.bytes <= 1024 && stats.evictions > 0 && "Cache stays within budget");
+        
+        network.set_activation_cache_bytes(0);
+        network.spread_activation({"A"});
+        network.spread_activation({"A"});
+        assert(network.activation_cache_stats().entries == 0 && "Disabled cache stores nothing");
+    }
+    
+    // Memory pressure scales the cache budget through the shared monitor
+    {
+        auto& monitor = monitoring::MemoryPressureMonitor::instance();
+        ActivationCache cache(4096);
+        
+        monitor.publish(monitoring::MemoryPressureLevel::HIGH);
+        assert(cache.max_bytes() == 1024 && "High pressure keeps a quarter");
+        cache.set_max_bytes(8192);
+        assert(cache.max_bytes() == 2048 && "New budgets are scaled too");
+        
+        monitor.publish(monitoring::MemoryPressureLevel::NORMAL);
+        assert(cache.max_bytes() == 8192 && "Budget restored once pressure clears");
+    }
+    
+    // Test the bytes gauge sums every cache instead of the last writer
+    {
+        auto& bytes = monitoring::MetricsRegistry::instance().get_gauge(
+            monitoring::metric_names::SEMANTIC_CACHE_BYTES);
+        double before = bytes.value();
+        
+        auto entry = std::make_shared<ActivationCache::Entry>();
+        entry->ranked = {{"concept", 1.0f}};
+        ActivationCache first(4096);
+        first.insert(1, ActivationCache::make_key({1}, ActivationConfig()), entry);
+        size_t first_bytes = first.stats().bytes;
+        {
+            ActivationCache second(4096);
+            second.insert(1, ActivationCache::make_key({2}, ActivationConfig()), entry);
+            assert(bytes.value() == before + first_bytes + second.stats().bytes);
+        }
+        assert(bytes.value() == before + first_bytes && "A destroyed cache withdraws its share");
+    }
+    
+    // Test edits made while a rebuild is in flight are kept and resolved
+    {
+        SemanticNetwork network;
+        std::thread writer([&network] {
+            for (int i = 0; i < 300; ++i) {
+                network.add_edge("hub", "leaf" + std::to_string(i), 0.5f);
+            }
+        });
+        for (int i = 0; i < 100; ++i) {
+            network.commit();
+            auto node = network.get_node("hub");
+            assert(!node.has_value() || (*node)->edges.size() <= 300);
+        }
+        writer.join();
+        network.commit();
+        
+        auto hub = network.get_node("hub");
+        assert(hub.has_value() && (*hub)->edges.size() == 300 && "No edit lost");
+        assert(network.num_nodes() == 301 && network.num_edges() == 300);
+        auto leaf = network.get_node("leaf299");
+        assert(leaf.has_value() && (*leaf)->concept == "leaf299");
+        
+        // The copy does not change with the network
+        network.add_edge("hub", "late", 1.0f);
+        network.commit();
+        assert((*hub)->edges.count("late") == 0);
+        assert((*network.get_node("hub"))->edges.count("late") == 1);
+    }
+    
+    // Test the first read merges pending edits once
+    {
+        SemanticNetwork network;
+        network.set_commit_threshold(0);
+        network.add_edge("A", "B", 1.0f);
+        network.spread_activation({"A"});
+        auto graph = network.graph();
+        
+        for (int i = 0; i < 50; ++i) {
+            network.add_edge("A", "n" + std::to_string(i), 0.5f);
+        }
+        assert(network.pending_edits() == 100 && "Edits are buffered");
+        assert((*network.get_node("A"))->edges.size() == 51 && network.num_nodes() == 52);
+        assert(network.pending_edits() == 0 && network.graph() != graph);
+        
+        graph = network.graph();
+        network.spread_activation({"A"});
+        assert(network.graph() == graph && "Reads without edits do not rebuild");
+    }
+    
+    // Test reaching the commit threshold merges in the background
+    {
+        SemanticNetwork network;
+        network.set_commit_threshold(64);
+        std::vector<std::tuple<std::string, std::string, float>> relations;
+        for (int i = 0; i < 40; ++i) {
+            relations.emplace_back("root", "c" + std::to_string(i), 1.0f);
+        }
+        network.add_edges(relations);   // 41 nodes + 40 edges
+        for (int i = 0; i < 200 && network.pending_edits() > 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        assert(network.pending_edits() == 0 && network.num_edges() == 40 && "Committed off-thread");
+        
+        // Edits below the threshold wait for the next read
+        network.add_edge("root", "extra", 1.0f);
+        assert(network.pending_edits() == 2);
+        assert(network.num_edges() == 41 && network.pending_edits() == 0);
+    }
+    
     std::cout << "All semantic network tests passed!\n";
 }
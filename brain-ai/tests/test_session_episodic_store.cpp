@@ -0,0 +1,156 @@
+#include "session_episodic_store.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+using namespace brain_ai;
+
+void test_session_episodic_store() {
+    // Test session isolation
+    {
+        SessionEpisodicStore store(SessionStoreConfig(10));
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+
+        store.add_episode("alice", "alice query", "alice response", emb);
+        store.add_episode("bob", "bob query", "bob response", emb);
+
+        auto alice = store.retrieve_similar("alice", emb, 5, 0.5f);
+        assert(alice.size() == 1 && "Alice should only see her own episode");
+        assert(alice[0].query == "alice query" && "Alice should get her episode");
+
+        auto bob = store.retrieve_similar("bob", emb, 5, 0.5f);
+        assert(bob.size() == 1 && bob[0].query == "bob query" && "Bob should only see his episode");
+
+        assert(store.retrieve_similar("carol", emb, 5, 0.5f).empty() &&
+               "Unknown session should have no episodes");
+        assert(store.session_count() == 2 && "Lookups must not create sessions");
+        assert(store.size() == 2 && "Store should hold 2 episodes");
+    }
+
+    // Test per-session capacity
+    {
+        SessionEpisodicStore store(SessionStoreConfig(2));
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+
+        store.add_episode("s1", "q1", "r1", emb);
+        store.add_episode("s1", "q2", "r2", emb);
+        store.add_episode("s1", "q3", "r3", emb);  // Evicts q1 in s1 only
+        store.add_episode("s2", "q4", "r4", emb);
+
+        assert(store.session_size("s1") == 2 && "Session ring should be bounded");
+        assert(store.session_size("s2") == 1 && "Other session unaffected");
+        assert(store.get_recent("s1", 10)[0].query == "q2" && "Oldest episode should be evicted");
+    }
+
+    // Test LRU session eviction under memory budget
+    {
+        SessionStoreConfig config(4);
+        config.num_shards = 4;
+        SessionEpisodicStore probe(config);
+        std::vector<float> emb(64, 0.5f);
+        probe.add_episode("probe", "q", "r", emb);
+        size_t per_session = probe.memory_usage_bytes() - probe.default_buffer().memory_usage_bytes();
+
+        config.memory_budget_bytes = per_session * 3 + per_session / 2;
+        SessionEpisodicStore store(config);
+        store.add_episode("s1", "q", "r", emb);
+        store.add_episode("s2", "q", "r", emb);
+        store.add_episode("s3", "q", "r", emb);
+        store.retrieve_similar("s1", emb);            // Touch s1, s2 becomes LRU
+        store.add_episode("s4", "q", "r", emb);       // Over budget -> evict s2
+
+        assert(store.session_count() == 3 && "One session should be evicted");
+        assert(store.evicted_sessions() == 1 && "Eviction should be counted");
+        assert(!store.find_session("s2") && "Least recently used session should go");
+        assert(store.find_session("s1") && store.find_session("s4") && "Recent sessions kept");
+        assert(store.memory_usage_bytes() <= config.memory_budget_bytes && "Should respect budget");
+    }
+
+    // Test a large default session does not push named sessions out
+    {
+        SessionStoreConfig config(16);
+        SessionEpisodicStore probe(config);
+        std::vector<float> emb(64, 0.5f);
+        probe.add_episode("probe", "q", "r", emb);
+        size_t per_session = probe.memory_usage_bytes();
+
+        config.memory_budget_bytes = per_session * 2 + per_session / 2;
+        SessionEpisodicStore store(config);
+        for (int i = 0; i < 16; ++i) {
+            store.add_episode("", "q", "r", emb);
+        }
+        assert(store.default_buffer().memory_usage_bytes() > config.memory_budget_bytes);
+        store.add_episode("s1", "q", "r", emb);
+        store.add_episode("s2", "q", "r", emb);
+
+        assert(store.session_count() == 2 && store.evicted_sessions() == 0 &&
+               "Default session is outside the budget");
+    }
+
+    // Test memory pressure shrinks the budget and evicts right away
+    {
+        SessionStoreConfig config(4);
+        config.memory_budget_bytes = 0;  // Unlimited until pressure sets in
+        SessionEpisodicStore store(config);
+        std::vector<float> emb(64, 0.5f);
+        for (int i = 0; i < 8; ++i) {
+            store.add_episode("s" + std::to_string(i), "q", "r", emb);
+        }
+
+        store.on_memory_pressure(monitoring::MemoryPressureLevel::HIGH);
+        assert(store.memory_budget_bytes() > 0 && "Pressure should cap an unlimited budget");
+        assert(store.session_count() <= 2 && "Sessions should be evicted down to a quarter");
+        assert(store.find_session("s7") && "Most recent session kept");
+
+        store.on_memory_pressure(monitoring::MemoryPressureLevel::MODERATE);
+        assert(store.session_count() <= 2 && "Easing pressure should not evict more");
+
+        store.on_memory_pressure(monitoring::MemoryPressureLevel::NORMAL);
+        assert(store.memory_budget_bytes() == 0 && "Budget restored once pressure clears");
+    }
+
+    // Test default session is pinned and clear
+    {
+        SessionStoreConfig config(4);
+        config.memory_budget_bytes = 1;  // Everything partitioned is over budget
+        SessionEpisodicStore store(config);
+        std::vector<float> emb = {1.0f, 0.0f, 0.0f};
+
+        store.add_episode("", "default query", "default response", emb);
+        store.add_episode("s1", "q1", "r1", emb);
+        store.add_episode("s2", "q2", "r2", emb);
+
+        assert(store.default_buffer().size() == 1 && "Default session is never evicted");
+        assert(store.session_count() == 1 && "Only the writing session survives");
+        assert(store.find_session("s2") && "Writer should not evict itself");
+
+        store.clear_session("s2");
+        assert(store.session_count() == 0 && "Session should be dropped");
+
+        store.clear();
+        assert(store.size() == 0 && "Store should be empty after clear");
+        assert(store.memory_usage_bytes() == 0 && "Accounting should reset");
+    }
+
+    // Test concurrent writers on different sessions
+    {
+        SessionEpisodicStore store(SessionStoreConfig(50));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&store, t]() {
+                std::vector<float> emb = {1.0f, static_cast<float>(t), 0.0f};
+                std::string session = "session_" + std::to_string(t);
+                for (int i = 0; i < 50; ++i) {
+                    store.add_episode(session, "q", "r", emb);
+                    store.retrieve_similar(session, emb, 3, 0.1f);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        assert(store.session_count() == 4 && "All sessions should exist");
+        assert(store.size() == 200 && "All episodes should be stored");
+    }
+
+    std::cout << "All session episodic store tests passed!\n";
+}
@@ -0,0 +1,126 @@
+#include "single_flight.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai;
+
+void test_single_flight() {
+    // Test concurrent callers of one key share a single execution
+    {
+        SingleFlight<std::string, std::vector<int>> flights;
+        const size_t callers = 6;
+        std::atomic<int> runs{0};
+        std::atomic<bool> release{false};
+        std::vector<SingleFlight<std::string, std::vector<int>>::Result> results(callers);
+        
+        auto work = [&]() {
+            runs.fetch_add(1);
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+            return std::vector<int>{1, 2, 3};
+        };
+        
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() { results[0] = flights.run("q", work); });
+        while (flights.in_flight() == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 1; i < callers; ++i) {
+            threads.emplace_back([&, i]() { results[i] = flights.run("q", work); });
+        }
+        // Hold the leader until every duplicate is waiting on it
+        while (flights.stats().coalesced < callers - 1) {
+            std::this_thread::yield();
+        }
+        release = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        assert(runs.load() == 1 && "Work ran once");
+        for (const auto& result : results) {
+            assert(result == results[0] && "Every caller shares the response");
+        }
+        assert(results[0]->size() == 3);
+        assert(flights.stats().executions == 1);
+        assert(flights.in_flight() == 0 && "Key released after completion");
+        
+        // Nothing is cached: the next call runs again
+        bool joined = true;
+        auto again = flights.run("q", work, &joined);
+        assert(!joined && again != results[0] && runs.load() == 2);
+    }
+    
+    // Test exceptions reach the caller and release the key
+    {
+        SingleFlight<int, int> flights;
+        bool caught = false;
+        try {
+            flights.run(7, []() -> int { throw std::runtime_error("failed"); });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught && "Exception propagated");
+        assert(flights.in_flight() == 0);
+        auto retried = flights.run(7, []() { return 42; });
+        assert(*retried == 42 && "Retried after failure");
+    }
+    
+    // Test distinct keys never wait on each other
+    {
+        SingleFlight<int, int> flights;
+        std::atomic<bool> inner_ran{false};
+        auto outer = flights.run(1, [&]() {
+            // A different key runs even while key 1 is in flight
+            auto inner = flights.run(2, [&]() { inner_ran = true; return 2; });
+            return *inner + 1;
+        });
+        assert(inner_ran.load() && *outer == 3);
+        assert(flights.stats().executions == 2 && flights.stats().coalesced == 0);
+    }
+    
+    // Test a waiter whose poll throws stops waiting; the leader finishes
+    {
+        SingleFlight<int, int> flights;
+        std::atomic<bool> release{false};
+        std::atomic<int> polls{0};
+        auto work = [&]() {
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+            return 5;
+        };
+        
+        SingleFlight<int, int>::Result leader_result;
+        std::thread leader([&]() { leader_result = flights.run(1, work); });
+        while (flights.in_flight() == 0) {
+            std::this_thread::yield();
+        }
+        
+        bool gave_up = false;
+        bool joined = false;
+        try {
+            flights.run(1, work, &joined, [&]() {
+                if (++polls == 3) {
+                    throw std::runtime_error("caller gone");
+                }
+            }, std::chrono::milliseconds(1));
+        } catch (const std::runtime_error&) {
+            gave_up = true;
+        }
+        assert(gave_up && joined && polls.load() == 3 && "Waiter abandoned the wait");
+        
+        release = true;
+        leader.join();
+        assert(*leader_result == 5 && flights.stats().executions == 1 && "Leader unaffected");
+    }
+    
+    std::cout << "All single flight tests passed!\n";
+}
@@ -1,4 +1,9 @@
 #include "vector_search/hnsw_index.hpp"
+#include "indexing/search_batcher.hpp"
+#include "errors/exceptions.hpp"
+#include "work_pool.hpp"
+#include <atomic>
+#include <future>
 #include <thread>
 #include <chrono>
 #include <iostream>
@@ -385,6 +390,251 @@ void test_dimension_validation() {
     EXPECT_TRUE(exception_thrown);
 }
 
+// ============================================================================
+// Batched Search
+// ============================================================================
+
+void test_search_batch_matches_search() {
+    HNSWIndex index(64, 1000);
+    std::mt19937 gen(7);
+    for (int i = 0; i < 300; ++i) {
+        index.add_document("doc" + std::to_string(i), random_embedding(64, gen),
+                           "Document " + std::to_string(i));
+    }
+    
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 17; ++i) {
+        queries.push_back(random_embedding(64, gen));
+    }
+    
+    // Serial and pooled batches both match one-at-a-time searches
+    brain_ai::WorkPool pool(3);
+    SearchCost cost;
+    auto serial = index.search_batch(queries, 5);
+    auto pooled = index.search_batch(queries, 5, &cost, &pool);
+    EXPECT_EQ(serial.size(), queries.size());
+    EXPECT_EQ(pooled.size(), queries.size());
+    EXPECT_TRUE(cost.ef_search >= 5);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto single = index.search(queries[i], 5);
+        EXPECT_EQ(serial[i].size(), single.size());
+        EXPECT_EQ(pooled[i].size(), single.size());
+        for (size_t r = 0; r < single.size(); ++r) {
+            EXPECT_EQ(serial[i][r].doc_id, single[r].doc_id);
+            EXPECT_EQ(pooled[i][r].doc_id, single[r].doc_id);
+            EXPECT_NEAR(pooled[i][r].similarity, single[r].similarity, 1e-6);
+        }
+    }
+    
+    // A bad query fails the batch before any search runs
+    queries.push_back(std::vector<float>(32, 0.1f));
+    bool exception_thrown = false;
+    try {
+        index.search_batch(queries, 5);
+    } catch (const std::invalid_argument&) {
+        exception_thrown = true;
+    }
+    EXPECT_TRUE(exception_thrown);
+}
+
+void test_search_batcher_concurrent() {
+    using namespace brain_ai::indexing;
+    
+    IndexConfig config;
+    config.embedding_dim = 64;
+    config.max_elements = 1000;
+    config.auto_save = false;
+    IndexManager manager(config);
+    
+    std::mt19937 gen(11);
+    for (int i = 0; i < 200; ++i) {
+        manager.add_document("doc" + std::to_string(i), random_embedding(64, gen),
+                             "Document " + std::to_string(i));
+    }
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 64; ++i) {
+        queries.push_back(random_embedding(64, gen));
+    }
+    
+    // A long linger and a burst of submissions from one thread: the whole
+    // burst lands in a few batches
+    SearchBatcherConfig batcher_config;
+    batcher_config.max_batch = 16;
+    batcher_config.max_linger = std::chrono::microseconds(20000);
+    SearchBatcher batcher(manager, batcher_config);
+    
+    std::vector<std::future<std::vector<SearchResult>>> futures;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        // Mixed top_k and thresholds share batches
+        size_t top_k = 1 + i % 8;
+        float threshold = (i % 3 == 0) ? 0.2f : 0.0f;
+        futures.push_back(batcher.submit(queries[i], top_k, threshold));
+    }
+    for (size_t i = 0; i < queries.size(); ++i) {
+        size_t top_k = 1 + i % 8;
+        float threshold = (i % 3 == 0) ? 0.2f : 0.0f;
+        auto batched = futures[i].get();
+        auto direct = manager.search(queries[i], top_k, threshold);
+        EXPECT_EQ(batched.size(), direct.size());
+        for (size_t r = 0; r < direct.size(); ++r) {
+            EXPECT_EQ(batched[r].doc_id, direct[r].doc_id);
+        }
+    }
+    
+    auto stats = batcher.get_stats();
+    EXPECT_EQ(stats.requests, queries.size());
+    EXPECT_TRUE(stats.batches < queries.size());
+    EXPECT_TRUE(stats.largest_batch > 1);
+    EXPECT_TRUE(stats.largest_batch <= 16);
+    
+    // Concurrent callers on blocking search()
+    std::vector<std::thread> threads;
+    std::atomic<int> matched{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = t; i < queries.size(); i += 4) {
+                auto results = batcher.search(queries[i], 5);
+                if (results.size() == 5) {
+                    matched++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(matched.load(), static_cast<int>(queries.size()));
+}
+
+void test_search_batcher_adaptive_linger() {
+    using namespace brain_ai::indexing;
+    
+    IndexConfig config;
+    config.embedding_dim = 16;
+    config.max_elements = 100;
+    config.auto_save = false;
+    IndexManager manager(config);
+    std::mt19937 gen(3);
+    manager.add_document("doc0", random_embedding(16, gen), "Document 0");
+    
+    SearchBatcherConfig batcher_config;
+    batcher_config.max_batch = 8;
+    batcher_config.max_linger = std::chrono::microseconds(2000);
+    SearchBatcher batcher(manager, batcher_config);
+    
+    // Idle: a lone request does not wait for company
+    EXPECT_EQ(batcher.current_linger().count(), 0);
+    auto start = std::chrono::steady_clock::now();
+    auto results = batcher.search(random_embedding(16, gen), 1);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(results.size(), 1u);
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(50));
+    
+    // A burst raises the arrival rate and with it the linger
+    std::vector<std::future<std::vector<SearchResult>>> futures;
+    for (int i = 0; i < 64; ++i) {
+        futures.push_back(batcher.submit(random_embedding(16, gen), 1));
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    EXPECT_TRUE(batcher.current_linger().count() > 0);
+    EXPECT_TRUE(batcher.current_linger() <= batcher_config.max_linger);
+    for (auto& future : futures) {
+        future.get();
+    }
+    
+    // Wrong dimension fails only its own future
+    auto bad = batcher.submit(std::vector<float>(8, 0.1f), 1);
+    bool exception_thrown = false;
+    try {
+        bad.get();
+    } catch (const std::invalid_argument&) {
+        exception_thrown = true;
+    }
+    EXPECT_TRUE(exception_thrown);
+    
+    // An expired request fails without being searched
+    auto expired = batcher.submit(random_embedding(16, gen), 1, 0.0f,
+                                  brain_ai::QueryPriority::INTERACTIVE,
+                                  brain_ai::RequestContext::with_timeout(std::chrono::milliseconds(0)));
+    bool cancelled = false;
+    try {
+        expired.get();
+    } catch (const brain_ai::errors::CancelledError&) {
+        cancelled = true;
+    }
+    EXPECT_TRUE(cancelled);
+    
+    // Batches are not capped by scheduler capacity: waiting requests hold no slot
+    auto& scheduler = brain_ai::QueryScheduler::shared();
+    auto saved = scheduler.config();
+    auto single = saved;
+    single.max_concurrency = 1;
+    scheduler.reconfigure(single);
+    futures.clear();
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(batcher.submit(random_embedding(16, gen), 1));
+    }
+    size_t served = 0;
+    for (auto& future : futures) {
+        served += future.get().size();
+    }
+    scheduler.reconfigure(saved);
+    EXPECT_EQ(served, 8u);
+}
+
+void test_search_batcher_caller_deadline() {
+    using namespace brain_ai::indexing;
+    
+    IndexConfig config;
+    config.embedding_dim = 16;
+    config.max_elements = 100;
+    config.auto_save = false;
+    IndexManager manager(config);
+    std::mt19937 gen(5);
+    manager.add_document("doc0", random_embedding(16, gen), "Document 0");
+    SearchBatcher batcher(manager);
+    
+    // Hold the only scheduler slot so the dispatcher cannot run the batch
+    auto& scheduler = brain_ai::QueryScheduler::shared();
+    auto saved = scheduler.config();
+    auto single = saved;
+    single.max_concurrency = 1;
+    scheduler.reconfigure(single);
+    auto slot = scheduler.admit(brain_ai::QueryPriority::INTERACTIVE);
+    
+    // The caller gives up at its deadline rather than when the batch runs
+    auto start = std::chrono::steady_clock::now();
+    bool cancelled = false;
+    try {
+        batcher.search(random_embedding(16, gen), 1, 0.0f,
+                       brain_ai::QueryPriority::INTERACTIVE,
+                       brain_ai::RequestContext::with_timeout(std::chrono::milliseconds(20)));
+    } catch (const brain_ai::errors::CancelledError&) {
+        cancelled = true;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    
+    // The dispatcher stops waiting for a slot once the whole batch expired
+    auto future = batcher.submit(random_embedding(16, gen), 1, 0.0f,
+                                 brain_ai::QueryPriority::INTERACTIVE,
+                                 brain_ai::RequestContext::with_timeout(std::chrono::milliseconds(20)));
+    bool completed = future.wait_for(std::chrono::milliseconds(500)) == std::future_status::ready;
+    
+    slot.release();
+    scheduler.reconfigure(saved);
+    EXPECT_TRUE(cancelled);
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(500));
+    EXPECT_TRUE(completed);
+    bool batch_cancelled = false;
+    try {
+        future.get();
+    } catch (const brain_ai::errors::CancelledError&) {
+        batch_cancelled = true;
+    }
+    EXPECT_TRUE(batch_cancelled);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -427,6 +677,12 @@ int main() {
     // Error handling
     run_test("Dimension validation", test_dimension_validation);
     
+    // Batched search
+    run_test("Search batch matches search", test_search_batch_matches_search);
+    run_test("Search batcher concurrent callers", test_search_batcher_concurrent);
+    run_test("Search batcher adaptive linger", test_search_batcher_adaptive_linger);
+    run_test("Search batcher caller deadline", test_search_batcher_caller_deadline);
+    
     std::cout << "\n============================================================\n";
     std::cout << "Vector Search Tests Complete\n";
     std::cout << "============================================================\n";
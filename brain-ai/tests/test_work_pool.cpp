@@ -0,0 +1,72 @@
+#include "work_pool.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace brain_ai;
+
+void test_work_pool() {
+    // Test parallel_for covers every index exactly once
+    {
+        WorkPool pool(3);
+        std::vector<std::atomic<int>> hits(10007);
+        pool.parallel_for(hits.size(), 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1);
+            }
+        });
+        for (const auto& hit : hits) {
+            assert(hit.load() == 1 && "Each index visited once");
+        }
+        
+        // Empty and single-chunk ranges run inline
+        pool.parallel_for(0, 8, [](size_t, size_t) { assert(false && "No chunks"); });
+        size_t covered = 0;
+        pool.parallel_for(5, 8, [&](size_t begin, size_t end) { covered += end - begin; });
+        assert(covered == 5);
+    }
+    
+    // Test exceptions propagate to the caller
+    {
+        WorkPool pool(2);
+        bool caught = false;
+        try {
+            pool.parallel_for(100, 1, [](size_t begin, size_t) {
+                if (begin == 42) {
+                    throw std::runtime_error("chunk failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught && "Chunk exception rethrown");
+    }
+    
+    // Test nested parallel_for from a pool task completes
+    {
+        WorkPool pool(1);
+        std::atomic<int> total{0};
+        pool.parallel_for(4, 1, [&](size_t, size_t) {
+            pool.parallel_for(10, 2, [&](size_t begin, size_t end) {
+                total.fetch_add(static_cast<int>(end - begin));
+            });
+        });
+        assert(total.load() == 40 && "Nested ranges complete");
+    }
+    
+    // Test submitted tasks run before destruction finishes
+    {
+        std::atomic<int> ran{0};
+        {
+            WorkPool pool(2);
+            for (int i = 0; i < 20; ++i) {
+                pool.submit([&] { ran.fetch_add(1); });
+            }
+        }
+        assert(ran.load() == 20 && "Queued tasks drained on shutdown");
+    }
+    
+    std::cout << "All work pool tests passed!\n";
+}